@@ -26,6 +26,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/base/nullability.h"
 #include "absl/strings/string_view.h"
@@ -161,6 +162,13 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       // Indicates how to downmix multi-channel capture audio to mono (when
       // needed).
       DownmixMethod capture_downmix_method = DownmixMethod::kAverageChannels;
+      // Carries the adaptive state of the echo cancellers over
+      // reinitializations, e.g., at stream format changes, see
+      // AudioProcessing::GetWarmStartState().
+      bool warm_start_on_reinitialization = false;
+      // Measures the execution time of every capture processing stage, see
+      // AudioProcessing::GetStageTimings(). Costs two clock reads per stage.
+      bool measure_stage_timings = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
@@ -379,6 +387,9 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       } fixed_digital;
     } gain_controller2;
 
+    // SeekAudio howling (AFC) and echo (AEC) suppression. When both are
+    // enabled the AEC runs first and the AFC processes its output. Modules
+    // that are not enabled do not load their engine library.
     struct SeekAudioAfc {
       SeekAudioAfc() = default;
       bool enabled = false;
@@ -386,6 +397,10 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       int echo_level = 0;
       std::string log_directory;
       std::string library_path; 
+      // Lets the engine undo the part of the AGC1 gain that it considers
+      // howling, after the AEC compensation if both run. See
+      // `SeekAudioAec::agc_compensation`.
+      bool agc_compensation = false;
     };
     SeekAudioAfc seek_audio_afc;
 
@@ -396,9 +411,64 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       int echo_level = 0;
       std::string log_directory;
       std::string library_path;
+      // 0 runs the engine inline on the capture thread. A positive value runs
+      // it on a worker thread and delays the capture signal by that many 10 ms
+      // frames, at most 16. Late frames pass through unprocessed.
+      int async_lookahead_frames = 0;
+      // With async processing, a positive value runs the engine on a pool of
+      // that many pinned worker threads shared by all APM instances of the
+      // process instead of on a thread per instance.
+      int shared_worker_threads = 0;
+      // Estimates the echo path delay with the AEC3 delay estimator and
+      // pre-delays the far-end reference by it, less a short headroom, so that
+      // the engine does not have to cover large render/capture skews.
+      bool align_far_end = false;
+      // Number of consecutive capture frames that may pass without a new
+      // far-end frame before they count as far-end underflow, to absorb
+      // render callback jitter.
+      int far_end_jitter_allowance_frames = 2;
+      // Lets the engine undo the part of the AGC1 gain that it considers
+      // residual echo. Runs on the lowest split band right after AGC1 and is
+      // skipped in worker thread mode.
+      bool agc_compensation = false;
     };
     SeekAudioAec seek_audio_aec;
 
+    // Adapts the AI engine power of the SeekAudio modules at runtime. The
+    // engines run at `idle_level` until howling or residual echo is detected,
+    // are then raised to the configured `suppress_level`/`echo_level`, and
+    // decay back once the detection has ended.
+    struct SeekAudioPowerGovernor {
+      bool operator==(const SeekAudioPowerGovernor& rhs) const {
+        return enabled == rhs.enabled && idle_level == rhs.idle_level &&
+               howling_threshold == rhs.howling_threshold &&
+               residual_echo_threshold == rhs.residual_echo_threshold &&
+               hold_frames == rhs.hold_frames &&
+               decay_frames == rhs.decay_frames &&
+               cpu_budget_cores == rhs.cpu_budget_cores;
+      }
+      bool operator!=(const SeekAudioPowerGovernor& rhs) const {
+        return !(*this == rhs);
+      }
+
+      bool enabled = false;
+      int idle_level = 0;
+      // Howling probability of the engine above which the howl power is
+      // raised.
+      float howling_threshold = 0.5f;
+      // Residual echo likelihood above which the echo power is raised. Needs
+      // an echo detector; without one the echo power is not governed.
+      float residual_echo_threshold = 0.5f;
+      // 10 ms frames for which the raised level is held after the detection
+      // has ended, and over which it then decays to `idle_level`.
+      int hold_frames = 100;
+      int decay_frames = 50;
+      // CPU time, in cores, that the SeekAudio engines of the whole process
+      // may use. Above it levels are not raised and decay without hold. 0
+      // disables the budget.
+      float cpu_budget_cores = 0.f;
+    } seek_audio_power_governor;
+
     std::string ToString() const;
   };
 
@@ -415,9 +485,14 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       kCustomRenderProcessingRuntimeSetting,
       kPlayoutAudioDeviceChange,
       kCapturePostGain,
-      kCaptureOutputUsed
+      kCaptureOutputUsed,
+      kSeekAudioMode
     };
 
+    // SeekAudio capture stages to run. With `kAecThenAfc` the AFC processes
+    // the output of the AEC.
+    enum class SeekAudioMode { kOff = 0, kAec = 1, kAfc = 2, kAecThenAfc = 3 };
+
     // Play-out audio device properties.
     struct PlayoutAudioDeviceInfo {
       int id;          // Identifies the audio device.
@@ -473,6 +548,17 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
       return {Type::kCaptureOutputUsed, capture_output_used};
     }
 
+    // Corresponds to Config::SeekAudioAec::enabled and
+    // Config::SeekAudioAfc::enabled, but for runtime configuration. Switching
+    // does not reinitialize APM, except when enabling SeekAudio from `kOff`.
+    // The engine libraries of the selected modules are opened when the
+    // setting is posted, on the calling thread. The libraries of modules
+    // switched off are closed on the calling thread of the next such setting
+    // or ApplyConfig().
+    static RuntimeSetting CreateSeekAudioMode(SeekAudioMode mode) {
+      return {Type::kSeekAudioMode, static_cast<int>(mode)};
+    }
+
     Type type() const { return type_; }
     // Getters do not return a value but instead modify the argument to protect
     // from implicit casting.
@@ -687,6 +773,25 @@ class RTC_EXPORT AudioProcessing : public RefCountInterface {
   // Returns the last applied configuration.
   virtual AudioProcessing::Config GetConfig() const = 0;
 
+  // Returns the adaptive state of the echo cancellers, i.e., of AEC3 when
+  // created by APM itself and of the SeekAudio engines that export it, in a
+  // compact binary form. Passing it to SetWarmStartState() of a new instance
+  // with the same formats lets that instance start out converged instead of
+  // re-adapting from scratch. Empty if no module has any state to provide.
+  virtual std::vector<uint8_t> GetWarmStartState() { return {}; }
+  // Restores a state returned by GetWarmStartState(). Modules that the state
+  // does not match keep their current state. Returns false if the state is
+  // malformed or no module could be restored.
+  virtual bool SetWarmStartState(ArrayView<const uint8_t> /* state */) {
+    return false;
+  }
+
+  // Returns histogram summaries of the execution times of the capture
+  // processing stages since `Config::Pipeline::measure_stage_timings` was
+  // enabled. Does not block the audio threads and may be called on any
+  // thread. All counts are zero while the measurement is disabled.
+  virtual AudioProcessingStageTimings GetStageTimings() { return {}; }
+
   enum Error {
     // Fatal errors.
     kNoError = 0,
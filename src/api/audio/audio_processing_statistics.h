@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_AUDIO_AUDIO_PROCESSING_STATISTICS_H_
+#define API_AUDIO_AUDIO_PROCESSING_STATISTICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+// This version of the stats uses Optionals, it will replace the regular
+// AudioProcessingStatistics struct.
+struct RTC_EXPORT AudioProcessingStats {
+  AudioProcessingStats();
+  AudioProcessingStats(const AudioProcessingStats& other);
+  ~AudioProcessingStats();
+
+  // Deprecated.
+  // TODO(bugs.webrtc.org/11226): Remove.
+  // True if voice is detected in the last capture frame, after processing.
+  // It is conservative in flagging audio as speech, with low likelihood of
+  // incorrectly flagging a frame as voice.
+  // Only reported if voice detection is enabled in AudioProcessing::Config.
+  std::optional<bool> voice_detected;
+
+  // AEC Statistics.
+  // ERL = 10log_10(P_far / P_echo)
+  std::optional<double> echo_return_loss;
+  // ERLE = 10log_10(P_echo / P_out)
+  std::optional<double> echo_return_loss_enhancement;
+  // Fraction of time that the AEC linear filter is divergent, in a 1-second
+  // non-overlapped aggregation window.
+  std::optional<double> divergent_filter_fraction;
+
+  // The delay metrics consists of the delay median and standard deviation. It
+  // also consists of the fraction of delay estimates that can make the echo
+  // cancellation perform poorly. The values are aggregated until the first
+  // call to `GetStatistics()` and afterwards aggregated and updated every
+  // second. Note that if there are several clients pulling metrics from
+  // `GetStatistics()` during a session the first call from any of them will
+  // change to one second aggregation window for all.
+  std::optional<int32_t> delay_median_ms;
+  std::optional<int32_t> delay_standard_deviation_ms;
+
+  // Residual echo detector likelihood.
+  std::optional<double> residual_echo_likelihood;
+  // Maximum residual echo likelihood from the last time period.
+  std::optional<double> residual_echo_likelihood_recent_max;
+
+  // The instantaneous delay estimate produced in the AEC. The unit is in
+  // milliseconds and the value is the instantaneous value at the time of the
+  // call to `GetStatistics()`.
+  std::optional<int32_t> delay_ms;
+
+  // Latency added to the capture signal by the SeekAudio AEC when its engine
+  // runs on a worker thread, see
+  // AudioProcessing::Config::SeekAudioAec::async_lookahead_frames.
+  std::optional<int32_t> seek_audio_latency_ms;
+  // Number of capture frames, since the SeekAudio AEC worker was started, for
+  // which the worker result was not ready in time and the unprocessed signal
+  // was passed on.
+  std::optional<int32_t> seek_audio_late_frames;
+  // Time left before the deadline when the SeekAudio AEC worker completed the
+  // last output frame, negative if it was late. The unit is in microseconds.
+  std::optional<int32_t> seek_audio_deadline_slack_us;
+  // Number of far-end frames dropped on the way to the SeekAudio AEC because
+  // the capture side fell behind, since the last initialization.
+  std::optional<int32_t> seek_audio_far_end_overflows;
+  // Number of capture frames for which no new far-end frame had arrived, since
+  // the last initialization. Gaps that follow a burst of far-end frames, or
+  // that are within Config::SeekAudioAec::far_end_jitter_allowance_frames,
+  // are not counted.
+  std::optional<int32_t> seek_audio_far_end_underflows;
+  // Time that the oldest far-end frame passed to the SeekAudio AEC with the
+  // last capture frame spent queued. The unit is in milliseconds.
+  std::optional<int32_t> seek_audio_far_end_queue_delay_ms;
+  // Delay by which the far-end is pre-aligned to the capture signal before it
+  // reaches the SeekAudio engine, see Config::SeekAudioAec::align_far_end. The
+  // unit is in milliseconds. Unset without alignment.
+  std::optional<int32_t> seek_audio_far_end_delay_ms;
+  // Numbers of events of the SeekAudio AEC and AFC since their creation,
+  // summed over both modules: frames passed through because an engine was not
+  // ready, invalid frames, failed engine calls, engine power changes and frames
+  // with a howling probability above 0.9. Unset when neither module runs.
+  std::optional<int32_t> seek_audio_not_ready_frames;
+  std::optional<int32_t> seek_audio_invalid_frames;
+  std::optional<int32_t> seek_audio_engine_errors;
+  std::optional<int32_t> seek_audio_power_changes;
+  std::optional<int32_t> seek_audio_howling_frames;
+};
+
+// Execution times of the stages of the capture processing, see
+// AudioProcessing::GetStageTimings(). Only measured when
+// AudioProcessing::Config::Pipeline::measure_stage_timings is set.
+struct RTC_EXPORT AudioProcessingStageTimings {
+  enum class Stage {
+    // Render audio queued for the capture side submodules, e.g., the render
+    // analysis of AEC3.
+    kRenderQueues,
+    kHighPassFilter,
+    // Pre- and post-level adjustment.
+    kCaptureLevelsAdjuster,
+    kEchoController,
+    kEchoControlMobile,
+    kNoiseSuppressor,
+    kSeekAudioAec,
+    kSeekAudioAfc,
+    kSeekAudioAgcCompensation,
+    // AGC1, i.e., the analog and the digital gain control.
+    kGainControl,
+    kGainController2,
+    kEchoDetector,
+    kPostFilter,
+    kCapturePostProcessor,
+    // All of the capture processing of a frame.
+    kTotal,
+  };
+  static constexpr size_t kNumStages = static_cast<size_t>(Stage::kTotal) + 1;
+
+  struct Timing {
+    // Number of capture frames in which the stage ran.
+    int64_t num_frames = 0;
+    // Number of those frames in which the stage alone took longer than the
+    // 10 ms duration of a frame.
+    int64_t num_frames_over_budget = 0;
+    // Per-frame execution times in microseconds. The percentiles are the upper
+    // edges of histogram buckets with a relative width of about 6%.
+    double mean_us = 0.0;
+    double p50_us = 0.0;
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double p999_us = 0.0;
+    double max_us = 0.0;
+  };
+
+  const Timing& operator[](Stage stage) const {
+    return stages[static_cast<size_t>(stage)];
+  }
+  Timing& operator[](Stage stage) { return stages[static_cast<size_t>(stage)]; }
+
+  std::array<Timing, kNumStages> stages;
+};
+
+}  // namespace webrtc
+
+#endif  // API_AUDIO_AUDIO_PROCESSING_STATISTICS_H_
@@ -41,20 +41,20 @@ namespace aec3 {
 // Computes and stores the frequency response of the filter.
 void ComputeFrequencyResponse(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
   for (auto& H2_ch : *H2) {
     H2_ch.fill(0.f);
   }
 
-  const size_t num_render_channels = H[0].size();
+  const size_t num_render_channels = H.num_channels();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
   for (size_t p = 0; p < num_partitions; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const PaddedFftData& H_p_ch = H[p][ch];
       for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-        float tmp =
-            H[p][ch].re[j] * H[p][ch].re[j] + H[p][ch].im[j] * H[p][ch].im[j];
+        float tmp = H_p_ch.re[j] * H_p_ch.re[j] + H_p_ch.im[j] * H_p_ch.im[j];
         (*H2)[p][j] = std::max((*H2)[p][j], tmp);
       }
     }
@@ -65,19 +65,19 @@ void ComputeFrequencyResponse(
 // Computes and stores the frequency response of the filter.
 void ComputeFrequencyResponse_Neon(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
   for (auto& H2_ch : *H2) {
     H2_ch.fill(0.f);
   }
 
-  const size_t num_render_channels = H[0].size();
+  const size_t num_render_channels = H.num_channels();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
   for (size_t p = 0; p < num_partitions; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     auto& H2_p = (*H2)[p];
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      const FftData& H_p_ch = H[p][ch];
+      const PaddedFftData& H_p_ch = H[p][ch];
       for (size_t j = 0; j < kFftLengthBy2; j += 4) {
         const float32x4_t re = vld1q_f32(&H_p_ch.re[j]);
         const float32x4_t im = vld1q_f32(&H_p_ch.im[j]);
@@ -99,24 +99,23 @@ void ComputeFrequencyResponse_Neon(
 // Computes and stores the frequency response of the filter.
 void ComputeFrequencyResponse_Sse2(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
   for (auto& H2_ch : *H2) {
     H2_ch.fill(0.f);
   }
 
-  const size_t num_render_channels = H[0].size();
+  const size_t num_render_channels = H.num_channels();
   RTC_DCHECK_EQ(H.size(), H2->capacity());
-  // constexpr __mmmask8 kMaxMask = static_cast<__mmmask8>(256u);
   for (size_t p = 0; p < num_partitions; ++p) {
     RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
     auto& H2_p = (*H2)[p];
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      const FftData& H_p_ch = H[p][ch];
+      const PaddedFftData& H_p_ch = H[p][ch];
       for (size_t j = 0; j < kFftLengthBy2; j += 4) {
-        const __m128 re = _mm_loadu_ps(&H_p_ch.re[j]);
+        const __m128 re = _mm_load_ps(&H_p_ch.re[j]);
         const __m128 re2 = _mm_mul_ps(re, re);
-        const __m128 im = _mm_loadu_ps(&H_p_ch.im[j]);
+        const __m128 im = _mm_load_ps(&H_p_ch.im[j]);
         const __m128 im2 = _mm_mul_ps(im, im);
         const __m128 H2_new = _mm_add_ps(re2, im2);
         __m128 H2_k_j = _mm_loadu_ps(&H2_p[j]);
@@ -135,15 +134,14 @@ void ComputeFrequencyResponse_Sse2(
 void AdaptPartitions(const RenderBuffer& render_buffer,
                      const FftData& G,
                      size_t num_partitions,
-                     std::vector<std::vector<FftData>>* H) {
-  ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
+                     FftArena* H) {
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
   size_t index = render_buffer.Position();
-  const size_t num_render_channels = render_buffer_data[index].size();
+  const size_t num_render_channels = render_buffer_data.num_channels();
   for (size_t p = 0; p < num_partitions; ++p) {
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      const FftData& X_p_ch = render_buffer_data[index][ch];
-      FftData& H_p_ch = (*H)[p][ch];
+      const PaddedFftData& X_p_ch = render_buffer_data[index][ch];
+      PaddedFftData& H_p_ch = (*H)[p][ch];
       for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
         H_p_ch.re[k] += X_p_ch.re[k] * G.re[k] + X_p_ch.im[k] * G.im[k];
         H_p_ch.im[k] += X_p_ch.re[k] * G.im[k] - X_p_ch.im[k] * G.re[k];
@@ -158,14 +156,15 @@ void AdaptPartitions(const RenderBuffer& render_buffer,
 void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
-                          std::vector<std::vector<FftData>>* H) {
-  webrtc::ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
-  const size_t num_render_channels = render_buffer_data[0].size();
+                          FftArena* H) {
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data.num_channels();
   const size_t lim1 = std::min(
       render_buffer_data.size() - render_buffer.Position(), num_partitions);
   const size_t lim2 = num_partitions;
-  constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
+  constexpr size_t kNumFourBinBands = kFftLengthBy2Padded / 4;
+  PaddedFftData G_padded;
+  G_padded.Assign(G);
 
   size_t X_partition = render_buffer.Position();
   size_t limit = lim1;
@@ -173,11 +172,11 @@ void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        FftData& H_p_ch = (*H)[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
+        PaddedFftData& H_p_ch = (*H)[p][ch];
+        const PaddedFftData& X = render_buffer_data[X_partition][ch];
         for (size_t k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
-          const float32x4_t G_re = vld1q_f32(&G.re[k]);
-          const float32x4_t G_im = vld1q_f32(&G.im[k]);
+          const float32x4_t G_re = vld1q_f32(&G_padded.re[k]);
+          const float32x4_t G_im = vld1q_f32(&G_padded.im[k]);
           const float32x4_t X_re = vld1q_f32(&X.re[k]);
           const float32x4_t X_im = vld1q_f32(&X.im[k]);
           const float32x4_t H_re = vld1q_f32(&H_p_ch.re[k]);
@@ -197,25 +196,6 @@ void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
     X_partition = 0;
     limit = lim2;
   } while (p < lim2);
-
-  X_partition = render_buffer.Position();
-  limit = lim1;
-  p = 0;
-  do {
-    for (; p < limit; ++p, ++X_partition) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        FftData& H_p_ch = (*H)[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
-
-        H_p_ch.re[kFftLengthBy2] += X.re[kFftLengthBy2] * G.re[kFftLengthBy2] +
-                                    X.im[kFftLengthBy2] * G.im[kFftLengthBy2];
-        H_p_ch.im[kFftLengthBy2] += X.re[kFftLengthBy2] * G.im[kFftLengthBy2] -
-                                    X.im[kFftLengthBy2] * G.re[kFftLengthBy2];
-      }
-    }
-    X_partition = 0;
-    limit = lim2;
-  } while (p < lim2);
 }
 #endif
 
@@ -224,14 +204,15 @@ void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
 void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
-                          std::vector<std::vector<FftData>>* H) {
-  ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
-  const size_t num_render_channels = render_buffer_data[0].size();
+                          FftArena* H) {
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data.num_channels();
   const size_t lim1 = std::min(
       render_buffer_data.size() - render_buffer.Position(), num_partitions);
   const size_t lim2 = num_partitions;
-  constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
+  constexpr size_t kNumFourBinBands = kFftLengthBy2Padded / 4;
+  PaddedFftData G_padded;
+  G_padded.Assign(G);
 
   size_t X_partition = render_buffer.Position();
   size_t limit = lim1;
@@ -239,16 +220,16 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        FftData& H_p_ch = (*H)[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
+        PaddedFftData& H_p_ch = (*H)[p][ch];
+        const PaddedFftData& X = render_buffer_data[X_partition][ch];
 
         for (size_t k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
-          const __m128 G_re = _mm_loadu_ps(&G.re[k]);
-          const __m128 G_im = _mm_loadu_ps(&G.im[k]);
-          const __m128 X_re = _mm_loadu_ps(&X.re[k]);
-          const __m128 X_im = _mm_loadu_ps(&X.im[k]);
-          const __m128 H_re = _mm_loadu_ps(&H_p_ch.re[k]);
-          const __m128 H_im = _mm_loadu_ps(&H_p_ch.im[k]);
+          const __m128 G_re = _mm_load_ps(&G_padded.re[k]);
+          const __m128 G_im = _mm_load_ps(&G_padded.im[k]);
+          const __m128 X_re = _mm_load_ps(&X.re[k]);
+          const __m128 X_im = _mm_load_ps(&X.im[k]);
+          const __m128 H_re = _mm_load_ps(&H_p_ch.re[k]);
+          const __m128 H_im = _mm_load_ps(&H_p_ch.im[k]);
           const __m128 a = _mm_mul_ps(X_re, G_re);
           const __m128 b = _mm_mul_ps(X_im, G_im);
           const __m128 c = _mm_mul_ps(X_re, G_im);
@@ -257,54 +238,33 @@ void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
           const __m128 f = _mm_sub_ps(c, d);
           const __m128 g = _mm_add_ps(H_re, e);
           const __m128 h = _mm_add_ps(H_im, f);
-          _mm_storeu_ps(&H_p_ch.re[k], g);
-          _mm_storeu_ps(&H_p_ch.im[k], h);
+          _mm_store_ps(&H_p_ch.re[k], g);
+          _mm_store_ps(&H_p_ch.im[k], h);
         }
       }
     }
     X_partition = 0;
     limit = lim2;
   } while (p < lim2);
-
-  X_partition = render_buffer.Position();
-  limit = lim1;
-  p = 0;
-  do {
-    for (; p < limit; ++p, ++X_partition) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        FftData& H_p_ch = (*H)[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
-
-        H_p_ch.re[kFftLengthBy2] += X.re[kFftLengthBy2] * G.re[kFftLengthBy2] +
-                                    X.im[kFftLengthBy2] * G.im[kFftLengthBy2];
-        H_p_ch.im[kFftLengthBy2] += X.re[kFftLengthBy2] * G.im[kFftLengthBy2] -
-                                    X.im[kFftLengthBy2] * G.re[kFftLengthBy2];
-      }
-    }
-
-    X_partition = 0;
-    limit = lim2;
-  } while (p < lim2);
 }
 #endif
 
 // Produces the filter output.
 void ApplyFilter(const RenderBuffer& render_buffer,
                  size_t num_partitions,
-                 const std::vector<std::vector<FftData>>& H,
+                 const FftArena& H,
                  FftData* S) {
   S->re.fill(0.f);
   S->im.fill(0.f);
 
-  ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
   size_t index = render_buffer.Position();
-  const size_t num_render_channels = render_buffer_data[index].size();
+  const size_t num_render_channels = render_buffer_data.num_channels();
+  RTC_DCHECK_EQ(num_render_channels, H.num_channels());
   for (size_t p = 0; p < num_partitions; ++p) {
-    RTC_DCHECK_EQ(num_render_channels, H[p].size());
     for (size_t ch = 0; ch < num_render_channels; ++ch) {
-      const FftData& X_p_ch = render_buffer_data[index][ch];
-      const FftData& H_p_ch = H[p][ch];
+      const PaddedFftData& X_p_ch = render_buffer_data[index][ch];
+      const PaddedFftData& H_p_ch = H[p][ch];
       for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
         S->re[k] += X_p_ch.re[k] * H_p_ch.re[k] - X_p_ch.im[k] * H_p_ch.im[k];
         S->im[k] += X_p_ch.re[k] * H_p_ch.im[k] + X_p_ch.im[k] * H_p_ch.re[k];
@@ -318,21 +278,17 @@ void ApplyFilter(const RenderBuffer& render_buffer,
 // Produces the filter output (Neon variant).
 void ApplyFilter_Neon(const RenderBuffer& render_buffer,
                       size_t num_partitions,
-                      const std::vector<std::vector<FftData>>& H,
+                      const FftArena& H,
                       FftData* S) {
-  // const RenderBuffer& render_buffer,
-  //                     webrtc::ArrayView<const FftData> H,
-  //                     FftData* S) {
-  RTC_DCHECK_GE(H.size(), H.size() - 1);
-  S->Clear();
-
-  webrtc::ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
-  const size_t num_render_channels = render_buffer_data[0].size();
+  PaddedFftData S_padded;
+  S_padded.Clear();
+
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data.num_channels();
   const size_t lim1 = std::min(
       render_buffer_data.size() - render_buffer.Position(), num_partitions);
   const size_t lim2 = num_partitions;
-  constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
+  constexpr size_t kNumFourBinBands = kFftLengthBy2Padded / 4;
 
   size_t X_partition = render_buffer.Position();
   size_t p = 0;
@@ -340,23 +296,23 @@ void ApplyFilter_Neon(const RenderBuffer& render_buffer,
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const FftData& H_p_ch = H[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
+        const PaddedFftData& H_p_ch = H[p][ch];
+        const PaddedFftData& X = render_buffer_data[X_partition][ch];
         for (size_t k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
           const float32x4_t X_re = vld1q_f32(&X.re[k]);
           const float32x4_t X_im = vld1q_f32(&X.im[k]);
           const float32x4_t H_re = vld1q_f32(&H_p_ch.re[k]);
           const float32x4_t H_im = vld1q_f32(&H_p_ch.im[k]);
-          const float32x4_t S_re = vld1q_f32(&S->re[k]);
-          const float32x4_t S_im = vld1q_f32(&S->im[k]);
+          const float32x4_t S_re = vld1q_f32(&S_padded.re[k]);
+          const float32x4_t S_im = vld1q_f32(&S_padded.im[k]);
           const float32x4_t a = vmulq_f32(X_re, H_re);
           const float32x4_t e = vmlsq_f32(a, X_im, H_im);
           const float32x4_t c = vmulq_f32(X_re, H_im);
           const float32x4_t f = vmlaq_f32(c, X_im, H_re);
           const float32x4_t g = vaddq_f32(S_re, e);
           const float32x4_t h = vaddq_f32(S_im, f);
-          vst1q_f32(&S->re[k], g);
-          vst1q_f32(&S->im[k], h);
+          vst1q_f32(&S_padded.re[k], g);
+          vst1q_f32(&S_padded.im[k], h);
         }
       }
     }
@@ -364,23 +320,7 @@ void ApplyFilter_Neon(const RenderBuffer& render_buffer,
     X_partition = 0;
   } while (p < lim2);
 
-  X_partition = render_buffer.Position();
-  p = 0;
-  limit = lim1;
-  do {
-    for (; p < limit; ++p, ++X_partition) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const FftData& H_p_ch = H[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
-        S->re[kFftLengthBy2] += X.re[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2] -
-                                X.im[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2];
-        S->im[kFftLengthBy2] += X.re[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2] +
-                                X.im[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2];
-      }
-    }
-    limit = lim2;
-    X_partition = 0;
-  } while (p < lim2);
+  S_padded.CopyTo(S);
 }
 #endif
 
@@ -388,22 +328,17 @@ void ApplyFilter_Neon(const RenderBuffer& render_buffer,
 // Produces the filter output (SSE2 variant).
 void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
                       size_t num_partitions,
-                      const std::vector<std::vector<FftData>>& H,
+                      const FftArena& H,
                       FftData* S) {
-  // const RenderBuffer& render_buffer,
-  //                     webrtc::ArrayView<const FftData> H,
-  //                     FftData* S) {
-  RTC_DCHECK_GE(H.size(), H.size() - 1);
-  S->re.fill(0.f);
-  S->im.fill(0.f);
+  PaddedFftData S_padded;
+  S_padded.Clear();
 
-  ArrayView<const std::vector<FftData>> render_buffer_data =
-      render_buffer.GetFftBuffer();
-  const size_t num_render_channels = render_buffer_data[0].size();
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data.num_channels();
   const size_t lim1 = std::min(
       render_buffer_data.size() - render_buffer.Position(), num_partitions);
   const size_t lim2 = num_partitions;
-  constexpr size_t kNumFourBinBands = kFftLengthBy2 / 4;
+  constexpr size_t kNumFourBinBands = kFftLengthBy2Padded / 4;
 
   size_t X_partition = render_buffer.Position();
   size_t p = 0;
@@ -411,15 +346,15 @@ void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
   do {
     for (; p < limit; ++p, ++X_partition) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const FftData& H_p_ch = H[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
+        const PaddedFftData& H_p_ch = H[p][ch];
+        const PaddedFftData& X = render_buffer_data[X_partition][ch];
         for (size_t k = 0, n = 0; n < kNumFourBinBands; ++n, k += 4) {
-          const __m128 X_re = _mm_loadu_ps(&X.re[k]);
-          const __m128 X_im = _mm_loadu_ps(&X.im[k]);
-          const __m128 H_re = _mm_loadu_ps(&H_p_ch.re[k]);
-          const __m128 H_im = _mm_loadu_ps(&H_p_ch.im[k]);
-          const __m128 S_re = _mm_loadu_ps(&S->re[k]);
-          const __m128 S_im = _mm_loadu_ps(&S->im[k]);
+          const __m128 X_re = _mm_load_ps(&X.re[k]);
+          const __m128 X_im = _mm_load_ps(&X.im[k]);
+          const __m128 H_re = _mm_load_ps(&H_p_ch.re[k]);
+          const __m128 H_im = _mm_load_ps(&H_p_ch.im[k]);
+          const __m128 S_re = _mm_load_ps(&S_padded.re[k]);
+          const __m128 S_im = _mm_load_ps(&S_padded.im[k]);
           const __m128 a = _mm_mul_ps(X_re, H_re);
           const __m128 b = _mm_mul_ps(X_im, H_im);
           const __m128 c = _mm_mul_ps(X_re, H_im);
@@ -428,8 +363,8 @@ void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
           const __m128 f = _mm_add_ps(c, d);
           const __m128 g = _mm_add_ps(S_re, e);
           const __m128 h = _mm_add_ps(S_im, f);
-          _mm_storeu_ps(&S->re[k], g);
-          _mm_storeu_ps(&S->im[k], h);
+          _mm_store_ps(&S_padded.re[k], g);
+          _mm_store_ps(&S_padded.im[k], h);
         }
       }
     }
@@ -437,23 +372,7 @@ void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
     X_partition = 0;
   } while (p < lim2);
 
-  X_partition = render_buffer.Position();
-  p = 0;
-  limit = lim1;
-  do {
-    for (; p < limit; ++p, ++X_partition) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const FftData& H_p_ch = H[p][ch];
-        const FftData& X = render_buffer_data[X_partition][ch];
-        S->re[kFftLengthBy2] += X.re[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2] -
-                                X.im[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2];
-        S->im[kFftLengthBy2] += X.re[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2] +
-                                X.im[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2];
-      }
-    }
-    limit = lim2;
-    X_partition = 0;
-  } while (p < lim2);
+  S_padded.CopyTo(S);
 }
 #endif
 
@@ -463,17 +382,11 @@ namespace {
 
 // Ensures that the newly added filter partitions after a size increase are set
 // to zero.
-void ZeroFilter(size_t old_size,
-                size_t new_size,
-                std::vector<std::vector<FftData>>* H) {
+void ZeroFilter(size_t old_size, size_t new_size, FftArena* H) {
   RTC_DCHECK_GE(H->size(), old_size);
   RTC_DCHECK_GE(H->size(), new_size);
-
-  for (size_t p = old_size; p < new_size; ++p) {
-    RTC_DCHECK_EQ((*H)[p].size(), (*H)[0].size());
-    for (size_t ch = 0; ch < (*H)[0].size(); ++ch) {
-      (*H)[p][ch].Clear();
-    }
+  if (new_size > old_size) {
+    H->Clear(old_size, new_size);
   }
 }
 
@@ -495,15 +408,13 @@ AdaptiveFirFilter::AdaptiveFirFilter(size_t max_size_partitions,
       current_size_partitions_(initial_size_partitions),
       target_size_partitions_(initial_size_partitions),
       old_target_size_partitions_(initial_size_partitions),
-      H_(max_size_partitions_, std::vector<FftData>(num_render_channels_)) {
+      H_(max_size_partitions_, num_render_channels_) {
   RTC_DCHECK(data_dumper_);
   RTC_DCHECK_GE(max_size_partitions, initial_size_partitions);
 
   RTC_DCHECK_LT(0, size_change_duration_blocks_);
   one_by_size_change_duration_blocks_ = 1.f / size_change_duration_blocks_;
 
-  ZeroFilter(0, max_size_partitions_, &H_);
-
   SetSizePartitions(current_size_partitions_, true);
 }
 
@@ -515,7 +426,7 @@ void AdaptiveFirFilter::HandleEchoPathChange() {
 }
 
 void AdaptiveFirFilter::SetSizePartitions(size_t size, bool immediate_effect) {
-  RTC_DCHECK_EQ(max_size_partitions_, H_.capacity());
+  RTC_DCHECK_EQ(max_size_partitions_, H_.size());
   RTC_DCHECK_LE(size, max_size_partitions_);
 
   target_size_partitions_ = std::min(max_size_partitions_, size);
@@ -570,6 +481,9 @@ void AdaptiveFirFilter::Filter(const RenderBuffer& render_buffer,
     case Aec3Optimization::kAvx2:
       aec3::ApplyFilter_Avx2(render_buffer, current_size_partitions_, H_, S);
       break;
+    case Aec3Optimization::kAvx512:
+      aec3::ApplyFilter_Avx512(render_buffer, current_size_partitions_, H_, S);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -614,6 +528,9 @@ void AdaptiveFirFilter::ComputeFrequencyResponse(
     case Aec3Optimization::kAvx2:
       aec3::ComputeFrequencyResponse_Avx2(current_size_partitions_, H_, H2);
       break;
+    case Aec3Optimization::kAvx512:
+      aec3::ComputeFrequencyResponse_Avx512(current_size_partitions_, H_, H2);
+      break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
     case Aec3Optimization::kNeon:
@@ -638,6 +555,7 @@ void AdaptiveFirFilter::AdaptAndUpdateSize(const RenderBuffer& render_buffer,
                                  &H_);
       break;
     case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
       aec3::AdaptPartitions_Avx2(render_buffer, G, current_size_partitions_,
                                  &H_);
       break;
@@ -668,8 +586,10 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
       impulse_response->begin() + (partition_to_constrain_ + 1) * kFftLengthBy2,
       0.f);
 
+  FftData H_p_ch;
   for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-    fft_.Ifft(H_[partition_to_constrain_][ch], &h);
+    H_[partition_to_constrain_][ch].CopyTo(&H_p_ch);
+    fft_.Ifft(H_p_ch, &h);
 
     static constexpr float kScale = 1.0f / kFftLengthBy2;
     std::for_each(h.begin(), h.begin() + kFftLengthBy2,
@@ -689,7 +609,8 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
       }
     }
 
-    fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
+    fft_.Fft(&h, &H_p_ch);
+    H_[partition_to_constrain_][ch].Assign(H_p_ch);
   }
 
   partition_to_constrain_ =
@@ -702,15 +623,18 @@ void AdaptiveFirFilter::ConstrainAndUpdateImpulseResponse(
 // time via setting the relevant time-domain coefficients to zero.
 void AdaptiveFirFilter::Constrain() {
   std::array<float, kFftLength> h;
+  FftData H_p_ch;
   for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-    fft_.Ifft(H_[partition_to_constrain_][ch], &h);
+    H_[partition_to_constrain_][ch].CopyTo(&H_p_ch);
+    fft_.Ifft(H_p_ch, &h);
 
     static constexpr float kScale = 1.0f / kFftLengthBy2;
     std::for_each(h.begin(), h.begin() + kFftLengthBy2,
                   [](float& a) { a *= kScale; });
     std::fill(h.begin() + kFftLengthBy2, h.end(), 0.f);
 
-    fft_.Fft(&h, &H_[partition_to_constrain_][ch]);
+    fft_.Fft(&h, &H_p_ch);
+    H_[partition_to_constrain_][ch].Assign(H_p_ch);
   }
 
   partition_to_constrain_ =
@@ -720,8 +644,8 @@ void AdaptiveFirFilter::Constrain() {
 }
 
 void AdaptiveFirFilter::ScaleFilter(float factor) {
-  for (auto& H_p : H_) {
-    for (auto& H_p_ch : H_p) {
+  for (size_t p = 0; p < max_size_partitions_; ++p) {
+    for (auto& H_p_ch : H_[p]) {
       for (auto& re : H_p_ch.re) {
         re *= factor;
       }
@@ -733,17 +657,23 @@ void AdaptiveFirFilter::ScaleFilter(float factor) {
 }
 
 // Set the filter coefficients.
+void AdaptiveFirFilter::SetFilter(size_t num_partitions, const FftArena& H) {
+  RTC_DCHECK_EQ(num_render_channels_, H.num_channels());
+  const size_t min_num_partitions =
+      std::min(current_size_partitions_, num_partitions);
+  for (size_t p = 0; p < min_num_partitions; ++p) {
+    std::copy(H[p].begin(), H[p].end(), H_[p].begin());
+  }
+}
+
 void AdaptiveFirFilter::SetFilter(size_t num_partitions,
                                   const std::vector<std::vector<FftData>>& H) {
   const size_t min_num_partitions =
       std::min(current_size_partitions_, num_partitions);
   for (size_t p = 0; p < min_num_partitions; ++p) {
-    RTC_DCHECK_EQ(H_[p].size(), H[p].size());
-    RTC_DCHECK_EQ(num_render_channels_, H_[p].size());
-
+    RTC_DCHECK_EQ(num_render_channels_, H[p].size());
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      std::copy(H[p][ch].re.begin(), H[p][ch].re.end(), H_[p][ch].re.begin());
-      std::copy(H[p][ch].im.begin(), H[p][ch].im.end(), H_[p][ch].im.begin());
+      H_[p][ch].Assign(H[p][ch]);
     }
   }
 }
@@ -20,6 +20,7 @@
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/fft_arena.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
@@ -30,23 +31,28 @@ namespace aec3 {
 // Computes and stores the frequency response of the filter.
 void ComputeFrequencyResponse(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #if defined(WEBRTC_HAS_NEON)
 void ComputeFrequencyResponse_Neon(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 void ComputeFrequencyResponse_Sse2(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 
 void ComputeFrequencyResponse_Avx2(
     size_t num_partitions,
-    const std::vector<std::vector<FftData>>& H,
+    const FftArena& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
+
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const FftArena& H,
     std::vector<std::array<float, kFftLengthBy2Plus1>>* H2);
 #endif
 
@@ -54,46 +60,51 @@ void ComputeFrequencyResponse_Avx2(
 void AdaptPartitions(const RenderBuffer& render_buffer,
                      const FftData& G,
                      size_t num_partitions,
-                     std::vector<std::vector<FftData>>* H);
+                     FftArena* H);
 #if defined(WEBRTC_HAS_NEON)
 void AdaptPartitions_Neon(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
-                          std::vector<std::vector<FftData>>* H);
+                          FftArena* H);
 #endif
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 void AdaptPartitions_Sse2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
-                          std::vector<std::vector<FftData>>* H);
+                          FftArena* H);
 
 void AdaptPartitions_Avx2(const RenderBuffer& render_buffer,
                           const FftData& G,
                           size_t num_partitions,
-                          std::vector<std::vector<FftData>>* H);
+                          FftArena* H);
 #endif
 
 // Produces the filter output.
 void ApplyFilter(const RenderBuffer& render_buffer,
                  size_t num_partitions,
-                 const std::vector<std::vector<FftData>>& H,
+                 const FftArena& H,
                  FftData* S);
 #if defined(WEBRTC_HAS_NEON)
 void ApplyFilter_Neon(const RenderBuffer& render_buffer,
                       size_t num_partitions,
-                      const std::vector<std::vector<FftData>>& H,
+                      const FftArena& H,
                       FftData* S);
 #endif
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 void ApplyFilter_Sse2(const RenderBuffer& render_buffer,
                       size_t num_partitions,
-                      const std::vector<std::vector<FftData>>& H,
+                      const FftArena& H,
                       FftData* S);
 
 void ApplyFilter_Avx2(const RenderBuffer& render_buffer,
                       size_t num_partitions,
-                      const std::vector<std::vector<FftData>>& H,
+                      const FftArena& H,
                       FftData* S);
+
+void ApplyFilter_Avx512(const RenderBuffer& render_buffer,
+                        size_t num_partitions,
+                        const FftArena& H,
+                        FftData* S);
 #endif
 
 }  // namespace aec3
@@ -144,8 +155,12 @@ class AdaptiveFirFilter {
 
   void DumpFilter(absl::string_view name_frequency_domain) {
     for (size_t p = 0; p < max_size_partitions_; ++p) {
-      data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].re);
-      data_dumper_->DumpRaw(name_frequency_domain, H_[p][0].im);
+      data_dumper_->DumpRaw(
+          name_frequency_domain,
+          ArrayView<const float>(H_[p][0].re.data(), kFftLengthBy2Plus1));
+      data_dumper_->DumpRaw(
+          name_frequency_domain,
+          ArrayView<const float>(H_[p][0].im.data(), kFftLengthBy2Plus1));
     }
   }
 
@@ -153,11 +168,12 @@ class AdaptiveFirFilter {
   void ScaleFilter(float factor);
 
   // Set the filter coefficients.
+  void SetFilter(size_t num_partitions, const FftArena& H);
   void SetFilter(size_t num_partitions,
                  const std::vector<std::vector<FftData>>& H);
 
   // Gets the filter coefficients.
-  const std::vector<std::vector<FftData>>& GetFilter() const { return H_; }
+  const FftArena& GetFilter() const { return H_; }
 
  private:
   // Adapts the filter and updates the filter size.
@@ -183,7 +199,7 @@ class AdaptiveFirFilter {
   size_t target_size_partitions_;
   size_t old_target_size_partitions_;
   int size_change_counter_ = 0;
-  std::vector<std::vector<FftData>> H_;
+  FftArena H_;
   size_t partition_to_constrain_ = 0;
 };
 
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace aec3 {
+
+namespace {
+
+// The first kFftLengthBy2 bins are processed in 16-bin vectors and the
+// remaining padded bins, including the Nyquist bin, in an 8-bin vector. Only
+// the 8-bin vectors are guaranteed to be aligned.
+constexpr size_t kNumSixteenBinBands = kFftLengthBy2 / 16;
+static_assert(kFftLengthBy2 % 16 == 0, "");
+static_assert(kFftLengthBy2Padded == kFftLengthBy2 + 8, "");
+
+}  // namespace
+
+// Computes and stores the frequency response of the filter.
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const FftArena& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  for (auto& H2_ch : *H2) {
+    H2_ch.fill(0.f);
+  }
+
+  const size_t num_render_channels = H.num_channels();
+  RTC_DCHECK_EQ(H.size(), H2->capacity());
+  for (size_t p = 0; p < num_partitions; ++p) {
+    RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
+    auto& H2_p = (*H2)[p];
+    // The maximum over the channels is kept in registers.
+    __m512 H2_max[kNumSixteenBinBands];
+    for (size_t n = 0; n < kNumSixteenBinBands; ++n) {
+      H2_max[n] = _mm512_setzero_ps();
+    }
+    float H2_max_nyquist = 0.f;
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const PaddedFftData& H_p_ch = H[p][ch];
+      for (size_t n = 0, k = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+        const __m512 re = _mm512_loadu_ps(&H_p_ch.re[k]);
+        const __m512 im = _mm512_loadu_ps(&H_p_ch.im[k]);
+        const __m512 re2 = _mm512_mul_ps(re, re);
+        const __m512 im2 = _mm512_mul_ps(im, im);
+        H2_max[n] = _mm512_max_ps(H2_max[n], _mm512_add_ps(re2, im2));
+      }
+      const float re_nyquist = H_p_ch.re[kFftLengthBy2];
+      const float im_nyquist = H_p_ch.im[kFftLengthBy2];
+      const float H2_new = re_nyquist * re_nyquist + im_nyquist * im_nyquist;
+      H2_max_nyquist = std::max(H2_max_nyquist, H2_new);
+    }
+    for (size_t n = 0, k = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+      _mm512_storeu_ps(&H2_p[k], H2_max[n]);
+    }
+    H2_p[kFftLengthBy2] = H2_max_nyquist;
+  }
+}
+
+// Produces the filter output (AVX-512 variant). The output is accumulated in
+// registers over all partitions and channels.
+void ApplyFilter_Avx512(const RenderBuffer& render_buffer,
+                        size_t num_partitions,
+                        const FftArena& H,
+                        FftData* S) {
+  __m512 S_re[kNumSixteenBinBands];
+  __m512 S_im[kNumSixteenBinBands];
+  for (size_t n = 0; n < kNumSixteenBinBands; ++n) {
+    S_re[n] = _mm512_setzero_ps();
+    S_im[n] = _mm512_setzero_ps();
+  }
+  __m256 S_re_tail = _mm256_setzero_ps();
+  __m256 S_im_tail = _mm256_setzero_ps();
+
+  const FftArena& render_buffer_data = render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data.num_channels();
+  const size_t lim1 = std::min(
+      render_buffer_data.size() - render_buffer.Position(), num_partitions);
+  const size_t lim2 = num_partitions;
+
+  size_t X_partition = render_buffer.Position();
+  size_t p = 0;
+  size_t limit = lim1;
+  do {
+    for (; p < limit; ++p, ++X_partition) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        const PaddedFftData& H_p_ch = H[p][ch];
+        const PaddedFftData& X = render_buffer_data[X_partition][ch];
+        for (size_t n = 0, k = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+          const __m512 X_re = _mm512_loadu_ps(&X.re[k]);
+          const __m512 X_im = _mm512_loadu_ps(&X.im[k]);
+          const __m512 H_re = _mm512_loadu_ps(&H_p_ch.re[k]);
+          const __m512 H_im = _mm512_loadu_ps(&H_p_ch.im[k]);
+          const __m512 a = _mm512_mul_ps(X_re, H_re);
+          const __m512 b = _mm512_mul_ps(X_im, H_im);
+          const __m512 c = _mm512_mul_ps(X_re, H_im);
+          const __m512 d = _mm512_mul_ps(X_im, H_re);
+          S_re[n] = _mm512_add_ps(S_re[n], _mm512_sub_ps(a, b));
+          S_im[n] = _mm512_add_ps(S_im[n], _mm512_add_ps(c, d));
+        }
+        const __m256 X_re = _mm256_load_ps(&X.re[kFftLengthBy2]);
+        const __m256 X_im = _mm256_load_ps(&X.im[kFftLengthBy2]);
+        const __m256 H_re = _mm256_load_ps(&H_p_ch.re[kFftLengthBy2]);
+        const __m256 H_im = _mm256_load_ps(&H_p_ch.im[kFftLengthBy2]);
+        const __m256 a = _mm256_mul_ps(X_re, H_re);
+        const __m256 b = _mm256_mul_ps(X_im, H_im);
+        const __m256 c = _mm256_mul_ps(X_re, H_im);
+        const __m256 d = _mm256_mul_ps(X_im, H_re);
+        S_re_tail = _mm256_add_ps(S_re_tail, _mm256_sub_ps(a, b));
+        S_im_tail = _mm256_add_ps(S_im_tail, _mm256_add_ps(c, d));
+      }
+    }
+    limit = lim2;
+    X_partition = 0;
+  } while (p < lim2);
+
+  for (size_t n = 0, k = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+    _mm512_storeu_ps(&S->re[k], S_re[n]);
+    _mm512_storeu_ps(&S->im[k], S_im[n]);
+  }
+  S->re[kFftLengthBy2] = _mm256_cvtss_f32(S_re_tail);
+  S->im[kFftLengthBy2] = _mm256_cvtss_f32(S_im_tail);
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aec3/adaptive_fir_filter_erl.h"
+
+namespace webrtc {
+
+namespace aec3 {
+
+// Computes and stores the echo return loss estimate of the filter, which is the
+// sum of the partition frequency responses. The sum is kept in registers.
+void ErlComputer_AVX512(
+    const std::vector<std::array<float, kFftLengthBy2Plus1>>& H2,
+    ArrayView<float> erl) {
+  static_assert(kFftLengthBy2 == 4 * 16, "");
+  __m512 erl_0 = _mm512_setzero_ps();
+  __m512 erl_16 = _mm512_setzero_ps();
+  __m512 erl_32 = _mm512_setzero_ps();
+  __m512 erl_48 = _mm512_setzero_ps();
+  float erl_nyquist = 0.f;
+  for (auto& H2_j : H2) {
+    erl_0 = _mm512_add_ps(erl_0, _mm512_loadu_ps(&H2_j[0]));
+    erl_16 = _mm512_add_ps(erl_16, _mm512_loadu_ps(&H2_j[16]));
+    erl_32 = _mm512_add_ps(erl_32, _mm512_loadu_ps(&H2_j[32]));
+    erl_48 = _mm512_add_ps(erl_48, _mm512_loadu_ps(&H2_j[48]));
+    erl_nyquist += H2_j[kFftLengthBy2];
+  }
+  _mm512_storeu_ps(&erl[0], erl_0);
+  _mm512_storeu_ps(&erl[16], erl_16);
+  _mm512_storeu_ps(&erl[32], erl_32);
+  _mm512_storeu_ps(&erl[48], erl_48);
+  erl[kFftLengthBy2] = erl_nyquist;
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -100,6 +100,31 @@ TEST(AdaptiveFirFilter, UpdateErlAvx2Optimization) {
   }
 }
 
+// Verifies that the optimized method for echo return loss computation is
+// bitexact to the reference counterpart.
+TEST(AdaptiveFirFilter, UpdateErlAvx512Optimization) {
+  bool use_avx512 = DetectOptimization() == Aec3Optimization::kAvx512;
+  if (use_avx512) {
+    const size_t kNumPartitions = 12;
+    std::vector<std::array<float, kFftLengthBy2Plus1>> H2(kNumPartitions);
+    std::array<float, kFftLengthBy2Plus1> erl;
+    std::array<float, kFftLengthBy2Plus1> erl_AVX512;
+
+    for (size_t j = 0; j < H2.size(); ++j) {
+      for (size_t k = 0; k < H2[j].size(); ++k) {
+        H2[j][k] = k + j / 3.f;
+      }
+    }
+
+    ErlComputer(H2, erl);
+    ErlComputer_AVX512(H2, erl_AVX512);
+
+    for (size_t j = 0; j < erl.size(); ++j) {
+      EXPECT_FLOAT_EQ(erl[j], erl_AVX512[j]);
+    }
+  }
+}
+
 #endif
 
 }  // namespace aec3
@@ -29,6 +29,7 @@
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
+#include "modules/audio_processing/aec3/fft_arena.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "rtc_base/checks.h"
@@ -93,16 +94,8 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
     FftData S_Neon;
     FftData G;
     Aec3Fft fft;
-    std::vector<std::vector<FftData>> H_C(
-        num_partitions, std::vector<FftData>(num_render_channels));
-    std::vector<std::vector<FftData>> H_Neon(
-        num_partitions, std::vector<FftData>(num_render_channels));
-    for (size_t p = 0; p < num_partitions; ++p) {
-      for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        H_C[p][ch].Clear();
-        H_Neon[p][ch].Clear();
-      }
-    }
+    FftArena H_C(num_partitions, num_render_channels);
+    FftArena H_Neon(num_partitions, num_render_channels);
 
     for (int k = 0; k < 30; ++k) {
       for (int band = 0; band < x.NumBands(); ++band) {
@@ -156,14 +149,13 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
        ComputeFrequencyResponseNeonOptimization) {
   const size_t num_render_channels = GetParam();
   for (size_t num_partitions : {2, 5, 12, 30, 50}) {
-    std::vector<std::vector<FftData>> H(
-        num_partitions, std::vector<FftData>(num_render_channels));
+    FftArena H(num_partitions, num_render_channels);
     std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
     std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Neon(num_partitions);
 
     for (size_t p = 0; p < num_partitions; ++p) {
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        for (size_t k = 0; k < H[p][ch].re.size(); ++k) {
+        for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
           H[p][ch].re[k] = k + p / 3.f + ch;
           H[p][ch].im[k] = p + k / 7.f - ch;
         }
@@ -203,16 +195,8 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
       FftData S_Sse2;
       FftData G;
       Aec3Fft fft;
-      std::vector<std::vector<FftData>> H_C(
-          num_partitions, std::vector<FftData>(num_render_channels));
-      std::vector<std::vector<FftData>> H_Sse2(
-          num_partitions, std::vector<FftData>(num_render_channels));
-      for (size_t p = 0; p < num_partitions; ++p) {
-        for (size_t ch = 0; ch < num_render_channels; ++ch) {
-          H_C[p][ch].Clear();
-          H_Sse2[p][ch].Clear();
-        }
-      }
+      FftArena H_C(num_partitions, num_render_channels);
+      FftArena H_Sse2(num_partitions, num_render_channels);
 
       for (size_t k = 0; k < 500; ++k) {
         for (int band = 0; band < x.NumBands(); ++band) {
@@ -275,16 +259,8 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
       FftData S_Avx2;
       FftData G;
       Aec3Fft fft;
-      std::vector<std::vector<FftData>> H_C(
-          num_partitions, std::vector<FftData>(num_render_channels));
-      std::vector<std::vector<FftData>> H_Avx2(
-          num_partitions, std::vector<FftData>(num_render_channels));
-      for (size_t p = 0; p < num_partitions; ++p) {
-        for (size_t ch = 0; ch < num_render_channels; ++ch) {
-          H_C[p][ch].Clear();
-          H_Avx2[p][ch].Clear();
-        }
-      }
+      FftArena H_C(num_partitions, num_render_channels);
+      FftArena H_Avx2(num_partitions, num_render_channels);
 
       for (size_t k = 0; k < 500; ++k) {
         for (int band = 0; band < x.NumBands(); ++band) {
@@ -335,15 +311,14 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
   bool use_sse2 = (GetCPUInfo(kSSE2) != 0);
   if (use_sse2) {
     for (size_t num_partitions : {2, 5, 12, 30, 50}) {
-      std::vector<std::vector<FftData>> H(
-          num_partitions, std::vector<FftData>(num_render_channels));
+      FftArena H(num_partitions, num_render_channels);
       std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
       std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Sse2(
           num_partitions);
 
       for (size_t p = 0; p < num_partitions; ++p) {
         for (size_t ch = 0; ch < num_render_channels; ++ch) {
-          for (size_t k = 0; k < H[p][ch].re.size(); ++k) {
+          for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
             H[p][ch].re[k] = k + p / 3.f + ch;
             H[p][ch].im[k] = p + k / 7.f - ch;
           }
@@ -370,15 +345,14 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
   bool use_avx2 = (GetCPUInfo(kAVX2) != 0);
   if (use_avx2) {
     for (size_t num_partitions : {2, 5, 12, 30, 50}) {
-      std::vector<std::vector<FftData>> H(
-          num_partitions, std::vector<FftData>(num_render_channels));
+      FftArena H(num_partitions, num_render_channels);
       std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
       std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Avx2(
           num_partitions);
 
       for (size_t p = 0; p < num_partitions; ++p) {
         for (size_t ch = 0; ch < num_render_channels; ++ch) {
-          for (size_t k = 0; k < H[p][ch].re.size(); ++k) {
+          for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
             H[p][ch].re[k] = k + p / 3.f + ch;
             H[p][ch].im[k] = p + k / 7.f - ch;
           }
@@ -397,6 +371,91 @@ TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
   }
 }
 
+// Verifies that the AVX-512 filter output is bitexact to the reference
+// counterpart. The filter adaptation has no AVX-512 variant and is shared.
+TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
+       FilterOutputAvx512Optimization) {
+  const size_t num_render_channels = GetParam();
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+  bool use_avx512 = DetectOptimization() == Aec3Optimization::kAvx512;
+  if (use_avx512) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
+                                    num_render_channels));
+      Random random_generator(42U);
+      Block x(kNumBands, num_render_channels);
+      FftData S_C;
+      FftData S_Avx512;
+      FftData G;
+      FftArena H(num_partitions, num_render_channels);
+
+      for (size_t k = 0; k < 500; ++k) {
+        for (int band = 0; band < x.NumBands(); ++band) {
+          for (int ch = 0; ch < x.NumChannels(); ++ch) {
+            RandomizeSampleVector(&random_generator, x.View(band, ch));
+          }
+        }
+        render_delay_buffer->Insert(x);
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+        ApplyFilter_Avx512(*render_buffer, num_partitions, H, &S_Avx512);
+        ApplyFilter(*render_buffer, num_partitions, H, &S_C);
+        for (size_t j = 0; j < S_C.re.size(); ++j) {
+          EXPECT_FLOAT_EQ(S_C.re[j], S_Avx512.re[j]);
+          EXPECT_FLOAT_EQ(S_C.im[j], S_Avx512.im[j]);
+        }
+
+        std::for_each(G.re.begin(), G.re.end(),
+                      [&](float& a) { a = random_generator.Rand<float>(); });
+        std::for_each(G.im.begin(), G.im.end(),
+                      [&](float& a) { a = random_generator.Rand<float>(); });
+        AdaptPartitions(*render_buffer, G, num_partitions, &H);
+      }
+    }
+  }
+}
+
+// Verifies that the AVX-512 method for frequency response computation is
+// bitexact to the reference counterpart.
+TEST_P(AdaptiveFirFilterOneTwoFourEightRenderChannels,
+       ComputeFrequencyResponseAvx512Optimization) {
+  const size_t num_render_channels = GetParam();
+  bool use_avx512 = DetectOptimization() == Aec3Optimization::kAvx512;
+  if (use_avx512) {
+    for (size_t num_partitions : {2, 5, 12, 30, 50}) {
+      FftArena H(num_partitions, num_render_channels);
+      std::vector<std::array<float, kFftLengthBy2Plus1>> H2(num_partitions);
+      std::vector<std::array<float, kFftLengthBy2Plus1>> H2_Avx512(
+          num_partitions);
+
+      for (size_t p = 0; p < num_partitions; ++p) {
+        for (size_t ch = 0; ch < num_render_channels; ++ch) {
+          for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+            H[p][ch].re[k] = k + p / 3.f + ch;
+            H[p][ch].im[k] = p + k / 7.f - ch;
+          }
+        }
+      }
+
+      ComputeFrequencyResponse(num_partitions, H, &H2);
+      ComputeFrequencyResponse_Avx512(num_partitions, H, &H2_Avx512);
+
+      for (size_t p = 0; p < num_partitions; ++p) {
+        for (size_t k = 0; k < H2[p].size(); ++k) {
+          EXPECT_FLOAT_EQ(H2[p][k], H2_Avx512[p][k]);
+        }
+      }
+    }
+  }
+}
+
 #endif
 
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
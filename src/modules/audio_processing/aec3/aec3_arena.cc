@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/aec3_arena.h"
+
+namespace webrtc {
+
+namespace {
+
+uint8_t* Align(uint8_t* p) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t aligned_address =
+      (address + Aec3Arena::kAlignment - 1) & ~(Aec3Arena::kAlignment - 1);
+  return p + (aligned_address - address);
+}
+
+}  // namespace
+
+Aec3Arena::Aec3Arena(size_t capacity_bytes)
+    : capacity_(capacity_bytes),
+      storage_(new uint8_t[capacity_bytes + kAlignment - 1]),
+      data_(Align(storage_.get())) {}
+
+Aec3Arena::~Aec3Arena() = default;
+
+uint8_t* Aec3Arena::AllocateBytes(size_t num_bytes) {
+  RTC_CHECK(!sealed_) << "Allocation from a sealed AEC3 arena.";
+  RTC_CHECK_LE(num_bytes, capacity_ - used_);
+  uint8_t* data = data_ + used_;
+  used_ += num_bytes;
+  return data;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_AEC3_ARENA_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_AEC3_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Bump allocator backing the buffers of one AEC3 instance with a single
+// allocation. The capacity is computed up front from the sizes of the buffers,
+// using RequiredBytes, and all allocations are done during initialization.
+// After Seal() has been called, any further allocation is an error, which
+// guarantees that no memory is allocated for the buffers while processing.
+// The allocated objects are never destroyed, and must be trivially
+// destructible.
+class Aec3Arena {
+ public:
+  // Alignment of each allocation, chosen so that no two allocations share a
+  // cache line.
+  static constexpr size_t kAlignment = 64;
+
+  // Returns the number of bytes of the arena used by an allocation of
+  // `num_elements` objects of type T.
+  template <typename T>
+  static constexpr size_t RequiredBytes(size_t num_elements) {
+    return (num_elements * sizeof(T) + kAlignment - 1) / kAlignment *
+           kAlignment;
+  }
+
+  explicit Aec3Arena(size_t capacity_bytes);
+
+  Aec3Arena() = delete;
+  Aec3Arena(const Aec3Arena&) = delete;
+  Aec3Arena& operator=(const Aec3Arena&) = delete;
+
+  ~Aec3Arena();
+
+  // Allocates `num_elements` value-initialized objects of type T.
+  template <typename T>
+  ArrayView<T> Allocate(size_t num_elements) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Objects in the arena are never destroyed.");
+    static_assert(alignof(T) <= kAlignment, "Unsupported alignment.");
+    T* data =
+        reinterpret_cast<T*>(AllocateBytes(RequiredBytes<T>(num_elements)));
+    for (size_t k = 0; k < num_elements; ++k) {
+      new (&data[k]) T();
+    }
+    return ArrayView<T>(data, num_elements);
+  }
+
+  // Marks the end of the initialization, after which no allocations are
+  // allowed.
+  void Seal() { sealed_ = true; }
+  bool sealed() const { return sealed_; }
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const { return used_; }
+
+  // Returns whether `p` points into the memory of the arena.
+  bool Contains(const void* p) const {
+    const uint8_t* q = static_cast<const uint8_t*>(p);
+    return q >= data_ && q < data_ + capacity_;
+  }
+
+ private:
+  uint8_t* AllocateBytes(size_t num_bytes);
+
+  const size_t capacity_;
+  const std::unique_ptr<uint8_t[]> storage_;
+  uint8_t* const data_;
+  size_t used_ = 0;
+  bool sealed_ = false;
+};
+
+// Two-dimensional [index][channel] array stored contiguously, either in an
+// Aec3Arena or in an allocation of its own.
+template <typename T>
+class Aec3Array2D {
+ public:
+  Aec3Array2D(size_t size, size_t num_channels)
+      : size_(size),
+        num_channels_(num_channels),
+        owned_data_(size * num_channels),
+        data_(owned_data_) {}
+
+  Aec3Array2D(size_t size, size_t num_channels, Aec3Arena* arena)
+      : size_(size),
+        num_channels_(num_channels),
+        data_(arena->Allocate<T>(size * num_channels)) {}
+
+  Aec3Array2D(const Aec3Array2D&) = delete;
+  Aec3Array2D& operator=(const Aec3Array2D&) = delete;
+
+  size_t size() const { return size_; }
+  size_t num_channels() const { return num_channels_; }
+
+  ArrayView<T> operator[](size_t index) {
+    RTC_DCHECK_LT(index, size_);
+    return data_.subview(index * num_channels_, num_channels_);
+  }
+  ArrayView<const T> operator[](size_t index) const {
+    RTC_DCHECK_LT(index, size_);
+    return ArrayView<const T>(data_).subview(index * num_channels_,
+                                             num_channels_);
+  }
+
+  // Returns all elements, in [index][channel] order.
+  ArrayView<T> data() { return data_; }
+  ArrayView<const T> data() const { return data_; }
+
+ private:
+  const size_t size_;
+  const size_t num_channels_;
+  std::vector<T> owned_data_;
+  const ArrayView<T> data_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_AEC3_ARENA_H_
@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/aec3_arena.h"
+
+#include <stdint.h>
+
+#include <array>
+#include <utility>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that the allocations are aligned, zeroed, non-overlapping and fill
+// the capacity computed with RequiredBytes.
+TEST(Aec3Arena, Allocation) {
+  constexpr size_t kNumFloats = 17;
+  constexpr size_t kNumSpectra = 3;
+  Aec3Arena arena(
+      Aec3Arena::RequiredBytes<float>(kNumFloats) +
+      Aec3Arena::RequiredBytes<std::array<float, kFftLengthBy2Plus1>>(
+          kNumSpectra));
+  ArrayView<float> x = arena.Allocate<float>(kNumFloats);
+  ArrayView<std::array<float, kFftLengthBy2Plus1>> X2 =
+      arena.Allocate<std::array<float, kFftLengthBy2Plus1>>(kNumSpectra);
+  EXPECT_EQ(arena.capacity(), arena.used());
+
+  ASSERT_EQ(kNumFloats, x.size());
+  ASSERT_EQ(kNumSpectra, X2.size());
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(x.data()) % Aec3Arena::kAlignment);
+  EXPECT_EQ(0u,
+            reinterpret_cast<uintptr_t>(X2.data()) % Aec3Arena::kAlignment);
+  EXPECT_LE(reinterpret_cast<uintptr_t>(x.data() + x.size()),
+            reinterpret_cast<uintptr_t>(X2.data()));
+  EXPECT_TRUE(arena.Contains(x.data()));
+  EXPECT_TRUE(arena.Contains(&X2[kNumSpectra - 1][kFftLengthBy2]));
+  for (float sample : x) {
+    EXPECT_EQ(0.f, sample);
+  }
+  for (const auto& spectrum : X2) {
+    for (float bin : spectrum) {
+      EXPECT_EQ(0.f, bin);
+    }
+  }
+}
+
+// Verifies that arrays and blocks stored in an arena index the same data as
+// those with their own allocations.
+TEST(Aec3Arena, ArrayAndBlockStorage) {
+  constexpr size_t kSize = 4;
+  constexpr size_t kNumChannels = 3;
+  Aec3Arena arena(Aec3Arena::RequiredBytes<int>(kSize * kNumChannels) +
+                  Aec3Arena::RequiredBytes<float>(2 * kBlockSize));
+  Aec3Array2D<int> arena_array(kSize, kNumChannels, &arena);
+  Aec3Array2D<int> owned_array(kSize, kNumChannels);
+  for (size_t index = 0; index < kSize; ++index) {
+    ASSERT_EQ(kNumChannels, arena_array[index].size());
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      EXPECT_EQ(0, arena_array[index][ch]);
+      arena_array[index][ch] = index * kNumChannels + ch;
+      owned_array[index][ch] = index * kNumChannels + ch;
+    }
+  }
+  for (size_t k = 0; k < kSize * kNumChannels; ++k) {
+    EXPECT_EQ(static_cast<int>(k), arena_array.data()[k]);
+    EXPECT_EQ(static_cast<int>(k), owned_array.data()[k]);
+  }
+
+  Block block(/*num_bands=*/1, /*num_channels=*/2,
+              arena.Allocate<float>(2 * kBlockSize));
+  EXPECT_TRUE(arena.Contains(block.View(/*band=*/0, /*channel=*/1).data()));
+  block.View(/*band=*/0, /*channel=*/1)[0] = 1.f;
+
+  // Copies of the block own their data.
+  Block copy = block;
+  EXPECT_FALSE(arena.Contains(copy.View(/*band=*/0, /*channel=*/0).data()));
+  EXPECT_EQ(1.f, copy.View(/*band=*/0, /*channel=*/1)[0]);
+
+  // Blocks stored in the arena keep their storage when assigned and swapped.
+  copy.View(/*band=*/0, /*channel=*/1)[0] = 2.f;
+  block = copy;
+  EXPECT_TRUE(arena.Contains(block.View(/*band=*/0, /*channel=*/0).data()));
+  EXPECT_EQ(2.f, block.View(/*band=*/0, /*channel=*/1)[0]);
+  copy.View(/*band=*/0, /*channel=*/1)[0] = 3.f;
+  block.Swap(copy);
+  EXPECT_TRUE(arena.Contains(block.View(/*band=*/0, /*channel=*/0).data()));
+  EXPECT_EQ(3.f, block.View(/*band=*/0, /*channel=*/1)[0]);
+  EXPECT_EQ(2.f, copy.View(/*band=*/0, /*channel=*/1)[0]);
+
+  // Reducing the number of channels keeps the storage.
+  block.SetNumChannels(1);
+  EXPECT_EQ(1, block.NumChannels());
+  EXPECT_TRUE(arena.Contains(block.View(/*band=*/0, /*channel=*/0).data()));
+
+  // Moving a block stored in the arena copies its data, while moving a block
+  // that owns its data leaves the source without channels.
+  block.View(/*band=*/0, /*channel=*/0)[0] = 3.f;
+  Block moved_from_arena = std::move(block);
+  EXPECT_EQ(1, block.NumChannels());
+  EXPECT_EQ(1, moved_from_arena.NumChannels());
+  EXPECT_EQ(3.f, moved_from_arena.View(/*band=*/0, /*channel=*/0)[0]);
+  Block moved = std::move(copy);
+  EXPECT_EQ(0, copy.NumChannels());
+  EXPECT_EQ(2, moved.NumChannels());
+  EXPECT_EQ(2.f, moved.View(/*band=*/0, /*channel=*/1)[0]);
+}
+
+#if GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
+
+TEST(Aec3ArenaDeathTest, AllocationAfterSeal) {
+  Aec3Arena arena(Aec3Arena::RequiredBytes<float>(2));
+  arena.Allocate<float>(1);
+  arena.Seal();
+  EXPECT_DEATH(arena.Allocate<float>(1), "");
+}
+
+TEST(Aec3ArenaDeathTest, AllocationBeyondCapacity) {
+  Aec3Arena arena(Aec3Arena::RequiredBytes<float>(1));
+  arena.Allocate<float>(1);
+  EXPECT_DEATH(arena.Allocate<float>(1), "");
+}
+
+#endif
+
+}  // namespace webrtc
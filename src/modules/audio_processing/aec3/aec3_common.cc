@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
@@ -20,7 +21,9 @@ namespace webrtc {
 
 Aec3Optimization DetectOptimization() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-  if (GetCPUInfo(kAVX2) != 0) {
+  if (GetAvailableCpuFeatures().avx512) {
+    return Aec3Optimization::kAvx512;
+  } else if (GetCPUInfo(kAVX2) != 0) {
     return Aec3Optimization::kAvx2;
   } else if (GetCPUInfo(kSSE2) != 0) {
     return Aec3Optimization::kSse2;
@@ -23,7 +23,7 @@ namespace webrtc {
 #define ALIGN16_END __attribute__((aligned(16)))
 #endif
 
-enum class Aec3Optimization { kNone, kSse2, kAvx2, kNeon };
+enum class Aec3Optimization { kNone, kSse2, kAvx2, kAvx512, kNeon };
 
 constexpr int kNumBlocksPerSecond = 250;
 
@@ -37,6 +37,8 @@ constexpr size_t kFftLengthBy2Plus1 = kFftLengthBy2 + 1;
 constexpr size_t kFftLengthBy2Minus1 = kFftLengthBy2 - 1;
 constexpr size_t kFftLength = 2 * kFftLengthBy2;
 constexpr size_t kFftLengthBy2Log2 = 6;
+// Number of bins of the padded frequency-domain data, see PaddedFftData.
+constexpr size_t kFftLengthBy2Padded = 72;
 
 constexpr int kRenderTransferQueueSizeFrames = 100;
 
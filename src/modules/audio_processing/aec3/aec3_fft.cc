@@ -14,6 +14,7 @@
 #include <functional>
 #include <iterator>
 
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
@@ -79,9 +80,58 @@ bool IsSse2Available() {
 #endif
 }
 
+// PFFFT is only faster than the Ooura FFT when it uses SIMD instructions.
+std::unique_ptr<const Pffft> CreatePffft(Aec3Optimization optimization) {
+  if (optimization == Aec3Optimization::kNone || !Pffft::IsSimdEnabled()) {
+    return nullptr;
+  }
+  return std::make_unique<Pffft>(kFftLength, Pffft::FftType::kReal);
+}
+
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() : Aec3Fft(DetectOptimization()) {}
+
+Aec3Fft::Aec3Fft(Aec3Optimization optimization)
+    : ooura_fft_(IsSse2Available()),
+      pffft_(CreatePffft(optimization)) {}
+
+Aec3Fft::~Aec3Fft() = default;
+
+// The ordered PFFFT output is packed like the Ooura output, but the Ooura FFT
+// computes the imaginary parts with the opposite sign.
+void Aec3Fft::PffftFft(const std::array<float, kFftLength>& x,
+                       FftData* X) const {
+  // The transform works in place, with working memory on the stack.
+  alignas(Pffft::kAlignment) std::array<float, kFftLength> buffer;
+  alignas(Pffft::kAlignment) std::array<float, kFftLength> work;
+  std::copy(x.begin(), x.end(), buffer.begin());
+  pffft_->ForwardTransform(buffer, buffer, work, /*ordered=*/true);
+  X->re[0] = buffer[0];
+  X->re[kFftLengthBy2] = buffer[1];
+  X->im[0] = X->im[kFftLengthBy2] = 0.f;
+  for (size_t k = 1, j = 2; k < kFftLengthBy2; ++k, j += 2) {
+    X->re[k] = buffer[j];
+    X->im[k] = -buffer[j + 1];
+  }
+}
+
+// Unlike the Ooura inverse FFT, which is scaled by kFftLengthBy2, the PFFFT
+// inverse FFT is scaled by kFftLength.
+void Aec3Fft::PffftIfft(const FftData& X,
+                        std::array<float, kFftLength>* x) const {
+  alignas(Pffft::kAlignment) std::array<float, kFftLength> buffer;
+  alignas(Pffft::kAlignment) std::array<float, kFftLength> work;
+  buffer[0] = X.re[0];
+  buffer[1] = X.re[kFftLengthBy2];
+  for (size_t k = 1, j = 2; k < kFftLengthBy2; ++k, j += 2) {
+    buffer[j] = X.re[k];
+    buffer[j + 1] = -X.im[k];
+  }
+  pffft_->BackwardTransform(buffer, buffer, work, /*ordered=*/true);
+  std::transform(buffer.begin(), buffer.end(), x->begin(),
+                 [](float a) { return 0.5f * a; });
+}
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(ArrayView<const float> x,
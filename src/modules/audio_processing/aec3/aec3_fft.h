@@ -12,22 +12,31 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_AEC3_FFT_H_
 
 #include <array>
+#include <memory>
 
 #include "api/array_view.h"
 #include "common_audio/third_party/ooura/fft_size_128/ooura_fft.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
 // Wrapper class that provides 128 point real valued FFT functionality with the
-// FftData type.
+// FftData type. Uses PFFFT for the SIMD optimizations if PFFFT is built with
+// SIMD support, and the Ooura FFT otherwise. The backends produce the same
+// results up to rounding, including the sign convention of the imaginary part
+// and the scaling of the inverse transform. The transforms only use working
+// memory on the stack, so one object may be used by several threads.
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
 
+  // Selects the backend based on DetectOptimization().
   Aec3Fft();
+  explicit Aec3Fft(Aec3Optimization optimization);
+  ~Aec3Fft();
 
   Aec3Fft(const Aec3Fft&) = delete;
   Aec3Fft& operator=(const Aec3Fft&) = delete;
@@ -36,16 +45,27 @@ class Aec3Fft {
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
+    if (pffft_) {
+      PffftFft(*x, X);
+      return;
+    }
     ooura_fft_.Fft(x->data());
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
+    if (pffft_) {
+      PffftIfft(X, x);
+      return;
+    }
     X.CopyToPackedArray(x);
     ooura_fft_.InverseFft(x->data());
   }
 
+  // Returns true if the PFFFT backend is used.
+  bool UsesPffft() const { return pffft_ != nullptr; }
+
   // Windows the input using a Hanning window, and then adds padding of
   // kFftLengthBy2 initial zeros before computing the Fft.
   void ZeroPaddedFft(ArrayView<const float> x, Window window, FftData* X) const;
@@ -65,7 +85,12 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+  void PffftFft(const std::array<float, kFftLength>& x, FftData* X) const;
+  void PffftIfft(const FftData& X, std::array<float, kFftLength>* x) const;
+
   const OouraFft ooura_fft_;
+  // Null when the Ooura backend is used.
+  const std::unique_ptr<const Pffft> pffft_;
 };
 
 }  // namespace webrtc
@@ -34,6 +34,7 @@
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/aec3/subtractor_output_analyzer.h"
 #include "modules/audio_processing/aec3/transparent_mode.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -119,6 +120,14 @@ class AecState {
   // Takes appropriate action at an echo path change.
   void HandleEchoPathChange(const EchoPathVariability& echo_path_variability);
 
+  // Stores and restores the ERLE estimates of the warm start state.
+  void GetWarmStartState(Aec3WarmStartState* state) const {
+    erle_estimator_.GetWarmStartState(state);
+  }
+  void SetWarmStartState(const Aec3WarmStartState& state) {
+    erle_estimator_.SetWarmStartState(state);
+  }
+
   // Returns the decay factor for the echo reverberation. The parameter `mild`
   // indicates which exponential decay to return. The default one or a milder
   // one that can be used during nearend regions.
@@ -11,11 +11,14 @@
 #ifndef MODULES_AUDIO_PROCESSING_AEC3_BLOCK_H_
 #define MODULES_AUDIO_PROCESSING_AEC3_BLOCK_H_
 
+#include <algorithm>
 #include <array>
+#include <utility>
 #include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
@@ -27,7 +30,62 @@ class Block {
   Block(int num_bands, int num_channels, float default_value = 0.0f)
       : num_bands_(num_bands),
         num_channels_(num_channels),
-        data_(num_bands * num_channels * kBlockSize, default_value) {}
+        owned_data_(num_bands * num_channels * kBlockSize, default_value),
+        data_(owned_data_) {}
+
+  // Creates a block with the audio data stored in `storage`, which must
+  // outlive the block. The size of `storage` bounds the number of channels
+  // that can be set. Copies of the block own their data.
+  Block(int num_bands, int num_channels, ArrayView<float> storage)
+      : num_bands_(num_bands),
+        num_channels_(num_channels),
+        external_storage_(true),
+        data_(storage) {
+    RTC_DCHECK_LE(num_bands * num_channels * kBlockSize, storage.size());
+    std::fill(data_.begin(), data_.end(), 0.0f);
+  }
+
+  Block(const Block& b)
+      : num_bands_(b.num_bands_),
+        num_channels_(b.num_channels_),
+        owned_data_(b.data_.begin(), b.data_.begin() + b.size()),
+        data_(owned_data_) {}
+
+  // A moved-from block that owned its data is left without channels. A block
+  // with external storage keeps its data.
+  Block(Block&& b)
+      : num_bands_(b.num_bands_),
+        num_channels_(b.num_channels_),
+        owned_data_(b.external_storage_
+                        ? std::vector<float>(b.data_.begin(),
+                                             b.data_.begin() + b.size())
+                        : std::move(b.owned_data_)),
+        data_(owned_data_) {
+    if (!b.external_storage_) {
+      b.num_channels_ = 0;
+      b.owned_data_.clear();
+      b.data_ = b.owned_data_;
+    }
+  }
+
+  // Copies the audio data of `b`. The dimensions of a block with external
+  // storage must match those of `b`.
+  Block& operator=(const Block& b) {
+    if (this == &b) {
+      return *this;
+    }
+    if (external_storage_) {
+      RTC_DCHECK_EQ(num_bands_, b.num_bands_);
+      RTC_DCHECK_EQ(num_channels_, b.num_channels_);
+    } else {
+      num_bands_ = b.num_bands_;
+      num_channels_ = b.num_channels_;
+      owned_data_.resize(b.size());
+      data_ = owned_data_;
+    }
+    std::copy(b.data_.begin(), b.data_.begin() + b.size(), data_.begin());
+    return *this;
+  }
 
   // Returns the number of bands.
   int NumBands() const { return num_bands_; }
@@ -38,22 +96,29 @@ class Block {
   // Modifies the number of channels and sets all samples to zero.
   void SetNumChannels(int num_channels) {
     num_channels_ = num_channels;
-    data_.resize(num_bands_ * num_channels_ * kBlockSize);
-    std::fill(data_.begin(), data_.end(), 0.0f);
+    if (external_storage_) {
+      RTC_CHECK_LE(size(), data_.size());
+    } else {
+      owned_data_.resize(size());
+      data_ = owned_data_;
+    }
+    std::fill(data_.begin(), data_.begin() + size(), 0.0f);
   }
 
   // Iterators for accessing the data.
-  auto begin(int band, int channel) {
-    return data_.begin() + GetIndex(band, channel);
+  float* begin(int band, int channel) {
+    return data_.data() + GetIndex(band, channel);
   }
 
-  auto begin(int band, int channel) const {
-    return data_.begin() + GetIndex(band, channel);
+  const float* begin(int band, int channel) const {
+    return data_.data() + GetIndex(band, channel);
   }
 
-  auto end(int band, int channel) { return begin(band, channel) + kBlockSize; }
+  float* end(int band, int channel) {
+    return begin(band, channel) + kBlockSize;
+  }
 
-  auto end(int band, int channel) const {
+  const float* end(int band, int channel) const {
     return begin(band, channel) + kBlockSize;
   }
 
@@ -68,11 +133,19 @@ class Block {
                                               kBlockSize);
   }
 
-  // Lets two Blocks swap audio data.
+  // Lets two Blocks swap audio data. Blocks with external storage swap the
+  // samples, and must have the same dimensions.
   void Swap(Block& b) {
+    if (external_storage_ || b.external_storage_) {
+      RTC_DCHECK_EQ(num_bands_, b.num_bands_);
+      RTC_DCHECK_EQ(num_channels_, b.num_channels_);
+      std::swap_ranges(data_.begin(), data_.begin() + size(), b.data_.begin());
+      return;
+    }
     std::swap(num_bands_, b.num_bands_);
     std::swap(num_channels_, b.num_channels_);
-    data_.swap(b.data_);
+    owned_data_.swap(b.owned_data_);
+    std::swap(data_, b.data_);
   }
 
  private:
@@ -82,9 +155,14 @@ class Block {
     return (band * num_channels_ + channel) * kBlockSize;
   }
 
+  // Returns the number of samples in the block.
+  size_t size() const { return num_bands_ * num_channels_ * kBlockSize; }
+
   int num_bands_;
   int num_channels_;
-  std::vector<float> data_;
+  bool external_storage_ = false;
+  std::vector<float> owned_data_;
+  ArrayView<float> data_;
 };
 
 }  // namespace webrtc
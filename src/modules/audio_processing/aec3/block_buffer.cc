@@ -18,6 +18,29 @@ BlockBuffer::BlockBuffer(size_t size, size_t num_bands, size_t num_channels)
     : size(static_cast<int>(size)),
       buffer(size, Block(num_bands, num_channels)) {}
 
+BlockBuffer::BlockBuffer(size_t size,
+                         size_t num_bands,
+                         size_t num_channels,
+                         Aec3Arena* arena)
+    : size(static_cast<int>(size)) {
+  RTC_DCHECK(arena);
+  ArrayView<float> data =
+      arena->Allocate<float>(size * num_bands * num_channels * kBlockSize);
+  const size_t block_size = num_bands * num_channels * kBlockSize;
+  buffer.reserve(size);
+  for (size_t k = 0; k < size; ++k) {
+    buffer.emplace_back(num_bands, num_channels,
+                        data.subview(k * block_size, block_size));
+  }
+}
+
 BlockBuffer::~BlockBuffer() = default;
 
+size_t BlockBuffer::ArenaBytes(size_t size,
+                               size_t num_bands,
+                               size_t num_channels) {
+  return Aec3Arena::RequiredBytes<float>(size * num_bands * num_channels *
+                                         kBlockSize);
+}
+
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 
 #include <vector>
 
+#include "modules/audio_processing/aec3/aec3_arena.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "rtc_base/checks.h"
 
@@ -24,8 +25,16 @@ namespace webrtc {
 // together with the read and write indices.
 struct BlockBuffer {
   BlockBuffer(size_t size, size_t num_bands, size_t num_channels);
+  // Stores the audio data of the blocks in `arena`.
+  BlockBuffer(size_t size,
+              size_t num_bands,
+              size_t num_channels,
+              Aec3Arena* arena);
   ~BlockBuffer();
 
+  // Returns the number of arena bytes needed by the buffer.
+  static size_t ArenaBytes(size_t size, size_t num_bands, size_t num_channels);
+
   int IncIndex(int index) const {
     RTC_DCHECK_EQ(buffer.size(), static_cast<size_t>(size));
     return index < size - 1 ? index + 1 : 0;
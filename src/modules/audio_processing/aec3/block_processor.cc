@@ -63,6 +63,9 @@ class BlockProcessorImpl final : public BlockProcessor {
   void SetAudioBufferDelay(int delay_ms) override;
   void SetCaptureOutputUsage(bool capture_output_used) override;
 
+  void GetWarmStartState(Aec3WarmStartState* state) const override;
+  void SetWarmStartState(const Aec3WarmStartState& state) override;
+
  private:
   static std::atomic<int> instance_count_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
@@ -77,6 +80,7 @@ class BlockProcessorImpl final : public BlockProcessor {
   RenderDelayBuffer::BufferingEvent render_event_;
   size_t capture_call_counter_ = 0;
   std::optional<DelayEstimate> estimated_delay_;
+  std::optional<size_t> warm_start_delay_blocks_;
 };
 
 std::atomic<int> BlockProcessorImpl::instance_count_(0);
@@ -162,6 +166,12 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
   bool has_delay_estimator = !config_.delay.use_external_delay_estimator;
   if (has_delay_estimator) {
     RTC_DCHECK(delay_controller_);
+    if (warm_start_delay_blocks_) {
+      // Align with the restored delay until one has been estimated, without
+      // reporting a delay change as that would reset the restored filters.
+      render_buffer_->AlignFromDelay(*warm_start_delay_blocks_);
+    }
+
     // Compute and apply the render delay required to achieve proper signal
     // alignment.
     estimated_delay_ = delay_controller_->GetDelay(
@@ -169,6 +179,7 @@ void BlockProcessorImpl::ProcessCapture(bool echo_path_gain_change,
         *capture_block);
 
     if (estimated_delay_) {
+      warm_start_delay_blocks_ = std::nullopt;
       bool delay_change =
           render_buffer_->AlignFromDelay(estimated_delay_->delay);
       if (delay_change) {
@@ -234,6 +245,24 @@ void BlockProcessorImpl::SetCaptureOutputUsage(bool capture_output_used) {
   echo_remover_->SetCaptureOutputUsage(capture_output_used);
 }
 
+void BlockProcessorImpl::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  state->delay_blocks = std::nullopt;
+  if (estimated_delay_) {
+    state->delay_blocks = estimated_delay_->delay;
+  } else if (warm_start_delay_blocks_) {
+    state->delay_blocks = warm_start_delay_blocks_;
+  }
+  echo_remover_->GetWarmStartState(state);
+}
+
+void BlockProcessorImpl::SetWarmStartState(const Aec3WarmStartState& state) {
+  if (!config_.delay.use_external_delay_estimator && !estimated_delay_) {
+    warm_start_delay_blocks_ = state.delay_blocks;
+  }
+  echo_remover_->SetWarmStartState(state);
+}
+
 }  // namespace
 
 std::unique_ptr<BlockProcessor> BlockProcessor::Create(
@@ -246,8 +275,8 @@ std::unique_ptr<BlockProcessor> BlockProcessor::Create(
       RenderDelayBuffer::Create(config, sample_rate_hz, num_render_channels));
   std::unique_ptr<RenderDelayController> delay_controller;
   if (!config.delay.use_external_delay_estimator) {
-    delay_controller.reset(RenderDelayController::Create(config, sample_rate_hz,
-                                                         num_capture_channels));
+    delay_controller.reset(RenderDelayController::Create(
+        env, config, sample_rate_hz, num_capture_channels));
   }
   std::unique_ptr<EchoRemover> echo_remover = EchoRemover::Create(
       env, config, sample_rate_hz, num_render_channels, num_capture_channels);
@@ -265,8 +294,8 @@ std::unique_ptr<BlockProcessor> BlockProcessor::Create(
     std::unique_ptr<RenderDelayBuffer> render_buffer) {
   std::unique_ptr<RenderDelayController> delay_controller;
   if (!config.delay.use_external_delay_estimator) {
-    delay_controller.reset(RenderDelayController::Create(config, sample_rate_hz,
-                                                         num_capture_channels));
+    delay_controller.reset(RenderDelayController::Create(
+        env, config, sample_rate_hz, num_capture_channels));
   }
   std::unique_ptr<EchoRemover> echo_remover = EchoRemover::Create(
       env, config, sample_rate_hz, num_render_channels, num_capture_channels);
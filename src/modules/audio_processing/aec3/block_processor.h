@@ -23,6 +23,7 @@
 #include "modules/audio_processing/aec3/echo_remover.h"
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/aec3/render_delay_controller.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -78,6 +79,12 @@ class BlockProcessor {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Stores the estimated render delay and the adaptive state of the echo
+  // remover in `state`, and restores it from a state stored by another
+  // instance. A restored delay is used until a new delay has been estimated.
+  virtual void GetWarmStartState(Aec3WarmStartState* state) const = 0;
+  virtual void SetWarmStartState(const Aec3WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
@@ -346,4 +346,49 @@ TEST(BlockProcessor, ExternalDelayAppliedCorrectlyWithInitialCaptureCalls) {
   block_processor->ProcessCapture(false, false, nullptr, &capture_block);
 }
 
+// Verifies that a restored delay is applied until a delay has been estimated,
+// without being reported as an echo path change, and that the rest of the
+// state is forwarded to the echo remover.
+TEST(BlockProcessor, AppliesWarmStartDelayWithoutDelayChange) {
+  constexpr size_t kNumBlocks = 10;
+  constexpr size_t kWarmStartDelayBlocks = 7;
+  constexpr int kRate = 16000;
+  auto render_delay_buffer_mock =
+      std::make_unique<NiceMock<test::MockRenderDelayBuffer>>(kRate, 1);
+  auto render_delay_controller_mock =
+      std::make_unique<NiceMock<test::MockRenderDelayController>>();
+  auto echo_remover_mock = std::make_unique<NiceMock<test::MockEchoRemover>>();
+
+  EXPECT_CALL(*render_delay_buffer_mock, AlignFromDelay(kWarmStartDelayBlocks))
+      .Times(kNumBlocks)
+      .WillOnce(Return(true))
+      .WillRepeatedly(Return(false));
+  EXPECT_CALL(*render_delay_controller_mock, GetDelay(_, _, _))
+      .WillRepeatedly(Return(std::nullopt));
+  EXPECT_CALL(*echo_remover_mock, SetWarmStartState(_));
+  EXPECT_CALL(*echo_remover_mock, ProcessCapture(_, _, _, _, _, _))
+      .Times(kNumBlocks)
+      .WillRepeatedly([](EchoPathVariability echo_path_variability, bool,
+                         const std::optional<DelayEstimate>&, RenderBuffer*,
+                         Block*, Block*) {
+        EXPECT_EQ(EchoPathVariability::DelayAdjustment::kNone,
+                  echo_path_variability.delay_change);
+      });
+
+  std::unique_ptr<BlockProcessor> block_processor(BlockProcessor::Create(
+      EchoCanceller3Config(), kRate, 1, 1, std::move(render_delay_buffer_mock),
+      std::move(render_delay_controller_mock), std::move(echo_remover_mock)));
+
+  Aec3WarmStartState state;
+  state.delay_blocks = kWarmStartDelayBlocks;
+  block_processor->SetWarmStartState(state);
+
+  Block render_block(NumBandsForRate(kRate), 1);
+  Block capture_block(NumBandsForRate(kRate), 1);
+  for (size_t k = 0; k < kNumBlocks; ++k) {
+    block_processor->BufferRender(render_block);
+    block_processor->ProcessCapture(false, false, nullptr, &capture_block);
+  }
+}
+
 }  // namespace webrtc
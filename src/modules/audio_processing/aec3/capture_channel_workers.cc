@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/capture_channel_workers.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/experiments/field_trial_parser.h"
+
+namespace webrtc {
+
+namespace {
+
+// Number of times a worker polls for the next block before it sleeps. Blocks
+// arrive in bursts of two or three per 10 ms frame, so this keeps the workers
+// awake within a burst.
+constexpr int kNumSpinIterations = 2000;
+
+// Layout of the work word: the block number in the upper 32 bits, followed by
+// the next unclaimed channel and the number of channels in 16 bits each.
+constexpr int kBlockShift = 32;
+constexpr int kNextChannelShift = 16;
+constexpr uint64_t kChannelMask = 0xFFFF;
+
+uint32_t BlockOf(uint64_t work) {
+  return static_cast<uint32_t>(work >> kBlockShift);
+}
+
+size_t NextChannelOf(uint64_t work) {
+  return static_cast<size_t>((work >> kNextChannelShift) & kChannelMask);
+}
+
+size_t NumChannelsOf(uint64_t work) {
+  return static_cast<size_t>(work & kChannelMask);
+}
+
+uint64_t PackWork(uint32_t block, size_t num_channels) {
+  return (static_cast<uint64_t>(block) << kBlockShift) | num_channels;
+}
+
+}  // namespace
+
+int CaptureChannelWorkers::NumThreadsFromFieldTrial(
+    const FieldTrialsView& field_trials,
+    size_t num_capture_channels) {
+  FieldTrialParameter<int> num_threads(/*key=*/"", 1);
+  ParseFieldTrial({&num_threads},
+                  field_trials.Lookup("WebRTC-Aec3CaptureChannelThreads"));
+  return std::clamp<int>(num_threads.Get(), 1,
+                         std::max<int>(num_capture_channels, 1));
+}
+
+CaptureChannelWorkers::CaptureChannelWorkers(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  workers_.reserve(num_threads - 1);
+  for (int k = 1; k < num_threads; ++k) {
+    workers_.push_back(PlatformThread::SpawnJoinable(
+        [this] { Run(); }, "Aec3CaptureChannelWorker",
+        ThreadAttributes().SetPriority(ThreadPriority::kRealtime)));
+  }
+}
+
+CaptureChannelWorkers::~CaptureChannelWorkers() {
+  quit_.store(true, std::memory_order_release);
+  // Publish an empty block to wake the sleeping workers.
+  work_.store(PackWork(++block_, 0), std::memory_order_release);
+  work_.notify_all();
+  for (PlatformThread& worker : workers_) {
+    worker.Finalize();
+  }
+}
+
+void CaptureChannelWorkers::ParallelFor(size_t num_channels,
+                                        FunctionView<void(size_t)> task) {
+  RTC_DCHECK_LE(num_channels, kChannelMask);
+  if (workers_.empty() || num_channels < 2) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      task(ch);
+    }
+    return;
+  }
+
+  task_ = task;
+  num_pending_channels_.store(static_cast<int>(num_channels),
+                              std::memory_order_relaxed);
+  const uint64_t work = PackWork(++block_, num_channels);
+  work_.store(work, std::memory_order_release);
+  work_.notify_all();
+
+  RunTasks(work);
+
+  // Wait for the channels claimed by the workers.
+  int num_pending = num_pending_channels_.load(std::memory_order_acquire);
+  while (num_pending != 0) {
+    num_pending_channels_.wait(num_pending, std::memory_order_acquire);
+    num_pending = num_pending_channels_.load(std::memory_order_acquire);
+  }
+}
+
+void CaptureChannelWorkers::Run() {
+  uint32_t last_block = 0;
+  while (true) {
+    const uint64_t work = WaitForBlock(last_block);
+    if (quit_.load(std::memory_order_acquire)) {
+      return;
+    }
+    last_block = BlockOf(work);
+    RunTasks(work);
+  }
+}
+
+uint64_t CaptureChannelWorkers::WaitForBlock(uint32_t last_block) const {
+  uint64_t work = work_.load(std::memory_order_acquire);
+  for (int k = 0; k < kNumSpinIterations && BlockOf(work) == last_block; ++k) {
+    std::this_thread::yield();
+    work = work_.load(std::memory_order_acquire);
+  }
+  while (BlockOf(work) == last_block) {
+    work_.wait(work, std::memory_order_acquire);
+    work = work_.load(std::memory_order_acquire);
+  }
+  return work;
+}
+
+void CaptureChannelWorkers::RunTasks(uint64_t work) {
+  const uint32_t block = BlockOf(work);
+  while (NextChannelOf(work) < NumChannelsOf(work)) {
+    const uint64_t claimed = work + (uint64_t{1} << kNextChannelShift);
+    if (!work_.compare_exchange_weak(work, claimed, std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+      // Another thread claimed the channel, or the block has ended.
+      if (BlockOf(work) != block) {
+        return;
+      }
+      continue;
+    }
+    task_(NextChannelOf(work));
+    if (num_pending_channels_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      num_pending_channels_.notify_one();
+    }
+    work = claimed;
+  }
+}
+
+void ForEachCaptureChannel(CaptureChannelWorkers* workers,
+                           size_t num_channels,
+                           FunctionView<void(size_t)> task) {
+  if (workers) {
+    workers->ParallelFor(num_channels, task);
+    return;
+  }
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    task(ch);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_CAPTURE_CHANNEL_WORKERS_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_CAPTURE_CHANNEL_WORKERS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "api/field_trials_view.h"
+#include "api/function_view.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Runs the per-capture-channel work of one AEC3 instance on a persistent pool
+// of worker threads, for microphone arrays where the serial channel loop does
+// not fit in the block deadline of one core. The calling thread takes part in
+// the work. The workers are released and joined per block through atomic
+// counters only: they spin briefly for the next block before they sleep.
+class CaptureChannelWorkers {
+ public:
+  // Returns the number of threads, including the capture thread, set by the
+  // WebRTC-Aec3CaptureChannelThreads field trial, e.g.
+  // "WebRTC-Aec3CaptureChannelThreads/4/". The result is limited to the
+  // number of capture channels, and is 1 if the trial is not set.
+  static int NumThreadsFromFieldTrial(const FieldTrialsView& field_trials,
+                                      size_t num_capture_channels);
+
+  // Starts `num_threads` - 1 workers.
+  explicit CaptureChannelWorkers(int num_threads);
+  ~CaptureChannelWorkers();
+  CaptureChannelWorkers(const CaptureChannelWorkers&) = delete;
+  CaptureChannelWorkers& operator=(const CaptureChannelWorkers&) = delete;
+
+  int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+  // Calls `task` once for each channel in [0, `num_channels`) and returns when
+  // all calls have returned. Calls for different channels may run
+  // concurrently, so they must not share mutable state. Must always be called
+  // from the same thread.
+  void ParallelFor(size_t num_channels, FunctionView<void(size_t)> task);
+
+ private:
+  void Run();
+  // Waits for a block other than `last_block` and returns its work word.
+  uint64_t WaitForBlock(uint32_t last_block) const;
+  // Claims and runs channels of the block of `work` until none is left.
+  void RunTasks(uint64_t work);
+
+  // Holds the block number, the next unclaimed channel and the number of
+  // channels of the current block, so that a worker that is late for a block
+  // cannot claim a channel of the next one.
+  std::atomic<uint64_t> work_{0};
+  std::atomic<int> num_pending_channels_{0};
+  std::atomic<bool> quit_{false};
+  // Written by ParallelFor() before the block is published in `work_`.
+  FunctionView<void(size_t)> task_;
+  uint32_t block_ = 0;
+  std::vector<PlatformThread> workers_;
+};
+
+// Runs `task` for all channels on `workers`, or serially on the calling thread
+// if `workers` is null. As any channel may run on a worker, `task` must not
+// use a shared ApmDataDumper, which is not thread-safe. Dump from the calling
+// thread after this returns instead.
+void ForEachCaptureChannel(CaptureChannelWorkers* workers,
+                           size_t num_channels,
+                           FunctionView<void(size_t)> task);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_CAPTURE_CHANNEL_WORKERS_H_
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/capture_channel_workers.h"
+
+#include <atomic>
+#include <vector>
+
+#include "test/explicit_key_value_config.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+using test::ExplicitKeyValueConfig;
+
+TEST(CaptureChannelWorkers, NumThreadsFromFieldTrial) {
+  const ExplicitKeyValueConfig no_trial("");
+  const ExplicitKeyValueConfig four_threads(
+      "WebRTC-Aec3CaptureChannelThreads/4/");
+  const ExplicitKeyValueConfig zero_threads(
+      "WebRTC-Aec3CaptureChannelThreads/0/");
+  EXPECT_EQ(1, CaptureChannelWorkers::NumThreadsFromFieldTrial(no_trial, 8));
+  EXPECT_EQ(4,
+            CaptureChannelWorkers::NumThreadsFromFieldTrial(four_threads, 8));
+  // Limited to the number of capture channels.
+  EXPECT_EQ(2,
+            CaptureChannelWorkers::NumThreadsFromFieldTrial(four_threads, 2));
+  EXPECT_EQ(1,
+            CaptureChannelWorkers::NumThreadsFromFieldTrial(zero_threads, 8));
+}
+
+// Verifies that every channel is processed exactly once per block, and that
+// the processing of a block has completed when ParallelFor() returns.
+TEST(CaptureChannelWorkers, RunsEachChannelOncePerBlock) {
+  constexpr int kNumBlocks = 2000;
+  for (int num_threads : {1, 2, 4, 8}) {
+    CaptureChannelWorkers workers(num_threads);
+    EXPECT_EQ(num_threads, workers.num_threads());
+    for (size_t num_channels : {0, 1, 3, 16}) {
+      SCOPED_TRACE(num_threads);
+      SCOPED_TRACE(num_channels);
+      std::vector<int> counts(num_channels, 0);
+      for (int block = 0; block < kNumBlocks; ++block) {
+        workers.ParallelFor(num_channels, [&](size_t ch) { ++counts[ch]; });
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+          ASSERT_EQ(block + 1, counts[ch]);
+        }
+      }
+    }
+  }
+}
+
+TEST(CaptureChannelWorkers, ForEachCaptureChannelWithoutWorkers) {
+  std::vector<int> counts(5, 0);
+  ForEachCaptureChannel(nullptr, counts.size(),
+                        [&](size_t ch) { ++counts[ch]; });
+  EXPECT_EQ(std::vector<int>(5, 1), counts);
+}
+
+}  // namespace webrtc
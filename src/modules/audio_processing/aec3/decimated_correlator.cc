@@ -0,0 +1,242 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/decimated_correlator.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Smoothing constant for the recursive averaging of the correlation and of
+// the capture envelope mean, giving a time constant of 50 updates.
+constexpr float kSmoothing = 0.02f;
+
+// Correlation peak level below which the correlation is considered to have
+// decayed to zero. Flushing it avoids denormals during long silences.
+constexpr float kMinPeakLevel = 1e-20f;
+
+static_assert(DecimatedCorrelator::kDecimationFactor == 8,
+              "The envelope kernels sum groups of eight samples.");
+
+}  // namespace
+
+DecimatedCorrelator::DecimatedCorrelator(Aec3Optimization optimization,
+                                         size_t sub_block_size,
+                                         size_t max_lag)
+    : optimization_(optimization),
+      sub_block_size_(sub_block_size),
+      decimated_render_(sub_block_size / kDecimationFactor - 1 +
+                            (max_lag + kDecimationFactor - 1) /
+                                kDecimationFactor,
+                        0.f),
+      correlation_((max_lag + kDecimationFactor - 1) / kDecimationFactor,
+                   0.f) {
+  RTC_DCHECK_EQ(0, sub_block_size % kDecimationFactor);
+  RTC_DCHECK_LT(0, sub_block_size);
+  RTC_DCHECK_LE(sub_block_size, kBlockSize);
+  RTC_DCHECK_LT(0, max_lag);
+}
+
+DecimatedCorrelator::~DecimatedCorrelator() = default;
+
+void DecimatedCorrelator::Reset() {
+  std::fill(correlation_.begin(), correlation_.end(), 0.f);
+  capture_envelope_mean_ = 0.f;
+  peak_lag_ = std::nullopt;
+}
+
+void DecimatedCorrelator::Update(const DownsampledRenderBuffer& render_buffer,
+                                 ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  RTC_DCHECK_LE(decimated_render_.size() * kDecimationFactor,
+                render_buffer.buffer.size());
+
+  // Compute the decimated render envelope by summing the magnitudes of groups
+  // of samples. The render buffer is stored in reverse time order, with the
+  // sample that aligns with the last capture sample at the read index. The
+  // groups are summed over the contiguous parts of the circular buffer, and any
+  // group that wraps around the end of the buffer is summed separately.
+  ArrayView<const float> x = render_buffer.buffer;
+  size_t x_index = render_buffer.read;
+  size_t m = 0;
+  while (m < decimated_render_.size()) {
+    const size_t num_contiguous_groups =
+        std::min(decimated_render_.size() - m,
+                 (x.size() - x_index) / kDecimationFactor);
+    SumMagnitudes(&x[x_index], num_contiguous_groups, &decimated_render_[m]);
+    m += num_contiguous_groups;
+    x_index += num_contiguous_groups * kDecimationFactor;
+    if (m < decimated_render_.size()) {
+      float sum = 0.f;
+      for (size_t k = 0; k < kDecimationFactor; ++k) {
+        x_index = x_index < x.size() ? x_index : 0;
+        sum += std::fabs(x[x_index++]);
+      }
+      decimated_render_[m++] = sum;
+    }
+  }
+
+  // Compute the decimated capture envelope, in reverse time order to match the
+  // render envelope. Its mean is removed to avoid biasing the correlation
+  // towards lags with a high render level, and it is scaled with the smoothing
+  // constant.
+  const size_t num_decimated_capture = sub_block_size_ / kDecimationFactor;
+  std::array<float, kBlockSize / kDecimationFactor> capture_gains;
+  SumMagnitudes(capture.data(), num_decimated_capture, capture_gains.data());
+  std::reverse(capture_gains.begin(),
+               capture_gains.begin() + num_decimated_capture);
+  float capture_envelope_sum = 0.f;
+  for (size_t j = 0; j < num_decimated_capture; ++j) {
+    capture_envelope_sum += capture_gains[j];
+  }
+  capture_envelope_mean_ +=
+      kSmoothing *
+      (capture_envelope_sum / num_decimated_capture - capture_envelope_mean_);
+  for (size_t j = 0; j < num_decimated_capture; ++j) {
+    capture_gains[j] =
+        kSmoothing * (capture_gains[j] - capture_envelope_mean_);
+  }
+  UpdateCorrelation(
+      ArrayView<const float>(capture_gains.data(), num_decimated_capture));
+
+  const size_t peak_index = aec3::MaxSquarePeakIndex(correlation_);
+  if (std::abs(correlation_[peak_index]) < kMinPeakLevel) {
+    Reset();
+    return;
+  }
+  peak_lag_ = peak_index * kDecimationFactor;
+}
+
+void DecimatedCorrelator::SumMagnitudes(const float* x,
+                                        size_t num_groups,
+                                        float* sums) const {
+  size_t k = 0;
+  switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      // Adds the magnitudes of the two halves of each group and sums four
+      // groups at a time by transposing the partial sums.
+      for (; k + 4 <= num_groups; k += 4) {
+        const __m128 sign_mask = _mm_set1_ps(-0.f);
+        __m128 s[4];
+        for (int g = 0; g < 4; ++g) {
+          const float* x_g = &x[8 * (k + g)];
+          s[g] = _mm_add_ps(_mm_andnot_ps(sign_mask, _mm_loadu_ps(&x_g[0])),
+                            _mm_andnot_ps(sign_mask, _mm_loadu_ps(&x_g[4])));
+        }
+        _MM_TRANSPOSE4_PS(s[0], s[1], s[2], s[3]);
+        _mm_storeu_ps(&sums[k], _mm_add_ps(_mm_add_ps(s[0], s[1]),
+                                           _mm_add_ps(s[2], s[3])));
+      }
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      // Deinterleaves two groups at a time into partial sums of the magnitudes
+      // of every fourth sample.
+      for (; k + 4 <= num_groups; k += 4) {
+        const float* x_k = &x[8 * k];
+        const float32x4x4_t a = vld4q_f32(&x_k[0]);
+        const float32x4x4_t b = vld4q_f32(&x_k[16]);
+        const float32x4_t sa =
+            vaddq_f32(vaddq_f32(vabsq_f32(a.val[0]), vabsq_f32(a.val[1])),
+                      vaddq_f32(vabsq_f32(a.val[2]), vabsq_f32(a.val[3])));
+        const float32x4_t sb =
+            vaddq_f32(vaddq_f32(vabsq_f32(b.val[0]), vabsq_f32(b.val[1])),
+                      vaddq_f32(vabsq_f32(b.val[2]), vabsq_f32(b.val[3])));
+        // The lanes of sa hold the half-group sums of groups 0, 0, 1, 1 and the
+        // lanes of sb those of groups 2, 2, 3, 3.
+        vst1q_f32(&sums[k], vcombine_f32(vpadd_f32(vget_low_f32(sa),
+                                                   vget_high_f32(sa)),
+                                         vpadd_f32(vget_low_f32(sb),
+                                                   vget_high_f32(sb))));
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+  for (; k < num_groups; ++k) {
+    float sum = 0.f;
+    for (size_t n = 0; n < kDecimationFactor; ++n) {
+      sum += std::fabs(x[kDecimationFactor * k + n]);
+    }
+    sums[k] = sum;
+  }
+}
+
+void DecimatedCorrelator::UpdateCorrelation(
+    ArrayView<const float> capture_gains) {
+  // Computes c[m] = (1 - kSmoothing) * c[m] + sum_j g[j] * x[j + m], where the
+  // capture gains g are in reverse time order.
+  constexpr float kDecay = 1.f - kSmoothing;
+  const float* x = decimated_render_.data();
+  float* c = correlation_.data();
+  const size_t c_size = correlation_.size();
+  size_t m = 0;
+  switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512: {
+      const __m128 decay = _mm_set1_ps(kDecay);
+      for (; m + 4 <= c_size; m += 4) {
+        __m128 c_m = _mm_mul_ps(decay, _mm_loadu_ps(&c[m]));
+        for (size_t j = 0; j < capture_gains.size(); ++j) {
+          const __m128 g_j = _mm_set1_ps(capture_gains[j]);
+          c_m = _mm_add_ps(c_m, _mm_mul_ps(g_j, _mm_loadu_ps(&x[j + m])));
+        }
+        _mm_storeu_ps(&c[m], c_m);
+      }
+    } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      for (; m + 4 <= c_size; m += 4) {
+        float32x4_t c_m = vmulq_n_f32(vld1q_f32(&c[m]), kDecay);
+        for (size_t j = 0; j < capture_gains.size(); ++j) {
+          c_m = vmlaq_n_f32(c_m, vld1q_f32(&x[j + m]), capture_gains[j]);
+        }
+        vst1q_f32(&c[m], c_m);
+      }
+      break;
+#endif
+    default:
+      break;
+  }
+  for (; m < c_size; ++m) {
+    float c_m = kDecay * c[m];
+    for (size_t j = 0; j < capture_gains.size(); ++j) {
+      c_m += capture_gains[j] * x[j + m];
+    }
+    c[m] = c_m;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_DECIMATED_CORRELATOR_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_DECIMATED_CORRELATOR_H_
+
+#include <stddef.h>
+
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+
+namespace webrtc {
+
+struct DownsampledRenderBuffer;
+
+// Produces a coarse estimate of the lag between the downsampled render and
+// capture signals by recursively averaging the cross-correlation of their
+// envelopes at a further decimated rate. The envelopes are used as the
+// downsampled signals are band-pass filtered, and their waveforms do not
+// survive the decimation. The estimate is used to select which matched filter
+// sections to adapt.
+class DecimatedCorrelator {
+ public:
+  // Decimation factor of the envelopes relative to the downsampled render and
+  // capture signals.
+  static constexpr size_t kDecimationFactor = 8;
+
+  DecimatedCorrelator(Aec3Optimization optimization,
+                      size_t sub_block_size,
+                      size_t max_lag);
+
+  DecimatedCorrelator() = delete;
+  DecimatedCorrelator(const DecimatedCorrelator&) = delete;
+  DecimatedCorrelator& operator=(const DecimatedCorrelator&) = delete;
+
+  ~DecimatedCorrelator();
+
+  // Updates the correlation with the values in the capture buffer.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              ArrayView<const float> capture);
+
+  // Resets the correlation.
+  void Reset();
+
+  // Returns the lag, in downsampled samples, of the correlation peak. The lag
+  // is quantized to multiples of kDecimationFactor. No lag is returned while
+  // the correlation is zero.
+  std::optional<size_t> PeakLag() const { return peak_lag_; }
+
+ private:
+  // Computes the sums of the magnitudes of `num_groups` consecutive groups of
+  // kDecimationFactor samples.
+  void SumMagnitudes(const float* x, size_t num_groups, float* sums) const;
+
+  // Recursively averages the correlation with the capture envelope samples,
+  // in reverse time order and scaled by the smoothing constant.
+  void UpdateCorrelation(ArrayView<const float> capture_gains);
+
+  const Aec3Optimization optimization_;
+  const size_t sub_block_size_;
+  std::vector<float> decimated_render_;
+  std::vector<float> correlation_;
+  float capture_envelope_mean_ = 0.f;
+  std::optional<size_t> peak_lag_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_DECIMATED_CORRELATOR_H_
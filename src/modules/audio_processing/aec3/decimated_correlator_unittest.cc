@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/decimated_correlator.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumMatchedFilters = 10;
+
+size_t MaxLag(size_t sub_block_size) {
+  return sub_block_size * ((kNumMatchedFilters - 1) *
+                               kMatchedFilterAlignmentShiftSizeSubBlocks +
+                           kMatchedFilterWindowSizeSubBlocks);
+}
+
+}  // namespace
+
+// Verifies that the correlation peak is found at the delay of artificially
+// delayed signals.
+TEST(DecimatedCorrelator, PeakLag) {
+  constexpr int kSampleRateHz = 16000;
+  Random random_generator(42U);
+  for (size_t down_sampling_factor : {4, 8}) {
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    for (size_t delay_samples : {5, 150, 800, 2000}) {
+      if (delay_samples >= MaxLag(sub_block_size)) {
+        continue;
+      }
+      SCOPED_TRACE(down_sampling_factor);
+      SCOPED_TRACE(delay_samples);
+      EchoCanceller3Config config;
+      config.delay.down_sampling_factor = down_sampling_factor;
+      config.delay.num_filters = kNumMatchedFilters;
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+      DelayBuffer<float> signal_delay_buffer(down_sampling_factor *
+                                             delay_samples);
+      Decimator capture_decimator(down_sampling_factor);
+      DecimatedCorrelator correlator(DetectOptimization(), sub_block_size,
+                                     MaxLag(sub_block_size));
+
+      Block render(/*num_bands=*/1, /*num_channels=*/1);
+      std::vector<float> capture(kBlockSize, 0.f);
+      for (size_t k = 0; k < 300 + delay_samples / sub_block_size; ++k) {
+        RandomizeSampleVector(&random_generator, render.View(0, 0));
+        signal_delay_buffer.Delay(render.View(0, 0), capture);
+        render_delay_buffer->Insert(render);
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        std::array<float, kBlockSize> downsampled_capture_data;
+        ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                             sub_block_size);
+        capture_decimator.Decimate(capture, downsampled_capture);
+        correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                          downsampled_capture);
+      }
+
+      // The decimation smears the peak over neighboring lags.
+      ASSERT_TRUE(correlator.PeakLag().has_value());
+      EXPECT_NEAR(delay_samples, *correlator.PeakLag(),
+                  2 * DecimatedCorrelator::kDecimationFactor);
+    }
+  }
+}
+
+// Verifies that no peak is reported without render signal, and after a reset.
+TEST(DecimatedCorrelator, NoPeakLagForZeroRender) {
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  Random random_generator(42U);
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = kDownSamplingFactor;
+  config.delay.num_filters = kNumMatchedFilters;
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+  DecimatedCorrelator correlator(DetectOptimization(), kSubBlockSize,
+                                 MaxLag(kSubBlockSize));
+  Block render(/*num_bands=*/1, /*num_channels=*/1);
+  std::vector<float> capture(kSubBlockSize, 0.f);
+  for (int k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator, capture);
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      capture);
+  }
+  EXPECT_FALSE(correlator.PeakLag().has_value());
+
+  for (int k = 0; k < 100; ++k) {
+    RandomizeSampleVector(&random_generator, render.View(0, 0));
+    RandomizeSampleVector(&random_generator, capture);
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      capture);
+  }
+  EXPECT_TRUE(correlator.PeakLag().has_value());
+  correlator.Reset();
+  EXPECT_FALSE(correlator.PeakLag().has_value());
+}
+
+// Verifies that the optimized correlation matches the reference
+// implementation.
+TEST(DecimatedCorrelator, OptimizationsMatchReference) {
+  constexpr int kSampleRateHz = 16000;
+  Random random_generator(42U);
+  for (size_t down_sampling_factor : {4, 8}) {
+    SCOPED_TRACE(down_sampling_factor);
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    EchoCanceller3Config config;
+    config.delay.down_sampling_factor = down_sampling_factor;
+    config.delay.num_filters = kNumMatchedFilters;
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+    DecimatedCorrelator correlator(DetectOptimization(), sub_block_size,
+                                   MaxLag(sub_block_size));
+    DecimatedCorrelator reference_correlator(
+        Aec3Optimization::kNone, sub_block_size, MaxLag(sub_block_size));
+    Block render(/*num_bands=*/1, /*num_channels=*/1);
+    std::vector<float> capture(sub_block_size, 0.f);
+    for (int k = 0; k < 500; ++k) {
+      RandomizeSampleVector(&random_generator, render.View(0, 0));
+      RandomizeSampleVector(&random_generator, capture);
+      render_delay_buffer->Insert(render);
+      render_delay_buffer->PrepareCaptureProcessing();
+      correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                        capture);
+      reference_correlator.Update(
+          render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+      ASSERT_EQ(reference_correlator.PeakLag(), correlator.PeakLag());
+    }
+  }
+}
+
+}  // namespace webrtc
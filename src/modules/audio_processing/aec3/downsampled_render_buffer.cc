@@ -16,10 +16,18 @@ namespace webrtc {
 
 DownsampledRenderBuffer::DownsampledRenderBuffer(size_t downsampled_buffer_size)
     : size(static_cast<int>(downsampled_buffer_size)),
-      buffer(downsampled_buffer_size, 0.f) {
-  std::fill(buffer.begin(), buffer.end(), 0.f);
-}
+      owned_buffer(downsampled_buffer_size, 0.f),
+      buffer(owned_buffer) {}
+
+DownsampledRenderBuffer::DownsampledRenderBuffer(size_t downsampled_buffer_size,
+                                                 Aec3Arena* arena)
+    : size(static_cast<int>(downsampled_buffer_size)),
+      buffer(arena->Allocate<float>(downsampled_buffer_size)) {}
 
 DownsampledRenderBuffer::~DownsampledRenderBuffer() = default;
 
+size_t DownsampledRenderBuffer::ArenaBytes(size_t downsampled_buffer_size) {
+  return Aec3Arena::RequiredBytes<float>(downsampled_buffer_size);
+}
+
 }  // namespace webrtc
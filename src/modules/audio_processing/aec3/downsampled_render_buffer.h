@@ -15,6 +15,8 @@
 
 #include <vector>
 
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_arena.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -22,8 +24,15 @@ namespace webrtc {
 // Holds the circular buffer of the downsampled render data.
 struct DownsampledRenderBuffer {
   explicit DownsampledRenderBuffer(size_t downsampled_buffer_size);
+  // Stores the downsampled render data in `arena`.
+  DownsampledRenderBuffer(size_t downsampled_buffer_size, Aec3Arena* arena);
+  DownsampledRenderBuffer(const DownsampledRenderBuffer&) = delete;
+  DownsampledRenderBuffer& operator=(const DownsampledRenderBuffer&) = delete;
   ~DownsampledRenderBuffer();
 
+  // Returns the number of arena bytes needed by the buffer.
+  static size_t ArenaBytes(size_t downsampled_buffer_size);
+
   int IncIndex(int index) const {
     RTC_DCHECK_EQ(buffer.size(), static_cast<size_t>(size));
     return index < size - 1 ? index + 1 : 0;
@@ -48,7 +57,9 @@ struct DownsampledRenderBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<float> buffer;
+  // Storage of the buffer when it is not stored in an arena.
+  std::vector<float> owned_buffer;
+  const ArrayView<float> buffer;
   int write = 0;
   int read = 0;
 };
@@ -30,13 +30,14 @@
 #include "modules/audio_processing/aec3/block_framer.h"
 #include "modules/audio_processing/aec3/block_processor.h"
 #include "modules/audio_processing/aec3/frame_blocker.h"
+#include "modules/audio_processing/aec3/render_transfer_queue.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 #include "modules/audio_processing/high_pass_filter.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/race_checker.h"
-#include "rtc_base/swap_queue.h"
 
 namespace webrtc {
 
@@ -117,12 +118,12 @@ void FillSubFrameView(
 
 void FillSubFrameView(
     bool proper_downmix_needed,
-    std::vector<std::vector<std::vector<float>>>* frame,
+    const RenderFrameView& frame,
     size_t sub_frame_index,
     std::vector<std::vector<ArrayView<float>>>* sub_frame_view) {
   RTC_DCHECK_GE(1, sub_frame_index);
-  RTC_DCHECK_EQ(frame->size(), sub_frame_view->size());
-  const size_t frame_num_channels = (*frame)[0].size();
+  RTC_DCHECK_EQ(frame.NumBands(), sub_frame_view->size());
+  const size_t frame_num_channels = frame.NumChannels();
   const size_t sub_frame_num_channels = (*sub_frame_view)[0].size();
   if (frame_num_channels > sub_frame_num_channels) {
     RTC_DCHECK_EQ(sub_frame_num_channels, 1u);
@@ -131,33 +132,34 @@ void FillSubFrameView(
       // is present in the echo reference signal but the echo canceller does the
       // processing in mono) downmix the echo reference by averaging the channel
       // content (otherwise downmixing is done by selecting channel 0).
-      for (size_t band = 0; band < frame->size(); ++band) {
+      for (size_t band = 0; band < frame.NumBands(); ++band) {
+        ArrayView<float> downmix =
+            frame.View(band, /*channel=*/0)
+                .subview(sub_frame_index * kSubFrameLength, kSubFrameLength);
         for (size_t ch = 1; ch < frame_num_channels; ++ch) {
+          ArrayView<const float> channel_data = frame.View(band, ch).subview(
+              sub_frame_index * kSubFrameLength, kSubFrameLength);
           for (size_t k = 0; k < kSubFrameLength; ++k) {
-            (*frame)[band][/*channel=*/0]
-                    [sub_frame_index * kSubFrameLength + k] +=
-                (*frame)[band][ch][sub_frame_index * kSubFrameLength + k];
+            downmix[k] += channel_data[k];
           }
         }
         const float one_by_num_channels = 1.0f / frame_num_channels;
         for (size_t k = 0; k < kSubFrameLength; ++k) {
-          (*frame)[band][/*channel=*/0][sub_frame_index * kSubFrameLength +
-                                        k] *= one_by_num_channels;
+          downmix[k] *= one_by_num_channels;
         }
       }
     }
-    for (size_t band = 0; band < frame->size(); ++band) {
-      (*sub_frame_view)[band][/*channel=*/0] = ArrayView<float>(
-          &(*frame)[band][/*channel=*/0][sub_frame_index * kSubFrameLength],
-          kSubFrameLength);
+    for (size_t band = 0; band < frame.NumBands(); ++band) {
+      (*sub_frame_view)[band][/*channel=*/0] =
+          frame.View(band, /*channel=*/0)
+              .subview(sub_frame_index * kSubFrameLength, kSubFrameLength);
     }
   } else {
     RTC_DCHECK_EQ(frame_num_channels, sub_frame_num_channels);
-    for (size_t band = 0; band < frame->size(); ++band) {
-      for (size_t channel = 0; channel < (*frame)[band].size(); ++channel) {
-        (*sub_frame_view)[band][channel] = ArrayView<float>(
-            &(*frame)[band][channel][sub_frame_index * kSubFrameLength],
-            kSubFrameLength);
+    for (size_t band = 0; band < frame.NumBands(); ++band) {
+      for (size_t channel = 0; channel < frame_num_channels; ++channel) {
+        (*sub_frame_view)[band][channel] = frame.View(band, channel).subview(
+            sub_frame_index * kSubFrameLength, kSubFrameLength);
       }
     }
   }
@@ -232,7 +234,7 @@ void ProcessRemainingCaptureFrameContent(bool level_change,
 
 void BufferRenderFrameContent(
     bool proper_downmix_needed,
-    std::vector<std::vector<std::vector<float>>>* render_frame,
+    const RenderFrameView& render_frame,
     size_t sub_frame_index,
     FrameBlocker* render_blocker,
     BlockProcessor* block_processor,
@@ -255,19 +257,15 @@ void BufferRemainingRenderFrameContent(FrameBlocker* render_blocker,
 }
 
 void CopyBufferIntoFrame(const AudioBuffer& buffer,
-                         size_t num_bands,
-                         size_t num_channels,
-                         std::vector<std::vector<std::vector<float>>>* frame) {
-  RTC_DCHECK_EQ(num_bands, frame->size());
-  RTC_DCHECK_EQ(num_channels, (*frame)[0].size());
-  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, (*frame)[0][0].size());
-  for (size_t band = 0; band < num_bands; ++band) {
-    for (size_t channel = 0; channel < num_channels; ++channel) {
+                         const RenderFrameView& frame) {
+  RTC_DCHECK_EQ(AudioBuffer::kSplitBandSize, frame.FrameLength());
+  for (size_t band = 0; band < frame.NumBands(); ++band) {
+    for (size_t channel = 0; channel < frame.NumChannels(); ++channel) {
       ArrayView<const float> buffer_view(
           &buffer.split_bands_const(channel)[band][0],
           AudioBuffer::kSplitBandSize);
       std::copy(buffer_view.begin(), buffer_view.end(),
-                (*frame)[band][channel].begin());
+                frame.View(band, channel).begin());
     }
   }
 }
@@ -675,8 +673,7 @@ class EchoCanceller3::RenderWriter {
  public:
   RenderWriter(ApmDataDumper* data_dumper,
                const EchoCanceller3Config& config,
-               SwapQueue<std::vector<std::vector<std::vector<float>>>,
-                         Aec3RenderQueueItemVerifier>* render_transfer_queue,
+               RenderTransferQueue* render_transfer_queue,
                size_t num_bands,
                size_t num_channels);
 
@@ -692,28 +689,21 @@ class EchoCanceller3::RenderWriter {
   const size_t num_bands_;
   const size_t num_channels_;
   std::unique_ptr<HighPassFilter> high_pass_filter_;
-  std::vector<std::vector<std::vector<float>>> render_queue_input_frame_;
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>* render_transfer_queue_;
+  RenderTransferQueue* render_transfer_queue_;
 };
 
 EchoCanceller3::RenderWriter::RenderWriter(
     ApmDataDumper* data_dumper,
     const EchoCanceller3Config& config,
-    SwapQueue<std::vector<std::vector<std::vector<float>>>,
-              Aec3RenderQueueItemVerifier>* render_transfer_queue,
+    RenderTransferQueue* render_transfer_queue,
     size_t num_bands,
     size_t num_channels)
     : data_dumper_(data_dumper),
       num_bands_(num_bands),
       num_channels_(num_channels),
-      render_queue_input_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
       render_transfer_queue_(render_transfer_queue) {
   RTC_DCHECK(data_dumper);
+  RTC_DCHECK(render_transfer_queue);
   if (config.filter.high_pass_filter_echo_reference) {
     high_pass_filter_ = std::make_unique<HighPassFilter>(16000, num_channels);
   }
@@ -733,13 +723,20 @@ void EchoCanceller3::RenderWriter::Insert(const AudioBuffer& input) {
   data_dumper_->DumpWav("aec3_render_input", AudioBuffer::kSplitBandSize,
                         &input.split_bands_const(0)[0][0], 16000, 1);
 
-  CopyBufferIntoFrame(input, num_bands_, num_channels_,
-                      &render_queue_input_frame_);
+  // The frame is dropped if the queue is full.
+  std::optional<RenderFrameView> frame = render_transfer_queue_->BeginInsert();
+  if (!frame) {
+    return;
+  }
+
+  CopyBufferIntoFrame(input, *frame);
   if (high_pass_filter_) {
-    high_pass_filter_->Process(&render_queue_input_frame_[0]);
+    for (size_t channel = 0; channel < num_channels_; ++channel) {
+      high_pass_filter_->Process(channel, frame->View(/*band=*/0, channel));
+    }
   }
 
-  static_cast<void>(render_transfer_queue_->Insert(&render_queue_input_frame_));
+  render_transfer_queue_->CommitInsert();
 }
 
 std::atomic<int> EchoCanceller3::instance_count_(0);
@@ -772,21 +769,10 @@ EchoCanceller3::EchoCanceller3(
               .multi_channel.stereo_detection_hysteresis_seconds),
       output_framer_(num_bands_, num_capture_channels_),
       capture_blocker_(num_bands_, num_capture_channels_),
-      render_transfer_queue_(
-          kRenderTransferQueueSizeFrames,
-          std::vector<std::vector<std::vector<float>>>(
-              num_bands_,
-              std::vector<std::vector<float>>(
-                  num_render_input_channels_,
-                  std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
-          Aec3RenderQueueItemVerifier(num_bands_,
-                                      num_render_input_channels_,
-                                      AudioBuffer::kSplitBandSize)),
-      render_queue_output_frame_(
-          num_bands_,
-          std::vector<std::vector<float>>(
-              num_render_input_channels_,
-              std::vector<float>(AudioBuffer::kSplitBandSize, 0.f))),
+      render_transfer_queue_(kRenderTransferQueueSizeFrames,
+                             num_bands_,
+                             num_render_input_channels_,
+                             AudioBuffer::kSplitBandSize),
       render_block_(num_bands_, num_render_input_channels_),
       capture_block_(num_bands_, num_capture_channels_),
       capture_sub_frame_view_(
@@ -849,6 +835,24 @@ void EchoCanceller3::Initialize() {
       num_bands_, std::vector<ArrayView<float>>(num_render_channels_to_aec_));
 }
 
+std::vector<uint8_t> EchoCanceller3::GetWarmStartState() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  Aec3WarmStartState state;
+  block_processor_->GetWarmStartState(&state);
+  return SerializeAec3WarmStartState(state);
+}
+
+bool EchoCanceller3::SetWarmStartState(ArrayView<const uint8_t> state) {
+  RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
+  Aec3WarmStartState warm_start_state;
+  if (!DeserializeAec3WarmStartState(state, &warm_start_state) ||
+      warm_start_state.capture_channels.size() != num_capture_channels_) {
+    return false;
+  }
+  block_processor_->SetWarmStartState(warm_start_state);
+  return true;
+}
+
 void EchoCanceller3::AnalyzeRender(const AudioBuffer& render) {
   RTC_DCHECK_RUNS_SERIALIZED(&render_race_checker_);
 
@@ -968,36 +972,38 @@ void EchoCanceller3::SetBlockProcessorForTesting(
 
 void EchoCanceller3::EmptyRenderQueue() {
   RTC_DCHECK_RUNS_SERIALIZED(&capture_race_checker_);
-  bool frame_to_buffer =
-      render_transfer_queue_.Remove(&render_queue_output_frame_);
-  while (frame_to_buffer) {
-    // Report render call in the metrics.
-    api_call_metrics_.ReportRenderCall();
-
-    if (multichannel_content_detector_.UpdateDetection(
-            render_queue_output_frame_)) {
-      // Reinitialize the AEC when proper stereo is detected.
-      Initialize();
-    }
-
-    // Buffer frame content.
-    BufferRenderFrameContent(
-        /*proper_downmix_needed=*/multichannel_content_detector_
-            .IsTemporaryMultiChannelContentDetected(),
-        &render_queue_output_frame_, 0, render_blocker_.get(),
-        block_processor_.get(), &render_block_, &render_sub_frame_view_);
-
-    BufferRenderFrameContent(
-        /*proper_downmix_needed=*/multichannel_content_detector_
-            .IsTemporaryMultiChannelContentDetected(),
-        &render_queue_output_frame_, 1, render_blocker_.get(),
-        block_processor_.get(), &render_block_, &render_sub_frame_view_);
-
-    BufferRemainingRenderFrameContent(render_blocker_.get(),
-                                      block_processor_.get(), &render_block_);
+  // The frames are processed in place, and all frames queued at the time are
+  // acquired and released together.
+  for (size_t num_frames = render_transfer_queue_.Acquire(); num_frames > 0;
+       num_frames = render_transfer_queue_.Acquire()) {
+    for (size_t k = 0; k < num_frames; ++k) {
+      const RenderFrameView frame = render_transfer_queue_.Frame(k);
+
+      // Report render call in the metrics.
+      api_call_metrics_.ReportRenderCall();
+
+      if (multichannel_content_detector_.UpdateDetection(frame)) {
+        // Reinitialize the AEC when proper stereo is detected.
+        Initialize();
+      }
 
-    frame_to_buffer =
-        render_transfer_queue_.Remove(&render_queue_output_frame_);
+      // Buffer frame content.
+      BufferRenderFrameContent(
+          /*proper_downmix_needed=*/multichannel_content_detector_
+              .IsTemporaryMultiChannelContentDetected(),
+          frame, 0, render_blocker_.get(), block_processor_.get(),
+          &render_block_, &render_sub_frame_view_);
+
+      BufferRenderFrameContent(
+          /*proper_downmix_needed=*/multichannel_content_detector_
+              .IsTemporaryMultiChannelContentDetected(),
+          frame, 1, render_blocker_.get(), block_processor_.get(),
+          &render_block_, &render_sub_frame_view_);
+
+      BufferRemainingRenderFrameContent(
+          render_blocker_.get(), block_processor_.get(), &render_block_);
+    }
+    render_transfer_queue_.Release(num_frames);
   }
 }
 }  // namespace webrtc
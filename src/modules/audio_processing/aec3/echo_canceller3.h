@@ -30,11 +30,11 @@
 #include "modules/audio_processing/aec3/config_selector.h"
 #include "modules/audio_processing/aec3/frame_blocker.h"
 #include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+#include "modules/audio_processing/aec3/render_transfer_queue.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/race_checker.h"
-#include "rtc_base/swap_queue.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -45,40 +45,6 @@ namespace webrtc {
 EchoCanceller3Config AdjustConfig(const EchoCanceller3Config& config,
                                   const FieldTrialsView& field_trials);
 
-// Functor for verifying the invariance of the frames being put into the render
-// queue.
-class Aec3RenderQueueItemVerifier {
- public:
-  Aec3RenderQueueItemVerifier(size_t num_bands,
-                              size_t num_channels,
-                              size_t frame_length)
-      : num_bands_(num_bands),
-        num_channels_(num_channels),
-        frame_length_(frame_length) {}
-
-  bool operator()(const std::vector<std::vector<std::vector<float>>>& v) const {
-    if (v.size() != num_bands_) {
-      return false;
-    }
-    for (const auto& band : v) {
-      if (band.size() != num_channels_) {
-        return false;
-      }
-      for (const auto& channel : band) {
-        if (channel.size() != frame_length_) {
-          return false;
-        }
-      }
-    }
-    return true;
-  }
-
- private:
-  const size_t num_bands_;
-  const size_t num_channels_;
-  const size_t frame_length_;
-};
-
 // Main class for the echo canceller3.
 // It does 4 things:
 // -Receives 10 ms frames of band-split audio.
@@ -139,6 +105,16 @@ class EchoCanceller3 : public EchoControl {
     block_processor_->UpdateEchoLeakageStatus(leakage_detected);
   }
 
+  // Returns the serialized adaptive state (render delay, linear filters and
+  // ERLE estimates), which lets a new instance with the same channel layout
+  // start out converged.
+  std::vector<uint8_t> GetWarmStartState() const;
+
+  // Restores a state returned by GetWarmStartState(). Returns false if the
+  // state is malformed or was stored for another number of capture channels.
+  // Filters stored for another number of render channels are not restored.
+  bool SetWarmStartState(ArrayView<const uint8_t> state);
+
  private:
   friend class EchoCanceller3Tester;
   FRIEND_TEST_ALL_PREFIXES(EchoCanceller3, DetectionOfProperStereo);
@@ -169,7 +145,8 @@ class EchoCanceller3 : public EchoControl {
     return config_selector_.active_config();
   }
 
-  // Empties the render SwapQueue.
+  // Empties the render transfer queue, in batches of all the frames queued at
+  // the time.
   void EmptyRenderQueue();
 
   // Analyzes and stores an internal copy of the split-band domain render
@@ -203,13 +180,9 @@ class EchoCanceller3 : public EchoControl {
   FrameBlocker capture_blocker_ RTC_GUARDED_BY(capture_race_checker_);
   std::unique_ptr<FrameBlocker> render_blocker_
       RTC_GUARDED_BY(capture_race_checker_);
-  SwapQueue<std::vector<std::vector<std::vector<float>>>,
-            Aec3RenderQueueItemVerifier>
-      render_transfer_queue_;
+  RenderTransferQueue render_transfer_queue_;
   std::unique_ptr<BlockProcessor> block_processor_
       RTC_GUARDED_BY(capture_race_checker_);
-  std::vector<std::vector<std::vector<float>>> render_queue_output_frame_
-      RTC_GUARDED_BY(capture_race_checker_);
   bool saturated_microphone_signal_ RTC_GUARDED_BY(capture_race_checker_) =
       false;
   Block render_block_ RTC_GUARDED_BY(capture_race_checker_);
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Checks that EchoCanceller3 does not allocate from the heap while
+// processing. The check replaces the global allocation functions, so it is
+// built as an executable of its own rather than as part of aec3_unittests,
+// where the replacement would affect all other tests and override the
+// allocators of the sanitizers.
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <optional>
+#include <string>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "api/environment/environment_factory.h"
+#include "modules/audio_processing/aec3/echo_canceller3.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/strings/string_builder.h"
+#include "test/gtest.h"
+
+namespace {
+
+// Heap allocations of all threads, counted by the replaced global allocation
+// functions below, including the aligned ones used by over-aligned types
+// such as the FFT data of the render buffers.
+std::atomic<int> num_heap_allocations{0};
+
+void* CountedAllocation(size_t size) {
+  num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = malloc(size > 0 ? size : 1);
+  RTC_CHECK(memory);
+  return memory;
+}
+
+void* CountedAlignedAllocation(size_t size, std::align_val_t alignment) {
+  num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = nullptr;
+  RTC_CHECK_EQ(
+      posix_memalign(&memory,
+                     std::max(static_cast<size_t>(alignment), sizeof(void*)),
+                     size > 0 ? size : 1),
+      0);
+  return memory;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  return CountedAllocation(size);
+}
+void* operator new[](size_t size) {
+  return CountedAllocation(size);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CountedAlignedAllocation(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CountedAlignedAllocation(size, alignment);
+}
+void operator delete(void* memory) noexcept {
+  free(memory);
+}
+void operator delete[](void* memory) noexcept {
+  free(memory);
+}
+void operator delete(void* memory, std::align_val_t) noexcept {
+  free(memory);
+}
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  free(memory);
+}
+
+namespace webrtc {
+namespace {
+
+std::string ProduceDebugText(int sample_rate_hz, int variant) {
+  StringBuilder ss;
+  ss << "Sample rate: " << sample_rate_hz << ", variant: " << variant;
+  return ss.Release();
+}
+
+}  // namespace
+
+// Verifies that the counting hook sees both plain and aligned allocations.
+TEST(EchoCanceller3Allocations, CountsAlignedAllocations) {
+  struct alignas(64) OverAligned {
+    float values[16];
+  };
+  // The volatile pointers keep the compiler from eliding the allocations.
+  const int num_allocations_before = num_heap_allocations.load();
+  int* volatile plain = new int;
+  OverAligned* volatile aligned = new OverAligned;
+  OverAligned* volatile aligned_array = new OverAligned[2];
+  EXPECT_EQ(num_heap_allocations.load() - num_allocations_before, 3);
+  delete plain;
+  delete aligned;
+  delete[] aligned_array;
+}
+
+// Verifies that the render and capture processing does not allocate from the
+// heap once the canceller runs. The first second covers the start-up, which
+// logs the initial render buffering. Stereo content detection is disabled, as
+// switching to the multichannel config reallocates the canceller.
+TEST(EchoCanceller3Allocations, NoHeapAllocationsWhenProcessing) {
+  constexpr int kNumStartupFrames = 100;
+  constexpr int kNumFrames = 500;
+  for (int rate : {16000, 48000}) {
+    for (size_t num_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(rate, num_channels));
+      EchoCanceller3Config config;
+      config.multi_channel.detect_stereo_content = false;
+      EchoCanceller3 aec3(CreateEnvironment(), config,
+                          /*multichannel_config=*/std::nullopt, rate,
+                          num_channels, num_channels);
+      AudioBuffer render_buffer(rate, num_channels, rate, num_channels, rate,
+                                num_channels);
+      AudioBuffer capture_buffer(rate, num_channels, rate, num_channels, rate,
+                                 num_channels);
+      Random random_generator(42U);
+      auto randomize = [&](AudioBuffer& buffer) {
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+          for (size_t band = 0; band < buffer.num_bands(); ++band) {
+            float* samples = buffer.split_bands(ch)[band];
+            for (size_t k = 0; k < buffer.num_frames_per_band(); ++k) {
+              samples[k] = random_generator.Rand<float>() * 2000.f - 1000.f;
+            }
+          }
+        }
+      };
+
+      int num_allocations = 0;
+      for (int frame = 0; frame < kNumStartupFrames + kNumFrames; ++frame) {
+        randomize(render_buffer);
+        randomize(capture_buffer);
+        const int num_allocations_before = num_heap_allocations.load();
+        aec3.AnalyzeRender(&render_buffer);
+        aec3.AnalyzeCapture(&capture_buffer);
+        aec3.ProcessCapture(&capture_buffer, /*level_change=*/false);
+        if (frame >= kNumStartupFrames) {
+          num_allocations +=
+              num_heap_allocations.load() - num_allocations_before;
+        }
+      }
+      EXPECT_EQ(num_allocations, 0);
+    }
+  }
+}
+
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
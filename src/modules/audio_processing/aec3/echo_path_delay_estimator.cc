@@ -23,6 +23,16 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
     ApmDataDumper* data_dumper,
     const EchoCanceller3Config& config,
     size_t num_capture_channels)
+    : EchoPathDelayEstimator(data_dumper,
+                             config,
+                             num_capture_channels,
+                             LagEstimation::kMatchedFilter) {}
+
+EchoPathDelayEstimator::EchoPathDelayEstimator(
+    ApmDataDumper* data_dumper,
+    const EchoCanceller3Config& config,
+    size_t num_capture_channels,
+    LagEstimation lag_estimation)
     : data_dumper_(data_dumper),
       down_sampling_factor_(config.delay.down_sampling_factor),
       sub_block_size_(down_sampling_factor_ != 0
@@ -44,7 +54,18 @@ EchoPathDelayEstimator::EchoPathDelayEstimator(
           config.delay.delay_estimate_smoothing,
           config.delay.delay_estimate_smoothing_delay_found,
           config.delay.delay_candidate_detection_threshold,
-          config.delay.detect_pre_echo),
+          config.delay.detect_pre_echo,
+          lag_estimation == LagEstimation::kCoarseToFineMatchedFilter),
+      cross_correlator_(
+          lag_estimation == LagEstimation::kPartitionedCrossCorrelation
+              ? std::make_unique<PartitionedCrossCorrelator>(
+                    DetectOptimization(),
+                    sub_block_size_,
+                    matched_filter_.GetMaxFilterLag(),
+                    config.delay.down_sampling_factor == 8
+                        ? config.render_levels.poor_excitation_render_limit_ds8
+                        : config.render_levels.poor_excitation_render_limit)
+              : nullptr),
       matched_filter_lag_aggregator_(data_dumper_,
                                      matched_filter_.GetMaxFilterLag(),
                                      config.delay) {
@@ -71,12 +92,17 @@ std::optional<DelayEstimate> EchoPathDelayEstimator::EstimateDelay(
   data_dumper_->DumpWav("aec3_capture_decimator_output",
                         downsampled_capture.size(), downsampled_capture.data(),
                         16000 / down_sampling_factor_, 1);
-  matched_filter_.Update(render_buffer, downsampled_capture,
-                         matched_filter_lag_aggregator_.ReliableDelayFound());
+  if (cross_correlator_) {
+    cross_correlator_->Update(render_buffer, downsampled_capture);
+  } else {
+    matched_filter_.Update(render_buffer, downsampled_capture,
+                           matched_filter_lag_aggregator_.ReliableDelayFound());
+  }
 
   std::optional<DelayEstimate> aggregated_matched_filter_lag =
       matched_filter_lag_aggregator_.Aggregate(
-          matched_filter_.GetBestLagEstimate());
+          cross_correlator_ ? cross_correlator_->GetBestLagEstimate()
+                            : matched_filter_.GetBestLagEstimate());
 
   // Run clockdrift detection.
   if (aggregated_matched_filter_lag &&
@@ -121,6 +147,9 @@ void EchoPathDelayEstimator::Reset(bool reset_lag_aggregator,
     matched_filter_lag_aggregator_.Reset(reset_delay_confidence);
   }
   matched_filter_.Reset(/*full_reset=*/reset_lag_aggregator);
+  if (cross_correlator_ && reset_lag_aggregator) {
+    cross_correlator_->Reset();
+  }
   old_aggregated_lag_ = std::nullopt;
   consistent_estimate_counter_ = 0;
 }
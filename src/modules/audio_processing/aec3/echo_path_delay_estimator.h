@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <optional>
 
 #include "api/array_view.h"
@@ -23,6 +24,7 @@
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/matched_filter.h"
 #include "modules/audio_processing/aec3/matched_filter_lag_aggregator.h"
+#include "modules/audio_processing/aec3/partitioned_cross_correlator.h"
 
 namespace webrtc {
 
@@ -33,9 +35,26 @@ struct EchoCanceller3Config;
 // Estimates the delay of the echo path.
 class EchoPathDelayEstimator {
  public:
+  // Method for producing the lag estimates that are aggregated into the delay
+  // estimate.
+  enum class LagEstimation {
+    // Adapts all the matched filter sections.
+    kMatchedFilter,
+    // Only adapts the matched filter sections around the peak of a decimated
+    // correlation.
+    kCoarseToFineMatchedFilter,
+    // Uses a partitioned frequency-domain GCC-PHAT instead of the matched
+    // filter.
+    kPartitionedCrossCorrelation,
+  };
+
   EchoPathDelayEstimator(ApmDataDumper* data_dumper,
                          const EchoCanceller3Config& config,
                          size_t num_capture_channels);
+  EchoPathDelayEstimator(ApmDataDumper* data_dumper,
+                         const EchoCanceller3Config& config,
+                         size_t num_capture_channels,
+                         LagEstimation lag_estimation);
   ~EchoPathDelayEstimator();
 
   EchoPathDelayEstimator(const EchoPathDelayEstimator&) = delete;
@@ -68,6 +87,9 @@ class EchoPathDelayEstimator {
   AlignmentMixer capture_mixer_;
   Decimator capture_decimator_;
   MatchedFilter matched_filter_;
+  // Null unless the partitioned cross-correlation is used, in which case the
+  // matched filter is not updated.
+  const std::unique_ptr<PartitionedCrossCorrelator> cross_correlator_;
   MatchedFilterLagAggregator matched_filter_lag_aggregator_;
   std::optional<DelayEstimate> old_aggregated_lag_;
   size_t consistent_estimate_counter_ = 0;
@@ -132,6 +132,59 @@ TEST(EchoPathDelayEstimator, DelayEstimation) {
   }
 }
 
+// Verifies that the delay estimator produces correct delay for artificially
+// delayed signals when using the partitioned cross-correlation.
+TEST(EchoPathDelayEstimator, DelayEstimationWithPartitionedCrossCorrelation) {
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr size_t kNumCaptureChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  Random random_generator(42U);
+  Block render(kNumBands, kNumRenderChannels);
+  Block capture(/*num_bands=*/1, kNumCaptureChannels);
+  ApmDataDumper data_dumper(0);
+  for (size_t down_sampling_factor : {4, 8}) {
+    EchoCanceller3Config config;
+    config.delay.delay_headroom_samples = 0;
+    config.delay.down_sampling_factor = down_sampling_factor;
+    config.delay.num_filters = 10;
+    for (size_t delay_samples : {30, 64, 150, 800, 4000, 12000}) {
+      SCOPED_TRACE(ProduceDebugText(delay_samples, down_sampling_factor));
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, kNumRenderChannels));
+      DelayBuffer<float> signal_delay_buffer(delay_samples);
+      EchoPathDelayEstimator estimator(
+          &data_dumper, config, kNumCaptureChannels,
+          EchoPathDelayEstimator::LagEstimation::kPartitionedCrossCorrelation);
+
+      std::optional<DelayEstimate> estimated_delay_samples;
+      for (size_t k = 0; k < (500 + (delay_samples) / kBlockSize); ++k) {
+        RandomizeSampleVector(&random_generator,
+                              render.View(/*band=*/0, /*channel=*/0));
+        signal_delay_buffer.Delay(render.View(/*band=*/0, /*channel=*/0),
+                                  capture.View(/*band=*/0, /*channel=*/0));
+        render_delay_buffer->Insert(render);
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        auto estimate = estimator.EstimateDelay(
+            render_delay_buffer->GetDownsampledRenderBuffer(), capture);
+        if (estimate) {
+          estimated_delay_samples = estimate;
+        }
+      }
+
+      ASSERT_TRUE(estimated_delay_samples);
+      size_t delay_ds = delay_samples / down_sampling_factor;
+      size_t estimated_delay_ds =
+          estimated_delay_samples->delay / down_sampling_factor;
+      EXPECT_NEAR(delay_ds, estimated_delay_ds,
+                  kBlockSize / down_sampling_factor);
+    }
+  }
+}
+
 // Verifies that the delay estimator does not produce delay estimates for render
 // signals of low level.
 TEST(EchoPathDelayEstimator, NoDelayEstimatesForLowLevelRenderSignals) {
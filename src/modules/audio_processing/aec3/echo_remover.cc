@@ -23,6 +23,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
+#include "modules/audio_processing/aec3/capture_channel_workers.h"
 #include "modules/audio_processing/aec3/comfort_noise_generator.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/echo_remover_metrics.h"
@@ -59,6 +60,21 @@ size_t NumChannelsOnHeap(size_t num_capture_channels) {
                                                        : 0;
 }
 
+// Creates the workers for the per-capture-channel processing if more than one
+// thread is requested.
+std::unique_ptr<CaptureChannelWorkers> CreateCaptureChannelWorkers(
+    const Environment& env,
+    size_t num_capture_channels) {
+  const int num_threads = CaptureChannelWorkers::NumThreadsFromFieldTrial(
+      env.field_trials(), num_capture_channels);
+  if (num_threads < 2) {
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "AEC3 processes " << num_capture_channels
+                   << " capture channels on " << num_threads << " threads";
+  return std::make_unique<CaptureChannelWorkers>(num_threads);
+}
+
 void LinearEchoPower(const FftData& E,
                      const FftData& Y,
                      std::array<float, kFftLengthBy2Plus1>* S2) {
@@ -137,6 +153,16 @@ class EchoRemoverImpl final : public EchoRemover {
     capture_output_used_ = capture_output_used;
   }
 
+  void GetWarmStartState(Aec3WarmStartState* state) const override {
+    subtractor_.GetWarmStartState(state);
+    aec_state_.GetWarmStartState(state);
+  }
+
+  void SetWarmStartState(const Aec3WarmStartState& state) override {
+    subtractor_.SetWarmStartState(state);
+    aec_state_.SetWarmStartState(state);
+  }
+
  private:
   // Selects which of the coarse and refined linear filter outputs that is most
   // appropriate to pass to the suppressor and forms the linear filter output by
@@ -146,13 +172,17 @@ class EchoRemoverImpl final : public EchoRemover {
 
   static std::atomic<int> instance_count_;
   const EchoCanceller3Config config_;
-  const Aec3Fft fft_;
+  // One FFT per capture channel, as the channels may be processed
+  // concurrently.
+  const std::vector<Aec3Fft> ffts_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const Aec3Optimization optimization_;
   const int sample_rate_hz_;
   const size_t num_render_channels_;
   const size_t num_capture_channels_;
   const bool use_coarse_filter_output_;
+  // Null unless the capture channels are processed on several threads.
+  const std::unique_ptr<CaptureChannelWorkers> workers_;
   Subtractor subtractor_;
   SuppressionGain suppression_gain_;
   ComfortNoiseGenerator cng_;
@@ -190,7 +220,7 @@ EchoRemoverImpl::EchoRemoverImpl(const Environment& env,
                                  size_t num_render_channels,
                                  size_t num_capture_channels)
     : config_(config),
-      fft_(),
+      ffts_(num_capture_channels),
       data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       optimization_(DetectOptimization()),
       sample_rate_hz_(sample_rate_hz),
@@ -198,12 +228,14 @@ EchoRemoverImpl::EchoRemoverImpl(const Environment& env,
       num_capture_channels_(num_capture_channels),
       use_coarse_filter_output_(
           config_.filter.enable_coarse_filter_output_usage),
+      workers_(CreateCaptureChannelWorkers(env, num_capture_channels_)),
       subtractor_(env,
                   config,
                   num_render_channels_,
                   num_capture_channels_,
                   data_dumper_.get(),
-                  optimization_),
+                  optimization_,
+                  workers_.get()),
       suppression_gain_(config_,
                         optimization_,
                         sample_rate_hz,
@@ -211,7 +243,8 @@ EchoRemoverImpl::EchoRemoverImpl(const Environment& env,
       cng_(config_, optimization_, num_capture_channels_),
       suppression_filter_(optimization_,
                           sample_rate_hz_,
-                          num_capture_channels_),
+                          num_capture_channels_,
+                          workers_.get()),
       render_signal_analyzer_(config_),
       residual_echo_estimator_(env, config_, num_render_channels),
       aec_state_(env, config_, num_capture_channels_),
@@ -373,15 +406,19 @@ void EchoRemoverImpl::ProcessCapture(
   subtractor_.Process(*render_buffer, *y, render_signal_analyzer_, aec_state_,
                       subtractor_output);
 
-  // Compute spectra.
+  // Compute spectra. The output selection state is shared by the channels,
+  // so the linear filter outputs are formed first.
   for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
     FormLinearFilterOutput(subtractor_output[ch], e[ch]);
-    WindowedPaddedFft(fft_, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
-    WindowedPaddedFft(fft_, e[ch], e_old_[ch], &E[ch]);
+  }
+  ForEachCaptureChannel(workers_.get(), num_capture_channels_, [&](size_t ch) {
+    const Aec3Fft& fft = ffts_[ch];
+    WindowedPaddedFft(fft, y->View(/*band=*/0, ch), y_old_[ch], &Y[ch]);
+    WindowedPaddedFft(fft, e[ch], e_old_[ch], &E[ch]);
     LinearEchoPower(E[ch], Y[ch], &S2_linear[ch]);
     Y[ch].Spectrum(optimization_, Y2[ch]);
     E[ch].Spectrum(optimization_, E2[ch]);
-  }
+  });
 
   // Optionally return the linear filter output.
   if (linear_output) {
@@ -22,6 +22,7 @@
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 
 namespace webrtc {
 
@@ -58,6 +59,11 @@ class EchoRemover {
   // resulting output is anyway not used, for instance when the endpoint is
   // muted.
   virtual void SetCaptureOutputUsage(bool capture_output_used) = 0;
+
+  // Stores the adaptive state of the linear filters and the ERLE estimators
+  // in `state`, and restores it from a state stored by another instance.
+  virtual void GetWarmStartState(Aec3WarmStartState* state) const = 0;
+  virtual void SetWarmStartState(const Aec3WarmStartState& state) = 0;
 };
 
 }  // namespace webrtc
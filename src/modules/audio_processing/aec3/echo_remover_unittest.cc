@@ -22,12 +22,18 @@
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "test/explicit_key_value_config.h"
 #include "test/gtest.h"
 
 namespace webrtc {
 namespace {
+
+using test::ExplicitKeyValueConfig;
+
 std::string ProduceDebugText(int sample_rate_hz) {
   StringBuilder ss;
   ss << "Sample rate: " << sample_rate_hz;
@@ -40,6 +46,33 @@ std::string ProduceDebugText(int sample_rate_hz, int delay) {
   return ss.Release();
 }
 
+// Creates an environment where the capture channels are processed on
+// `num_threads` threads.
+Environment CreateEnvironmentWithThreads(int num_threads) {
+  StringBuilder ss;
+  ss << "WebRTC-Aec3CaptureChannelThreads/" << num_threads << "/";
+  return CreateEnvironment(
+      std::make_unique<ExplicitKeyValueConfig>(ss.Release()));
+}
+
+// Produces a render block and a capture block that contains a differently
+// scaled echo of the render signal in each channel.
+void GenerateEcho(Random* random_generator, Block* x, Block* y) {
+  for (int band = 0; band < x->NumBands(); ++band) {
+    for (int ch = 0; ch < x->NumChannels(); ++ch) {
+      RandomizeSampleVector(random_generator, x->View(band, ch));
+    }
+    for (int ch = 0; ch < y->NumChannels(); ++ch) {
+      ArrayView<const float> x_band = x->View(band, /*channel=*/0);
+      ArrayView<float> y_band = y->View(band, ch);
+      const float scale = 0.2f + 0.05f * ch;
+      for (size_t k = 0; k < kBlockSize; ++k) {
+        y_band[k] = scale * x_band[k];
+      }
+    }
+  }
+}
+
 }  // namespace
 
 class EchoRemoverMultiChannel
@@ -212,4 +245,92 @@ TEST(EchoRemover, BasicEchoRemoval) {
   }
 }
 
+// Verifies that processing the capture channels on several threads produces
+// the same output as processing them serially.
+TEST(EchoRemover, MultiThreadedProcessingIsBitExact) {
+  constexpr int kRate = 48000;
+  constexpr size_t kNumRenderChannels = 2;
+  constexpr size_t kNumCaptureChannels = 8;
+  constexpr int kNumBlocksToProcess = 300;
+  const EchoCanceller3Config config;
+  std::optional<DelayEstimate> delay_estimate;
+  EchoPathVariability echo_path_variability(
+      false, EchoPathVariability::DelayAdjustment::kNone, false);
+
+  std::vector<std::vector<float>> outputs;
+  for (int num_threads : {1, 3, 8}) {
+    SCOPED_TRACE(num_threads);
+    std::unique_ptr<EchoRemover> remover =
+        EchoRemover::Create(CreateEnvironmentWithThreads(num_threads), config,
+                            kRate, kNumRenderChannels, kNumCaptureChannels);
+    std::unique_ptr<RenderDelayBuffer> render_buffer(
+        RenderDelayBuffer::Create(config, kRate, kNumRenderChannels));
+    Random random_generator(42U);
+    Block x(NumBandsForRate(kRate), kNumRenderChannels);
+    Block y(NumBandsForRate(kRate), kNumCaptureChannels);
+    std::vector<float> output;
+    for (int k = 0; k < kNumBlocksToProcess; ++k) {
+      GenerateEcho(&random_generator, &x, &y);
+      render_buffer->Insert(x);
+      render_buffer->PrepareCaptureProcessing();
+      remover->ProcessCapture(echo_path_variability, false, delay_estimate,
+                              render_buffer->GetRenderBuffer(), nullptr, &y);
+      for (int band = 0; band < y.NumBands(); ++band) {
+        for (int ch = 0; ch < y.NumChannels(); ++ch) {
+          output.insert(output.end(), y.begin(band, ch), y.end(band, ch));
+        }
+      }
+    }
+    outputs.push_back(std::move(output));
+  }
+  for (size_t k = 1; k < outputs.size(); ++k) {
+    EXPECT_EQ(outputs[0], outputs[k]);
+  }
+}
+
+// Measures how the capture processing time scales with the number of capture
+// channels and threads.
+TEST(EchoRemover, DISABLED_MultiThreadedScalingBenchmark) {
+  constexpr int kRate = 48000;
+  constexpr size_t kNumRenderChannels = 2;
+  constexpr int kNumBlocks = 2000;
+  const EchoCanceller3Config config;
+  std::optional<DelayEstimate> delay_estimate;
+  EchoPathVariability echo_path_variability(
+      false, EchoPathVariability::DelayAdjustment::kNone, false);
+
+  for (size_t num_capture_channels : {1, 2, 4, 8, 16}) {
+    for (int num_threads : {1, 2, 4, 8, 16}) {
+      if (static_cast<size_t>(num_threads) > num_capture_channels) {
+        continue;
+      }
+      std::unique_ptr<EchoRemover> remover = EchoRemover::Create(
+          CreateEnvironmentWithThreads(num_threads), config, kRate,
+          kNumRenderChannels, num_capture_channels);
+      std::unique_ptr<RenderDelayBuffer> render_buffer(
+          RenderDelayBuffer::Create(config, kRate, kNumRenderChannels));
+      Random random_generator(42U);
+      Block x(NumBandsForRate(kRate), kNumRenderChannels);
+      Block y(NumBandsForRate(kRate), num_capture_channels);
+
+      test::PerformanceTimer timer(kNumBlocks);
+      for (int k = 0; k < kNumBlocks; ++k) {
+        GenerateEcho(&random_generator, &x, &y);
+        render_buffer->Insert(x);
+        render_buffer->PrepareCaptureProcessing();
+        timer.StartTimer();
+        remover->ProcessCapture(echo_path_variability, false, delay_estimate,
+                                render_buffer->GetRenderBuffer(), nullptr,
+                                &y);
+        timer.StopTimer();
+      }
+      RTC_LOG(LS_INFO) << "EchoRemover, " << num_capture_channels
+                       << " capture channels, " << num_threads
+                       << " threads: " << timer.GetDurationAverage()
+                       << " +/- " << timer.GetDurationStandardDeviation()
+                       << " us per block";
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -43,6 +43,31 @@ void ErleEstimator::Reset(bool delay_change) {
   }
 }
 
+void ErleEstimator::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  auto erle = subband_erle_estimator_.Erle(/*onset_compensated=*/false);
+  auto erle_log2 = fullband_erle_estimator_.ErleLog2();
+  state->capture_channels.resize(erle.size());
+  for (size_t ch = 0; ch < erle.size(); ++ch) {
+    state->capture_channels[ch].erle = erle[ch];
+    state->capture_channels[ch].fullband_erle_log2 = erle_log2[ch];
+  }
+}
+
+void ErleEstimator::SetWarmStartState(const Aec3WarmStartState& state) {
+  const size_t num_capture_channels = state.capture_channels.size();
+  std::vector<std::array<float, kFftLengthBy2Plus1>> erle(num_capture_channels);
+  std::vector<float> erle_log2(num_capture_channels);
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    erle[ch] = state.capture_channels[ch].erle;
+    erle_log2[ch] = state.capture_channels[ch].fullband_erle_log2;
+  }
+  subband_erle_estimator_.SetErle(erle);
+  fullband_erle_estimator_.SetErleLog2(erle_log2);
+  // The restored estimates are valid, there is no startup phase to wait for.
+  blocks_since_reset_ = startup_phase_length_blocks_;
+}
+
 void ErleEstimator::Update(
     const RenderBuffer& render_buffer,
     ArrayView<const std::vector<std::array<float, kFftLengthBy2Plus1>>>
@@ -25,6 +25,7 @@
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/signal_dependent_erle_estimator.h"
 #include "modules/audio_processing/aec3/subband_erle_estimator.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 
 namespace webrtc {
@@ -42,6 +43,12 @@ class ErleEstimator {
   // Resets the fullband ERLE estimator and the subbands ERLE estimators.
   void Reset(bool delay_change);
 
+  // Stores the subband and fullband ERLE estimates in `state`, and restores
+  // them from it. The signal dependent estimator is not part of the state, it
+  // is rederived from the restored subband estimates.
+  void GetWarmStartState(Aec3WarmStartState* state) const;
+  void SetWarmStartState(const Aec3WarmStartState& state);
+
   // Updates the ERLE estimates.
   void Update(
       const RenderBuffer& render_buffer,
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/fft_arena.h"
+
+namespace webrtc {
+
+FftArena::FftArena(size_t size, size_t num_channels)
+    : data_(size, num_channels) {}
+
+FftArena::FftArena(size_t size, size_t num_channels, Aec3Arena* arena)
+    : data_(size, num_channels, arena) {}
+
+FftArena::~FftArena() = default;
+
+void FftArena::Clear(size_t begin, size_t end) {
+  RTC_DCHECK_LE(begin, end);
+  RTC_DCHECK_LE(end, size());
+  ArrayView<PaddedFftData> data = data_.data();
+  for (size_t k = begin * num_channels(); k < end * num_channels(); ++k) {
+    data[k].Clear();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,86 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_FFT_ARENA_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_FFT_ARENA_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_arena.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// The data of an FftData with the bins padded up to a multiple of 8 and
+// aligned, so that vectorized code can process all bins with full-width
+// aligned loads and without a scalar tail for the Nyquist bin. The padding bins
+// are zero.
+struct alignas(32) PaddedFftData {
+  // Copies the data in src and clears the padding.
+  void Assign(const FftData& src) {
+    std::copy(src.re.begin(), src.re.end(), re.begin());
+    std::copy(src.im.begin(), src.im.end(), im.begin());
+    std::fill(re.begin() + kFftLengthBy2Plus1, re.end(), 0.f);
+    std::fill(im.begin() + kFftLengthBy2Plus1, im.end(), 0.f);
+  }
+
+  // Copies the unpadded data into dst.
+  void CopyTo(FftData* dst) const {
+    RTC_DCHECK(dst);
+    std::copy(re.begin(), re.begin() + kFftLengthBy2Plus1, dst->re.begin());
+    std::copy(im.begin(), im.begin() + kFftLengthBy2Plus1, dst->im.begin());
+  }
+
+  void Clear() {
+    re.fill(0.f);
+    im.fill(0.f);
+  }
+
+  std::array<float, kFftLengthBy2Padded> re;
+  std::array<float, kFftLengthBy2Padded> im;
+};
+
+// Two-dimensional [index][channel] array of PaddedFftData in one contiguous
+// allocation, used for the render FFT buffer and for the partitions of the
+// adaptive filters. Walking the partitions and channels in order thus streams
+// through memory instead of hopping between per-partition heap rows.
+class FftArena {
+ public:
+  FftArena(size_t size, size_t num_channels);
+  // Stores the data in `arena`.
+  FftArena(size_t size, size_t num_channels, Aec3Arena* arena);
+  ~FftArena();
+
+  size_t size() const { return data_.size(); }
+  size_t num_channels() const { return data_.num_channels(); }
+
+  ArrayView<PaddedFftData> operator[](size_t index) { return data_[index]; }
+  ArrayView<const PaddedFftData> operator[](size_t index) const {
+    return data_[index];
+  }
+
+  // Clears the data at the indices [begin, end).
+  void Clear(size_t begin, size_t end);
+  void Clear() { Clear(0, size()); }
+
+ private:
+  Aec3Array2D<PaddedFftData> data_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_FFT_ARENA_H_
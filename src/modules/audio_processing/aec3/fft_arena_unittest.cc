@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/fft_arena.h"
+
+#include <stdint.h>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// Verifies that the padded data round-trips to FftData and that the padding is
+// zeroed.
+TEST(PaddedFftData, AssignAndCopy) {
+  FftData x;
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    x.re[k] = k + 1.f;
+    x.im[k] = -2.f * k;
+  }
+  PaddedFftData padded;
+  padded.re.fill(7.f);
+  padded.im.fill(7.f);
+  padded.Assign(x);
+  for (size_t k = kFftLengthBy2Plus1; k < kFftLengthBy2Padded; ++k) {
+    EXPECT_EQ(0.f, padded.re[k]);
+    EXPECT_EQ(0.f, padded.im[k]);
+  }
+
+  FftData y;
+  y.Clear();
+  padded.CopyTo(&y);
+  EXPECT_EQ(x.re, y.re);
+  EXPECT_EQ(x.im, y.im);
+}
+
+// Verifies the layout assumed by the vectorized filter code.
+TEST(FftArena, Layout) {
+  static_assert(kFftLengthBy2Padded % 8 == 0, "");
+  static_assert(kFftLengthBy2Padded >= kFftLengthBy2Plus1, "");
+  static_assert(
+      sizeof(PaddedFftData) == 2 * kFftLengthBy2Padded * sizeof(float), "");
+
+  for (size_t num_channels : {1, 2, 8}) {
+    FftArena arena(5, num_channels);
+    EXPECT_EQ(5u, arena.size());
+    EXPECT_EQ(num_channels, arena.num_channels());
+    const PaddedFftData* const first = &arena[0][0];
+    for (size_t index = 0; index < arena.size(); ++index) {
+      ASSERT_EQ(num_channels, arena[index].size());
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        const PaddedFftData& data = arena[index][ch];
+        EXPECT_EQ(first + index * num_channels + ch, &data);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data.re.data()) % 32);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(data.im.data()) % 32);
+        for (size_t k = 0; k < kFftLengthBy2Padded; ++k) {
+          EXPECT_EQ(0.f, data.re[k]);
+          EXPECT_EQ(0.f, data.im[k]);
+        }
+      }
+    }
+  }
+}
+
+TEST(FftArena, ClearRange) {
+  FftArena arena(4, 2);
+  for (size_t index = 0; index < arena.size(); ++index) {
+    for (PaddedFftData& data : arena[index]) {
+      data.re.fill(1.f);
+      data.im.fill(1.f);
+    }
+  }
+  arena.Clear(1, 3);
+  for (size_t index = 0; index < arena.size(); ++index) {
+    const float expected = index == 1 || index == 2 ? 0.f : 1.f;
+    for (const PaddedFftData& data : arena[index]) {
+      EXPECT_EQ(expected, data.re[0]);
+      EXPECT_EQ(expected, data.im[kFftLengthBy2Padded - 1]);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -13,15 +13,15 @@
 namespace webrtc {
 
 FftBuffer::FftBuffer(size_t size, size_t num_channels)
-    : size(static_cast<int>(size)),
-      buffer(size, std::vector<FftData>(num_channels)) {
-  for (auto& block : buffer) {
-    for (auto& channel_fft_data : block) {
-      channel_fft_data.Clear();
-    }
-  }
-}
+    : size(static_cast<int>(size)), buffer(size, num_channels) {}
+
+FftBuffer::FftBuffer(size_t size, size_t num_channels, Aec3Arena* arena)
+    : size(static_cast<int>(size)), buffer(size, num_channels, arena) {}
 
 FftBuffer::~FftBuffer() = default;
 
+size_t FftBuffer::ArenaBytes(size_t size, size_t num_channels) {
+  return Aec3Arena::RequiredBytes<PaddedFftData>(size * num_channels);
+}
+
 }  // namespace webrtc
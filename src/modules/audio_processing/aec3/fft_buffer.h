@@ -13,19 +13,23 @@
 
 #include <stddef.h>
 
-#include <vector>
-
-#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/aec3_arena.h"
+#include "modules/audio_processing/aec3/fft_arena.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-// Struct for bundling a circular buffer of FftData objects together with the
+// Struct for bundling a circular buffer of padded FFT data together with the
 // read and write indices.
 struct FftBuffer {
   FftBuffer(size_t size, size_t num_channels);
+  // Stores the FFT data in `arena`.
+  FftBuffer(size_t size, size_t num_channels, Aec3Arena* arena);
   ~FftBuffer();
 
+  // Returns the number of arena bytes needed by the buffer.
+  static size_t ArenaBytes(size_t size, size_t num_channels);
+
   int IncIndex(int index) const {
     RTC_DCHECK_EQ(buffer.size(), static_cast<size_t>(size));
     return index < size - 1 ? index + 1 : 0;
@@ -50,7 +54,7 @@ struct FftBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<std::vector<FftData>> buffer;
+  FftArena buffer;
   int write = 0;
   int read = 0;
 };
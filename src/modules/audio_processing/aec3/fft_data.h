@@ -64,6 +64,7 @@ struct FftData {
                                         im[kFftLengthBy2] * im[kFftLengthBy2];
       } break;
       case Aec3Optimization::kAvx2:
+      case Aec3Optimization::kAvx512:
         SpectrumAVX2(power_spectrum);
         break;
 #endif
@@ -56,6 +56,14 @@ void FullBandErleEstimator::Reset() {
             hold_counters_instantaneous_erle_.end(), 0);
 }
 
+void FullBandErleEstimator::SetErleLog2(ArrayView<const float> erle_log2) {
+  const size_t num_capture_channels =
+      std::min(erle_log2.size(), erle_time_domain_log2_.size());
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    erle_time_domain_log2_[ch] = std::max(erle_log2[ch], min_erle_log2_);
+  }
+}
+
 void FullBandErleEstimator::Update(
     ArrayView<const float> X2,
     ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
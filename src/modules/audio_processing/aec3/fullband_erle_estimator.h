@@ -32,6 +32,9 @@ class FullBandErleEstimator {
   // Resets the ERLE estimator.
   void Reset();
 
+  // Sets the per capture channel fullband ERLE estimates in log2 units.
+  void SetErleLog2(ArrayView<const float> erle_log2);
+
   // Updates the ERLE estimator.
   void Update(ArrayView<const float> X2,
               ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -47,6 +50,9 @@ class FullBandErleEstimator {
     return min_erle;
   }
 
+  // Returns the fullband ERLE estimates in log2 units per capture channel.
+  ArrayView<const float> ErleLog2() const { return erle_time_domain_log2_; }
+
   // Returns an estimation of the current linear filter quality. It returns a
   // float number between 0 and 1 mapping 1 to the highest possible quality.
   ArrayView<const std::optional<float>> GetInstLinearQualityEstimates() const {
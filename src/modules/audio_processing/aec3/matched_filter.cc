@@ -24,10 +24,12 @@
 #include <algorithm>
 #include <cstddef>
 #include <initializer_list>
+#include <memory>
 #include <optional>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/decimated_correlator.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -40,6 +42,10 @@ namespace {
 // equal to 4.
 constexpr int kAccumulatedErrorSubSampleRate = 4;
 
+// Number of updates after a full reset during which all filter sections are
+// updated in the coarse-to-fine search.
+constexpr int kNumFullSearchUpdatesAfterReset = webrtc::kNumBlocksPerSecond / 2;
+
 void UpdateAccumulatedError(
     const webrtc::ArrayView<const float> instantaneous_accumulated_error,
     const webrtc::ArrayView<float> accumulated_error,
@@ -603,6 +609,31 @@ MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
                              float smoothing_slow,
                              float matching_filter_threshold,
                              bool detect_pre_echo)
+    : MatchedFilter(data_dumper,
+                    optimization,
+                    sub_block_size,
+                    window_size_sub_blocks,
+                    num_matched_filters,
+                    alignment_shift_sub_blocks,
+                    excitation_limit,
+                    smoothing_fast,
+                    smoothing_slow,
+                    matching_filter_threshold,
+                    detect_pre_echo,
+                    /*coarse_to_fine_search=*/false) {}
+
+MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
+                             Aec3Optimization optimization,
+                             size_t sub_block_size,
+                             size_t window_size_sub_blocks,
+                             int num_matched_filters,
+                             size_t alignment_shift_sub_blocks,
+                             float excitation_limit,
+                             float smoothing_fast,
+                             float smoothing_slow,
+                             float matching_filter_threshold,
+                             bool detect_pre_echo,
+                             bool coarse_to_fine_search)
     : data_dumper_(data_dumper),
       optimization_(optimization),
       sub_block_size_(sub_block_size),
@@ -615,7 +646,16 @@ MatchedFilter::MatchedFilter(ApmDataDumper* data_dumper,
       smoothing_fast_(smoothing_fast),
       smoothing_slow_(smoothing_slow),
       matching_filter_threshold_(matching_filter_threshold),
-      detect_pre_echo_(detect_pre_echo) {
+      detect_pre_echo_(detect_pre_echo),
+      coarse_correlator_(
+          coarse_to_fine_search
+              ? std::make_unique<DecimatedCorrelator>(
+                    optimization_, sub_block_size_,
+                    (num_matched_filters - 1) * filter_intra_lag_shift_ +
+                        window_size_sub_blocks * sub_block_size_)
+              : nullptr),
+      active_filters_(num_matched_filters, true),
+      num_full_search_updates_left_(kNumFullSearchUpdatesAfterReset) {
   RTC_DCHECK(data_dumper);
   RTC_DCHECK_LT(0, window_size_sub_blocks);
   RTC_DCHECK((kBlockSize % sub_block_size) == 0);
@@ -651,6 +691,35 @@ void MatchedFilter::Reset(bool full_reset) {
       std::fill(e.begin(), e.end(), 1.0f);
     }
     number_pre_echo_updates_ = 0;
+    if (coarse_correlator_) {
+      coarse_correlator_->Reset();
+      num_full_search_updates_left_ = kNumFullSearchUpdatesAfterReset;
+    }
+  }
+}
+
+void MatchedFilter::SelectActiveFilters(
+    const DownsampledRenderBuffer& render_buffer,
+    ArrayView<const float> capture) {
+  coarse_correlator_->Update(render_buffer, capture);
+  const std::optional<size_t> coarse_lag = coarse_correlator_->PeakLag();
+  if (num_full_search_updates_left_ > 0 || !coarse_lag) {
+    num_full_search_updates_left_ =
+        std::max(num_full_search_updates_left_ - 1, 0);
+    std::fill(active_filters_.begin(), active_filters_.end(), true);
+    return;
+  }
+
+  // Update the one or two overlapping sections covering the coarse lag, and
+  // the section that last produced the best lag.
+  const size_t window_size = filters_[0].size();
+  size_t alignment_shift = 0;
+  for (size_t n = 0; n < filters_.size(); ++n) {
+    active_filters_[n] =
+        (*coarse_lag >= alignment_shift &&
+         *coarse_lag < alignment_shift + window_size) ||
+        static_cast<int>(n) == last_detected_best_lag_filter_;
+    alignment_shift += filter_intra_lag_shift_;
   }
 }
 
@@ -672,6 +741,10 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
     error_sum_anchor += y[k] * y[k];
   }
 
+  if (coarse_correlator_) {
+    SelectActiveFilters(render_buffer, y);
+  }
+
   // Apply all matched filters.
   float winner_error_sum = error_sum_anchor;
   winner_lag_ = std::nullopt;
@@ -681,6 +754,11 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
   const int num_filters = static_cast<int>(filters_.size());
   int winner_index = -1;
   for (int n = 0; n < num_filters; ++n) {
+    if (!active_filters_[n]) {
+      previous_lag_estimate = std::nullopt;
+      alignment_shift += filter_intra_lag_shift_;
+      continue;
+    }
     float error_sum = 0.f;
     bool filters_updated = false;
     const bool compute_pre_echo =
@@ -704,6 +782,12 @@ void MatchedFilter::Update(const DownsampledRenderBuffer& render_buffer,
             filters_[n], &filters_updated, &error_sum, compute_pre_echo,
             instantaneous_accumulated_error_, scratch_memory_);
         break;
+      case Aec3Optimization::kAvx512:
+        aec3::MatchedFilterCore_AVX512(
+            x_start_index, x2_sum_threshold, smoothing, render_buffer.buffer, y,
+            filters_[n], &filters_updated, &error_sum, compute_pre_echo,
+            instantaneous_accumulated_error_, scratch_memory_);
+        break;
 #endif
 #if defined(WEBRTC_HAS_NEON)
       case Aec3Optimization::kNeon:
@@ -13,6 +13,7 @@
 
 #include <stddef.h>
 
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -24,6 +25,7 @@
 namespace webrtc {
 
 class ApmDataDumper;
+class DecimatedCorrelator;
 struct DownsampledRenderBuffer;
 
 namespace aec3 {
@@ -73,6 +75,20 @@ void MatchedFilterCore_AVX2(size_t x_start_index,
                             ArrayView<float> accumulated_error,
                             ArrayView<float> scratch_memory);
 
+// Filter core for the matched filter that is optimized for AVX-512. The
+// accumulated error is computed by the AVX2 filter core.
+void MatchedFilterCore_AVX512(size_t x_start_index,
+                              float x2_sum_threshold,
+                              float smoothing,
+                              ArrayView<const float> x,
+                              ArrayView<const float> y,
+                              ArrayView<float> h,
+                              bool* filters_updated,
+                              float* error_sum,
+                              bool compute_accumulated_error,
+                              ArrayView<float> accumulated_error,
+                              ArrayView<float> scratch_memory);
+
 #endif
 
 // Filter core for the matched filter.
@@ -118,6 +134,23 @@ class MatchedFilter {
                 float matching_filter_threshold,
                 bool detect_pre_echo);
 
+  // If `coarse_to_fine_search` is set, a decimated correlation over the whole
+  // lag range selects the filter sections to adapt, and only the sections
+  // covering its peak and the section of the last detected lag are updated.
+  // All sections are updated during a period after a full reset.
+  MatchedFilter(ApmDataDumper* data_dumper,
+                Aec3Optimization optimization,
+                size_t sub_block_size,
+                size_t window_size_sub_blocks,
+                int num_matched_filters,
+                size_t alignment_shift_sub_blocks,
+                float excitation_limit,
+                float smoothing_fast,
+                float smoothing_slow,
+                float matching_filter_threshold,
+                bool detect_pre_echo,
+                bool coarse_to_fine_search);
+
   MatchedFilter() = delete;
   MatchedFilter(const MatchedFilter&) = delete;
   MatchedFilter& operator=(const MatchedFilter&) = delete;
@@ -148,6 +181,10 @@ class MatchedFilter {
                            size_t downsampling_factor) const;
 
  private:
+  // Selects the filter sections to update in the coarse-to-fine search.
+  void SelectActiveFilters(const DownsampledRenderBuffer& render_buffer,
+                           ArrayView<const float> capture);
+
   void Dump();
 
   ApmDataDumper* const data_dumper_;
@@ -168,6 +205,9 @@ class MatchedFilter {
   const float smoothing_slow_;
   const float matching_filter_threshold_;
   const bool detect_pre_echo_;
+  const std::unique_ptr<DecimatedCorrelator> coarse_correlator_;
+  std::vector<bool> active_filters_;
+  int num_full_search_updates_left_ = 0;
 };
 
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 // Defines WEBRTC_ARCH_X86_FAMILY, used below.
@@ -35,6 +36,8 @@
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
@@ -60,6 +63,10 @@ constexpr size_t kAlignmentShiftSubBlocks = kWindowSizeSubBlocks * 3 / 4;
 
 class MatchedFilterTest : public ::testing::TestWithParam<bool> {};
 
+// Parameterized on pre-echo detection and on the coarse-to-fine search.
+class MatchedFilterSearchTest
+    : public ::testing::TestWithParam<std::tuple<bool, bool>> {};
+
 #if defined(WEBRTC_HAS_NEON)
 // Verifies that the optimized methods for NEON are similar to their reference
 // counterparts.
@@ -229,6 +236,59 @@ TEST_P(MatchedFilterTest, TestAvx2Optimizations) {
   }
 }
 
+TEST_P(MatchedFilterTest, TestAvx512Optimizations) {
+  bool use_avx512 = DetectOptimization() == Aec3Optimization::kAvx512;
+  const bool kComputeAccumulatederror = GetParam();
+  if (use_avx512) {
+    Random random_generator(42U);
+    constexpr float kSmoothing = 0.7f;
+    // Without accumulated error, the filter length need not be a multiple of
+    // the vector width. The accumulated error falls back to the AVX2 kernel,
+    // which requires it.
+    const size_t filter_length = kComputeAccumulatederror ? 512 : 500;
+    for (auto down_sampling_factor : kDownSamplingFactors) {
+      const size_t sub_block_size = kBlockSize / down_sampling_factor;
+      std::vector<float> x(2000);
+      RandomizeSampleVector(&random_generator, x);
+      std::vector<float> y(sub_block_size);
+      std::vector<float> h_AVX512(filter_length);
+      std::vector<float> h(filter_length);
+      std::vector<float> accumulated_error(filter_length / 4);
+      std::vector<float> accumulated_error_AVX512(filter_length / 4);
+      std::vector<float> scratch_memory(filter_length);
+      int x_index = 0;
+      for (int k = 0; k < 1000; ++k) {
+        RandomizeSampleVector(&random_generator, y);
+        bool filters_updated = false;
+        float error_sum = 0.f;
+        bool filters_updated_AVX512 = false;
+        float error_sum_AVX512 = 0.f;
+        MatchedFilterCore_AVX512(x_index, h.size() * 150.f * 150.f, kSmoothing,
+                                 x, y, h_AVX512, &filters_updated_AVX512,
+                                 &error_sum_AVX512, kComputeAccumulatederror,
+                                 accumulated_error_AVX512, scratch_memory);
+        MatchedFilterCore(x_index, h.size() * 150.f * 150.f, kSmoothing, x, y,
+                          h, &filters_updated, &error_sum,
+                          kComputeAccumulatederror, accumulated_error);
+        EXPECT_EQ(filters_updated, filters_updated_AVX512);
+        EXPECT_NEAR(error_sum, error_sum_AVX512, error_sum / 100000.f);
+        for (size_t j = 0; j < h.size(); ++j) {
+          EXPECT_NEAR(h[j], h_AVX512[j], 0.00001f);
+        }
+        for (size_t j = 0; j < accumulated_error.size(); j += 4) {
+          float difference =
+              std::abs(accumulated_error[j] - accumulated_error_AVX512[j]);
+          float relative_difference = accumulated_error[j] > 0
+                                          ? difference / accumulated_error[j]
+                                          : difference;
+          EXPECT_NEAR(relative_difference, 0.0f, 0.00001f);
+        }
+        x_index = (x_index + sub_block_size) % x.size();
+      }
+    }
+  }
+}
+
 #endif
 
 // Verifies that the (optimized) function MaxSquarePeakIndex() produces output
@@ -255,8 +315,9 @@ TEST(MatchedFilter, MaxSquarePeakIndex) {
 
 // Verifies that the matched filter produces proper lag estimates for
 // artificially delayed signals.
-TEST_P(MatchedFilterTest, LagEstimation) {
-  const bool kDetectPreEcho = GetParam();
+TEST_P(MatchedFilterSearchTest, LagEstimation) {
+  const bool kDetectPreEcho = std::get<0>(GetParam());
+  const bool kCoarseToFineSearch = std::get<1>(GetParam());
   Random random_generator(42U);
   constexpr size_t kNumChannels = 1;
   constexpr int kSampleRateHz = 48000;
@@ -282,7 +343,8 @@ TEST_P(MatchedFilterTest, LagEstimation) {
           kWindowSizeSubBlocks, kNumMatchedFilters, kAlignmentShiftSubBlocks,
           150, config.delay.delay_estimate_smoothing,
           config.delay.delay_estimate_smoothing_delay_found,
-          config.delay.delay_candidate_detection_threshold, kDetectPreEcho);
+          config.delay.delay_candidate_detection_threshold, kDetectPreEcho,
+          kCoarseToFineSearch);
 
       std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
           RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
@@ -326,8 +388,9 @@ TEST_P(MatchedFilterTest, LagEstimation) {
 }
 
 // Test the pre echo estimation.
-TEST_P(MatchedFilterTest, PreEchoEstimation) {
-  const bool kDetectPreEcho = GetParam();
+TEST_P(MatchedFilterSearchTest, PreEchoEstimation) {
+  const bool kDetectPreEcho = std::get<0>(GetParam());
+  const bool kCoarseToFineSearch = std::get<1>(GetParam());
   Random random_generator(42U);
   constexpr size_t kNumChannels = 1;
   constexpr int kSampleRateHz = 48000;
@@ -357,7 +420,8 @@ TEST_P(MatchedFilterTest, PreEchoEstimation) {
         kWindowSizeSubBlocks, kNumMatchedFilters, kAlignmentShiftSubBlocks, 150,
         config.delay.delay_estimate_smoothing,
         config.delay.delay_estimate_smoothing_delay_found,
-        config.delay.delay_candidate_detection_threshold, kDetectPreEcho);
+        config.delay.delay_candidate_detection_threshold, kDetectPreEcho,
+        kCoarseToFineSearch);
     std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
         RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
     // Analyze the correlation between render and capture.
@@ -499,7 +563,125 @@ TEST_P(MatchedFilterTest, LagNotUpdatedForLowLevelRender) {
   }
 }
 
+// Verifies that the coarse-to-fine search follows a change of the delay into
+// another filter section, both with and without a full reset at the change.
+TEST(MatchedFilter, CoarseToFineSearchFollowsDelayChange) {
+  constexpr size_t kNumChannels = 1;
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  for (bool full_reset : {false, true}) {
+    SCOPED_TRACE(full_reset);
+    Random random_generator(42U);
+    ApmDataDumper data_dumper(0);
+    EchoCanceller3Config config;
+    config.delay.down_sampling_factor = kDownSamplingFactor;
+    config.delay.num_filters = kNumMatchedFilters;
+    MatchedFilter filter(
+        &data_dumper, DetectOptimization(), kSubBlockSize, kWindowSizeSubBlocks,
+        kNumMatchedFilters, kAlignmentShiftSubBlocks, 150,
+        config.delay.delay_estimate_smoothing,
+        config.delay.delay_estimate_smoothing_delay_found,
+        config.delay.delay_candidate_detection_threshold,
+        /*detect_pre_echo=*/true, /*coarse_to_fine_search=*/true);
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+    Decimator capture_decimator(kDownSamplingFactor);
+    Block render(/*num_bands=*/1, kNumChannels);
+    std::vector<float> capture(kBlockSize, 0.f);
+
+    bool first_block = true;
+    for (size_t delay_samples : {200, 3000}) {
+      SCOPED_TRACE(delay_samples);
+      DelayBuffer<float> signal_delay_buffer(kDownSamplingFactor *
+                                             delay_samples);
+      if (full_reset) {
+        filter.Reset(/*full_reset=*/true);
+      }
+      for (size_t k = 0; k < (600 + delay_samples / kSubBlockSize); ++k) {
+        RandomizeSampleVector(&random_generator, render.View(0, 0));
+        signal_delay_buffer.Delay(render.View(0, 0), capture);
+        render_delay_buffer->Insert(render);
+        if (first_block) {
+          render_delay_buffer->Reset();
+          first_block = false;
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        std::array<float, kBlockSize> downsampled_capture_data;
+        ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                             kSubBlockSize);
+        capture_decimator.Decimate(capture, downsampled_capture);
+        filter.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      downsampled_capture, /*use_slow_smoothing=*/false);
+      }
+
+      auto lag_estimate = filter.GetBestLagEstimate();
+      ASSERT_TRUE(lag_estimate.has_value());
+      EXPECT_EQ(delay_samples, lag_estimate->lag);
+    }
+  }
+}
+
+// Measures the cost of the full and the coarse-to-fine search for different
+// numbers of filter sections.
+TEST(MatchedFilter, DISABLED_CoarseToFineSearchBenchmark) {
+  constexpr size_t kNumChannels = 1;
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  constexpr int kNumBlocks = 2000;
+  for (int num_filters : {5, 10, 25, 50}) {
+    for (bool coarse_to_fine_search : {false, true}) {
+      Random random_generator(42U);
+      ApmDataDumper data_dumper(0);
+      EchoCanceller3Config config;
+      config.delay.down_sampling_factor = kDownSamplingFactor;
+      config.delay.num_filters = num_filters;
+      MatchedFilter filter(
+          &data_dumper, DetectOptimization(), kSubBlockSize,
+          kWindowSizeSubBlocks, num_filters, kAlignmentShiftSubBlocks, 150,
+          config.delay.delay_estimate_smoothing,
+          config.delay.delay_estimate_smoothing_delay_found,
+          config.delay.delay_candidate_detection_threshold,
+          config.delay.detect_pre_echo, coarse_to_fine_search);
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, kNumChannels));
+      Decimator capture_decimator(kDownSamplingFactor);
+      DelayBuffer<float> signal_delay_buffer(kDownSamplingFactor * 200);
+      Block render(/*num_bands=*/1, kNumChannels);
+      std::vector<float> capture(kBlockSize, 0.f);
+
+      test::PerformanceTimer timer(kNumBlocks);
+      for (int k = 0; k < kNumBlocks; ++k) {
+        RandomizeSampleVector(&random_generator, render.View(0, 0));
+        signal_delay_buffer.Delay(render.View(0, 0), capture);
+        render_delay_buffer->Insert(render);
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        std::array<float, kBlockSize> downsampled_capture_data;
+        ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                             kSubBlockSize);
+        capture_decimator.Decimate(capture, downsampled_capture);
+        timer.StartTimer();
+        filter.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      downsampled_capture, /*use_slow_smoothing=*/false);
+        timer.StopTimer();
+      }
+      RTC_LOG(LS_INFO) << "MatchedFilter, " << num_filters << " filters, "
+                       << (coarse_to_fine_search ? "coarse-to-fine" : "full")
+                       << " search: " << timer.GetDurationAverage() << " +/- "
+                       << timer.GetDurationStandardDeviation()
+                       << " us per block";
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(_, MatchedFilterTest, testing::Values(true, false));
+INSTANTIATE_TEST_SUITE_P(_,
+                         MatchedFilterSearchTest,
+                         testing::Combine(testing::Bool(), testing::Bool()));
 
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
@@ -48,6 +48,14 @@ class MockEchoRemover : public EchoRemover {
               SetCaptureOutputUsage,
               (bool capture_output_used),
               (override));
+  MOCK_METHOD(void,
+              GetWarmStartState,
+              (Aec3WarmStartState * state),
+              (const, override));
+  MOCK_METHOD(void,
+              SetWarmStartState,
+              (const Aec3WarmStartState& state),
+              (override));
 };
 
 }  // namespace test
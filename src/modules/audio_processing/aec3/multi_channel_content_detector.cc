@@ -12,6 +12,7 @@
 
 #include <cmath>
 
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/metrics.h"
 
@@ -42,6 +43,24 @@ bool HasStereoContent(const std::vector<std::vector<std::vector<float>>>& frame,
   return false;
 }
 
+bool HasStereoContent(const RenderFrameView& frame,
+                      float detection_threshold) {
+  if (frame.NumChannels() < 2) {
+    return false;
+  }
+
+  for (size_t band = 0; band < frame.NumBands(); ++band) {
+    ArrayView<const float> left = frame.View(band, /*channel=*/0);
+    ArrayView<const float> right = frame.View(band, /*channel=*/1);
+    for (size_t k = 0; k < left.size(); ++k) {
+      if (std::fabs(left[k] - right[k]) > detection_threshold) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 // In order to avoid logging metrics for very short lifetimes that are unlikely
 // to reflect real calls and that may dilute the "real" data, logging is limited
 // to lifetimes of at leats 5 seconds.
@@ -112,11 +131,23 @@ bool MultiChannelContentDetector::UpdateDetection(
                   persistent_multichannel_content_detected_);
     return false;
   }
+  return UpdateDetectionState(HasStereoContent(frame, detection_threshold_));
+}
+
+bool MultiChannelContentDetector::UpdateDetection(
+    const RenderFrameView& frame) {
+  if (!detect_stereo_content_) {
+    RTC_DCHECK_EQ(frame.NumChannels() > 1,
+                  persistent_multichannel_content_detected_);
+    return false;
+  }
+  return UpdateDetectionState(HasStereoContent(frame, detection_threshold_));
+}
 
+bool MultiChannelContentDetector::UpdateDetectionState(
+    bool stereo_detected_in_frame) {
   const bool previous_persistent_multichannel_content_detected =
       persistent_multichannel_content_detected_;
-  const bool stereo_detected_in_frame =
-      HasStereoContent(frame, detection_threshold_);
 
   consecutive_frames_with_stereo_ =
       stereo_detected_in_frame ? consecutive_frames_with_stereo_ + 1 : 0;
@@ -18,6 +18,8 @@
 #include <optional>
 #include <vector>
 
+#include "modules/audio_processing/aec3/render_transfer_queue.h"
+
 namespace webrtc {
 
 // Analyzes audio content to determine whether the contained audio is proper
@@ -42,6 +44,7 @@ class MultiChannelContentDetector {
   // detected.
   bool UpdateDetection(
       const std::vector<std::vector<std::vector<float>>>& frame);
+  bool UpdateDetection(const RenderFrameView& frame);
 
   bool IsProperMultiChannelContentDetected() const {
     return persistent_multichannel_content_detected_;
@@ -52,6 +55,10 @@ class MultiChannelContentDetector {
   }
 
  private:
+  // Updates the detection state with the result of the comparison of the
+  // channels of a frame.
+  bool UpdateDetectionState(bool stereo_detected_in_frame);
+
   // Tracks and logs metrics for the amount of multichannel content detected.
   class MetricsLogger {
    public:
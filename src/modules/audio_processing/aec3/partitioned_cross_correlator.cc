@@ -0,0 +1,301 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/partitioned_cross_correlator.h"
+
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Smoothing constant for the recursive averaging of the spectra, giving a
+// time constant of 100 updates.
+constexpr float kSmoothing = 0.01f;
+
+// Regularization of the phase transform weights relative to the mean
+// magnitude of the cross-spectrum, which limits the amplification of the bins
+// without signal content.
+constexpr float kRegularization = 0.1f;
+
+// Number of partitions that are transformed to the lag domain per update.
+constexpr size_t kNumPartitionsAnalyzedPerUpdate = 4;
+
+// Number of updates of all partitions before the averaged cross-spectra are
+// considered reliable. The phase transform turns the few cross-spectra
+// averaged before that into sharp peaks, even for uncorrelated signals.
+constexpr int kNumUpdatesBeforeReporting = static_cast<int>(2.f / kSmoothing);
+
+// Required ratio between the energy of the correlation peak and the mean of
+// the squared correlation over all lags for the peak to be reliable.
+constexpr float kPeakToAverageThreshold = 50.f;
+
+}  // namespace
+
+PartitionedCrossCorrelator::PartitionedCrossCorrelator(
+    Aec3Optimization optimization,
+    size_t sub_block_size,
+    size_t max_lag,
+    float excitation_limit)
+    : optimization_(optimization),
+      sub_block_size_(sub_block_size),
+      max_lag_(max_lag),
+      render_spectra_per_partition_(kFftLengthBy2 / sub_block_size),
+      x2_sum_threshold_(kFftLength * excitation_limit * excitation_limit),
+      fft_(optimization),
+      render_spectra_(((max_lag + kFftLengthBy2 - 1) / kFftLengthBy2 - 1) *
+                          render_spectra_per_partition_ +
+                      1),
+      cross_spectra_((max_lag + kFftLengthBy2 - 1) / kFftLengthBy2),
+      partition_peaks_(cross_spectra_.size()),
+      partition_peak_lags_(cross_spectra_.size()),
+      partition_energies_(cross_spectra_.size()) {
+  RTC_DCHECK_LT(0, sub_block_size);
+  RTC_DCHECK_EQ(0, kFftLengthBy2 % sub_block_size);
+  RTC_DCHECK_LT(0, max_lag);
+  Reset();
+}
+
+PartitionedCrossCorrelator::~PartitionedCrossCorrelator() = default;
+
+void PartitionedCrossCorrelator::Reset() {
+  num_render_spectra_ = 0;
+  expected_render_read_ = std::nullopt;
+  for (FftData& G : cross_spectra_) {
+    G.Clear();
+  }
+  std::fill(partition_peaks_.begin(), partition_peaks_.end(), 0.f);
+  std::fill(partition_peak_lags_.begin(), partition_peak_lags_.end(), 0);
+  std::fill(partition_energies_.begin(), partition_energies_.end(), 0.f);
+  next_partition_to_analyze_ = 0;
+  all_partitions_analyzed_ = false;
+  num_updates_ = 0;
+  reported_lag_estimate_ = std::nullopt;
+}
+
+void PartitionedCrossCorrelator::Update(
+    const DownsampledRenderBuffer& render_buffer,
+    ArrayView<const float> capture) {
+  RTC_DCHECK_EQ(sub_block_size_, capture.size());
+  RTC_DCHECK_LE(kFftLength, render_buffer.buffer.size());
+  reported_lag_estimate_ = std::nullopt;
+
+  // The stored render spectra assume that the render buffer is read one
+  // sub-block further for each update. Any other jump in the render buffer
+  // changes the alignment with the capture signal.
+  if (expected_render_read_ && *expected_render_read_ != render_buffer.read) {
+    Reset();
+  }
+  expected_render_read_ = render_buffer.OffsetIndex(
+      render_buffer.read, -static_cast<int>(sub_block_size_));
+
+  // Compute the spectrum of the kFftLength most recent render samples in time
+  // order. The render buffer is stored in reverse time order, with the sample
+  // that aligns with the last capture sample at the read index.
+  std::array<float, kFftLength> x;
+  ArrayView<const float> buffer = render_buffer.buffer;
+  size_t x_index = render_buffer.read;
+  float x2_sum = 0.f;
+  for (size_t k = kFftLength; k > 0; --k) {
+    x[k - 1] = buffer[x_index];
+    x2_sum += x[k - 1] * x[k - 1];
+    x_index = x_index < buffer.size() - 1 ? x_index + 1 : 0;
+  }
+  render_spectra_index_ = render_spectra_index_ > 0
+                              ? render_spectra_index_ - 1
+                              : render_spectra_.size() - 1;
+  FftData& X = render_spectra_[render_spectra_index_];
+  fft_.Fft(&x, &X);
+  num_render_spectra_ = std::min(num_render_spectra_ + 1,
+                                 render_spectra_.size());
+
+  // The correlation is only updated when there is sufficient render
+  // excitation.
+  if (x2_sum < x2_sum_threshold_) {
+    return;
+  }
+
+  // Compute the spectrum of the capture sub-block, zero-padded in front to
+  // align its last sample with the last render sample. This makes the
+  // circular correlation with the render frame equal to the linear
+  // correlation for the kFftLengthBy2 lags of each partition.
+  std::array<float, kFftLength> y;
+  std::fill(y.begin(), y.end() - sub_block_size_, 0.f);
+  std::copy(capture.begin(), capture.end(), y.end() - sub_block_size_);
+  FftData Y;
+  fft_.Fft(&y, &Y);
+
+  UpdateCrossSpectra(Y);
+  // The last partition is updated once the render spectra at its lag exist.
+  if (num_render_spectra_ == render_spectra_.size()) {
+    ++num_updates_;
+  }
+
+  for (size_t k = 0;
+       k < std::min(kNumPartitionsAnalyzedPerUpdate, cross_spectra_.size());
+       ++k) {
+    AnalyzePartition(next_partition_to_analyze_);
+    if (++next_partition_to_analyze_ == cross_spectra_.size()) {
+      next_partition_to_analyze_ = 0;
+      all_partitions_analyzed_ = true;
+    }
+  }
+  if (!all_partitions_analyzed_ || num_updates_ < kNumUpdatesBeforeReporting) {
+    return;
+  }
+
+  // Report the lag of the highest peak if it stands out from the correlation
+  // over all lags.
+  const size_t peak_partition = std::distance(
+      partition_peaks_.begin(),
+      std::max_element(partition_peaks_.begin(), partition_peaks_.end()));
+  const float peak = partition_peaks_[peak_partition];
+  const float mean_energy =
+      std::accumulate(partition_energies_.begin(), partition_energies_.end(),
+                      0.f) /
+      max_lag_;
+  if (mean_energy > 0.f && peak > kPeakToAverageThreshold * mean_energy) {
+    const size_t lag = partition_peak_lags_[peak_partition];
+    reported_lag_estimate_ = MatchedFilter::LagEstimate(lag, lag);
+  }
+}
+
+void PartitionedCrossCorrelator::UpdateCrossSpectra(const FftData& Y) {
+  // Computes G = (1 - kSmoothing) * G + kSmoothing * Y * conj(X) for each
+  // partition, where X is the render spectrum at the partition lag.
+  constexpr float kDecay = 1.f - kSmoothing;
+  const size_t num_render_spectra = render_spectra_.size();
+  for (size_t p = 0; p < cross_spectra_.size(); ++p) {
+    const size_t offset = p * render_spectra_per_partition_;
+    if (offset >= num_render_spectra_) {
+      break;
+    }
+    const FftData& X =
+        render_spectra_[(render_spectra_index_ + offset) % num_render_spectra];
+    FftData& G = cross_spectra_[p];
+    size_t k = 0;
+    switch (optimization_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+      case Aec3Optimization::kSse2:
+      case Aec3Optimization::kAvx2:
+      case Aec3Optimization::kAvx512: {
+        const __m128 decay = _mm_set1_ps(kDecay);
+        const __m128 smoothing = _mm_set1_ps(kSmoothing);
+        for (; k + 4 <= kFftLengthBy2Plus1; k += 4) {
+          const __m128 x_re = _mm_loadu_ps(&X.re[k]);
+          const __m128 x_im = _mm_loadu_ps(&X.im[k]);
+          const __m128 y_re = _mm_loadu_ps(&Y.re[k]);
+          const __m128 y_im = _mm_loadu_ps(&Y.im[k]);
+          const __m128 re = _mm_add_ps(_mm_mul_ps(y_re, x_re),
+                                       _mm_mul_ps(y_im, x_im));
+          const __m128 im = _mm_sub_ps(_mm_mul_ps(y_im, x_re),
+                                       _mm_mul_ps(y_re, x_im));
+          _mm_storeu_ps(&G.re[k],
+                        _mm_add_ps(_mm_mul_ps(decay, _mm_loadu_ps(&G.re[k])),
+                                   _mm_mul_ps(smoothing, re)));
+          _mm_storeu_ps(&G.im[k],
+                        _mm_add_ps(_mm_mul_ps(decay, _mm_loadu_ps(&G.im[k])),
+                                   _mm_mul_ps(smoothing, im)));
+        }
+      } break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+      case Aec3Optimization::kNeon:
+        for (; k + 4 <= kFftLengthBy2Plus1; k += 4) {
+          const float32x4_t x_re = vld1q_f32(&X.re[k]);
+          const float32x4_t x_im = vld1q_f32(&X.im[k]);
+          const float32x4_t y_re = vld1q_f32(&Y.re[k]);
+          const float32x4_t y_im = vld1q_f32(&Y.im[k]);
+          const float32x4_t re =
+              vmlaq_f32(vmulq_f32(y_re, x_re), y_im, x_im);
+          const float32x4_t im =
+              vmlsq_f32(vmulq_f32(y_im, x_re), y_re, x_im);
+          vst1q_f32(&G.re[k], vmlaq_n_f32(vmulq_n_f32(vld1q_f32(&G.re[k]),
+                                                      kDecay),
+                                          re, kSmoothing));
+          vst1q_f32(&G.im[k], vmlaq_n_f32(vmulq_n_f32(vld1q_f32(&G.im[k]),
+                                                      kDecay),
+                                          im, kSmoothing));
+        }
+        break;
+#endif
+      default:
+        break;
+    }
+    for (; k < kFftLengthBy2Plus1; ++k) {
+      const float re = Y.re[k] * X.re[k] + Y.im[k] * X.im[k];
+      const float im = Y.im[k] * X.re[k] - Y.re[k] * X.im[k];
+      G.re[k] = kDecay * G.re[k] + kSmoothing * re;
+      G.im[k] = kDecay * G.im[k] + kSmoothing * im;
+    }
+  }
+}
+
+void PartitionedCrossCorrelator::AnalyzePartition(size_t partition) {
+  // The phase transform divides each bin by the magnitude of the
+  // cross-spectrum, so that only its phase remains.
+  const FftData& G = cross_spectra_[partition];
+  std::array<float, kFftLengthBy2Plus1> G_abs;
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    G_abs[k] = std::sqrt(G.re[k] * G.re[k] + G.im[k] * G.im[k]);
+  }
+  const float regularization =
+      kRegularization *
+          std::accumulate(G_abs.begin(), G_abs.end(), 0.f) /
+          kFftLengthBy2Plus1 +
+      1e-10f;
+  FftData G_weighted;
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    const float weight = 1.f / (G_abs[k] + regularization);
+    G_weighted.re[k] = weight * G.re[k];
+    G_weighted.im[k] = weight * G.im[k];
+  }
+  std::array<float, kFftLength> r;
+  fft_.Ifft(G_weighted, &r);
+
+  // Only the first kFftLengthBy2 lags belong to the partition.
+  const size_t first_lag = partition * kFftLengthBy2;
+  const size_t num_lags = std::min(kFftLengthBy2, max_lag_ - first_lag);
+  size_t peak_index = 0;
+  float energy = 0.f;
+  for (size_t k = 0; k < num_lags; ++k) {
+    energy += r[k] * r[k];
+    if (std::fabs(r[k]) > std::fabs(r[peak_index])) {
+      peak_index = k;
+    }
+  }
+  // The phase transform leaves a narrow peak, which a delay between two lags
+  // splits over both. The peak energy therefore includes the larger
+  // neighbour.
+  const float before =
+      peak_index > 0 ? r[peak_index - 1] * r[peak_index - 1] : 0.f;
+  const float after =
+      peak_index + 1 < num_lags ? r[peak_index + 1] * r[peak_index + 1] : 0.f;
+  partition_peaks_[partition] =
+      r[peak_index] * r[peak_index] + std::max(before, after);
+  partition_peak_lags_[partition] = first_lag + peak_index;
+  partition_energies_[partition] = energy;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_PARTITIONED_CROSS_CORRELATOR_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_PARTITIONED_CROSS_CORRELATOR_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/matched_filter.h"
+
+namespace webrtc {
+
+struct DownsampledRenderBuffer;
+
+// Estimates the lag between the downsampled render and capture signals using
+// a generalized cross-correlation with phase transform weighting (GCC-PHAT).
+// The lag range is split into partitions of kFftLengthBy2 lags. For each
+// partition, the cross-spectrum between the capture sub-block and the render
+// signal at the partition lag is recursively averaged in the frequency
+// domain. The render spectra are computed once per update and reused for the
+// later partitions, and a few partitions are divided by their own magnitude
+// and transformed back to the lag domain per update. The lag estimates are
+// produced in the format of the MatchedFilter, to be aggregated by the
+// MatchedFilterLagAggregator.
+class PartitionedCrossCorrelator {
+ public:
+  PartitionedCrossCorrelator(Aec3Optimization optimization,
+                             size_t sub_block_size,
+                             size_t max_lag,
+                             float excitation_limit);
+
+  PartitionedCrossCorrelator() = delete;
+  PartitionedCrossCorrelator(const PartitionedCrossCorrelator&) = delete;
+  PartitionedCrossCorrelator& operator=(const PartitionedCrossCorrelator&) =
+      delete;
+
+  ~PartitionedCrossCorrelator();
+
+  // Updates the correlation with the values in the capture buffer.
+  void Update(const DownsampledRenderBuffer& render_buffer,
+              ArrayView<const float> capture);
+
+  // Resets the correlation.
+  void Reset();
+
+  // Returns the lag estimate of the last update, if the correlation peak was
+  // reliable.
+  std::optional<const MatchedFilter::LagEstimate> GetBestLagEstimate() const {
+    return reported_lag_estimate_;
+  }
+
+ private:
+  // Adds the cross-spectrum of the capture with the render spectrum of each
+  // partition to the recursively averaged cross-spectra.
+  void UpdateCrossSpectra(const FftData& Y);
+
+  // Transforms the phase of the cross-spectrum of `partition` to the lag
+  // domain and stores its peak.
+  void AnalyzePartition(size_t partition);
+
+  const Aec3Optimization optimization_;
+  const size_t sub_block_size_;
+  const size_t max_lag_;
+  const size_t render_spectra_per_partition_;
+  const float x2_sum_threshold_;
+  const Aec3Fft fft_;
+  // Render spectra of the past updates, newest first from
+  // `render_spectra_index_`.
+  std::vector<FftData> render_spectra_;
+  size_t render_spectra_index_ = 0;
+  size_t num_render_spectra_ = 0;
+  std::optional<int> expected_render_read_;
+  std::vector<FftData> cross_spectra_;
+  // Energy of the peak of each partition, see AnalyzePartition().
+  std::vector<float> partition_peaks_;
+  std::vector<size_t> partition_peak_lags_;
+  std::vector<float> partition_energies_;
+  size_t next_partition_to_analyze_ = 0;
+  bool all_partitions_analyzed_ = false;
+  int num_updates_ = 0;
+  std::optional<MatchedFilter::LagEstimate> reported_lag_estimate_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_PARTITIONED_CROSS_CORRELATOR_H_
@@ -0,0 +1,184 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/partitioned_cross_correlator.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/render_delay_buffer.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumMatchedFilters = 10;
+constexpr float kExcitationLimit = 150.f;
+
+size_t MaxLag(size_t sub_block_size) {
+  return sub_block_size * ((kNumMatchedFilters - 1) *
+                               kMatchedFilterAlignmentShiftSizeSubBlocks +
+                           kMatchedFilterWindowSizeSubBlocks);
+}
+
+}  // namespace
+
+// Verifies that the lag estimate matches the delay of artificially delayed
+// signals.
+TEST(PartitionedCrossCorrelator, LagEstimation) {
+  constexpr int kSampleRateHz = 16000;
+  Random random_generator(42U);
+  for (size_t down_sampling_factor : {4, 8}) {
+    const size_t sub_block_size = kBlockSize / down_sampling_factor;
+    for (size_t delay_samples : {5, 64, 150, 800, 2000}) {
+      if (delay_samples >= MaxLag(sub_block_size)) {
+        continue;
+      }
+      SCOPED_TRACE(down_sampling_factor);
+      SCOPED_TRACE(delay_samples);
+      EchoCanceller3Config config;
+      config.delay.down_sampling_factor = down_sampling_factor;
+      config.delay.num_filters = kNumMatchedFilters;
+      std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+          RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+      DelayBuffer<float> signal_delay_buffer(down_sampling_factor *
+                                             delay_samples);
+      Decimator capture_decimator(down_sampling_factor);
+      PartitionedCrossCorrelator correlator(DetectOptimization(),
+                                            sub_block_size,
+                                            MaxLag(sub_block_size),
+                                            kExcitationLimit);
+
+      Block render(/*num_bands=*/1, /*num_channels=*/1);
+      std::vector<float> capture(kBlockSize, 0.f);
+      // The estimate needs the render spectra at the maximum lag.
+      const size_t num_updates =
+          300 + (MaxLag(sub_block_size) + delay_samples) / sub_block_size;
+      for (size_t k = 0; k < num_updates; ++k) {
+        RandomizeSampleVector(&random_generator, render.View(0, 0));
+        signal_delay_buffer.Delay(render.View(0, 0), capture);
+        render_delay_buffer->Insert(render);
+        if (k == 0) {
+          render_delay_buffer->Reset();
+        }
+        render_delay_buffer->PrepareCaptureProcessing();
+        std::array<float, kBlockSize> downsampled_capture_data;
+        ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                             sub_block_size);
+        capture_decimator.Decimate(capture, downsampled_capture);
+        correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                          downsampled_capture);
+      }
+
+      const auto lag_estimate = correlator.GetBestLagEstimate();
+      ASSERT_TRUE(lag_estimate.has_value());
+      EXPECT_NEAR(delay_samples, lag_estimate->lag, 1);
+      EXPECT_EQ(lag_estimate->lag, lag_estimate->pre_echo_lag);
+    }
+  }
+}
+
+// Verifies that no lag is estimated for uncorrelated signals, and for render
+// signals without excitation.
+TEST(PartitionedCrossCorrelator, NoLagEstimateForUncorrelatedSignals) {
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  Random random_generator(42U);
+  EchoCanceller3Config config;
+  config.delay.down_sampling_factor = kDownSamplingFactor;
+  config.delay.num_filters = kNumMatchedFilters;
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+  PartitionedCrossCorrelator correlator(DetectOptimization(), kSubBlockSize,
+                                        MaxLag(kSubBlockSize),
+                                        kExcitationLimit);
+  Block render(/*num_bands=*/1, /*num_channels=*/1);
+  std::vector<float> capture(kSubBlockSize, 0.f);
+  for (int k = 0; k < 500; ++k) {
+    RandomizeSampleVector(&random_generator, capture);
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      capture);
+    EXPECT_FALSE(correlator.GetBestLagEstimate().has_value());
+  }
+
+  for (int k = 0; k < 500; ++k) {
+    RandomizeSampleVector(&random_generator, render.View(0, 0));
+    RandomizeSampleVector(&random_generator, capture);
+    render_delay_buffer->Insert(render);
+    render_delay_buffer->PrepareCaptureProcessing();
+    correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                      capture);
+    EXPECT_FALSE(correlator.GetBestLagEstimate().has_value());
+  }
+}
+
+// Measures the update time for different maximum lags, corresponding to the
+// number of matched filters.
+TEST(PartitionedCrossCorrelator, DISABLED_Benchmark) {
+  constexpr int kSampleRateHz = 16000;
+  constexpr size_t kDownSamplingFactor = 4;
+  constexpr size_t kSubBlockSize = kBlockSize / kDownSamplingFactor;
+  constexpr int kNumBlocks = 2000;
+  for (size_t num_filters : {5, 10, 25, 50}) {
+    Random random_generator(42U);
+    EchoCanceller3Config config;
+    config.delay.down_sampling_factor = kDownSamplingFactor;
+    config.delay.num_filters = num_filters;
+    const size_t max_lag =
+        kSubBlockSize *
+        ((num_filters - 1) * kMatchedFilterAlignmentShiftSizeSubBlocks +
+         kMatchedFilterWindowSizeSubBlocks);
+    PartitionedCrossCorrelator correlator(DetectOptimization(), kSubBlockSize,
+                                          max_lag, kExcitationLimit);
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, 1));
+    Decimator capture_decimator(kDownSamplingFactor);
+    DelayBuffer<float> signal_delay_buffer(kDownSamplingFactor * 200);
+    Block render(/*num_bands=*/1, /*num_channels=*/1);
+    std::vector<float> capture(kBlockSize, 0.f);
+
+    test::PerformanceTimer timer(kNumBlocks);
+    for (int k = 0; k < kNumBlocks; ++k) {
+      RandomizeSampleVector(&random_generator, render.View(0, 0));
+      signal_delay_buffer.Delay(render.View(0, 0), capture);
+      render_delay_buffer->Insert(render);
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      std::array<float, kBlockSize> downsampled_capture_data;
+      ArrayView<float> downsampled_capture(downsampled_capture_data.data(),
+                                           kSubBlockSize);
+      capture_decimator.Decimate(capture, downsampled_capture);
+      timer.StartTimer();
+      correlator.Update(render_delay_buffer->GetDownsampledRenderBuffer(),
+                        downsampled_capture);
+      timer.StopTimer();
+    }
+    RTC_LOG(LS_INFO) << "PartitionedCrossCorrelator, " << num_filters
+                     << " filters: " << timer.GetDurationAverage() << " +/- "
+                     << timer.GetDurationStandardDeviation()
+                     << " us per block";
+  }
+}
+
+}  // namespace webrtc
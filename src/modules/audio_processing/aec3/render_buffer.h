@@ -55,7 +55,7 @@ class RenderBuffer {
   }
 
   // Returns the circular fft buffer.
-  ArrayView<const std::vector<FftData>> GetFftBuffer() const {
+  const FftArena& GetFftBuffer() const {
     return fft_buffer_->buffer;
   }
 
@@ -22,6 +22,7 @@
 
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_arena.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/alignment_mixer.h"
@@ -39,6 +40,25 @@
 namespace webrtc {
 namespace {
 
+size_t NumRenderBufferBlocks(const EchoCanceller3Config& config) {
+  return GetRenderDelayBufferSize(config.delay.down_sampling_factor,
+                                  config.delay.num_filters,
+                                  config.filter.refined.length_blocks);
+}
+
+// Returns the size of the arena holding all the render buffers.
+size_t RenderBuffersArenaBytes(const EchoCanceller3Config& config,
+                               int sample_rate_hz,
+                               size_t num_render_channels) {
+  const size_t num_blocks = NumRenderBufferBlocks(config);
+  return BlockBuffer::ArenaBytes(num_blocks, NumBandsForRate(sample_rate_hz),
+                                 num_render_channels) +
+         SpectrumBuffer::ArenaBytes(num_blocks, num_render_channels) +
+         FftBuffer::ArenaBytes(num_blocks, num_render_channels) +
+         DownsampledRenderBuffer::ArenaBytes(GetDownSampledBufferSize(
+             config.delay.down_sampling_factor, config.delay.num_filters));
+}
+
 class RenderDelayBufferImpl final : public RenderDelayBuffer {
  public:
   RenderDelayBufferImpl(const EchoCanceller3Config& config,
@@ -76,6 +96,7 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   const LoggingSeverity delay_log_level_;
   size_t down_sampling_factor_;
   const int sub_block_size_;
+  Aec3Arena arena_;
   BlockBuffer blocks_;
   SpectrumBuffer spectra_;
   FftBuffer ffts_;
@@ -98,11 +119,15 @@ class RenderDelayBufferImpl final : public RenderDelayBuffer {
   bool external_audio_buffer_delay_verified_after_reset_ = false;
   size_t min_latency_blocks_ = 0;
   size_t excess_render_detection_counter_ = 0;
+  int num_unanalyzed_blocks_ = 0;
 
   int MapDelayToTotalDelay(size_t delay) const;
   int ComputeDelay() const;
   void ApplyTotalDelay(int delay);
-  void InsertBlock(const Block& block, int previous_write);
+  void InsertBlock(const Block& block);
+  void AnalyzeInsertedBlocks();
+  void DecimateBlock(int age_blocks);
+  void ComputeBlockSpectra(int age_blocks);
   bool DetectActiveRender(ArrayView<const float> x) const;
   bool DetectExcessRenderBlocks();
   void IncrementWriteIndices();
@@ -128,17 +153,20 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
       sub_block_size_(static_cast<int>(down_sampling_factor_ > 0
                                            ? kBlockSize / down_sampling_factor_
                                            : kBlockSize)),
-      blocks_(GetRenderDelayBufferSize(down_sampling_factor_,
-                                       config.delay.num_filters,
-                                       config.filter.refined.length_blocks),
+      arena_(RenderBuffersArenaBytes(config,
+                                     sample_rate_hz,
+                                     num_render_channels)),
+      blocks_(NumRenderBufferBlocks(config),
               NumBandsForRate(sample_rate_hz),
-              num_render_channels),
-      spectra_(blocks_.buffer.size(), num_render_channels),
-      ffts_(blocks_.buffer.size(), num_render_channels),
+              num_render_channels,
+              &arena_),
+      spectra_(blocks_.buffer.size(), num_render_channels, &arena_),
+      ffts_(blocks_.buffer.size(), num_render_channels, &arena_),
       delay_(config_.delay.default_delay),
       echo_remover_buffer_(&blocks_, &spectra_, &ffts_),
       low_rate_(GetDownSampledBufferSize(down_sampling_factor_,
-                                         config.delay.num_filters)),
+                                         config.delay.num_filters),
+                &arena_),
       render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
       render_decimator_(down_sampling_factor_),
       fft_(),
@@ -151,6 +179,11 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
     RTC_DCHECK_EQ(spectra_.buffer[i].size(), ffts_.buffer[i].size());
   }
 
+  // All render buffers have been allocated, and none may be reallocated
+  // during processing.
+  RTC_DCHECK_EQ(arena_.used(), arena_.capacity());
+  arena_.Seal();
+
   Reset();
 }
 
@@ -215,7 +248,6 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
   }
 
   // Increase the write indices to where the new blocks should be written.
-  const int previous_write = blocks_.write;
   IncrementWriteIndices();
 
   // Allow overrun and do a reset when render overrun occurrs due to more render
@@ -230,8 +262,11 @@ RenderDelayBuffer::BufferingEvent RenderDelayBufferImpl::Insert(
     render_activity_ = render_activity_counter_ >= 20;
   }
 
-  // Insert the new render block into the specified position.
-  InsertBlock(block, previous_write);
+  // Insert the new render block into the specified position. The block is
+  // analyzed first when it is needed for capture processing.
+  InsertBlock(block);
+  num_unanalyzed_blocks_ =
+      std::min(num_unanalyzed_blocks_ + 1, blocks_.size - 1);
 
   if (event != BufferingEvent::kNone) {
     Reset();
@@ -250,6 +285,8 @@ RenderDelayBufferImpl::PrepareCaptureProcessing() {
   RenderDelayBuffer::BufferingEvent event = BufferingEvent::kNone;
   ++capture_call_counter_;
 
+  AnalyzeInsertedBlocks();
+
   if (delay_) {
     if (last_call_was_render_) {
       last_call_was_render_ = false;
@@ -379,13 +416,8 @@ void RenderDelayBufferImpl::AlignFromExternalDelay() {
 }
 
 // Inserts a block into the render buffers.
-void RenderDelayBufferImpl::InsertBlock(const Block& block,
-                                        int previous_write) {
+void RenderDelayBufferImpl::InsertBlock(const Block& block) {
   auto& b = blocks_;
-  auto& lr = low_rate_;
-  auto& ds = render_ds_;
-  auto& f = ffts_;
-  auto& s = spectra_;
   const size_t num_bands = b.buffer[b.write].NumBands();
   const size_t num_render_channels = b.buffer[b.write].NumChannels();
   RTC_DCHECK_EQ(block.NumBands(), num_bands);
@@ -407,19 +439,65 @@ void RenderDelayBufferImpl::InsertBlock(const Block& block,
       }
     }
   }
+}
+
+// Computes the downsampled signal and the spectra of the blocks inserted since
+// the previous call, oldest first. Blocks that have already been overwritten
+// in the low-rate buffer are not downsampled.
+void RenderDelayBufferImpl::AnalyzeInsertedBlocks() {
+  const int low_rate_size_blocks = low_rate_.size / sub_block_size_;
+  for (int age_blocks = num_unanalyzed_blocks_ - 1; age_blocks >= 0;
+       --age_blocks) {
+    if (age_blocks < low_rate_size_blocks - 1) {
+      DecimateBlock(age_blocks);
+    }
+    ComputeBlockSpectra(age_blocks);
+  }
+  num_unanalyzed_blocks_ = 0;
+}
 
+// Downsamples the block inserted `age_blocks` blocks before the most recent
+// one into the low-rate buffer.
+void RenderDelayBufferImpl::DecimateBlock(int age_blocks) {
+  auto& lr = low_rate_;
+  auto& ds = render_ds_;
+  const Block& block = blocks_.buffer[blocks_.OffsetIndex(blocks_.write,
+                                                          -age_blocks)];
   std::array<float, kBlockSize> downmixed_render;
-  render_mixer_.ProduceOutput(b.buffer[b.write], downmixed_render);
+  render_mixer_.ProduceOutput(block, downmixed_render);
   render_decimator_.Decimate(downmixed_render, ds);
   data_dumper_->DumpWav("aec3_render_decimator_output", ds.size(), ds.data(),
                         16000 / down_sampling_factor_, 1);
-  std::copy(ds.rbegin(), ds.rend(), lr.buffer.begin() + lr.write);
-  for (int channel = 0; channel < b.buffer[b.write].NumChannels(); ++channel) {
-    fft_.PaddedFft(b.buffer[b.write].View(/*band=*/0, channel),
-                   b.buffer[previous_write].View(/*band=*/0, channel),
-                   &f.buffer[f.write][channel]);
-    f.buffer[f.write][channel].Spectrum(optimization_,
-                                        s.buffer[s.write][channel]);
+  std::copy(ds.rbegin(), ds.rend(),
+            lr.buffer.begin() +
+                lr.OffsetIndex(lr.write, age_blocks * sub_block_size_));
+}
+
+// Computes the FFTs and spectra of the block inserted `age_blocks` blocks
+// before the most recent one. The computation is skipped for channels where
+// the block and the previous block are digital silence.
+void RenderDelayBufferImpl::ComputeBlockSpectra(int age_blocks) {
+  const Block& block =
+      blocks_.buffer[blocks_.OffsetIndex(blocks_.write, -age_blocks)];
+  const Block& previous_block =
+      blocks_.buffer[blocks_.OffsetIndex(blocks_.write, -age_blocks - 1)];
+  auto X2 = spectra_.buffer[spectra_.OffsetIndex(spectra_.write, age_blocks)];
+  auto X_padded = ffts_.buffer[ffts_.OffsetIndex(ffts_.write, age_blocks)];
+  FftData X;
+  for (int channel = 0; channel < block.NumChannels(); ++channel) {
+    ArrayView<const float, kBlockSize> x = block.View(/*band=*/0, channel);
+    ArrayView<const float, kBlockSize> x_old =
+        previous_block.View(/*band=*/0, channel);
+    auto is_zero = [](float sample) { return sample == 0.f; };
+    if (std::all_of(x.begin(), x.end(), is_zero) &&
+        std::all_of(x_old.begin(), x_old.end(), is_zero)) {
+      X2[channel].fill(0.f);
+      X_padded[channel].Clear();
+      continue;
+    }
+    fft_.PaddedFft(x, x_old, &X);
+    X.Spectrum(optimization_, X2[channel]);
+    X_padded[channel].Assign(X);
   }
 }
 
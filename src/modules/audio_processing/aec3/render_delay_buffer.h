@@ -41,11 +41,13 @@ class RenderDelayBuffer {
   // Resets the buffer alignment.
   virtual void Reset() = 0;
 
-  // Inserts a block into the buffer.
+  // Inserts a block into the buffer. The downsampled signal and the spectra
+  // of the block are computed in the next call to PrepareCaptureProcessing.
   virtual BufferingEvent Insert(const Block& block) = 0;
 
-  // Updates the buffers one step based on the specified buffer delay. Returns
-  // an enum indicating whether there was a special event that occurred.
+  // Analyzes the inserted render blocks and updates the buffers one step based
+  // on the specified buffer delay. Returns an enum indicating whether there
+  // was a special event that occurred.
   virtual BufferingEvent PrepareCaptureProcessing() = 0;
 
   // Called on capture blocks where PrepareCaptureProcessing is not called.
@@ -10,13 +10,26 @@
 
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_arena.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/block_buffer.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/spectrum_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "modules/audio_processing/test/echo_canceller_test_tools.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gtest.h"
@@ -30,6 +43,26 @@ std::string ProduceDebugText(int sample_rate_hz) {
   return ss.Release();
 }
 
+// Verifies that the newest render spectrum and FFT in the buffer are those of
+// the `x` and `x_old` blocks.
+void VerifyNewestRenderSpectrum(RenderBuffer* render_buffer,
+                                const Block& x,
+                                const Block& x_old) {
+  Aec3Fft fft;
+  FftData X;
+  std::array<float, kFftLengthBy2Plus1> X2;
+  const SpectrumBuffer& spectra = render_buffer->GetSpectrumBuffer();
+  for (int ch = 0; ch < x.NumChannels(); ++ch) {
+    fft.PaddedFft(x.View(/*band=*/0, ch), x_old.View(/*band=*/0, ch), &X);
+    X.Spectrum(DetectOptimization(), X2);
+    EXPECT_EQ(X2, spectra.buffer[spectra.write][ch]);
+    FftData X_buffer;
+    render_buffer->GetFftBuffer()[spectra.write][ch].CopyTo(&X_buffer);
+    EXPECT_EQ(X.re, X_buffer.re);
+    EXPECT_EQ(X.im, X_buffer.im);
+  }
+}
+
 }  // namespace
 
 // Verifies that the buffer overflow is correctly reported.
@@ -87,6 +120,131 @@ TEST(RenderDelayBuffer, AlignFromDelay) {
   }
 }
 
+// Verifies that the render buffers are stored in one allocation, and that they
+// are not reallocated during processing.
+TEST(RenderDelayBuffer, RenderBuffersInOneAllocation) {
+  Random random_generator(42U);
+  for (int rate : {16000, 48000}) {
+    for (size_t num_channels : {1, 2, 8}) {
+      SCOPED_TRACE(ProduceDebugText(rate));
+      SCOPED_TRACE(num_channels);
+      EchoCanceller3Config config;
+      std::unique_ptr<RenderDelayBuffer> delay_buffer(
+          RenderDelayBuffer::Create(config, rate, num_channels));
+      const RenderBuffer* render_buffer = delay_buffer->GetRenderBuffer();
+      const BlockBuffer& blocks = render_buffer->GetBlockBuffer();
+      const SpectrumBuffer& spectra = render_buffer->GetSpectrumBuffer();
+      const FftArena& ffts = render_buffer->GetFftBuffer();
+      const DownsampledRenderBuffer& low_rate =
+          delay_buffer->GetDownsampledRenderBuffer();
+      const int num_bands = NumBandsForRate(rate);
+
+      // Returns the storage ranges of all the buffers.
+      auto get_ranges = [&]() {
+        std::vector<std::pair<const void*, const void*>> ranges;
+        for (const Block& block : blocks.buffer) {
+          ranges.emplace_back(block.begin(/*band=*/0, /*channel=*/0),
+                              block.end(num_bands - 1, num_channels - 1));
+        }
+        ranges.emplace_back(spectra.buffer.data().begin(),
+                            spectra.buffer.data().end());
+        ranges.emplace_back(&ffts[0][0], &ffts[ffts.size() - 1][0] +
+                                             ffts.num_channels());
+        ranges.emplace_back(low_rate.buffer.begin(), low_rate.buffer.end());
+        return ranges;
+      };
+
+      const auto ranges = get_ranges();
+      size_t total_size = 0;
+      const uint8_t* begin = static_cast<const uint8_t*>(ranges[0].first);
+      const uint8_t* end = begin;
+      for (const auto& range : ranges) {
+        const uint8_t* range_begin = static_cast<const uint8_t*>(range.first);
+        const uint8_t* range_end = static_cast<const uint8_t*>(range.second);
+        total_size += range_end - range_begin;
+        begin = std::min(begin, range_begin);
+        end = std::max(end, range_end);
+      }
+      // The allocations of the four buffers are padded to the arena alignment.
+      EXPECT_LE(static_cast<size_t>(end - begin),
+                total_size + 4 * Aec3Arena::kAlignment);
+
+      Block x(num_bands, num_channels);
+      for (int k = 0; k < 500; ++k) {
+        for (int band = 0; band < num_bands; ++band) {
+          for (size_t ch = 0; ch < num_channels; ++ch) {
+            RandomizeSampleVector(&random_generator, x.View(band, ch));
+          }
+        }
+        delay_buffer->Insert(x);
+        delay_buffer->PrepareCaptureProcessing();
+        if (k % 100 == 50) {
+          delay_buffer->AlignFromDelay(k % 7);
+        }
+        if (k % 100 == 99) {
+          delay_buffer->Reset();
+        }
+      }
+      EXPECT_EQ(ranges, get_ranges());
+    }
+  }
+}
+
+// Verifies that the render analysis, which is done when the capture processing
+// needs it, matches the analysis of the inserted blocks. The render signal
+// contains digital silence, for which the FFTs are skipped.
+TEST(RenderDelayBuffer, LazyRenderAnalysis) {
+  constexpr int kSampleRateHz = 16000;
+  for (size_t num_channels : {1, 2}) {
+    SCOPED_TRACE(num_channels);
+    const EchoCanceller3Config config;
+    const size_t sub_block_size =
+        kBlockSize / config.delay.down_sampling_factor;
+    std::unique_ptr<RenderDelayBuffer> delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, num_channels));
+    Decimator decimator(config.delay.down_sampling_factor);
+    Random random_generator(42U);
+    Block x(/*num_bands=*/1, num_channels);
+    Block x_old(/*num_bands=*/1, num_channels);
+    std::vector<float> x_ds(sub_block_size);
+    for (int k = 0; k < 300; ++k) {
+      // Insert zero to two render blocks per capture block.
+      for (int j = 0; j < k % 3; ++j) {
+        x_old = x;
+        for (size_t ch = 0; ch < num_channels; ++ch) {
+          if (k % 4 == 0 || (k > 100 && k < 150)) {
+            std::fill(x.begin(/*band=*/0, ch), x.end(/*band=*/0, ch), 0.f);
+          } else {
+            RandomizeSampleVector(&random_generator, x.View(/*band=*/0, ch));
+          }
+        }
+        delay_buffer->Insert(x);
+        decimator.Decimate(x.View(/*band=*/0, /*channel=*/0), x_ds);
+      }
+      delay_buffer->PrepareCaptureProcessing();
+      VerifyNewestRenderSpectrum(delay_buffer->GetRenderBuffer(), x, x_old);
+      if (num_channels == 1) {
+        const DownsampledRenderBuffer& low_rate =
+            delay_buffer->GetDownsampledRenderBuffer();
+        EXPECT_TRUE(std::equal(x_ds.rbegin(), x_ds.rend(),
+                               low_rate.buffer.begin() + low_rate.write));
+      }
+    }
+
+    // Insert more render blocks than the buffer can hold without capture
+    // processing.
+    for (int k = 0; k < 1000; ++k) {
+      x_old = x;
+      for (size_t ch = 0; ch < num_channels; ++ch) {
+        RandomizeSampleVector(&random_generator, x.View(/*band=*/0, ch));
+      }
+      delay_buffer->Insert(x);
+    }
+    delay_buffer->PrepareCaptureProcessing();
+    VerifyNewestRenderSpectrum(delay_buffer->GetRenderBuffer(), x, x_old);
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 
 // Verifies the check for feasible delay.
@@ -18,6 +18,8 @@
 
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
+#include "api/environment/environment.h"
+#include "api/field_trials_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
@@ -30,11 +32,24 @@ namespace webrtc {
 
 namespace {
 
+EchoPathDelayEstimator::LagEstimation SelectLagEstimation(
+    const FieldTrialsView& field_trials) {
+  if (field_trials.IsEnabled("WebRTC-Aec3PartitionedCrossCorrelationDelay")) {
+    return EchoPathDelayEstimator::LagEstimation::kPartitionedCrossCorrelation;
+  }
+  if (field_trials.IsEnabled("WebRTC-Aec3CoarseToFineDelaySearch")) {
+    return EchoPathDelayEstimator::LagEstimation::kCoarseToFineMatchedFilter;
+  }
+  return EchoPathDelayEstimator::LagEstimation::kMatchedFilter;
+}
+
 class RenderDelayControllerImpl final : public RenderDelayController {
  public:
-  RenderDelayControllerImpl(const EchoCanceller3Config& config,
-                            int sample_rate_hz,
-                            size_t num_capture_channels);
+  RenderDelayControllerImpl(
+      const EchoCanceller3Config& config,
+      int sample_rate_hz,
+      size_t num_capture_channels,
+      EchoPathDelayEstimator::LagEstimation lag_estimation);
 
   RenderDelayControllerImpl() = delete;
   RenderDelayControllerImpl(const RenderDelayControllerImpl&) = delete;
@@ -87,11 +102,15 @@ std::atomic<int> RenderDelayControllerImpl::instance_count_(0);
 RenderDelayControllerImpl::RenderDelayControllerImpl(
     const EchoCanceller3Config& config,
     int sample_rate_hz,
-    size_t num_capture_channels)
+    size_t num_capture_channels,
+    EchoPathDelayEstimator::LagEstimation lag_estimation)
     : data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       hysteresis_limit_blocks_(
           static_cast<int>(config.delay.hysteresis_limit_blocks)),
-      delay_estimator_(data_dumper_.get(), config, num_capture_channels),
+      delay_estimator_(data_dumper_.get(),
+                       config,
+                       num_capture_channels,
+                       lag_estimation),
       last_delay_estimate_quality_(DelayEstimate::Quality::kCoarse) {
   RTC_DCHECK(ValidFullBandRate(sample_rate_hz));
   delay_estimator_.LogDelayEstimationProperties(sample_rate_hz, 0);
@@ -178,8 +197,19 @@ RenderDelayController* RenderDelayController::Create(
     const EchoCanceller3Config& config,
     int sample_rate_hz,
     size_t num_capture_channels) {
-  return new RenderDelayControllerImpl(config, sample_rate_hz,
-                                       num_capture_channels);
+  return new RenderDelayControllerImpl(
+      config, sample_rate_hz, num_capture_channels,
+      EchoPathDelayEstimator::LagEstimation::kMatchedFilter);
+}
+
+RenderDelayController* RenderDelayController::Create(
+    const Environment& env,
+    const EchoCanceller3Config& config,
+    int sample_rate_hz,
+    size_t num_capture_channels) {
+  return new RenderDelayControllerImpl(
+      config, sample_rate_hz, num_capture_channels,
+      SelectLagEstimation(env.field_trials()));
 }
 
 }  // namespace webrtc
@@ -15,6 +15,7 @@
 
 #include "api/array_view.h"
 #include "api/audio/echo_canceller3_config.h"
+#include "api/environment/environment.h"
 #include "modules/audio_processing/aec3/block.h"
 #include "modules/audio_processing/aec3/delay_estimate.h"
 #include "modules/audio_processing/aec3/downsampled_render_buffer.h"
@@ -29,6 +30,10 @@ class RenderDelayController {
   static RenderDelayController* Create(const EchoCanceller3Config& config,
                                        int sample_rate_hz,
                                        size_t num_capture_channels);
+  static RenderDelayController* Create(const Environment& env,
+                                       const EchoCanceller3Config& config,
+                                       int sample_rate_hz,
+                                       size_t num_capture_channels);
   virtual ~RenderDelayController() = default;
 
   // Resets the delay controller. If the delay confidence is reset, the reset
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/render_transfer_queue.h"
+
+namespace webrtc {
+
+RenderTransferQueue::RenderTransferQueue(size_t capacity,
+                                         size_t num_bands,
+                                         size_t num_channels,
+                                         size_t frame_length)
+    : capacity_(capacity),
+      num_bands_(num_bands),
+      num_channels_(num_channels),
+      frame_length_(frame_length),
+      frame_stride_(num_bands * num_channels * frame_length),
+      frames_(capacity * frame_stride_, 0.f) {
+  RTC_DCHECK_LT(0, capacity);
+  RTC_DCHECK_LT(0, num_bands);
+  RTC_DCHECK_LT(0, num_channels);
+}
+
+RenderTransferQueue::~RenderTransferQueue() = default;
+
+std::optional<RenderFrameView> RenderTransferQueue::BeginInsert() {
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+    return std::nullopt;
+  }
+  return FrameAtPosition(tail);
+}
+
+void RenderTransferQueue::CommitInsert() {
+  tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+              std::memory_order_release);
+}
+
+size_t RenderTransferQueue::Acquire() {
+  num_acquired_frames_ = tail_.load(std::memory_order_acquire) -
+                         head_.load(std::memory_order_relaxed);
+  RTC_DCHECK_LE(num_acquired_frames_, capacity_);
+  return num_acquired_frames_;
+}
+
+RenderFrameView RenderTransferQueue::Frame(size_t index) {
+  RTC_DCHECK_LT(index, num_acquired_frames_);
+  return FrameAtPosition(head_.load(std::memory_order_relaxed) + index);
+}
+
+void RenderTransferQueue::Release(size_t num_frames) {
+  RTC_DCHECK_LE(num_frames, num_acquired_frames_);
+  num_acquired_frames_ -= num_frames;
+  head_.store(head_.load(std::memory_order_relaxed) + num_frames,
+              std::memory_order_release);
+}
+
+void RenderTransferQueue::Clear() {
+  head_.store(tail_.load(std::memory_order_relaxed),
+              std::memory_order_relaxed);
+  num_acquired_frames_ = 0;
+}
+
+RenderFrameView RenderTransferQueue::FrameAtPosition(size_t position) {
+  return RenderFrameView(&frames_[(position % capacity_) * frame_stride_],
+                         num_bands_, num_channels_, frame_length_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_RENDER_TRANSFER_QUEUE_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_RENDER_TRANSFER_QUEUE_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// View of a band-split multichannel render frame, stored flat in
+// [band][channel][sample] order.
+class RenderFrameView {
+ public:
+  RenderFrameView(float* data,
+                  size_t num_bands,
+                  size_t num_channels,
+                  size_t frame_length)
+      : data_(data),
+        num_bands_(num_bands),
+        num_channels_(num_channels),
+        frame_length_(frame_length) {}
+
+  size_t NumBands() const { return num_bands_; }
+  size_t NumChannels() const { return num_channels_; }
+  size_t FrameLength() const { return frame_length_; }
+
+  ArrayView<float> View(size_t band, size_t channel) const {
+    RTC_DCHECK_LT(band, num_bands_);
+    RTC_DCHECK_LT(channel, num_channels_);
+    return ArrayView<float>(
+        &data_[(band * num_channels_ + channel) * frame_length_],
+        frame_length_);
+  }
+
+ private:
+  float* data_;
+  size_t num_bands_;
+  size_t num_channels_;
+  size_t frame_length_;
+};
+
+// Fixed-capacity, lock-free queue carrying the render frames from the render
+// thread to the capture thread, for exactly one producer and one consumer. The
+// frames are preallocated in one allocation with a fixed stride and are filled
+// and read in place, so neither side allocates or copies nested containers.
+// The consumer can acquire all queued frames at once and release them after
+// processing, which costs one atomic load and one atomic store regardless of
+// the number of frames. When the queue is full, new frames are dropped.
+class RenderTransferQueue {
+ public:
+  RenderTransferQueue(size_t capacity,
+                      size_t num_bands,
+                      size_t num_channels,
+                      size_t frame_length);
+
+  RenderTransferQueue() = delete;
+  RenderTransferQueue(const RenderTransferQueue&) = delete;
+  RenderTransferQueue& operator=(const RenderTransferQueue&) = delete;
+
+  ~RenderTransferQueue();
+
+  size_t capacity() const { return capacity_; }
+
+  // Render thread. Returns the frame to fill, or no frame if the queue is full.
+  // The frame is published by CommitInsert().
+  std::optional<RenderFrameView> BeginInsert();
+  void CommitInsert();
+
+  // Capture thread. Returns the number of queued frames, which are accessed
+  // with Frame(), oldest first. The frames stay valid, and may be modified in
+  // place, until they are released with Release().
+  size_t Acquire();
+  RenderFrameView Frame(size_t index);
+  void Release(size_t num_frames);
+
+  // Drops all queued frames. Neither side may run meanwhile.
+  void Clear();
+
+ private:
+  RenderFrameView FrameAtPosition(size_t position);
+
+  const size_t capacity_;
+  const size_t num_bands_;
+  const size_t num_channels_;
+  const size_t frame_length_;
+  const size_t frame_stride_;
+  std::vector<float> frames_;
+  // Monotonic frame counters. The producer only writes `tail_` and the
+  // consumer only writes `head_`. Kept on separate cache lines to avoid false
+  // sharing.
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+  // Number of frames returned by the last Acquire(), only accessed by the
+  // consumer.
+  size_t num_acquired_frames_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_RENDER_TRANSFER_QUEUE_H_
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/render_transfer_queue.h"
+
+#include <optional>
+#include <thread>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumBands = 2;
+constexpr size_t kNumChannels = 2;
+constexpr size_t kFrameLength = 160;
+
+// Fills the frame with values that identify the frame, band, channel and
+// sample.
+void FillFrame(int frame_index, const RenderFrameView& frame) {
+  for (size_t band = 0; band < frame.NumBands(); ++band) {
+    for (size_t channel = 0; channel < frame.NumChannels(); ++channel) {
+      ArrayView<float> x = frame.View(band, channel);
+      for (size_t k = 0; k < x.size(); ++k) {
+        x[k] = frame_index * 10000 + band * 1000 + channel * 100 + k % 100;
+      }
+    }
+  }
+}
+
+bool VerifyFrame(int frame_index, const RenderFrameView& frame) {
+  for (size_t band = 0; band < frame.NumBands(); ++band) {
+    for (size_t channel = 0; channel < frame.NumChannels(); ++channel) {
+      ArrayView<const float> x = frame.View(band, channel);
+      for (size_t k = 0; k < x.size(); ++k) {
+        if (x[k] != frame_index * 10000 + band * 1000 + channel * 100 +
+                        k % 100) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool Insert(int frame_index, RenderTransferQueue* queue) {
+  std::optional<RenderFrameView> frame = queue->BeginInsert();
+  if (!frame) {
+    return false;
+  }
+  FillFrame(frame_index, *frame);
+  queue->CommitInsert();
+  return true;
+}
+
+}  // namespace
+
+// Verifies that the frames are delivered in order, with their dimensions and
+// content intact, and that the bands and channels do not overlap.
+TEST(RenderTransferQueue, InOrderDelivery) {
+  RenderTransferQueue queue(/*capacity=*/4, kNumBands, kNumChannels,
+                            kFrameLength);
+  EXPECT_EQ(0u, queue.Acquire());
+  ASSERT_TRUE(Insert(0, &queue));
+  ASSERT_TRUE(Insert(1, &queue));
+
+  ASSERT_EQ(2u, queue.Acquire());
+  for (int k = 0; k < 2; ++k) {
+    RenderFrameView frame = queue.Frame(k);
+    EXPECT_EQ(kNumBands, frame.NumBands());
+    EXPECT_EQ(kNumChannels, frame.NumChannels());
+    EXPECT_EQ(kFrameLength, frame.FrameLength());
+    EXPECT_TRUE(VerifyFrame(k, frame));
+  }
+  queue.Release(2);
+  EXPECT_EQ(0u, queue.Acquire());
+}
+
+// Verifies that frames are dropped when the queue is full and that the space
+// is reclaimed when the frames are released.
+TEST(RenderTransferQueue, DropsFramesWhenFull) {
+  constexpr size_t kCapacity = 3;
+  RenderTransferQueue queue(kCapacity, kNumBands, kNumChannels, kFrameLength);
+  for (size_t k = 0; k < kCapacity; ++k) {
+    EXPECT_TRUE(Insert(k, &queue));
+  }
+  EXPECT_FALSE(Insert(kCapacity, &queue));
+
+  ASSERT_EQ(kCapacity, queue.Acquire());
+  EXPECT_TRUE(VerifyFrame(kCapacity - 1, queue.Frame(kCapacity - 1)));
+  queue.Release(1);
+  EXPECT_TRUE(Insert(kCapacity, &queue));
+  EXPECT_FALSE(Insert(kCapacity + 1, &queue));
+
+  ASSERT_EQ(kCapacity, queue.Acquire());
+  for (size_t k = 0; k < kCapacity; ++k) {
+    EXPECT_TRUE(VerifyFrame(k + 1, queue.Frame(k)));
+  }
+}
+
+// Verifies partial releases, wraparound and clearing.
+TEST(RenderTransferQueue, PartialReleaseAndWraparound) {
+  constexpr size_t kCapacity = 3;
+  RenderTransferQueue queue(kCapacity, kNumBands, kNumChannels, kFrameLength);
+  int next_insert = 0;
+  int next_remove = 0;
+  for (int round = 0; round < 10; ++round) {
+    while (Insert(next_insert, &queue)) {
+      ++next_insert;
+    }
+    const size_t num_frames = queue.Acquire();
+    ASSERT_EQ(kCapacity, num_frames);
+    const size_t num_released = 1 + round % kCapacity;
+    for (size_t k = 0; k < num_released; ++k) {
+      EXPECT_TRUE(VerifyFrame(next_remove++, queue.Frame(k)));
+    }
+    queue.Release(num_released);
+  }
+
+  queue.Clear();
+  EXPECT_EQ(0u, queue.Acquire());
+  ASSERT_TRUE(Insert(next_insert, &queue));
+  ASSERT_EQ(1u, queue.Acquire());
+  EXPECT_TRUE(VerifyFrame(next_insert, queue.Frame(0)));
+}
+
+// Verifies that all frames that are not dropped arrive intact and in order
+// when the producer and the consumer run on different threads.
+TEST(RenderTransferQueue, ConcurrentProducerAndConsumer) {
+  constexpr int kNumFrames = 20000;
+  RenderTransferQueue queue(/*capacity=*/8, kNumBands, kNumChannels,
+                            kFrameLength);
+  std::thread producer([&queue] {
+    for (int k = 0; k < kNumFrames; ++k) {
+      while (!Insert(k, &queue)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int next_frame = 0;
+  bool all_frames_intact = true;
+  while (next_frame < kNumFrames) {
+    const size_t num_frames = queue.Acquire();
+    for (size_t k = 0; k < num_frames; ++k) {
+      all_frames_intact =
+          VerifyFrame(next_frame++, queue.Frame(k)) && all_frames_intact;
+    }
+    queue.Release(num_frames);
+    if (num_frames == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(all_frames_intact);
+  EXPECT_EQ(0u, queue.Acquire());
+}
+
+}  // namespace webrtc
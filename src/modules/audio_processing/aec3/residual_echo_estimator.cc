@@ -19,6 +19,8 @@
 #include "api/environment/environment.h"
 #include "api/field_trials_view.h"
 #include "modules/audio_processing/aec3/reverb_model.h"
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
@@ -80,6 +82,7 @@ void GetRenderIndexesToAnalyze(
 // Estimates the residual echo power based on the echo return loss enhancement
 // (ERLE) and the linear power estimate.
 void LinearEstimate(
+    Aec3Optimization optimization,
     ArrayView<const std::array<float, kFftLengthBy2Plus1>> S2_linear,
     ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
     ArrayView<std::array<float, kFftLengthBy2Plus1>> R2) {
@@ -88,10 +91,7 @@ void LinearEstimate(
 
   const size_t num_capture_channels = R2.size();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      RTC_DCHECK_LT(0.f, erle[ch][k]);
-      R2[ch][k] = S2_linear[ch][k] / erle[ch][k];
-    }
+    ComputeLinearResidualEcho(optimization, S2_linear[ch], erle[ch], R2[ch]);
   }
 }
 
@@ -108,20 +108,10 @@ void NonLinearEstimate(float echo_path_gain,
   }
 }
 
-// Applies a soft noise gate to the echo generating power.
-void ApplyNoiseGate(const EchoCanceller3Config::EchoModel& config,
-                    ArrayView<float, kFftLengthBy2Plus1> X2) {
-  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-    if (config.noise_gate_power > X2[k]) {
-      X2[k] = std::max(0.f, X2[k] - config.noise_gate_slope *
-                                        (config.noise_gate_power - X2[k]));
-    }
-  }
-}
-
 // Estimates the echo generating signal power as gated maximal power over a
 // time window.
-void EchoGeneratingPower(size_t num_render_channels,
+void EchoGeneratingPower(Aec3Optimization optimization,
+                         size_t num_render_channels,
                          const SpectrumBuffer& spectrum_buffer,
                          const EchoCanceller3Config::EchoModel& echo_model,
                          int filter_delay_blocks,
@@ -143,10 +133,8 @@ void EchoGeneratingPower(size_t num_render_channels,
       std::array<float, kFftLengthBy2Plus1> render_power;
       render_power.fill(0.f);
       for (size_t ch = 0; ch < num_render_channels; ++ch) {
-        const auto& channel_power = spectrum_buffer.buffer[k][ch];
-        for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
-          render_power[j] += channel_power[j];
-        }
+        aec3::VectorMath(optimization)
+            .Accumulate(spectrum_buffer.buffer[k][ch], render_power);
       }
       for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
         X2[j] = std::max(X2[j], render_power[j]);
@@ -161,6 +149,7 @@ ResidualEchoEstimator::ResidualEchoEstimator(const Environment& env,
                                              const EchoCanceller3Config& config,
                                              size_t num_render_channels)
     : config_(config),
+      optimization_(DetectOptimization()),
       num_render_channels_(num_render_channels),
       early_reflections_transparent_mode_gain_(GetTransparentModeGain()),
       late_reflections_transparent_mode_gain_(GetTransparentModeGain()),
@@ -206,8 +195,10 @@ void ResidualEchoEstimator::Estimate(
     } else {
       const bool onset_compensated =
           erle_onset_compensation_in_dominant_nearend_ || !dominant_nearend;
-      LinearEstimate(S2_linear, aec_state.Erle(onset_compensated), R2);
-      LinearEstimate(S2_linear, aec_state.ErleUnbounded(), R2_unbounded);
+      LinearEstimate(optimization_, S2_linear,
+                     aec_state.Erle(onset_compensated), R2);
+      LinearEstimate(optimization_, S2_linear, aec_state.ErleUnbounded(),
+                     R2_unbounded);
     }
 
     UpdateReverb(ReverbType::kLinear, aec_state, render_buffer,
@@ -228,19 +219,19 @@ void ResidualEchoEstimator::Estimate(
     } else {
       // Estimate the echo generating signal power.
       std::array<float, kFftLengthBy2Plus1> X2;
-      EchoGeneratingPower(num_render_channels_,
+      EchoGeneratingPower(optimization_, num_render_channels_,
                           render_buffer.GetSpectrumBuffer(), config_.echo_model,
                           aec_state.MinDirectPathFilterDelay(), X2);
       if (!aec_state.UseStationarityProperties()) {
-        ApplyNoiseGate(config_.echo_model, X2);
+        ApplyNoiseGate(optimization_, config_.echo_model.noise_gate_power,
+                       config_.echo_model.noise_gate_slope, X2);
       }
 
       // Subtract the stationary noise power to avoid stationary noise causing
       // excessive echo suppression.
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        X2[k] -= config_.echo_model.stationary_gate_slope * X2_noise_floor_[k];
-        X2[k] = std::max(0.f, X2[k]);
-      }
+      SubtractNoiseFloor(optimization_,
+                         config_.echo_model.stationary_gate_slope,
+                         X2_noise_floor_, X2);
 
       NonLinearEstimate(echo_path_gain, X2, R2);
       NonLinearEstimate(echo_path_gain, X2, R2_unbounded);
@@ -259,11 +250,11 @@ void ResidualEchoEstimator::Estimate(
     // Scale the echo according to echo audibility.
     std::array<float, kFftLengthBy2Plus1> residual_scaling;
     aec_state.GetResidualEchoScaling(residual_scaling);
+    aec3::VectorMath vector_math(optimization_);
     for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        R2[ch][k] *= residual_scaling[k];
-        R2_unbounded[ch][k] *= residual_scaling[k];
-      }
+      vector_math.Multiply(R2[ch], residual_scaling, R2[ch]);
+      vector_math.Multiply(R2_unbounded[ch], residual_scaling,
+                           R2_unbounded[ch]);
     }
   }
 }
@@ -283,10 +274,7 @@ void ResidualEchoEstimator::UpdateRenderNoisePower(
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      aec3::VectorMath(optimization_).Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -329,10 +317,7 @@ void ResidualEchoEstimator::UpdateReverb(ReverbType reverb_type,
   if (num_render_channels_ > 1) {
     render_power_data.fill(0.f);
     for (size_t ch = 0; ch < num_render_channels_; ++ch) {
-      const auto& channel_power = X2[ch];
-      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-        render_power_data[k] += channel_power[k];
-      }
+      aec3::VectorMath(optimization_).Accumulate(X2[ch], render_power_data);
     }
     render_power = render_power_data;
   }
@@ -358,9 +343,7 @@ void ResidualEchoEstimator::AddReverb(
   ArrayView<const float, kFftLengthBy2Plus1> reverb_power =
       echo_reverb_.reverb();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      R2[ch][k] += reverb_power[k];
-    }
+    aec3::VectorMath(optimization_).Accumulate(reverb_power, R2[ch]);
   }
 }
 
@@ -11,10 +11,11 @@
 #include "modules/audio_processing/aec3/signal_dependent_erle_estimator.h"
 
 #include <algorithm>
-#include <functional>
 #include <numeric>
 
 #include "modules/audio_processing/aec3/spectrum_buffer.h"
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
@@ -115,12 +116,24 @@ SetMaxErleSubbands(float max_erle_l, float max_erle_h, size_t limit_subband_l) {
   return max_erle;
 }
 
+std::array<float, kFftLengthBy2Plus1> SetMaxErleBands(
+    const std::array<size_t, kFftLengthBy2Plus1>& band_to_subband,
+    const std::array<float, SignalDependentErleEstimator::kSubbands>&
+        max_erle_subbands) {
+  std::array<float, kFftLengthBy2Plus1> max_erle;
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    max_erle[k] = max_erle_subbands[band_to_subband[k]];
+  }
+  return max_erle;
+}
+
 }  // namespace
 
 SignalDependentErleEstimator::SignalDependentErleEstimator(
     const EchoCanceller3Config& config,
     size_t num_capture_channels)
-    : min_erle_(config.erle.min),
+    : optimization_(DetectOptimization()),
+      min_erle_(config.erle.min),
       num_sections_(config.erle.num_sections),
       num_blocks_(config.filter.refined.length_blocks),
       delay_headroom_blocks_(config.delay.delay_headroom_samples / kBlockSize),
@@ -128,6 +141,7 @@ SignalDependentErleEstimator::SignalDependentErleEstimator(
       max_erle_(SetMaxErleSubbands(config.erle.max_l,
                                    config.erle.max_h,
                                    band_to_subband_[kFftLengthBy2 / 2])),
+      max_erle_bands_(SetMaxErleBands(band_to_subband_, max_erle_)),
       section_boundaries_blocks_(SetSectionsBoundaries(delay_headroom_blocks_,
                                                        num_blocks_,
                                                        num_sections_)),
@@ -199,19 +213,26 @@ void SignalDependentErleEstimator::Update(
 
   // Applies the correction factor to the input erle for getting a more refined
   // erle estimation for the current input signal.
+  const ArrayView<const float> max_erle(max_erle_bands_.data(), kFftLengthBy2);
   for (size_t ch = 0; ch < erle_.size(); ++ch) {
+    std::array<float, kFftLengthBy2> correction_factors;
     for (size_t k = 0; k < kFftLengthBy2; ++k) {
       RTC_DCHECK_GT(correction_factors_[ch].size(), n_active_sections_[ch][k]);
-      float correction_factor =
-          correction_factors_[ch][n_active_sections_[ch][k]]
-                             [band_to_subband_[k]];
-      erle_[ch][k] = SafeClamp(average_erle[ch][k] * correction_factor,
-                               min_erle_, max_erle_[band_to_subband_[k]]);
-      if (use_onset_detection_) {
-        erle_onset_compensated_[ch][k] =
-            SafeClamp(average_erle_onset_compensated[ch][k] * correction_factor,
-                      min_erle_, max_erle_[band_to_subband_[k]]);
-      }
+      correction_factors[k] = correction_factors_[ch][n_active_sections_[ch][k]]
+                                                 [band_to_subband_[k]];
+    }
+    ApplyErleCorrection(
+        optimization_,
+        ArrayView<const float>(average_erle[ch].data(), kFftLengthBy2),
+        correction_factors, min_erle_, max_erle,
+        ArrayView<float>(erle_[ch].data(), kFftLengthBy2));
+    if (use_onset_detection_) {
+      ApplyErleCorrection(
+          optimization_,
+          ArrayView<const float>(average_erle_onset_compensated[ch].data(),
+                                 kFftLengthBy2),
+          correction_factors, min_erle_, max_erle,
+          ArrayView<float>(erle_onset_compensated_[ch].data(), kFftLengthBy2));
     }
   }
 }
@@ -351,6 +372,7 @@ void SignalDependentErleEstimator::ComputeEchoEstimatePerFilterSection(
   const size_t num_render_channels = spectrum_render_buffer.buffer[0].size();
   const size_t num_capture_channels = S2_section_accum_.size();
   const float one_by_num_render_channels = 1.f / num_render_channels;
+  aec3::VectorMath vector_math(optimization_);
 
   RTC_DCHECK_EQ(S2_section_accum_.size(), filter_frequency_responses.size());
 
@@ -380,23 +402,18 @@ void SignalDependentErleEstimator::ComputeEchoEstimatePerFilterSection(
                 one_by_num_render_channels;
           }
         }
-        std::transform(H2_section.begin(), H2_section.end(),
-                       filter_frequency_responses[capture_ch][block].begin(),
-                       H2_section.begin(), std::plus<float>());
+        vector_math.Accumulate(filter_frequency_responses[capture_ch][block],
+                               H2_section);
         idx_render = spectrum_render_buffer.IncIndex(idx_render);
       }
 
-      std::transform(X2_section.begin(), X2_section.end(), H2_section.begin(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     std::multiplies<float>());
+      vector_math.Multiply(X2_section, H2_section,
+                           S2_section_accum_[capture_ch][section]);
     }
 
     for (size_t section = 1; section < num_sections_; ++section) {
-      std::transform(S2_section_accum_[capture_ch][section - 1].begin(),
-                     S2_section_accum_[capture_ch][section - 1].end(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     S2_section_accum_[capture_ch][section].begin(),
-                     std::plus<float>());
+      vector_math.Accumulate(S2_section_accum_[capture_ch][section - 1],
+                             S2_section_accum_[capture_ch][section]);
     }
   }
 }
@@ -80,12 +80,15 @@ class SignalDependentErleEstimator {
 
   void ComputeActiveFilterSections();
 
+  const Aec3Optimization optimization_;
   const float min_erle_;
   const size_t num_sections_;
   const size_t num_blocks_;
   const size_t delay_headroom_blocks_;
   const std::array<size_t, kFftLengthBy2Plus1> band_to_subband_;
   const std::array<float, kSubbands> max_erle_;
+  // The maximum ERLE of the subband of each band.
+  const std::array<float, kFftLengthBy2Plus1> max_erle_bands_;
   const std::vector<size_t> section_boundaries_blocks_;
   const bool use_onset_detection_;
   std::vector<std::array<float, kFftLengthBy2Plus1>> erle_;
@@ -15,16 +15,18 @@
 namespace webrtc {
 
 SpectrumBuffer::SpectrumBuffer(size_t size, size_t num_channels)
-    : size(static_cast<int>(size)),
-      buffer(size,
-             std::vector<std::array<float, kFftLengthBy2Plus1>>(num_channels)) {
-  for (auto& channel : buffer) {
-    for (auto& c : channel) {
-      std::fill(c.begin(), c.end(), 0.f);
-    }
-  }
-}
+    : size(static_cast<int>(size)), buffer(size, num_channels) {}
+
+SpectrumBuffer::SpectrumBuffer(size_t size,
+                               size_t num_channels,
+                               Aec3Arena* arena)
+    : size(static_cast<int>(size)), buffer(size, num_channels, arena) {}
 
 SpectrumBuffer::~SpectrumBuffer() = default;
 
+size_t SpectrumBuffer::ArenaBytes(size_t size, size_t num_channels) {
+  return Aec3Arena::RequiredBytes<std::array<float, kFftLengthBy2Plus1>>(
+      size * num_channels);
+}
+
 }  // namespace webrtc
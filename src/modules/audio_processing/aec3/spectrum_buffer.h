@@ -16,17 +16,23 @@
 #include <array>
 #include <vector>
 
+#include "modules/audio_processing/aec3/aec3_arena.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
-// Struct for bundling a circular buffer of one dimensional vector objects
-// together with the read and write indices.
+// Struct for bundling a circular buffer of per-channel spectra together with
+// the read and write indices.
 struct SpectrumBuffer {
   SpectrumBuffer(size_t size, size_t num_channels);
+  // Stores the spectra in `arena`.
+  SpectrumBuffer(size_t size, size_t num_channels, Aec3Arena* arena);
   ~SpectrumBuffer();
 
+  // Returns the number of arena bytes needed by the buffer.
+  static size_t ArenaBytes(size_t size, size_t num_channels);
+
   int IncIndex(int index) const {
     RTC_DCHECK_EQ(buffer.size(), static_cast<size_t>(size));
     return index < size - 1 ? index + 1 : 0;
@@ -52,7 +58,7 @@ struct SpectrumBuffer {
   void DecReadIndex() { read = DecIndex(read); }
 
   const int size;
-  std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>> buffer;
+  Aec3Array2D<std::array<float, kFftLengthBy2Plus1>> buffer;
   int write = 0;
   int read = 0;
 };
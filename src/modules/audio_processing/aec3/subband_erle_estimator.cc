@@ -11,10 +11,11 @@
 #include "modules/audio_processing/aec3/subband_erle_estimator.h"
 
 #include <algorithm>
-#include <functional>
 
 #include "api/environment/environment.h"
 #include "api/field_trials_view.h"
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+#include "modules/audio_processing/aec3/vector_math.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
 
@@ -26,6 +27,12 @@ constexpr float kX2BandEnergyThreshold = 44015068.0f;
 constexpr int kBlocksToHoldErle = 100;
 constexpr int kBlocksForOnsetDetection = kBlocksToHoldErle + 150;
 constexpr int kPointsToAccumulate = 6;
+// Virtually unbounded ERLE.
+constexpr float kUnboundedErleMax = 100000.0f;
+// The ERLE is estimated in the bands 1 to kFftLengthBy2 - 1, and the edge bands
+// copy their neighbors.
+constexpr size_t kFirstEstimatedBand = 1;
+constexpr size_t kNumEstimatedBands = kFftLengthBy2 - 1;
 
 std::array<float, kFftLengthBy2Plus1> SetMaxErleBands(float max_erle_l,
                                                       float max_erle_h) {
@@ -44,9 +51,12 @@ bool EnableMinErleDuringOnsets(const FieldTrialsView& field_trials) {
 SubbandErleEstimator::SubbandErleEstimator(const Environment& env,
                                            const EchoCanceller3Config& config,
                                            size_t num_capture_channels)
-    : use_onset_detection_(config.erle.onset_detection),
+    : optimization_(DetectOptimization()),
+      use_onset_detection_(config.erle.onset_detection),
       min_erle_(config.erle.min),
       max_erle_(SetMaxErleBands(config.erle.max_l, config.erle.max_h)),
+      max_erle_unbounded_(
+          SetMaxErleBands(kUnboundedErleMax, kUnboundedErleMax)),
       use_min_erle_during_onsets_(
           EnableMinErleDuringOnsets(env.field_trials())),
       accum_spectra_(num_capture_channels),
@@ -74,6 +84,18 @@ void SubbandErleEstimator::Reset() {
   ResetAccumulatedSpectra();
 }
 
+void SubbandErleEstimator::SetErle(
+    ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle) {
+  const size_t num_capture_channels = std::min(erle.size(), erle_.size());
+  for (size_t ch = 0; ch < num_capture_channels; ++ch) {
+    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+      erle_unbounded_[ch][k] = std::max(erle[ch][k], min_erle_);
+      erle_[ch][k] = std::min(erle_unbounded_[ch][k], max_erle_[k]);
+    }
+    erle_onset_compensated_[ch] = erle_[ch];
+  }
+}
+
 void SubbandErleEstimator::Update(
     ArrayView<const float, kFftLengthBy2Plus1> X2,
     ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -122,28 +144,22 @@ void SubbandErleEstimator::UpdateBands(
       continue;
     }
 
-    std::array<float, kFftLengthBy2> new_erle;
-    std::array<bool, kFftLengthBy2> is_erle_updated;
-    is_erle_updated.fill(false);
-
-    for (size_t k = 1; k < kFftLengthBy2; ++k) {
-      if (accum_spectra_.E2[ch][k] > 0.f) {
-        new_erle[k] = accum_spectra_.Y2[ch][k] / accum_spectra_.E2[ch][k];
-        is_erle_updated[k] = true;
-      }
-    }
+    const auto& Y2 = accum_spectra_.Y2[ch];
+    const auto& E2 = accum_spectra_.E2[ch];
+    const auto& low_render_energy = accum_spectra_.low_render_energy[ch];
 
     if (use_onset_detection_) {
       for (size_t k = 1; k < kFftLengthBy2; ++k) {
-        if (is_erle_updated[k] && !accum_spectra_.low_render_energy[ch][k]) {
+        if (E2[k] > 0.f && !low_render_energy[k]) {
           if (coming_onset_[ch][k]) {
             coming_onset_[ch][k] = false;
             if (!use_min_erle_during_onsets_) {
+              const float new_erle = Y2[k] / E2[k];
               float alpha =
-                  new_erle[k] < erle_during_onsets_[ch][k] ? 0.3f : 0.15f;
+                  new_erle < erle_during_onsets_[ch][k] ? 0.3f : 0.15f;
               erle_during_onsets_[ch][k] = SafeClamp(
                   erle_during_onsets_[ch][k] +
-                      alpha * (new_erle[k] - erle_during_onsets_[ch][k]),
+                      alpha * (new_erle - erle_during_onsets_[ch][k]),
                   min_erle_, max_erle_[k]);
             }
           }
@@ -152,32 +168,24 @@ void SubbandErleEstimator::UpdateBands(
       }
     }
 
-    auto update_erle_band = [](float& erle, float new_erle,
-                               bool low_render_energy, float min_erle,
-                               float max_erle) {
-      float alpha = 0.05f;
-      if (new_erle < erle) {
-        alpha = low_render_energy ? 0.f : 0.1f;
-      }
-      erle = SafeClamp(erle + alpha * (new_erle - erle), min_erle, max_erle);
+    // Smooths the ERLE towards Y2 / E2 in the bands where E2 is positive.
+    auto update_erle_bands = [&](ArrayView<const float> max_erle,
+                                 ArrayView<float> erle) {
+      UpdateErleBands(
+          optimization_,
+          ArrayView<const float>(&Y2[kFirstEstimatedBand], kNumEstimatedBands),
+          ArrayView<const float>(&E2[kFirstEstimatedBand], kNumEstimatedBands),
+          ArrayView<const bool>(&low_render_energy[kFirstEstimatedBand],
+                                kNumEstimatedBands),
+          min_erle_, max_erle.subview(kFirstEstimatedBand, kNumEstimatedBands),
+          erle.subview(kFirstEstimatedBand, kNumEstimatedBands));
     };
 
-    for (size_t k = 1; k < kFftLengthBy2; ++k) {
-      if (is_erle_updated[k]) {
-        const bool low_render_energy = accum_spectra_.low_render_energy[ch][k];
-        update_erle_band(erle_[ch][k], new_erle[k], low_render_energy,
-                         min_erle_, max_erle_[k]);
-        if (use_onset_detection_) {
-          update_erle_band(erle_onset_compensated_[ch][k], new_erle[k],
-                           low_render_energy, min_erle_, max_erle_[k]);
-        }
-
-        // Virtually unbounded ERLE.
-        constexpr float kUnboundedErleMax = 100000.0f;
-        update_erle_band(erle_unbounded_[ch][k], new_erle[k], low_render_energy,
-                         min_erle_, kUnboundedErleMax);
-      }
+    update_erle_bands(max_erle_, erle_[ch]);
+    if (use_onset_detection_) {
+      update_erle_bands(max_erle_, erle_onset_compensated_[ch]);
     }
+    update_erle_bands(max_erle_unbounded_, erle_unbounded_[ch]);
   }
 }
 
@@ -236,10 +244,8 @@ void SubbandErleEstimator::UpdateAccumulatedSpectra(
       st.low_render_energy[ch].fill(false);
     }
 
-    std::transform(Y2[ch].begin(), Y2[ch].end(), st.Y2[ch].begin(),
-                   st.Y2[ch].begin(), std::plus<float>());
-    std::transform(E2[ch].begin(), E2[ch].end(), st.E2[ch].begin(),
-                   st.E2[ch].begin(), std::plus<float>());
+    aec3::VectorMath(optimization_).Accumulate(Y2[ch], st.Y2[ch]);
+    aec3::VectorMath(optimization_).Accumulate(E2[ch], st.E2[ch]);
 
     for (size_t k = 0; k < X2.size(); ++k) {
       st.low_render_energy[ch][k] =
@@ -36,6 +36,10 @@ class SubbandErleEstimator {
   // Resets the ERLE estimator.
   void Reset();
 
+  // Sets the ERLE estimates, e.g., from a previous instance. The estimates are
+  // bounded as when updated.
+  void SetErle(ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle);
+
   // Updates the ERLE estimate.
   void Update(ArrayView<const float, kFftLengthBy2Plus1> X2,
               ArrayView<const std::array<float, kFftLengthBy2Plus1>> Y2,
@@ -86,9 +90,11 @@ class SubbandErleEstimator {
   void UpdateBands(const std::vector<bool>& converged_filters);
   void DecreaseErlePerBandForLowRenderSignals();
 
+  const Aec3Optimization optimization_;
   const bool use_onset_detection_;
   const float min_erle_;
   const std::array<float, kFftLengthBy2Plus1> max_erle_;
+  const std::array<float, kFftLengthBy2Plus1> max_erle_unbounded_;
   const bool use_min_erle_during_onsets_;
   AccumulatedSpectra accum_spectra_;
   // ERLE without special handling of render onsets.
@@ -69,7 +69,23 @@ Subtractor::Subtractor(const Environment& env,
                        size_t num_capture_channels,
                        ApmDataDumper* data_dumper,
                        Aec3Optimization optimization)
-    : fft_(),
+    : Subtractor(env,
+                 config,
+                 num_render_channels,
+                 num_capture_channels,
+                 data_dumper,
+                 optimization,
+                 /*workers=*/nullptr) {}
+
+Subtractor::Subtractor(const Environment& env,
+                       const EchoCanceller3Config& config,
+                       size_t num_render_channels,
+                       size_t num_capture_channels,
+                       ApmDataDumper* data_dumper,
+                       Aec3Optimization optimization,
+                       CaptureChannelWorkers* workers)
+    : ffts_(num_capture_channels),
+      workers_(workers),
       data_dumper_(data_dumper),
       optimization_(optimization),
       config_(config),
@@ -178,6 +194,42 @@ void Subtractor::ExitInitialState() {
   }
 }
 
+void Subtractor::GetWarmStartState(Aec3WarmStartState* state) const {
+  RTC_DCHECK(state);
+  state->capture_channels.resize(num_capture_channels_);
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    const FftArena& H = refined_filters_[ch]->GetFilter();
+    state->num_render_channels = H.num_channels();
+    auto& filter = state->capture_channels[ch].filter;
+    filter.resize(refined_filters_[ch]->SizePartitions());
+    for (size_t p = 0; p < filter.size(); ++p) {
+      filter[p].resize(H.num_channels());
+      for (size_t render_ch = 0; render_ch < H.num_channels(); ++render_ch) {
+        H[p][render_ch].CopyTo(&filter[p][render_ch]);
+      }
+    }
+  }
+}
+
+void Subtractor::SetWarmStartState(const Aec3WarmStartState& state) {
+  if (state.capture_channels.size() != num_capture_channels_ ||
+      state.num_render_channels !=
+          refined_filters_[0]->GetFilter().num_channels()) {
+    return;
+  }
+  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+    const auto& H = state.capture_channels[ch].filter;
+    if (H.empty()) {
+      continue;
+    }
+    refined_filters_[ch]->SetSizePartitions(
+        std::min(H.size(), refined_filters_[ch]->max_filter_size_partitions()),
+        true);
+    refined_filters_[ch]->SetFilter(H.size(), H);
+    coarse_filter_[ch]->SetFilter(H.size(), H);
+  }
+}
+
 void Subtractor::Process(const RenderBuffer& render_buffer,
                          const Block& capture,
                          const RenderSignalAnalyzer& render_signal_analyzer,
@@ -205,8 +257,13 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
                                &X2_coarse);
   }
 
+  // Gains of the first channel, dumped after the channels are processed.
+  FftData G_refined_dump;
+  FftData G_coarse_dump;
+
   // Process all capture channels
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  ForEachCaptureChannel(workers_, num_capture_channels_, [&](size_t ch) {
+    const Aec3Fft& fft = ffts_[ch];
     SubtractorOutput& output = outputs[ch];
     ArrayView<const float> y = capture.View(/*band=*/0, ch);
     FftData& E_refined = output.E_refined;
@@ -219,10 +276,10 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
 
     // Form the outputs of the refined and coarse filters.
     refined_filters_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_refined, &output.s_refined);
+    PredictionError(fft, S, y, &e_refined, &output.s_refined);
 
     coarse_filter_[ch]->Filter(render_buffer, &S);
-    PredictionError(fft_, S, y, &e_coarse, &output.s_coarse);
+    PredictionError(fft, S, y, &e_coarse, &output.s_coarse);
 
     // Compute the signal powers in the subtractor output.
     output.ComputeMetrics(y);
@@ -242,8 +299,8 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     }
 
     // Compute the FFts of the refined and coarse filter outputs.
-    fft_.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
-    fft_.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
+    fft.ZeroPaddedFft(e_refined, Aec3Fft::Window::kHanning, &E_refined);
+    fft.ZeroPaddedFft(e_coarse, Aec3Fft::Window::kHanning, &E_coarse);
 
     // Compute spectra for future use.
     E_coarse.Spectrum(optimization_, output.E2_coarse);
@@ -273,9 +330,8 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
     refined_filters_[ch]->ComputeFrequencyResponse(
         &refined_frequency_responses_[ch]);
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_refined", G.im);
+    if (ch == 0 && ApmDataDumper::IsAvailable()) {
+      G_refined_dump.Assign(G);
     }
 
     // Update the coarse filter.
@@ -308,23 +364,25 @@ void Subtractor::Process(const RenderBuffer& render_buffer,
       coarse_filter_[ch]->Adapt(render_buffer, G);
     }
 
-    if (ch == 0) {
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.re);
-      data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G.im);
-      filter_misadjustment_estimators_[ch].Dump(data_dumper_);
-      DumpFilters();
+    if (ch == 0 && ApmDataDumper::IsAvailable()) {
+      G_coarse_dump.Assign(G);
     }
 
     std::for_each(e_refined.begin(), e_refined.end(),
                   [](float& a) { a = SafeClamp(a, -32768.f, 32767.f); });
-
-    if (ch == 0) {
-      data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
-                            &e_refined[0], 16000, 1);
-      data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
-                            &e_coarse[0], 16000, 1);
-    }
-  }
+  });
+
+  // The data dumper is not thread-safe, see ForEachCaptureChannel().
+  data_dumper_->DumpRaw("aec3_subtractor_G_refined", G_refined_dump.re);
+  data_dumper_->DumpRaw("aec3_subtractor_G_refined", G_refined_dump.im);
+  data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G_coarse_dump.re);
+  data_dumper_->DumpRaw("aec3_subtractor_G_coarse", G_coarse_dump.im);
+  filter_misadjustment_estimators_[0].Dump(data_dumper_);
+  DumpFilters();
+  data_dumper_->DumpWav("aec3_refined_filters_output", kBlockSize,
+                        &outputs[0].e_refined[0], 16000, 1);
+  data_dumper_->DumpWav("aec3_coarse_filter_output", kBlockSize,
+                        &outputs[0].e_coarse[0], 16000, 1);
 }
 
 void Subtractor::FilterMisadjustmentEstimator::Update(
@@ -25,12 +25,14 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/aec_state.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/capture_channel_workers.h"
 #include "modules/audio_processing/aec3/coarse_filter_update_gain.h"
 #include "modules/audio_processing/aec3/echo_path_variability.h"
 #include "modules/audio_processing/aec3/refined_filter_update_gain.h"
 #include "modules/audio_processing/aec3/render_buffer.h"
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
+#include "modules/audio_processing/aec3/warm_start_state.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
@@ -45,6 +47,14 @@ class Subtractor {
              size_t num_capture_channels,
              ApmDataDumper* data_dumper,
              Aec3Optimization optimization);
+  // As above, but processes the capture channels on `workers` if not null.
+  Subtractor(const Environment& env,
+             const EchoCanceller3Config& config,
+             size_t num_render_channels,
+             size_t num_capture_channels,
+             ApmDataDumper* data_dumper,
+             Aec3Optimization optimization,
+             CaptureChannelWorkers* workers);
   ~Subtractor();
   Subtractor(const Subtractor&) = delete;
   Subtractor& operator=(const Subtractor&) = delete;
@@ -61,6 +71,12 @@ class Subtractor {
   // Exits the initial state.
   void ExitInitialState();
 
+  // Stores the refined filters in `state`, and restores them from it. The
+  // coarse filters are reseeded from the restored refined filters. Filters of
+  // another channel layout are not restored.
+  void GetWarmStartState(Aec3WarmStartState* state) const;
+  void SetWarmStartState(const Aec3WarmStartState& state);
+
   // Returns the block-wise frequency responses for the refined adaptive
   // filters.
   const std::vector<std::vector<std::array<float, kFftLengthBy2Plus1>>>&
@@ -127,7 +143,10 @@ class Subtractor {
     int overhang_ = 0.f;
   };
 
-  const Aec3Fft fft_;
+  // One FFT per capture channel, as the channels may be processed
+  // concurrently.
+  const std::vector<Aec3Fft> ffts_;
+  CaptureChannelWorkers* const workers_;
   ApmDataDumper* data_dumper_;
   const Aec3Optimization optimization_;
   const EchoCanceller3Config config_;
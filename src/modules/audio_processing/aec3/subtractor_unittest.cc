@@ -34,8 +34,10 @@
 #include "modules/audio_processing/aec3/render_signal_analyzer.h"
 #include "modules/audio_processing/aec3/subtractor_output.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "modules/audio_processing/test/performance_timer.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gtest.h"
@@ -236,6 +238,44 @@ TEST(Subtractor, Convergence) {
   }
 }
 
+// Verifies that the refined filters are restored from a warm start state, and
+// that a state stored for another render channel layout is ignored.
+TEST(Subtractor, RestoresWarmStartState) {
+  const Environment env = CreateEnvironment();
+  ApmDataDumper data_dumper(42);
+  EchoCanceller3Config config;
+  Subtractor subtractor(env, config, 1, 1, &data_dumper, DetectOptimization());
+
+  Aec3WarmStartState state;
+  subtractor.GetWarmStartState(&state);
+  ASSERT_EQ(1u, state.num_render_channels);
+  ASSERT_EQ(1u, state.capture_channels.size());
+  auto& filter = state.capture_channels[0].filter;
+  ASSERT_FALSE(filter.empty());
+  for (size_t p = 0; p < filter.size(); ++p) {
+    filter[p][0].re.fill(static_cast<float>(p + 1));
+  }
+
+  Subtractor restored(env, config, 1, 1, &data_dumper, DetectOptimization());
+  restored.SetWarmStartState(state);
+  Aec3WarmStartState restored_state;
+  restored.GetWarmStartState(&restored_state);
+  ASSERT_EQ(filter.size(), restored_state.capture_channels[0].filter.size());
+  for (size_t p = 0; p < filter.size(); ++p) {
+    EXPECT_EQ(filter[p][0].re,
+              restored_state.capture_channels[0].filter[p][0].re);
+  }
+
+  Subtractor stereo(env, config, 2, 1, &data_dumper, DetectOptimization());
+  stereo.SetWarmStartState(state);
+  Aec3WarmStartState stereo_state;
+  stereo.GetWarmStartState(&stereo_state);
+  EXPECT_EQ(2u, stereo_state.num_render_channels);
+  for (const auto& H : stereo_state.capture_channels[0].filter) {
+    EXPECT_EQ(0.f, H[0].re[0]);
+  }
+}
+
 // Verifies that the subtractor is able to handle the case when the refined
 // filter is longer than the coarse filter.
 TEST(Subtractor, RefinedFilterLongerThanCoarseFilter) {
@@ -344,4 +384,60 @@ TEST_P(SubtractorMultiChannelUpToFourRender,
     EXPECT_NEAR(1.f, echo_to_nearend_power, 0.25f);
   }
 }
+
+// Measures the cost of the filtering and adaptation of the subtractor for
+// 1, 2 and 8 render channels with the default filter lengths.
+TEST(Subtractor, DISABLED_Benchmark) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+  constexpr int kNumBlocks = 5000;
+  const Environment env = CreateEnvironment();
+  const EchoCanceller3Config config;
+  for (size_t num_render_channels : {1, 2, 8}) {
+    ApmDataDumper data_dumper(42);
+    Subtractor subtractor(env, config, num_render_channels,
+                          /*num_capture_channels=*/1, &data_dumper,
+                          DetectOptimization());
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(config, kSampleRateHz, num_render_channels));
+    RenderSignalAnalyzer render_signal_analyzer(config);
+    AecState aec_state(env, config, /*num_capture_channels=*/1);
+    Random random_generator(42U);
+    Block x(kNumBands, num_render_channels);
+    Block y(/*num_bands=*/1, /*num_capture_channels=*/1);
+    std::vector<SubtractorOutput> output(1);
+
+    test::PerformanceTimer timer(kNumBlocks);
+    for (int block_num = 0; block_num < kNumBlocks; ++block_num) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        RandomizeSampleVector(&random_generator, x.View(/*band=*/0, ch));
+      }
+      // The capture signal is a scaled copy of the first render channel, so
+      // that the filters keep adapting.
+      ArrayView<const float> x0 = x.View(/*band=*/0, /*channel=*/0);
+      ArrayView<float> y0 = y.View(/*band=*/0, /*channel=*/0);
+      for (size_t k = 0; k < kBlockSize; ++k) {
+        y0[k] = 0.5f * x0[k];
+      }
+
+      render_delay_buffer->Insert(x);
+      if (block_num == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      render_signal_analyzer.Update(*render_delay_buffer->GetRenderBuffer(),
+                                    aec_state.MinDirectPathFilterDelay());
+
+      timer.StartTimer();
+      subtractor.Process(*render_delay_buffer->GetRenderBuffer(), y,
+                         render_signal_analyzer, aec_state, output);
+      timer.StopTimer();
+    }
+    RTC_LOG(LS_INFO) << "Subtractor, " << num_render_channels
+                     << " render channels: " << timer.GetDurationAverage()
+                     << " +/- " << timer.GetDurationStandardDeviation()
+                     << " us per block";
+  }
+}
+
 }  // namespace webrtc
@@ -63,10 +63,20 @@ const float kSqrtHanning[kFftLength] = {
 SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
                                      int sample_rate_hz,
                                      size_t num_capture_channels)
+    : SuppressionFilter(optimization,
+                        sample_rate_hz,
+                        num_capture_channels,
+                        /*workers=*/nullptr) {}
+
+SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
+                                     int sample_rate_hz,
+                                     size_t num_capture_channels,
+                                     CaptureChannelWorkers* workers)
     : optimization_(optimization),
       sample_rate_hz_(sample_rate_hz),
       num_capture_channels_(num_capture_channels),
-      fft_(),
+      ffts_(num_capture_channels),
+      workers_(workers),
       e_output_old_(NumBandsForRate(sample_rate_hz_),
                     std::vector<std::array<float, kFftLengthBy2>>(
                         num_capture_channels_)) {
@@ -100,7 +110,8 @@ void SuppressionFilter::ApplyGain(
   const float high_bands_noise_scaling =
       0.4f * std::sqrt(1.f - high_bands_gain * high_bands_gain);
 
-  for (size_t ch = 0; ch < num_capture_channels_; ++ch) {
+  ForEachCaptureChannel(workers_, num_capture_channels_, [&](size_t ch) {
+    const Aec3Fft& fft = ffts_[ch];
     FftData E;
 
     // Analysis filterbank.
@@ -119,7 +130,7 @@ void SuppressionFilter::ApplyGain(
     // Synthesis filterbank.
     std::array<float, kFftLength> e_extended;
     constexpr float kIfftNormalization = 2.f / kFftLength;
-    fft_.Ifft(E, &e_extended);
+    fft.Ifft(E, &e_extended);
 
     auto e0 = e->View(/*band=*/0, ch);
     float* e0_old = e_output_old_[0][ch].data();
@@ -149,7 +160,7 @@ void SuppressionFilter::ApplyGain(
     if (e->NumBands() > 1) {
       E.Assign(comfort_noise_high_band[ch]);
       std::array<float, kFftLength> time_domain_high_band_noise;
-      fft_.Ifft(E, &time_domain_high_band_noise);
+      fft.Ifft(E, &time_domain_high_band_noise);
 
       auto e1 = e->View(/*band=*/1, ch);
       const float gain = high_bands_noise_scaling * kIfftNormalization;
@@ -174,7 +185,7 @@ void SuppressionFilter::ApplyGain(
         e_band[i] = SafeClamp(e_band[i], -32768.f, 32767.f);
       }
     }
-  }
+  });
 }
 
 }  // namespace webrtc
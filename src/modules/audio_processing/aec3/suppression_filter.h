@@ -17,6 +17,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/aec3_fft.h"
 #include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/capture_channel_workers.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 
 namespace webrtc {
@@ -26,6 +27,11 @@ class SuppressionFilter {
   SuppressionFilter(Aec3Optimization optimization,
                     int sample_rate_hz,
                     size_t num_capture_channels_);
+  // As above, but filters the capture channels on `workers` if not null.
+  SuppressionFilter(Aec3Optimization optimization,
+                    int sample_rate_hz,
+                    size_t num_capture_channels_,
+                    CaptureChannelWorkers* workers);
   ~SuppressionFilter();
 
   SuppressionFilter(const SuppressionFilter&) = delete;
@@ -42,7 +48,10 @@ class SuppressionFilter {
   const Aec3Optimization optimization_;
   const int sample_rate_hz_;
   const size_t num_capture_channels_;
-  const Aec3Fft fft_;
+  // One FFT per capture channel, as the channels may be filtered
+  // concurrently.
+  const std::vector<Aec3Fft> ffts_;
+  CaptureChannelWorkers* const workers_;
   std::vector<std::vector<std::array<float, kFftLengthBy2>>> e_output_old_;
 };
 
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/aec3/dominant_nearend_detector.h"
 #include "modules/audio_processing/aec3/moving_average.h"
 #include "modules/audio_processing/aec3/subband_nearend_detector.h"
+#include "modules/audio_processing/aec3/suppression_kernels.h"
 #include "modules/audio_processing/aec3/vector_math.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -64,21 +65,18 @@ void LimitHighFrequencyGains(bool conservative_hf_suppression,
 
 // Scales the echo according to assessed audibility at the other end.
 void WeightEchoForAudibility(const EchoCanceller3Config& config,
+                             Aec3Optimization optimization,
                              ArrayView<const float> echo,
                              ArrayView<float> weighted_echo) {
   RTC_DCHECK_EQ(kFftLengthBy2Plus1, echo.size());
   RTC_DCHECK_EQ(kFftLengthBy2Plus1, weighted_echo.size());
 
-  auto weigh = [](float threshold, float normalizer, size_t begin, size_t end,
-                  ArrayView<const float> echo, ArrayView<float> weighted_echo) {
-    for (size_t k = begin; k < end; ++k) {
-      if (echo[k] < threshold) {
-        float tmp = (threshold - echo[k]) * normalizer;
-        weighted_echo[k] = echo[k] * std::max(0.f, 1.f - tmp * tmp);
-      } else {
-        weighted_echo[k] = echo[k];
-      }
-    }
+  auto weigh = [optimization](float threshold, float normalizer, size_t begin,
+                              size_t end, ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo) {
+    ApplyAudibilityWeighting(optimization, threshold, normalizer,
+                             echo.subview(begin, end - begin),
+                             weighted_echo.subview(begin, end - begin));
   };
 
   float threshold = config.echo_audibility.floor_power *
@@ -195,17 +193,9 @@ void SuppressionGain::GainToNoAudibleEcho(
     std::array<float, kFftLengthBy2Plus1>* gain) const {
   const auto& p = dominant_nearend_detector_->IsNearendState() ? nearend_params_
                                                                : normal_params_;
-  for (size_t k = 0; k < gain->size(); ++k) {
-    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
-    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
-    float g = 1.0f;
-    if (enr > p.enr_transparent_[k] && emr > p.emr_transparent_[k]) {
-      g = (p.enr_suppress_[k] - enr) /
-          (p.enr_suppress_[k] - p.enr_transparent_[k]);
-      g = std::max(g, p.emr_transparent_[k] / emr);
-    }
-    (*gain)[k] = g;
-  }
+  ComputeNoAudibleEchoGain(optimization_, nearend, echo, masker,
+                           p.enr_transparent_, p.enr_suppress_,
+                           p.emr_transparent_, *gain);
 }
 
 // Compute the minimum gain as the attenuating gain to put the signal just
@@ -221,12 +211,8 @@ void SuppressionGain::GetMinGain(ArrayView<const float> weighted_residual_echo,
         low_noise_render ? config_.echo_audibility.low_render_limit
                          : config_.echo_audibility.normal_render_limit;
 
-    for (size_t k = 0; k < min_gain.size(); ++k) {
-      min_gain[k] = weighted_residual_echo[k] > 0.f
-                        ? min_echo_power / weighted_residual_echo[k]
-                        : 1.f;
-      min_gain[k] = std::min(min_gain[k], 1.f);
-    }
+    ComputeMinGain(optimization_, min_echo_power, weighted_residual_echo,
+                   min_gain);
 
     if (!initial_state_ ||
         config_.suppressor.lf_smoothing_during_initial_phase) {
@@ -281,7 +267,8 @@ void SuppressionGain::LowerBandGain(
 
     // Weight echo power in terms of audibility.
     std::array<float, kFftLengthBy2Plus1> weighted_residual_echo;
-    WeightEchoForAudibility(config_, residual_echo[ch], weighted_residual_echo);
+    WeightEchoForAudibility(config_, optimization_, residual_echo[ch],
+                            weighted_residual_echo);
 
     std::array<float, kFftLengthBy2Plus1> min_gain;
     GetMinGain(weighted_residual_echo, last_nearend_[ch], last_echo_[ch],
@@ -290,10 +277,7 @@ void SuppressionGain::LowerBandGain(
     GainToNoAudibleEcho(nearend, weighted_residual_echo, comfort_noise[0], &G);
 
     // Clamp gains.
-    for (size_t k = 0; k < gain->size(); ++k) {
-      G[k] = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
-      (*gain)[k] = std::min((*gain)[k], G[k]);
-    }
+    ApplyGainBounds(optimization_, min_gain, max_gain, G, *gain);
 
     // Store data required for the gain computation of the next block.
     std::copy(nearend.begin(), nearend.end(), last_nearend_[ch].begin());
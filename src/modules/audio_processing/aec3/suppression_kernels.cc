@@ -0,0 +1,846 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
+
+namespace webrtc {
+namespace aec3 {
+
+namespace {
+
+static_assert(sizeof(bool) == 1, "The low render energy flags are bytes");
+
+#if defined(WEBRTC_HAS_NEON)
+// Computes a / b. ARMv7 lacks a vector division, for which two Newton-Raphson
+// iterations refine the reciprocal estimate.
+inline float32x4_t Divide_NEON(float32x4_t a, float32x4_t b) {
+#if defined(WEBRTC_ARCH_ARM64)
+  return vdivq_f32(a, b);
+#else
+  float32x4_t b_inv = vrecpeq_f32(b);
+  b_inv = vmulq_f32(vrecpsq_f32(b, b_inv), b_inv);
+  b_inv = vmulq_f32(vrecpsq_f32(b, b_inv), b_inv);
+  return vmulq_f32(a, b_inv);
+#endif
+}
+
+// Expands four bool flags into a lane mask.
+inline uint32x4_t LoadFlags_NEON(const bool* flags) {
+  uint32_t bytes;
+  memcpy(&bytes, flags, sizeof(bytes));
+  const uint8x8_t b = vreinterpret_u8_u32(vdup_n_u32(bytes));
+  const uint32x4_t b_32 = vmovl_u16(vget_low_u16(vmovl_u8(b)));
+  return vcgtq_u32(b_32, vdupq_n_u32(0));
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Selects a where the mask is set, and b elsewhere.
+inline __m128 Select_SSE2(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Expands four bool flags into a lane mask.
+inline __m128 LoadFlags_SSE2(const bool* flags) {
+  int32_t bytes;
+  memcpy(&bytes, flags, sizeof(bytes));
+  const __m128i zero = _mm_setzero_si128();
+  __m128i b = _mm_cvtsi32_si128(bytes);
+  b = _mm_unpacklo_epi8(b, zero);
+  b = _mm_unpacklo_epi16(b, zero);
+  return _mm_castsi128_ps(_mm_cmpgt_epi32(b, zero));
+}
+#endif
+
+}  // namespace
+
+void NoAudibleEchoGain(ArrayView<const float> nearend,
+                       ArrayView<const float> echo,
+                       ArrayView<const float> masker,
+                       ArrayView<const float> enr_transparent,
+                       ArrayView<const float> enr_suppress,
+                       ArrayView<const float> emr_transparent,
+                       ArrayView<float> gain) {
+  for (size_t k = 0; k < gain.size(); ++k) {
+    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
+    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
+    float g = 1.0f;
+    if (enr > enr_transparent[k] && emr > emr_transparent[k]) {
+      g = (enr_suppress[k] - enr) / (enr_suppress[k] - enr_transparent[k]);
+      g = std::max(g, emr_transparent[k] / emr);
+    }
+    gain[k] = g;
+  }
+}
+
+void AudibilityWeighting(float threshold,
+                         float normalizer,
+                         ArrayView<const float> echo,
+                         ArrayView<float> weighted_echo) {
+  for (size_t k = 0; k < echo.size(); ++k) {
+    if (echo[k] < threshold) {
+      float tmp = (threshold - echo[k]) * normalizer;
+      weighted_echo[k] = echo[k] * std::max(0.f, 1.f - tmp * tmp);
+    } else {
+      weighted_echo[k] = echo[k];
+    }
+  }
+}
+
+void MinGain(float min_echo_power,
+             ArrayView<const float> weighted_residual_echo,
+             ArrayView<float> min_gain) {
+  for (size_t k = 0; k < min_gain.size(); ++k) {
+    min_gain[k] = weighted_residual_echo[k] > 0.f
+                      ? min_echo_power / weighted_residual_echo[k]
+                      : 1.f;
+    min_gain[k] = std::min(min_gain[k], 1.f);
+  }
+}
+
+void GainBounds(ArrayView<const float> min_gain,
+                ArrayView<const float> max_gain,
+                ArrayView<float> G,
+                ArrayView<float> gain) {
+  for (size_t k = 0; k < gain.size(); ++k) {
+    G[k] = std::max(std::min(G[k], max_gain[k]), min_gain[k]);
+    gain[k] = std::min(gain[k], G[k]);
+  }
+}
+
+void LinearResidualEcho(ArrayView<const float> S2_linear,
+                        ArrayView<const float> erle,
+                        ArrayView<float> R2) {
+  for (size_t k = 0; k < R2.size(); ++k) {
+    R2[k] = S2_linear[k] / erle[k];
+  }
+}
+
+void NoiseGate(float noise_gate_power,
+               float noise_gate_slope,
+               ArrayView<float> X2) {
+  for (size_t k = 0; k < X2.size(); ++k) {
+    if (noise_gate_power > X2[k]) {
+      X2[k] = std::max(0.f,
+                       X2[k] - noise_gate_slope * (noise_gate_power - X2[k]));
+    }
+  }
+}
+
+void NoiseFloorSubtraction(float slope,
+                           ArrayView<const float> X2_noise_floor,
+                           ArrayView<float> X2) {
+  for (size_t k = 0; k < X2.size(); ++k) {
+    X2[k] -= slope * X2_noise_floor[k];
+    X2[k] = std::max(0.f, X2[k]);
+  }
+}
+
+void ErleBandsUpdate(ArrayView<const float> Y2,
+                     ArrayView<const float> E2,
+                     ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     ArrayView<const float> max_erle,
+                     ArrayView<float> erle) {
+  for (size_t k = 0; k < erle.size(); ++k) {
+    if (E2[k] > 0.f) {
+      const float new_erle = Y2[k] / E2[k];
+      float alpha = 0.05f;
+      if (new_erle < erle[k]) {
+        alpha = low_render_energy[k] ? 0.f : 0.1f;
+      }
+      erle[k] = SafeClamp(erle[k] + alpha * (new_erle - erle[k]), min_erle,
+                          max_erle[k]);
+    }
+  }
+}
+
+void ErleCorrection(ArrayView<const float> average_erle,
+                    ArrayView<const float> correction_factors,
+                    float min_erle,
+                    ArrayView<const float> max_erle,
+                    ArrayView<float> erle) {
+  for (size_t k = 0; k < erle.size(); ++k) {
+    erle[k] = SafeClamp(average_erle[k] * correction_factors[k], min_erle,
+                        max_erle[k]);
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON)
+void NoAudibleEchoGain_NEON(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t one = vdupq_n_f32(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t echo_k = vld1q_f32(&echo[k]);
+    const float32x4_t enr_t = vld1q_f32(&enr_transparent[k]);
+    const float32x4_t enr_s = vld1q_f32(&enr_suppress[k]);
+    const float32x4_t emr_t = vld1q_f32(&emr_transparent[k]);
+    const float32x4_t enr =
+        Divide_NEON(echo_k, vaddq_f32(vld1q_f32(&nearend[k]), one));
+    const float32x4_t emr =
+        Divide_NEON(echo_k, vaddq_f32(vld1q_f32(&masker[k]), one));
+    const uint32x4_t suppress =
+        vandq_u32(vcgtq_f32(enr, enr_t), vcgtq_f32(emr, emr_t));
+    float32x4_t g =
+        Divide_NEON(vsubq_f32(enr_s, enr), vsubq_f32(enr_s, enr_t));
+    g = vmaxq_f32(g, Divide_NEON(emr_t, emr));
+    vst1q_f32(&gain[k], vbslq_f32(suppress, g, one));
+  }
+  NoAudibleEchoGain(nearend.subview(k), echo.subview(k), masker.subview(k),
+                    enr_transparent.subview(k), enr_suppress.subview(k),
+                    emr_transparent.subview(k), gain.subview(k));
+}
+
+void AudibilityWeighting_NEON(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo) {
+  const int size = static_cast<int>(echo.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t threshold_v = vdupq_n_f32(threshold);
+  const float32x4_t normalizer_v = vdupq_n_f32(normalizer);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t echo_k = vld1q_f32(&echo[k]);
+    const uint32x4_t below = vcltq_f32(echo_k, threshold_v);
+    const float32x4_t tmp =
+        vmulq_f32(vsubq_f32(threshold_v, echo_k), normalizer_v);
+    const float32x4_t weight =
+        vmaxq_f32(zero, vsubq_f32(one, vmulq_f32(tmp, tmp)));
+    vst1q_f32(&weighted_echo[k],
+              vbslq_f32(below, vmulq_f32(echo_k, weight), echo_k));
+  }
+  AudibilityWeighting(threshold, normalizer, echo.subview(k),
+                      weighted_echo.subview(k));
+}
+
+void MinGain_NEON(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain) {
+  const int size = static_cast<int>(min_gain.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t min_echo_power_v = vdupq_n_f32(min_echo_power);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t echo_k = vld1q_f32(&weighted_residual_echo[k]);
+    const float32x4_t g = vbslq_f32(
+        vcgtq_f32(echo_k, zero), Divide_NEON(min_echo_power_v, echo_k), one);
+    vst1q_f32(&min_gain[k], vminq_f32(g, one));
+  }
+  MinGain(min_echo_power, weighted_residual_echo.subview(k),
+          min_gain.subview(k));
+}
+
+void GainBounds_NEON(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 2;
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    float32x4_t G_k = vminq_f32(vld1q_f32(&G[k]), vld1q_f32(&max_gain[k]));
+    G_k = vmaxq_f32(G_k, vld1q_f32(&min_gain[k]));
+    vst1q_f32(&G[k], G_k);
+    vst1q_f32(&gain[k], vminq_f32(vld1q_f32(&gain[k]), G_k));
+  }
+  GainBounds(min_gain.subview(k), max_gain.subview(k), G.subview(k),
+             gain.subview(k));
+}
+
+void LinearResidualEcho_NEON(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2) {
+  const int size = static_cast<int>(R2.size());
+  const int vector_limit = size >> 2;
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    vst1q_f32(&R2[k],
+              Divide_NEON(vld1q_f32(&S2_linear[k]), vld1q_f32(&erle[k])));
+  }
+  LinearResidualEcho(S2_linear.subview(k), erle.subview(k), R2.subview(k));
+}
+
+void NoiseGate_NEON(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t power = vdupq_n_f32(noise_gate_power);
+  const float32x4_t slope = vdupq_n_f32(noise_gate_slope);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t X2_k = vld1q_f32(&X2[k]);
+    const float32x4_t gated = vmaxq_f32(
+        zero, vsubq_f32(X2_k, vmulq_f32(slope, vsubq_f32(power, X2_k))));
+    vst1q_f32(&X2[k], vbslq_f32(vcgtq_f32(power, X2_k), gated, X2_k));
+  }
+  NoiseGate(noise_gate_power, noise_gate_slope, X2.subview(k));
+}
+
+void NoiseFloorSubtraction_NEON(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t slope_v = vdupq_n_f32(slope);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t X2_k = vsubq_f32(
+        vld1q_f32(&X2[k]), vmulq_f32(slope_v, vld1q_f32(&X2_noise_floor[k])));
+    vst1q_f32(&X2[k], vmaxq_f32(zero, X2_k));
+  }
+  NoiseFloorSubtraction(slope, X2_noise_floor.subview(k), X2.subview(k));
+}
+
+void ErleBandsUpdate_NEON(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t alpha_increase = vdupq_n_f32(0.05f);
+  const float32x4_t alpha_decrease = vdupq_n_f32(0.1f);
+  const float32x4_t min_erle_v = vdupq_n_f32(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t E2_k = vld1q_f32(&E2[k]);
+    const float32x4_t erle_k = vld1q_f32(&erle[k]);
+    const float32x4_t new_erle = Divide_NEON(vld1q_f32(&Y2[k]), E2_k);
+    const float32x4_t decrease_alpha =
+        vbslq_f32(LoadFlags_NEON(&low_render_energy[k]), zero, alpha_decrease);
+    const float32x4_t alpha =
+        vbslq_f32(vcltq_f32(new_erle, erle_k), decrease_alpha, alpha_increase);
+    float32x4_t updated =
+        vaddq_f32(erle_k, vmulq_f32(alpha, vsubq_f32(new_erle, erle_k)));
+    updated = vminq_f32(vmaxq_f32(updated, min_erle_v),
+                        vld1q_f32(&max_erle[k]));
+    vst1q_f32(&erle[k], vbslq_f32(vcgtq_f32(E2_k, zero), updated, erle_k));
+  }
+  ErleBandsUpdate(Y2.subview(k), E2.subview(k), low_render_energy.subview(k),
+                  min_erle, max_erle.subview(k), erle.subview(k));
+}
+
+void ErleCorrection_NEON(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 2;
+  const float32x4_t min_erle_v = vdupq_n_f32(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const float32x4_t corrected = vmulq_f32(
+        vld1q_f32(&average_erle[k]), vld1q_f32(&correction_factors[k]));
+    vst1q_f32(&erle[k], vminq_f32(vmaxq_f32(corrected, min_erle_v),
+                                  vld1q_f32(&max_erle[k])));
+  }
+  ErleCorrection(average_erle.subview(k), correction_factors.subview(k),
+                 min_erle, max_erle.subview(k), erle.subview(k));
+}
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void NoAudibleEchoGain_SSE2(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 2;
+  const __m128 one = _mm_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 echo_k = _mm_loadu_ps(&echo[k]);
+    const __m128 enr_t = _mm_loadu_ps(&enr_transparent[k]);
+    const __m128 enr_s = _mm_loadu_ps(&enr_suppress[k]);
+    const __m128 emr_t = _mm_loadu_ps(&emr_transparent[k]);
+    const __m128 enr =
+        _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&nearend[k]), one));
+    const __m128 emr =
+        _mm_div_ps(echo_k, _mm_add_ps(_mm_loadu_ps(&masker[k]), one));
+    const __m128 suppress =
+        _mm_and_ps(_mm_cmpgt_ps(enr, enr_t), _mm_cmpgt_ps(emr, emr_t));
+    __m128 g = _mm_div_ps(_mm_sub_ps(enr_s, enr), _mm_sub_ps(enr_s, enr_t));
+    g = _mm_max_ps(g, _mm_div_ps(emr_t, emr));
+    _mm_storeu_ps(&gain[k], Select_SSE2(suppress, g, one));
+  }
+  NoAudibleEchoGain(nearend.subview(k), echo.subview(k), masker.subview(k),
+                    enr_transparent.subview(k), enr_suppress.subview(k),
+                    emr_transparent.subview(k), gain.subview(k));
+}
+
+void AudibilityWeighting_SSE2(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo) {
+  const int size = static_cast<int>(echo.size());
+  const int vector_limit = size >> 2;
+  const __m128 threshold_v = _mm_set1_ps(threshold);
+  const __m128 normalizer_v = _mm_set1_ps(normalizer);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 echo_k = _mm_loadu_ps(&echo[k]);
+    const __m128 below = _mm_cmplt_ps(echo_k, threshold_v);
+    const __m128 tmp =
+        _mm_mul_ps(_mm_sub_ps(threshold_v, echo_k), normalizer_v);
+    const __m128 weight =
+        _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(tmp, tmp)));
+    _mm_storeu_ps(&weighted_echo[k],
+                  Select_SSE2(below, _mm_mul_ps(echo_k, weight), echo_k));
+  }
+  AudibilityWeighting(threshold, normalizer, echo.subview(k),
+                      weighted_echo.subview(k));
+}
+
+void MinGain_SSE2(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain) {
+  const int size = static_cast<int>(min_gain.size());
+  const int vector_limit = size >> 2;
+  const __m128 min_echo_power_v = _mm_set1_ps(min_echo_power);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 echo_k = _mm_loadu_ps(&weighted_residual_echo[k]);
+    const __m128 g = Select_SSE2(_mm_cmpgt_ps(echo_k, zero),
+                                 _mm_div_ps(min_echo_power_v, echo_k), one);
+    _mm_storeu_ps(&min_gain[k], _mm_min_ps(g, one));
+  }
+  MinGain(min_echo_power, weighted_residual_echo.subview(k),
+          min_gain.subview(k));
+}
+
+void GainBounds_SSE2(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 2;
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    __m128 G_k = _mm_min_ps(_mm_loadu_ps(&G[k]), _mm_loadu_ps(&max_gain[k]));
+    G_k = _mm_max_ps(G_k, _mm_loadu_ps(&min_gain[k]));
+    _mm_storeu_ps(&G[k], G_k);
+    _mm_storeu_ps(&gain[k], _mm_min_ps(_mm_loadu_ps(&gain[k]), G_k));
+  }
+  GainBounds(min_gain.subview(k), max_gain.subview(k), G.subview(k),
+             gain.subview(k));
+}
+
+void LinearResidualEcho_SSE2(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2) {
+  const int size = static_cast<int>(R2.size());
+  const int vector_limit = size >> 2;
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    _mm_storeu_ps(&R2[k], _mm_div_ps(_mm_loadu_ps(&S2_linear[k]),
+                                     _mm_loadu_ps(&erle[k])));
+  }
+  LinearResidualEcho(S2_linear.subview(k), erle.subview(k), R2.subview(k));
+}
+
+void NoiseGate_SSE2(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 2;
+  const __m128 power = _mm_set1_ps(noise_gate_power);
+  const __m128 slope = _mm_set1_ps(noise_gate_slope);
+  const __m128 zero = _mm_setzero_ps();
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 X2_k = _mm_loadu_ps(&X2[k]);
+    const __m128 gated = _mm_max_ps(
+        zero, _mm_sub_ps(X2_k, _mm_mul_ps(slope, _mm_sub_ps(power, X2_k))));
+    _mm_storeu_ps(&X2[k], Select_SSE2(_mm_cmpgt_ps(power, X2_k), gated, X2_k));
+  }
+  NoiseGate(noise_gate_power, noise_gate_slope, X2.subview(k));
+}
+
+void NoiseFloorSubtraction_SSE2(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 2;
+  const __m128 slope_v = _mm_set1_ps(slope);
+  const __m128 zero = _mm_setzero_ps();
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 X2_k =
+        _mm_sub_ps(_mm_loadu_ps(&X2[k]),
+                   _mm_mul_ps(slope_v, _mm_loadu_ps(&X2_noise_floor[k])));
+    _mm_storeu_ps(&X2[k], _mm_max_ps(zero, X2_k));
+  }
+  NoiseFloorSubtraction(slope, X2_noise_floor.subview(k), X2.subview(k));
+}
+
+void ErleBandsUpdate_SSE2(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 2;
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 alpha_increase = _mm_set1_ps(0.05f);
+  const __m128 alpha_decrease = _mm_set1_ps(0.1f);
+  const __m128 min_erle_v = _mm_set1_ps(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 E2_k = _mm_loadu_ps(&E2[k]);
+    const __m128 erle_k = _mm_loadu_ps(&erle[k]);
+    const __m128 new_erle = _mm_div_ps(_mm_loadu_ps(&Y2[k]), E2_k);
+    const __m128 decrease_alpha =
+        _mm_andnot_ps(LoadFlags_SSE2(&low_render_energy[k]), alpha_decrease);
+    const __m128 alpha = Select_SSE2(_mm_cmplt_ps(new_erle, erle_k),
+                                     decrease_alpha, alpha_increase);
+    __m128 updated =
+        _mm_add_ps(erle_k, _mm_mul_ps(alpha, _mm_sub_ps(new_erle, erle_k)));
+    updated = _mm_min_ps(_mm_max_ps(updated, min_erle_v),
+                         _mm_loadu_ps(&max_erle[k]));
+    _mm_storeu_ps(&erle[k],
+                  Select_SSE2(_mm_cmpgt_ps(E2_k, zero), updated, erle_k));
+  }
+  ErleBandsUpdate(Y2.subview(k), E2.subview(k), low_render_energy.subview(k),
+                  min_erle, max_erle.subview(k), erle.subview(k));
+}
+
+void ErleCorrection_SSE2(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 2;
+  const __m128 min_erle_v = _mm_set1_ps(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 4; k += 4) {
+    const __m128 corrected = _mm_mul_ps(_mm_loadu_ps(&average_erle[k]),
+                                        _mm_loadu_ps(&correction_factors[k]));
+    _mm_storeu_ps(&erle[k], _mm_min_ps(_mm_max_ps(corrected, min_erle_v),
+                                       _mm_loadu_ps(&max_erle[k])));
+  }
+  ErleCorrection(average_erle.subview(k), correction_factors.subview(k),
+                 min_erle, max_erle.subview(k), erle.subview(k));
+}
+#endif
+
+}  // namespace aec3
+
+void ComputeNoAudibleEchoGain(Aec3Optimization optimization,
+                              ArrayView<const float> nearend,
+                              ArrayView<const float> echo,
+                              ArrayView<const float> masker,
+                              ArrayView<const float> enr_transparent,
+                              ArrayView<const float> enr_suppress,
+                              ArrayView<const float> emr_transparent,
+                              ArrayView<float> gain) {
+  RTC_DCHECK_EQ(gain.size(), nearend.size());
+  RTC_DCHECK_EQ(gain.size(), echo.size());
+  RTC_DCHECK_EQ(gain.size(), masker.size());
+  RTC_DCHECK_EQ(gain.size(), enr_transparent.size());
+  RTC_DCHECK_EQ(gain.size(), enr_suppress.size());
+  RTC_DCHECK_EQ(gain.size(), emr_transparent.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::NoAudibleEchoGain_SSE2(nearend, echo, masker, enr_transparent,
+                                   enr_suppress, emr_transparent, gain);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::NoAudibleEchoGain_AVX2(nearend, echo, masker, enr_transparent,
+                                   enr_suppress, emr_transparent, gain);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::NoAudibleEchoGain_NEON(nearend, echo, masker, enr_transparent,
+                                   enr_suppress, emr_transparent, gain);
+      break;
+#endif
+    default:
+      aec3::NoAudibleEchoGain(nearend, echo, masker, enr_transparent,
+                              enr_suppress, emr_transparent, gain);
+  }
+}
+
+void ApplyAudibilityWeighting(Aec3Optimization optimization,
+                              float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo) {
+  RTC_DCHECK_EQ(echo.size(), weighted_echo.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::AudibilityWeighting_SSE2(threshold, normalizer, echo,
+                                     weighted_echo);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::AudibilityWeighting_AVX2(threshold, normalizer, echo,
+                                     weighted_echo);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::AudibilityWeighting_NEON(threshold, normalizer, echo,
+                                     weighted_echo);
+      break;
+#endif
+    default:
+      aec3::AudibilityWeighting(threshold, normalizer, echo, weighted_echo);
+  }
+}
+
+void ComputeMinGain(Aec3Optimization optimization,
+                    float min_echo_power,
+                    ArrayView<const float> weighted_residual_echo,
+                    ArrayView<float> min_gain) {
+  RTC_DCHECK_EQ(min_gain.size(), weighted_residual_echo.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::MinGain_SSE2(min_echo_power, weighted_residual_echo, min_gain);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::MinGain_AVX2(min_echo_power, weighted_residual_echo, min_gain);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::MinGain_NEON(min_echo_power, weighted_residual_echo, min_gain);
+      break;
+#endif
+    default:
+      aec3::MinGain(min_echo_power, weighted_residual_echo, min_gain);
+  }
+}
+
+void ApplyGainBounds(Aec3Optimization optimization,
+                     ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain) {
+  RTC_DCHECK_EQ(gain.size(), min_gain.size());
+  RTC_DCHECK_EQ(gain.size(), max_gain.size());
+  RTC_DCHECK_EQ(gain.size(), G.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::GainBounds_SSE2(min_gain, max_gain, G, gain);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::GainBounds_AVX2(min_gain, max_gain, G, gain);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::GainBounds_NEON(min_gain, max_gain, G, gain);
+      break;
+#endif
+    default:
+      aec3::GainBounds(min_gain, max_gain, G, gain);
+  }
+}
+
+void ComputeLinearResidualEcho(Aec3Optimization optimization,
+                               ArrayView<const float> S2_linear,
+                               ArrayView<const float> erle,
+                               ArrayView<float> R2) {
+  RTC_DCHECK_EQ(R2.size(), S2_linear.size());
+  RTC_DCHECK_EQ(R2.size(), erle.size());
+  // Checked here, as the optimized kernels only run the reference kernel on
+  // the bins beyond the last full vector.
+  for (float erle_k : erle) {
+    RTC_DCHECK_LT(0.f, erle_k);
+  }
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::LinearResidualEcho_SSE2(S2_linear, erle, R2);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::LinearResidualEcho_AVX2(S2_linear, erle, R2);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::LinearResidualEcho_NEON(S2_linear, erle, R2);
+      break;
+#endif
+    default:
+      aec3::LinearResidualEcho(S2_linear, erle, R2);
+  }
+}
+
+void ApplyNoiseGate(Aec3Optimization optimization,
+                    float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::NoiseGate_SSE2(noise_gate_power, noise_gate_slope, X2);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::NoiseGate_AVX2(noise_gate_power, noise_gate_slope, X2);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::NoiseGate_NEON(noise_gate_power, noise_gate_slope, X2);
+      break;
+#endif
+    default:
+      aec3::NoiseGate(noise_gate_power, noise_gate_slope, X2);
+  }
+}
+
+void SubtractNoiseFloor(Aec3Optimization optimization,
+                        float slope,
+                        ArrayView<const float> X2_noise_floor,
+                        ArrayView<float> X2) {
+  RTC_DCHECK_EQ(X2.size(), X2_noise_floor.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::NoiseFloorSubtraction_SSE2(slope, X2_noise_floor, X2);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::NoiseFloorSubtraction_AVX2(slope, X2_noise_floor, X2);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::NoiseFloorSubtraction_NEON(slope, X2_noise_floor, X2);
+      break;
+#endif
+    default:
+      aec3::NoiseFloorSubtraction(slope, X2_noise_floor, X2);
+  }
+}
+
+void UpdateErleBands(Aec3Optimization optimization,
+                     ArrayView<const float> Y2,
+                     ArrayView<const float> E2,
+                     ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     ArrayView<const float> max_erle,
+                     ArrayView<float> erle) {
+  RTC_DCHECK_EQ(erle.size(), Y2.size());
+  RTC_DCHECK_EQ(erle.size(), E2.size());
+  RTC_DCHECK_EQ(erle.size(), low_render_energy.size());
+  RTC_DCHECK_EQ(erle.size(), max_erle.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::ErleBandsUpdate_SSE2(Y2, E2, low_render_energy, min_erle, max_erle,
+                                 erle);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::ErleBandsUpdate_AVX2(Y2, E2, low_render_energy, min_erle, max_erle,
+                                 erle);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::ErleBandsUpdate_NEON(Y2, E2, low_render_energy, min_erle, max_erle,
+                                 erle);
+      break;
+#endif
+    default:
+      aec3::ErleBandsUpdate(Y2, E2, low_render_energy, min_erle, max_erle,
+                            erle);
+  }
+}
+
+void ApplyErleCorrection(Aec3Optimization optimization,
+                         ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle) {
+  RTC_DCHECK_EQ(erle.size(), average_erle.size());
+  RTC_DCHECK_EQ(erle.size(), correction_factors.size());
+  RTC_DCHECK_EQ(erle.size(), max_erle.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kSse2:
+      aec3::ErleCorrection_SSE2(average_erle, correction_factors, min_erle,
+                                max_erle, erle);
+      break;
+    case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
+      aec3::ErleCorrection_AVX2(average_erle, correction_factors, min_erle,
+                                max_erle, erle);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Aec3Optimization::kNeon:
+      aec3::ErleCorrection_NEON(average_erle, correction_factors, min_erle,
+                                max_erle, erle);
+      break;
+#endif
+    default:
+      aec3::ErleCorrection(average_erle, correction_factors, min_erle,
+                           max_erle, erle);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,251 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSION_KERNELS_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSION_KERNELS_H_
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/system/arch.h"
+
+// Per-bin kernels of the suppression gain computation, the residual echo
+// estimation and the ERLE estimation. The optimized variants compute the same
+// expressions as the reference variants, lane by lane.
+
+namespace webrtc {
+namespace aec3 {
+
+// Computes the gain that renders the echo inaudible given the nearend and the
+// masker powers, and the per-bin masking thresholds.
+void NoAudibleEchoGain(ArrayView<const float> nearend,
+                       ArrayView<const float> echo,
+                       ArrayView<const float> masker,
+                       ArrayView<const float> enr_transparent,
+                       ArrayView<const float> enr_suppress,
+                       ArrayView<const float> emr_transparent,
+                       ArrayView<float> gain);
+// Attenuates the echo below `threshold` according to its audibility.
+void AudibilityWeighting(float threshold,
+                         float normalizer,
+                         ArrayView<const float> echo,
+                         ArrayView<float> weighted_echo);
+// Computes the gain that puts the echo at `min_echo_power`, limited to 1.
+void MinGain(float min_echo_power,
+             ArrayView<const float> weighted_residual_echo,
+             ArrayView<float> min_gain);
+// Bounds `G` by `min_gain` and `max_gain` and updates `gain` to the minimum of
+// itself and the bounded gain.
+void GainBounds(ArrayView<const float> min_gain,
+                ArrayView<const float> max_gain,
+                ArrayView<float> G,
+                ArrayView<float> gain);
+// Computes the residual echo power from the linear echo power and the ERLE.
+void LinearResidualEcho(ArrayView<const float> S2_linear,
+                        ArrayView<const float> erle,
+                        ArrayView<float> R2);
+// Applies a soft noise gate to the echo generating power.
+void NoiseGate(float noise_gate_power,
+               float noise_gate_slope,
+               ArrayView<float> X2);
+// Subtracts the scaled noise floor from the echo generating power.
+void NoiseFloorSubtraction(float slope,
+                           ArrayView<const float> X2_noise_floor,
+                           ArrayView<float> X2);
+// Smooths the ERLE towards Y2 / E2 in the bins where E2 is positive. Decreases
+// are not tracked in the bins with low render energy.
+void ErleBandsUpdate(ArrayView<const float> Y2,
+                     ArrayView<const float> E2,
+                     ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     ArrayView<const float> max_erle,
+                     ArrayView<float> erle);
+// Computes the ERLE as the corrected average ERLE, bounded to the ERLE limits.
+void ErleCorrection(ArrayView<const float> average_erle,
+                    ArrayView<const float> correction_factors,
+                    float min_erle,
+                    ArrayView<const float> max_erle,
+                    ArrayView<float> erle);
+
+#if defined(WEBRTC_HAS_NEON)
+void NoAudibleEchoGain_NEON(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain);
+void AudibilityWeighting_NEON(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo);
+void MinGain_NEON(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain);
+void GainBounds_NEON(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain);
+void LinearResidualEcho_NEON(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2);
+void NoiseGate_NEON(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2);
+void NoiseFloorSubtraction_NEON(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2);
+void ErleBandsUpdate_NEON(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle);
+void ErleCorrection_NEON(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle);
+#endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void NoAudibleEchoGain_SSE2(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain);
+void AudibilityWeighting_SSE2(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo);
+void MinGain_SSE2(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain);
+void GainBounds_SSE2(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain);
+void LinearResidualEcho_SSE2(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2);
+void NoiseGate_SSE2(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2);
+void NoiseFloorSubtraction_SSE2(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2);
+void ErleBandsUpdate_SSE2(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle);
+void ErleCorrection_SSE2(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle);
+
+void NoAudibleEchoGain_AVX2(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain);
+void AudibilityWeighting_AVX2(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo);
+void MinGain_AVX2(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain);
+void GainBounds_AVX2(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain);
+void LinearResidualEcho_AVX2(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2);
+void NoiseGate_AVX2(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2);
+void NoiseFloorSubtraction_AVX2(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2);
+void ErleBandsUpdate_AVX2(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle);
+void ErleCorrection_AVX2(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle);
+#endif
+
+}  // namespace aec3
+
+// Dispatchers to the kernels above. The AVX-512 optimization uses the AVX2
+// kernels.
+void ComputeNoAudibleEchoGain(Aec3Optimization optimization,
+                              ArrayView<const float> nearend,
+                              ArrayView<const float> echo,
+                              ArrayView<const float> masker,
+                              ArrayView<const float> enr_transparent,
+                              ArrayView<const float> enr_suppress,
+                              ArrayView<const float> emr_transparent,
+                              ArrayView<float> gain);
+void ApplyAudibilityWeighting(Aec3Optimization optimization,
+                              float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo);
+void ComputeMinGain(Aec3Optimization optimization,
+                    float min_echo_power,
+                    ArrayView<const float> weighted_residual_echo,
+                    ArrayView<float> min_gain);
+void ApplyGainBounds(Aec3Optimization optimization,
+                     ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain);
+void ComputeLinearResidualEcho(Aec3Optimization optimization,
+                               ArrayView<const float> S2_linear,
+                               ArrayView<const float> erle,
+                               ArrayView<float> R2);
+void ApplyNoiseGate(Aec3Optimization optimization,
+                    float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2);
+void SubtractNoiseFloor(Aec3Optimization optimization,
+                        float slope,
+                        ArrayView<const float> X2_noise_floor,
+                        ArrayView<float> X2);
+void UpdateErleBands(Aec3Optimization optimization,
+                     ArrayView<const float> Y2,
+                     ArrayView<const float> E2,
+                     ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     ArrayView<const float> max_erle,
+                     ArrayView<float> erle);
+void ApplyErleCorrection(Aec3Optimization optimization,
+                         ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSION_KERNELS_H_
@@ -0,0 +1,233 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+
+namespace webrtc {
+namespace aec3 {
+
+namespace {
+
+// Expands eight bool flags into a lane mask.
+inline __m256 LoadFlags_AVX2(const bool* flags) {
+  const __m128i b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags));
+  return _mm256_castsi256_ps(
+      _mm256_cmpgt_epi32(_mm256_cvtepu8_epi32(b), _mm256_setzero_si256()));
+}
+
+}  // namespace
+
+void NoAudibleEchoGain_AVX2(ArrayView<const float> nearend,
+                            ArrayView<const float> echo,
+                            ArrayView<const float> masker,
+                            ArrayView<const float> enr_transparent,
+                            ArrayView<const float> enr_suppress,
+                            ArrayView<const float> emr_transparent,
+                            ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 3;
+  const __m256 one = _mm256_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 enr_t = _mm256_loadu_ps(&enr_transparent[k]);
+    const __m256 enr_s = _mm256_loadu_ps(&enr_suppress[k]);
+    const __m256 emr_t = _mm256_loadu_ps(&emr_transparent[k]);
+    const __m256 enr =
+        _mm256_div_ps(echo_k, _mm256_add_ps(_mm256_loadu_ps(&nearend[k]), one));
+    const __m256 emr =
+        _mm256_div_ps(echo_k, _mm256_add_ps(_mm256_loadu_ps(&masker[k]), one));
+    const __m256 suppress =
+        _mm256_and_ps(_mm256_cmp_ps(enr, enr_t, _CMP_GT_OQ),
+                      _mm256_cmp_ps(emr, emr_t, _CMP_GT_OQ));
+    __m256 g = _mm256_div_ps(_mm256_sub_ps(enr_s, enr),
+                             _mm256_sub_ps(enr_s, enr_t));
+    g = _mm256_max_ps(g, _mm256_div_ps(emr_t, emr));
+    _mm256_storeu_ps(&gain[k], _mm256_blendv_ps(one, g, suppress));
+  }
+  NoAudibleEchoGain(nearend.subview(k), echo.subview(k), masker.subview(k),
+                    enr_transparent.subview(k), enr_suppress.subview(k),
+                    emr_transparent.subview(k), gain.subview(k));
+}
+
+void AudibilityWeighting_AVX2(float threshold,
+                              float normalizer,
+                              ArrayView<const float> echo,
+                              ArrayView<float> weighted_echo) {
+  const int size = static_cast<int>(echo.size());
+  const int vector_limit = size >> 3;
+  const __m256 threshold_v = _mm256_set1_ps(threshold);
+  const __m256 normalizer_v = _mm256_set1_ps(normalizer);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 below = _mm256_cmp_ps(echo_k, threshold_v, _CMP_LT_OQ);
+    const __m256 tmp =
+        _mm256_mul_ps(_mm256_sub_ps(threshold_v, echo_k), normalizer_v);
+    const __m256 weight =
+        _mm256_max_ps(zero, _mm256_sub_ps(one, _mm256_mul_ps(tmp, tmp)));
+    _mm256_storeu_ps(
+        &weighted_echo[k],
+        _mm256_blendv_ps(echo_k, _mm256_mul_ps(echo_k, weight), below));
+  }
+  AudibilityWeighting(threshold, normalizer, echo.subview(k),
+                      weighted_echo.subview(k));
+}
+
+void MinGain_AVX2(float min_echo_power,
+                  ArrayView<const float> weighted_residual_echo,
+                  ArrayView<float> min_gain) {
+  const int size = static_cast<int>(min_gain.size());
+  const int vector_limit = size >> 3;
+  const __m256 min_echo_power_v = _mm256_set1_ps(min_echo_power);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.f);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&weighted_residual_echo[k]);
+    const __m256 g =
+        _mm256_blendv_ps(one, _mm256_div_ps(min_echo_power_v, echo_k),
+                         _mm256_cmp_ps(echo_k, zero, _CMP_GT_OQ));
+    _mm256_storeu_ps(&min_gain[k], _mm256_min_ps(g, one));
+  }
+  MinGain(min_echo_power, weighted_residual_echo.subview(k),
+          min_gain.subview(k));
+}
+
+void GainBounds_AVX2(ArrayView<const float> min_gain,
+                     ArrayView<const float> max_gain,
+                     ArrayView<float> G,
+                     ArrayView<float> gain) {
+  const int size = static_cast<int>(gain.size());
+  const int vector_limit = size >> 3;
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    __m256 G_k =
+        _mm256_min_ps(_mm256_loadu_ps(&G[k]), _mm256_loadu_ps(&max_gain[k]));
+    G_k = _mm256_max_ps(G_k, _mm256_loadu_ps(&min_gain[k]));
+    _mm256_storeu_ps(&G[k], G_k);
+    _mm256_storeu_ps(&gain[k], _mm256_min_ps(_mm256_loadu_ps(&gain[k]), G_k));
+  }
+  GainBounds(min_gain.subview(k), max_gain.subview(k), G.subview(k),
+             gain.subview(k));
+}
+
+void LinearResidualEcho_AVX2(ArrayView<const float> S2_linear,
+                             ArrayView<const float> erle,
+                             ArrayView<float> R2) {
+  const int size = static_cast<int>(R2.size());
+  const int vector_limit = size >> 3;
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    _mm256_storeu_ps(&R2[k], _mm256_div_ps(_mm256_loadu_ps(&S2_linear[k]),
+                                           _mm256_loadu_ps(&erle[k])));
+  }
+  LinearResidualEcho(S2_linear.subview(k), erle.subview(k), R2.subview(k));
+}
+
+void NoiseGate_AVX2(float noise_gate_power,
+                    float noise_gate_slope,
+                    ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 3;
+  const __m256 power = _mm256_set1_ps(noise_gate_power);
+  const __m256 slope = _mm256_set1_ps(noise_gate_slope);
+  const __m256 zero = _mm256_setzero_ps();
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 X2_k = _mm256_loadu_ps(&X2[k]);
+    const __m256 decrease = _mm256_mul_ps(slope, _mm256_sub_ps(power, X2_k));
+    const __m256 gated = _mm256_max_ps(zero, _mm256_sub_ps(X2_k, decrease));
+    _mm256_storeu_ps(&X2[k],
+                     _mm256_blendv_ps(X2_k, gated,
+                                      _mm256_cmp_ps(power, X2_k, _CMP_GT_OQ)));
+  }
+  NoiseGate(noise_gate_power, noise_gate_slope, X2.subview(k));
+}
+
+void NoiseFloorSubtraction_AVX2(float slope,
+                                ArrayView<const float> X2_noise_floor,
+                                ArrayView<float> X2) {
+  const int size = static_cast<int>(X2.size());
+  const int vector_limit = size >> 3;
+  const __m256 slope_v = _mm256_set1_ps(slope);
+  const __m256 zero = _mm256_setzero_ps();
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 X2_k = _mm256_sub_ps(
+        _mm256_loadu_ps(&X2[k]),
+        _mm256_mul_ps(slope_v, _mm256_loadu_ps(&X2_noise_floor[k])));
+    _mm256_storeu_ps(&X2[k], _mm256_max_ps(zero, X2_k));
+  }
+  NoiseFloorSubtraction(slope, X2_noise_floor.subview(k), X2.subview(k));
+}
+
+void ErleBandsUpdate_AVX2(ArrayView<const float> Y2,
+                          ArrayView<const float> E2,
+                          ArrayView<const bool> low_render_energy,
+                          float min_erle,
+                          ArrayView<const float> max_erle,
+                          ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 3;
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 alpha_increase = _mm256_set1_ps(0.05f);
+  const __m256 alpha_decrease = _mm256_set1_ps(0.1f);
+  const __m256 min_erle_v = _mm256_set1_ps(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 E2_k = _mm256_loadu_ps(&E2[k]);
+    const __m256 erle_k = _mm256_loadu_ps(&erle[k]);
+    const __m256 new_erle = _mm256_div_ps(_mm256_loadu_ps(&Y2[k]), E2_k);
+    const __m256 decrease_alpha = _mm256_andnot_ps(
+        LoadFlags_AVX2(&low_render_energy[k]), alpha_decrease);
+    const __m256 alpha =
+        _mm256_blendv_ps(alpha_increase, decrease_alpha,
+                         _mm256_cmp_ps(new_erle, erle_k, _CMP_LT_OQ));
+    __m256 updated = _mm256_add_ps(
+        erle_k, _mm256_mul_ps(alpha, _mm256_sub_ps(new_erle, erle_k)));
+    updated = _mm256_min_ps(_mm256_max_ps(updated, min_erle_v),
+                            _mm256_loadu_ps(&max_erle[k]));
+    _mm256_storeu_ps(&erle[k],
+                     _mm256_blendv_ps(erle_k, updated,
+                                      _mm256_cmp_ps(E2_k, zero, _CMP_GT_OQ)));
+  }
+  ErleBandsUpdate(Y2.subview(k), E2.subview(k), low_render_energy.subview(k),
+                  min_erle, max_erle.subview(k), erle.subview(k));
+}
+
+void ErleCorrection_AVX2(ArrayView<const float> average_erle,
+                         ArrayView<const float> correction_factors,
+                         float min_erle,
+                         ArrayView<const float> max_erle,
+                         ArrayView<float> erle) {
+  const int size = static_cast<int>(erle.size());
+  const int vector_limit = size >> 3;
+  const __m256 min_erle_v = _mm256_set1_ps(min_erle);
+  int k = 0;
+  for (; k < vector_limit * 8; k += 8) {
+    const __m256 corrected =
+        _mm256_mul_ps(_mm256_loadu_ps(&average_erle[k]),
+                      _mm256_loadu_ps(&correction_factors[k]));
+    _mm256_storeu_ps(&erle[k],
+                     _mm256_min_ps(_mm256_max_ps(corrected, min_erle_v),
+                                   _mm256_loadu_ps(&max_erle[k])));
+  }
+  ErleCorrection(average_erle.subview(k), correction_factors.subview(k),
+                 min_erle, max_erle.subview(k), erle.subview(k));
+}
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -0,0 +1,254 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/suppression_kernels.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// The sizes cover the spectrum sizes used and the scalar tails of all vector
+// widths.
+constexpr size_t kSizes[] = {3, 7, 13, kFftLengthBy2 - 1, kFftLengthBy2Plus1};
+
+// Relative tolerance for the rounding differences between the reference and
+// the optimized kernels, such as those of the division approximation on ARMv7.
+constexpr float kTolerance = 1e-5f;
+
+std::vector<Aec3Optimization> OptimizationsToTest() {
+  std::vector<Aec3Optimization> optimizations;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(Aec3Optimization::kSse2);
+  }
+  if (GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(Aec3Optimization::kAvx2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Aec3Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
+std::vector<float> RandomVector(size_t size,
+                                float min,
+                                float max,
+                                Random* random_generator) {
+  std::vector<float> x(size);
+  for (float& x_k : x) {
+    x_k = min + (max - min) * random_generator->Rand<float>();
+  }
+  return x;
+}
+
+void ExpectParity(const std::vector<float>& reference,
+                  const std::vector<float>& optimized) {
+  ASSERT_EQ(reference.size(), optimized.size());
+  for (size_t k = 0; k < reference.size(); ++k) {
+    EXPECT_NEAR(reference[k], optimized[k],
+                kTolerance * std::max(1.f, fabsf(reference[k])))
+        << "bin " << k;
+  }
+}
+
+}  // namespace
+
+// Verifies that the optimized no audible echo gain computation matches the
+// reference computation.
+TEST(SuppressionKernels, NoAudibleEchoGain) {
+  Random random_generator(42U);
+  for (size_t size : kSizes) {
+    for (Aec3Optimization optimization : OptimizationsToTest()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      const std::vector<float> nearend =
+          RandomVector(size, 0.f, 1e5f, &random_generator);
+      const std::vector<float> echo =
+          RandomVector(size, 0.f, 1e5f, &random_generator);
+      const std::vector<float> masker =
+          RandomVector(size, 0.f, 1e5f, &random_generator);
+      const std::vector<float> enr_transparent =
+          RandomVector(size, 0.1f, 1.f, &random_generator);
+      const std::vector<float> emr_transparent =
+          RandomVector(size, 0.1f, 1.f, &random_generator);
+      std::vector<float> enr_suppress =
+          RandomVector(size, 0.1f, 5.f, &random_generator);
+      for (size_t k = 0; k < size; ++k) {
+        enr_suppress[k] += enr_transparent[k];
+      }
+
+      std::vector<float> gain(size);
+      std::vector<float> gain_optimized(size);
+      ComputeNoAudibleEchoGain(Aec3Optimization::kNone, nearend, echo, masker,
+                               enr_transparent, enr_suppress, emr_transparent,
+                               gain);
+      ComputeNoAudibleEchoGain(optimization, nearend, echo, masker,
+                               enr_transparent, enr_suppress, emr_transparent,
+                               gain_optimized);
+      ExpectParity(gain, gain_optimized);
+    }
+  }
+}
+
+// Verifies that the optimized audibility weighting matches the reference
+// weighting.
+TEST(SuppressionKernels, AudibilityWeighting) {
+  Random random_generator(42U);
+  constexpr float kThreshold = 128.f * 10.f;
+  constexpr float kNormalizer = 1.f / (kThreshold - 128.f);
+  for (size_t size : kSizes) {
+    for (Aec3Optimization optimization : OptimizationsToTest()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      const std::vector<float> echo =
+          RandomVector(size, 0.f, 2.f * kThreshold, &random_generator);
+      std::vector<float> weighted_echo(size);
+      std::vector<float> weighted_echo_optimized(size);
+      ApplyAudibilityWeighting(Aec3Optimization::kNone, kThreshold,
+                               kNormalizer, echo, weighted_echo);
+      ApplyAudibilityWeighting(optimization, kThreshold, kNormalizer, echo,
+                               weighted_echo_optimized);
+      ExpectParity(weighted_echo, weighted_echo_optimized);
+    }
+  }
+}
+
+// Verifies that the optimized minimum and bounded gain computations match the
+// reference computations.
+TEST(SuppressionKernels, GainLimits) {
+  Random random_generator(42U);
+  constexpr float kMinEchoPower = 192.f;
+  for (size_t size : kSizes) {
+    for (Aec3Optimization optimization : OptimizationsToTest()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      std::vector<float> weighted_residual_echo =
+          RandomVector(size, 0.f, 1000.f, &random_generator);
+      for (size_t k = 0; k < size; k += 3) {
+        weighted_residual_echo[k] = 0.f;
+      }
+      std::vector<float> min_gain(size);
+      std::vector<float> min_gain_optimized(size);
+      ComputeMinGain(Aec3Optimization::kNone, kMinEchoPower,
+                     weighted_residual_echo, min_gain);
+      ComputeMinGain(optimization, kMinEchoPower, weighted_residual_echo,
+                     min_gain_optimized);
+      ExpectParity(min_gain, min_gain_optimized);
+
+      const std::vector<float> max_gain =
+          RandomVector(size, 0.5f, 1.f, &random_generator);
+      std::vector<float> G = RandomVector(size, 0.f, 1.f, &random_generator);
+      std::vector<float> gain = RandomVector(size, 0.f, 1.f, &random_generator);
+      std::vector<float> G_optimized = G;
+      std::vector<float> gain_optimized = gain;
+      ApplyGainBounds(Aec3Optimization::kNone, min_gain, max_gain, G, gain);
+      ApplyGainBounds(optimization, min_gain, max_gain, G_optimized,
+                      gain_optimized);
+      ExpectParity(G, G_optimized);
+      ExpectParity(gain, gain_optimized);
+    }
+  }
+}
+
+// Verifies that the optimized residual echo kernels match the reference
+// kernels.
+TEST(SuppressionKernels, ResidualEcho) {
+  Random random_generator(42U);
+  constexpr float kNoiseGatePower = 27509.42f;
+  constexpr float kNoiseGateSlope = 0.3f;
+  constexpr float kStationaryGateSlope = 10.f;
+  for (size_t size : kSizes) {
+    for (Aec3Optimization optimization : OptimizationsToTest()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      const std::vector<float> S2_linear =
+          RandomVector(size, 0.f, 1e6f, &random_generator);
+      const std::vector<float> erle =
+          RandomVector(size, 1.f, 4.f, &random_generator);
+      std::vector<float> R2(size);
+      std::vector<float> R2_optimized(size);
+      ComputeLinearResidualEcho(Aec3Optimization::kNone, S2_linear, erle, R2);
+      ComputeLinearResidualEcho(optimization, S2_linear, erle, R2_optimized);
+      ExpectParity(R2, R2_optimized);
+
+      std::vector<float> X2 =
+          RandomVector(size, 0.f, 2.f * kNoiseGatePower, &random_generator);
+      std::vector<float> X2_optimized = X2;
+      ApplyNoiseGate(Aec3Optimization::kNone, kNoiseGatePower, kNoiseGateSlope,
+                     X2);
+      ApplyNoiseGate(optimization, kNoiseGatePower, kNoiseGateSlope,
+                     X2_optimized);
+      ExpectParity(X2, X2_optimized);
+
+      const std::vector<float> X2_noise_floor =
+          RandomVector(size, 0.f, 3000.f, &random_generator);
+      SubtractNoiseFloor(Aec3Optimization::kNone, kStationaryGateSlope,
+                         X2_noise_floor, X2);
+      SubtractNoiseFloor(optimization, kStationaryGateSlope, X2_noise_floor,
+                         X2_optimized);
+      ExpectParity(X2, X2_optimized);
+    }
+  }
+}
+
+// Verifies that the optimized ERLE kernels match the reference kernels.
+TEST(SuppressionKernels, Erle) {
+  Random random_generator(42U);
+  constexpr float kMinErle = 1.f;
+  for (size_t size : kSizes) {
+    for (Aec3Optimization optimization : OptimizationsToTest()) {
+      SCOPED_TRACE(static_cast<int>(optimization));
+      const std::vector<float> Y2 =
+          RandomVector(size, 0.f, 1e6f, &random_generator);
+      std::vector<float> E2 = RandomVector(size, 0.f, 1e6f, &random_generator);
+      for (size_t k = 0; k < size; k += 4) {
+        E2[k] = 0.f;
+      }
+      std::array<bool, kFftLengthBy2Plus1> low_render_energy_data;
+      for (size_t k = 0; k < size; ++k) {
+        low_render_energy_data[k] = random_generator.Rand(0, 2) == 0;
+      }
+      const ArrayView<const bool> low_render_energy(
+          low_render_energy_data.data(), size);
+      const std::vector<float> max_erle =
+          RandomVector(size, 1.5f, 4.f, &random_generator);
+      std::vector<float> erle =
+          RandomVector(size, kMinErle, 4.f, &random_generator);
+      std::vector<float> erle_optimized = erle;
+      for (int k = 0; k < 10; ++k) {
+        UpdateErleBands(Aec3Optimization::kNone, Y2, E2, low_render_energy,
+                        kMinErle, max_erle, erle);
+        UpdateErleBands(optimization, Y2, E2, low_render_energy, kMinErle,
+                        max_erle, erle_optimized);
+      }
+      ExpectParity(erle, erle_optimized);
+
+      const std::vector<float> average_erle =
+          RandomVector(size, kMinErle, 4.f, &random_generator);
+      const std::vector<float> correction_factors =
+          RandomVector(size, 0.2f, 2.f, &random_generator);
+      ApplyErleCorrection(Aec3Optimization::kNone, average_erle,
+                          correction_factors, kMinErle, max_erle, erle);
+      ApplyErleCorrection(optimization, average_erle, correction_factors,
+                          kMinErle, max_erle, erle_optimized);
+      ExpectParity(erle, erle_optimized);
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/warm_start_state.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'A', '3', 'W', 'S'};
+constexpr uint8_t kVersion = 1;
+// Bounds that a parsed blob must respect, well above any configuration.
+constexpr size_t kMaxChannels = 64;
+constexpr size_t kMaxPartitions = 1024;
+
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* data) : data_(data) {}
+
+  void U8(uint8_t value) { data_->push_back(value); }
+  void U16(size_t value) {
+    RTC_DCHECK_LE(value, std::numeric_limits<uint16_t>::max());
+    data_->push_back(static_cast<uint8_t>(value));
+    data_->push_back(static_cast<uint8_t>(value >> 8));
+  }
+  void Float(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int shift = 0; shift < 32; shift += 8) {
+      data_->push_back(static_cast<uint8_t>(bits >> shift));
+    }
+  }
+  template <typename Iterator>
+  void Floats(Iterator begin, Iterator end) {
+    for (; begin != end; ++begin) {
+      Float(*begin);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>* const data_;
+};
+
+class Reader {
+ public:
+  explicit Reader(ArrayView<const uint8_t> data) : data_(data) {}
+
+  bool ok() const { return ok_; }
+  bool at_end() const { return ok_ && position_ == data_.size(); }
+
+  uint8_t U8() {
+    if (!Has(1)) {
+      return 0;
+    }
+    return data_[position_++];
+  }
+  size_t U16() {
+    if (!Has(2)) {
+      return 0;
+    }
+    const size_t value = data_[position_] | (data_[position_ + 1] << 8);
+    position_ += 2;
+    return value;
+  }
+  float Float() {
+    if (!Has(4)) {
+      return 0.f;
+    }
+    uint32_t bits = 0;
+    for (int k = 3; k >= 0; --k) {
+      bits = (bits << 8) | data_[position_ + k];
+    }
+    position_ += 4;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+  template <typename Iterator>
+  void Floats(Iterator begin, Iterator end) {
+    for (; begin != end; ++begin) {
+      *begin = Float();
+    }
+  }
+
+ private:
+  bool Has(size_t num_bytes) {
+    ok_ = ok_ && data_.size() - position_ >= num_bytes;
+    return ok_;
+  }
+
+  const ArrayView<const uint8_t> data_;
+  size_t position_ = 0;
+  bool ok_ = true;
+};
+
+}  // namespace
+
+std::vector<uint8_t> SerializeAec3WarmStartState(
+    const Aec3WarmStartState& state) {
+  std::vector<uint8_t> data;
+  Writer writer(&data);
+  for (uint8_t byte : kMagic) {
+    writer.U8(byte);
+  }
+  writer.U8(kVersion);
+  writer.U8(state.delay_blocks ? 1 : 0);
+  writer.U16(state.delay_blocks.value_or(0));
+  writer.U16(state.num_render_channels);
+  writer.U16(state.capture_channels.size());
+  for (const auto& channel : state.capture_channels) {
+    writer.U16(channel.filter.size());
+    for (const auto& partition : channel.filter) {
+      RTC_DCHECK_EQ(partition.size(), state.num_render_channels);
+      for (const FftData& H : partition) {
+        writer.Floats(H.re.begin(), H.re.end());
+        // The first and last imaginary parts are always zero.
+        writer.Floats(H.im.begin() + 1, H.im.end() - 1);
+      }
+    }
+    writer.Floats(channel.erle.begin(), channel.erle.end());
+    writer.Float(channel.fullband_erle_log2);
+  }
+  return data;
+}
+
+bool DeserializeAec3WarmStartState(ArrayView<const uint8_t> data,
+                                   Aec3WarmStartState* state) {
+  RTC_DCHECK(state);
+  Reader reader(data);
+  for (uint8_t byte : kMagic) {
+    if (reader.U8() != byte) {
+      return false;
+    }
+  }
+  if (reader.U8() != kVersion) {
+    return false;
+  }
+  const bool has_delay = reader.U8() != 0;
+  const size_t delay_blocks = reader.U16();
+  state->delay_blocks =
+      has_delay ? std::optional<size_t>(delay_blocks) : std::nullopt;
+  state->num_render_channels = reader.U16();
+  const size_t num_capture_channels = reader.U16();
+  if (!reader.ok() || state->num_render_channels > kMaxChannels ||
+      num_capture_channels > kMaxChannels) {
+    return false;
+  }
+
+  state->capture_channels.resize(num_capture_channels);
+  for (auto& channel : state->capture_channels) {
+    const size_t num_partitions = reader.U16();
+    if (!reader.ok() || num_partitions > kMaxPartitions) {
+      return false;
+    }
+    channel.filter.resize(num_partitions);
+    for (auto& partition : channel.filter) {
+      partition.resize(state->num_render_channels);
+      for (FftData& H : partition) {
+        reader.Floats(H.re.begin(), H.re.end());
+        H.im[0] = H.im[kFftLengthBy2] = 0.f;
+        reader.Floats(H.im.begin() + 1, H.im.end() - 1);
+      }
+      if (!reader.ok()) {
+        return false;
+      }
+    }
+    reader.Floats(channel.erle.begin(), channel.erle.end());
+    channel.fullband_erle_log2 = reader.Float();
+  }
+  return reader.at_end();
+}
+
+}  // namespace webrtc
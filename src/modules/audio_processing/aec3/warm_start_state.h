@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+
+namespace webrtc {
+
+// Adaptive state of AEC3 that lets a new instance start out converged: the
+// render delay, the refined linear filters and the ERLE estimates. Everything
+// else is cheap to re-estimate.
+struct Aec3WarmStartState {
+  struct CaptureChannel {
+    // Refined filter, [partition][render channel].
+    std::vector<std::vector<FftData>> filter;
+    std::array<float, kFftLengthBy2Plus1> erle;
+    float fullband_erle_log2 = 0.f;
+  };
+
+  size_t num_render_channels = 0;
+  // Delay of the render delay buffer in blocks, if any was estimated.
+  std::optional<size_t> delay_blocks;
+  std::vector<CaptureChannel> capture_channels;
+};
+
+// Compact little-endian binary form of `state`, with the filters stored as
+// 32 bit floats.
+std::vector<uint8_t> SerializeAec3WarmStartState(
+    const Aec3WarmStartState& state);
+
+// Parses the output of SerializeAec3WarmStartState(). Returns false, leaving
+// `state` unspecified, if `data` is malformed or of another version.
+bool DeserializeAec3WarmStartState(ArrayView<const uint8_t> data,
+                                   Aec3WarmStartState* state);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_WARM_START_STATE_H_
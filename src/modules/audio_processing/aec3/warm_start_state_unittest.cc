@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/warm_start_state.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+Aec3WarmStartState CreateState(size_t num_render_channels,
+                               size_t num_capture_channels,
+                               size_t num_partitions) {
+  Aec3WarmStartState state;
+  state.num_render_channels = num_render_channels;
+  state.delay_blocks = 7;
+  state.capture_channels.resize(num_capture_channels);
+  float value = 0.f;
+  for (auto& channel : state.capture_channels) {
+    channel.filter.resize(num_partitions);
+    for (auto& partition : channel.filter) {
+      partition.resize(num_render_channels);
+      for (FftData& H : partition) {
+        for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+          H.re[k] = value += 0.25f;
+          H.im[k] = -value;
+        }
+        H.im[0] = H.im[kFftLengthBy2] = 0.f;
+      }
+    }
+    for (float& erle : channel.erle) {
+      erle = value += 1.f;
+    }
+    channel.fullband_erle_log2 = 3.5f;
+  }
+  return state;
+}
+
+}  // namespace
+
+TEST(Aec3WarmStartState, RoundTrip) {
+  const Aec3WarmStartState state = CreateState(2, 3, 4);
+  const std::vector<uint8_t> data = SerializeAec3WarmStartState(state);
+
+  Aec3WarmStartState restored;
+  ASSERT_TRUE(DeserializeAec3WarmStartState(data, &restored));
+  EXPECT_EQ(state.num_render_channels, restored.num_render_channels);
+  EXPECT_EQ(state.delay_blocks, restored.delay_blocks);
+  ASSERT_EQ(state.capture_channels.size(), restored.capture_channels.size());
+  for (size_t ch = 0; ch < state.capture_channels.size(); ++ch) {
+    const auto& expected = state.capture_channels[ch];
+    const auto& actual = restored.capture_channels[ch];
+    ASSERT_EQ(expected.filter.size(), actual.filter.size());
+    for (size_t p = 0; p < expected.filter.size(); ++p) {
+      ASSERT_EQ(expected.filter[p].size(), actual.filter[p].size());
+      for (size_t render_ch = 0; render_ch < expected.filter[p].size();
+           ++render_ch) {
+        EXPECT_EQ(expected.filter[p][render_ch].re,
+                  actual.filter[p][render_ch].re);
+        EXPECT_EQ(expected.filter[p][render_ch].im,
+                  actual.filter[p][render_ch].im);
+      }
+    }
+    EXPECT_EQ(expected.erle, actual.erle);
+    EXPECT_EQ(expected.fullband_erle_log2, actual.fullband_erle_log2);
+  }
+}
+
+TEST(Aec3WarmStartState, RoundTripWithoutDelay) {
+  Aec3WarmStartState state = CreateState(1, 1, 0);
+  state.delay_blocks = std::nullopt;
+  Aec3WarmStartState restored;
+  ASSERT_TRUE(DeserializeAec3WarmStartState(SerializeAec3WarmStartState(state),
+                                            &restored));
+  EXPECT_FALSE(restored.delay_blocks);
+  ASSERT_EQ(1u, restored.capture_channels.size());
+  EXPECT_TRUE(restored.capture_channels[0].filter.empty());
+}
+
+// The imaginary parts that are zero by construction are not stored.
+TEST(Aec3WarmStartState, IsCompact) {
+  constexpr size_t kNumPartitions = 12;
+  const std::vector<uint8_t> data =
+      SerializeAec3WarmStartState(CreateState(1, 1, kNumPartitions));
+  EXPECT_GT(kNumPartitions * sizeof(FftData) + 80 * sizeof(float),
+            data.size());
+}
+
+TEST(Aec3WarmStartState, RejectsMalformedData) {
+  const std::vector<uint8_t> data =
+      SerializeAec3WarmStartState(CreateState(2, 1, 3));
+  Aec3WarmStartState restored;
+
+  EXPECT_FALSE(DeserializeAec3WarmStartState({}, &restored));
+  for (size_t size : {size_t{3}, size_t{12}, data.size() / 2,
+                      data.size() - 1}) {
+    EXPECT_FALSE(DeserializeAec3WarmStartState(
+        ArrayView<const uint8_t>(data.data(), size), &restored));
+  }
+
+  std::vector<uint8_t> trailing = data;
+  trailing.push_back(0);
+  EXPECT_FALSE(DeserializeAec3WarmStartState(trailing, &restored));
+
+  std::vector<uint8_t> wrong_magic = data;
+  wrong_magic[0] = 'X';
+  EXPECT_FALSE(DeserializeAec3WarmStartState(wrong_magic, &restored));
+
+  std::vector<uint8_t> wrong_version = data;
+  wrong_version[4] = 2;
+  EXPECT_FALSE(DeserializeAec3WarmStartState(wrong_version, &restored));
+}
+
+}  // namespace webrtc
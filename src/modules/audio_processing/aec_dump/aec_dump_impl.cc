@@ -242,6 +242,9 @@ void AecDumpImpl::WriteRuntimeSetting(
       setting->set_capture_output_used(x);
       break;
     }
+    case AudioProcessing::RuntimeSetting::Type::kSeekAudioMode:
+      // SeekAudio mode changes are not stored in aecdumps.
+      break;
     case AudioProcessing::RuntimeSetting::Type::kPlayoutVolumeChange: {
       int x;
       runtime_setting.GetInt(&x);
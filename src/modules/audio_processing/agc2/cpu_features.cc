@@ -10,11 +10,69 @@
 
 #include "modules/audio_processing/agc2/cpu_features.h"
 
+#include <stdint.h>
+
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/arch.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Returns true if the CPU supports AVX-512F and the OS saves the opmask and the
+// ZMM registers across context switches.
+bool IsAvx512Supported() {
+  // Bits of the XMM, YMM, opmask, upper ZMM0-15 and ZMM16-31 states in XCR0.
+  constexpr uint64_t kAvx512StateMask = 0xE6;
+  constexpr int kOsxsaveBit = 1 << 27;
+  constexpr int kAvx512fBit = 1 << 16;
+#if defined(_MSC_VER)
+  int cpu_info[4];
+  __cpuid(cpu_info, 0);
+  if (cpu_info[0] < 7) {
+    return false;
+  }
+  __cpuid(cpu_info, 1);
+  if ((cpu_info[2] & kOsxsaveBit) == 0) {
+    return false;
+  }
+  __cpuidex(cpu_info, 7, 0);
+  if ((cpu_info[1] & kAvx512fBit) == 0) {
+    return false;
+  }
+  const uint64_t xcr0 = _xgetbv(0);
+#else
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid_max(0, nullptr) < 7) {
+    return false;
+  }
+  __cpuid(1, eax, ebx, ecx, edx);
+  if ((ecx & kOsxsaveBit) == 0) {
+    return false;
+  }
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  if ((ebx & kAvx512fBit) == 0) {
+    return false;
+  }
+  unsigned int xcr0_low, xcr0_high;
+  __asm__ volatile("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+  const uint64_t xcr0 = (uint64_t{xcr0_high} << 32) | xcr0_low;
+#endif
+  return (xcr0 & kAvx512StateMask) == kAvx512StateMask;
+}
+#endif
+
+}  // namespace
 
 std::string AvailableCpuFeatures::ToString() const {
   char buf[64];
@@ -28,6 +86,10 @@ std::string AvailableCpuFeatures::ToString() const {
     builder << (first ? "AVX2" : "_AVX2");
     first = false;
   }
+  if (avx512) {
+    builder << (first ? "AVX512" : "_AVX512");
+    first = false;
+  }
   if (neon) {
     builder << (first ? "NEON" : "_NEON");
     first = false;
@@ -41,9 +103,11 @@ std::string AvailableCpuFeatures::ToString() const {
 // Detects available CPU features.
 AvailableCpuFeatures GetAvailableCpuFeatures() {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+  const bool avx2 = GetCPUInfo(kAVX2) != 0;
   return {/*sse2=*/GetCPUInfo(kSSE2) != 0,
-          /*avx2=*/GetCPUInfo(kAVX2) != 0,
-          /*neon=*/false};
+          /*avx2=*/avx2,
+          /*neon=*/false,
+          /*avx512=*/avx2 && IsAvx512Supported()};
 #elif defined(WEBRTC_HAS_NEON)
   return {/*sse2=*/false,
           /*avx2=*/false,
@@ -18,11 +18,14 @@ namespace webrtc {
 // Collection of flags indicating which CPU features are available on the
 // current platform. True means available.
 struct AvailableCpuFeatures {
-  AvailableCpuFeatures(bool sse2, bool avx2, bool neon)
-      : sse2(sse2), avx2(avx2), neon(neon) {}
+  AvailableCpuFeatures(bool sse2, bool avx2, bool neon, bool avx512 = false)
+      : sse2(sse2), avx2(avx2), avx512(avx512), neon(neon) {}
   // Intel.
   bool sse2;
   bool avx2;
+  // AVX-512 foundation instructions, together with OS support for the
+  // extended register state.
+  bool avx512;
   // ARM.
   bool neon;
   std::string ToString() const;
@@ -43,7 +43,9 @@ class VectorMath {
   float DotProduct(ArrayView<const float> x, ArrayView<const float> y) const {
     RTC_DCHECK_EQ(x.size(), y.size());
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-    if (cpu_features_.avx2) {
+    if (cpu_features_.avx512) {
+      return DotProductAvx512(x, y);
+    } else if (cpu_features_.avx2) {
       return DotProductAvx2(x, y);
     } else if (cpu_features_.sse2) {
       __m128 accumulator = _mm_setzero_ps();
@@ -103,6 +105,8 @@ class VectorMath {
  private:
   float DotProductAvx2(ArrayView<const float> x,
                        ArrayView<const float> y) const;
+  float DotProductAvx512(ArrayView<const float> x,
+                         ArrayView<const float> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+float VectorMath::DotProductAvx512(ArrayView<const float> x,
+                                   ArrayView<const float> y) const {
+  RTC_DCHECK(cpu_features_.avx512);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  __m512 accumulator = _mm512_setzero_ps();
+  constexpr int kBlockSizeLog2 = 4;
+  constexpr int kBlockSize = 1 << kBlockSizeLog2;
+  const int incomplete_block_index = (x.size() >> kBlockSizeLog2)
+                                     << kBlockSizeLog2;
+  for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+    RTC_DCHECK_LE(i + kBlockSize, x.size());
+    const __m512 x_i = _mm512_loadu_ps(&x[i]);
+    const __m512 y_i = _mm512_loadu_ps(&y[i]);
+    accumulator = _mm512_fmadd_ps(x_i, y_i, accumulator);
+  }
+  // Add the last block if incomplete. The masked loads do not touch the memory
+  // beyond the end of the vectors.
+  const int remainder = dchecked_cast<int>(x.size()) - incomplete_block_index;
+  if (remainder > 0) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << remainder) - 1);
+    const __m512 x_i = _mm512_maskz_loadu_ps(mask, &x[incomplete_block_index]);
+    const __m512 y_i = _mm512_maskz_loadu_ps(mask, &y[incomplete_block_index]);
+    accumulator = _mm512_fmadd_ps(x_i, y_i, accumulator);
+  }
+  // Reduce `accumulator` by addition.
+  return _mm512_reduce_add_ps(accumulator);
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
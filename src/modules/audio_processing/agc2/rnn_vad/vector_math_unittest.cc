@@ -41,11 +41,35 @@ TEST_P(VectorMathParametrization, TestDotProduct) {
       kEnergyOfXSubspan);
 }
 
+// Verifies that the optimized dot product matches the reference one for all
+// lengths, including those with an incomplete last block.
+TEST_P(VectorMathParametrization, TestDotProductMatchesReference) {
+  const VectorMath reference(NoAvailableCpuFeatures());
+  const VectorMath vector_math(/*cpu_features=*/GetParam());
+  std::vector<float> x(67);
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = kX[i % kSizeOfX];
+    y[i] = kX[(3 * i + 1) % kSizeOfX];
+  }
+  for (size_t size = 0; size <= x.size(); ++size) {
+    ArrayView<const float> x_view(x.data(), size);
+    ArrayView<const float> y_view(y.data(), size);
+    EXPECT_NEAR(reference.DotProduct(x_view, y_view),
+                vector_math.DotProduct(x_view, y_view), 1e-5f)
+        << "size: " << size;
+  }
+}
+
 // Finds the relevant CPU features combinations to test.
 std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
   v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/false});
   AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.avx512) {
+    v.push_back(
+        {/*sse2=*/false, /*avx2=*/false, /*neon=*/false, /*avx512=*/true});
+  }
   if (available.avx2) {
     v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
   }
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -55,6 +56,7 @@
 #include "modules/audio_processing/post_filter.h"
 #include "modules/audio_processing/render_queue_item_verifier.h"
 #include "modules/audio_processing/rms_level.h"
+#include "modules/audio_processing/seek_audio_warm_start.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/denormal_disabler.h"
 #include "rtc_base/logging.h"
@@ -68,7 +70,6 @@
 #define LOG_TAG "SEEKAUDIO"
 #define LOGI(...) ((void)__android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__))
 
-#define AEC_TEST 1
 #define LOG_TEST 0
 
 #define RETURN_ON_ERR(expr) \
@@ -83,6 +84,8 @@ namespace webrtc {
 
 namespace {
 
+using CaptureStage = AudioProcessingStageTimings::Stage;
+
 bool SampleRateSupportsMultiBand(int sample_rate_hz) {
   return sample_rate_hz == AudioProcessing::kSampleRate32kHz ||
          sample_rate_hz == AudioProcessing::kSampleRate48kHz;
@@ -349,6 +352,21 @@ void SetDownmixMethod(AudioBuffer& buffer, DownmixMethod method) {
 
 constexpr int kUnspecifiedDataDumpInputVolume = -100;
 
+// Number of `event`s of the SeekAudio modules, either of which may be null.
+int32_t SeekAudioEventCount(const SeekAudioAec* aec,
+                            const SeekAudioAfc* afc,
+                            SeekAudioEvent event) {
+  int64_t count = 0;
+  if (aec) {
+    count += aec->events().count(event);
+  }
+  if (afc) {
+    count += afc->events().count(event);
+  }
+  return static_cast<int32_t>(
+      std::min<int64_t>(count, std::numeric_limits<int32_t>::max()));
+}
+
 }  // namespace
 
 // Throughout webrtc, it's assumed that success is represented by zero.
@@ -369,7 +387,8 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
     bool adaptive_gain_controller_enabled,
     bool gain_controller2_enabled,
     bool gain_adjustment_enabled,
-    bool echo_controller_enabled) {
+    bool echo_controller_enabled,
+    bool seek_audio_enabled) {
   bool changed = false;
   changed |= (high_pass_filter_enabled != high_pass_filter_enabled_);
   changed |=
@@ -380,6 +399,7 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
   changed |= (gain_controller2_enabled != gain_controller2_enabled_);
   changed |= (gain_adjustment_enabled != gain_adjustment_enabled_);
   changed |= (echo_controller_enabled != echo_controller_enabled_);
+  changed |= (seek_audio_enabled != seek_audio_enabled_);
   if (changed) {
     high_pass_filter_enabled_ = high_pass_filter_enabled;
     mobile_echo_controller_enabled_ = mobile_echo_controller_enabled;
@@ -388,6 +408,7 @@ bool AudioProcessingImpl::SubmoduleStates::Update(
     gain_controller2_enabled_ = gain_controller2_enabled;
     gain_adjustment_enabled_ = gain_adjustment_enabled;
     echo_controller_enabled_ = echo_controller_enabled;
+    seek_audio_enabled_ = seek_audio_enabled;
   }
 
   changed |= first_update_;
@@ -410,6 +431,7 @@ bool AudioProcessingImpl::SubmoduleStates::CaptureMultiBandProcessingActive(
     bool ec_processing_active) const {
   return high_pass_filter_enabled_ || mobile_echo_controller_enabled_ ||
          noise_suppressor_enabled_ || adaptive_gain_controller_enabled_ ||
+         seek_audio_enabled_ ||
          (echo_controller_enabled_ && ec_processing_active);
 }
 
@@ -426,7 +448,8 @@ bool AudioProcessingImpl::SubmoduleStates::CaptureAnalyzerActive() const {
 bool AudioProcessingImpl::SubmoduleStates::RenderMultiBandSubModulesActive()
     const {
   return RenderMultiBandProcessingActive() || mobile_echo_controller_enabled_ ||
-         adaptive_gain_controller_enabled_ || echo_controller_enabled_;
+         adaptive_gain_controller_enabled_ || echo_controller_enabled_ ||
+         seek_audio_enabled_;
 }
 
 bool AudioProcessingImpl::SubmoduleStates::RenderFullBandProcessingActive()
@@ -506,15 +529,16 @@ AudioProcessingImpl::AudioProcessingImpl(
   }
 
   RTC_LOG(LS_INFO) << "AudioProcessing: " << config_.ToString();
+  capture_stage_timer_.SetEnabled(config_.pipeline.measure_stage_timings);
 
-#if AEC_TEST
+  // SeekAudio AEC only by default, the AFC can be added at runtime through
+  // RuntimeSetting::CreateSeekAudioMode().
   config_.seek_audio_aec.enabled = true;
   config_.seek_audio_aec.suppress_level = 35;
   config_.seek_audio_aec.echo_level = 35;
-#else
-  config_.seek_audio_afc.enabled = true;
-  config_.seek_audio_aec.suppress_level = 35;
-#endif
+  config_.seek_audio_afc.suppress_level = 35;
+  SeekAudioLibraries seek_audio_libraries = AcquireSeekAudioLibraries(config_);
+  SwapSeekAudioLibraries(seek_audio_libraries);
 
   // Mark Echo Controller enabled if a factory is injected.
   capture_nonlocked_.echo_controller_enabled =
@@ -557,6 +581,11 @@ void AudioProcessingImpl::MaybeInitializeRender(
 }
 
 void AudioProcessingImpl::InitializeLocked() {
+  std::vector<uint8_t> warm_start_state;
+  if (config_.pipeline.warm_start_on_reinitialization) {
+    warm_start_state = GetWarmStartStateLocked();
+  }
+
   UpdateActiveSubmoduleStates();
 
   const int render_audiobuffer_sample_rate_hz =
@@ -586,27 +615,6 @@ void AudioProcessingImpl::InitializeLocked() {
     render_.render_converter.reset(nullptr);
   }
 
-  agc_in_audio.reset(new AudioBuffer(
-	  formats_.api_format.input_stream().sample_rate_hz(),
-	  formats_.api_format.input_stream().num_channels(),
-	  capture_nonlocked_.capture_processing_format.sample_rate_hz(),
-	  formats_.api_format.output_stream().num_channels(),
-	  formats_.api_format.output_stream().sample_rate_hz(),
-	  formats_.api_format.output_stream().num_channels()));
-  SetDownmixMethod(*agc_in_audio,
-	  config_.pipeline.capture_downmix_method);
-
-  agc_out_audio.reset(new AudioBuffer(
-	  formats_.api_format.input_stream().sample_rate_hz(),
-	  formats_.api_format.input_stream().num_channels(),
-	  capture_nonlocked_.capture_processing_format.sample_rate_hz(),
-	  formats_.api_format.output_stream().num_channels(),
-	  formats_.api_format.output_stream().sample_rate_hz(),
-	  formats_.api_format.output_stream().num_channels()));
-  SetDownmixMethod(*agc_out_audio,
-	  config_.pipeline.capture_downmix_method);
-
-
   capture_.capture_audio.reset(new AudioBuffer(
       formats_.api_format.input_stream().sample_rate_hz(),
       formats_.api_format.input_stream().num_channels(),
@@ -632,79 +640,7 @@ void AudioProcessingImpl::InitializeLocked() {
   } else {
     capture_.capture_fullband_audio.reset();
   }
-#if AEC_TEST  
-  if (config_.seek_audio_aec.enabled) {
-	  LOGI("Initializing SeekAudio AEC module");
-	  if (!submodules_.seek_audio_aec) {
-		  submodules_.seek_audio_aec = std::make_unique<SeekAudioAec>();
-	  }
-#if LOG_TEST
-	  if (!config_.seek_audio_aec.log_directory.empty()) {
-		  LOGI("Opening AEC log in directory: %s", config_.seek_audio_aec.log_directory.c_str());
-		  if (submodules_.seek_audio_aec->ProcessOpenLog(config_.seek_audio_aec.log_directory.c_str()) != 0) {
-			  LOGW("Failed to open SeekAudioAEC log");
-		  }
-		  else {
-			  LOGI("AEC log opened successfully");
-		  }
-	  }
-#endif
-
-	  bool aec_initialized = submodules_.seek_audio_aec->Initialize(16000);//only support 16k samplerate
-	  submodules_.seek_audio_aec->SetSuppressPowerHowl(config_.seek_audio_aec.suppress_level);
-	  submodules_.seek_audio_aec->SetSuppressPowerEcho(config_.seek_audio_aec.echo_level);
-
-	  if (!aec_initialized) {
-		  LOGW("SeekAudio AEC initialization failed, disabling module");
-		  submodules_.seek_audio_aec.reset();
-	  }
-	  else {
-		  LOGI("SeekAudio AEC module initialized successfully");
-	  }
-  }
-  else {
-	  LOGI("SeekAudio AEC disabled by configuration");
-	  submodules_.seek_audio_aec.reset();
-  }
-#else
-  if (config_.seek_audio_afc.enabled) {
-      LOGI("Initializing SeekAudio AFC module");
-      if (!submodules_.seek_audio_afc) {
-          submodules_.seek_audio_afc = std::make_unique<SeekAudioAfc>();
-      }
-
-#if LOG_TEST
-	  if (!config_.seek_audio_afc.log_directory.empty()) {
-		  LOGI("Opening AFC log in directory: %s", config_.seek_audio_afc.log_directory.c_str());
-		  if (submodules_.seek_audio_afc->ProcessOpenLog(config_.seek_audio_afc.log_directory.c_str()) != 0) {
-			  LOGW("Failed to open SeekAudioAFC log");
-		  }
-		  else {
-			  LOGI("AFC log opened successfully");
-		  }
-	  }
-#endif
-
-      bool afc_initialized = submodules_.seek_audio_afc->Initialize(
-          16000 ,
-          formats_.api_format.input_stream().num_channels());
-
-	  submodules_.seek_audio_afc->SetSuppressPower(config_.seek_audio_afc.suppress_level);
-	  
-
-      if (!afc_initialized) {
-          LOGW("SeekAudio AFC initialization failed, disabling module");
-          submodules_.seek_audio_afc.reset();
-      }
-      else {
-          LOGI("SeekAudio AFC module initialized successfully");
-      }
-  }
-  else {
-      LOGI("SeekAudio AFC disabled by configuration");
-      submodules_.seek_audio_afc.reset();
-  }
-#endif
+  InitializeSeekAudio();
 
   AllocateRenderQueue();
 
@@ -719,6 +655,10 @@ void AudioProcessingImpl::InitializeLocked() {
   InitializePreProcessor();
   InitializeCaptureLevelsAdjuster();
 
+  if (!warm_start_state.empty()) {
+    SetWarmStartStateLocked(warm_start_state);
+  }
+
   if (aec_dump_) {
     aec_dump_->WriteInitMessage(formats_.api_format, TimeUTCMillis());
   }
@@ -803,6 +743,11 @@ void AudioProcessingImpl::InitializeLocked(const ProcessingConfig& config) {
 }
 
 void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
+  // The SeekAudio engine libraries are opened before taking the locks, so that
+  // the capture thread does not wait for it. The libraries replaced below are
+  // closed after the locks are released.
+  SeekAudioLibraries seek_audio_libraries = AcquireSeekAudioLibraries(config);
+
   // Run in a single-threaded manner when applying the settings.
   MutexLock lock_render(&mutex_render_);
   MutexLock lock_capture(&mutex_capture_);
@@ -841,7 +786,39 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
   const bool gain_adjustment_config_changed =
       config_.capture_level_adjustment != config.capture_level_adjustment;
 
+  const bool seek_audio_governor_config_changed =
+      config_.seek_audio_power_governor != config.seek_audio_power_governor;
+
+  const bool seek_audio_async_config_changed =
+      config_.seek_audio_aec.async_lookahead_frames !=
+          config.seek_audio_aec.async_lookahead_frames ||
+      config_.seek_audio_aec.shared_worker_threads !=
+          config.seek_audio_aec.shared_worker_threads;
+
+  const bool seek_audio_agc_compensation_config_changed =
+      config_.seek_audio_aec.agc_compensation !=
+          config.seek_audio_aec.agc_compensation ||
+      config_.seek_audio_afc.agc_compensation !=
+          config.seek_audio_afc.agc_compensation;
+
+  const bool seek_audio_alignment_config_changed =
+      config_.seek_audio_aec.align_far_end !=
+      config.seek_audio_aec.align_far_end;
+
+  const bool seek_audio_jitter_config_changed =
+      config_.seek_audio_aec.far_end_jitter_allowance_frames !=
+      config.seek_audio_aec.far_end_jitter_allowance_frames;
+
+  const bool seek_audio_modules_config_changed =
+      config_.seek_audio_aec.enabled != config.seek_audio_aec.enabled ||
+      config_.seek_audio_aec.library_path !=
+          config.seek_audio_aec.library_path ||
+      config_.seek_audio_afc.enabled != config.seek_audio_afc.enabled ||
+      config_.seek_audio_afc.library_path !=
+          config.seek_audio_afc.library_path;
+
   config_ = config;
+  capture_stage_timer_.SetEnabled(config_.pipeline.measure_stage_timings);
 
   if (aec_config_changed) {
     InitializeEchoController();
@@ -872,6 +849,42 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
     InitializeCaptureLevelsAdjuster();
   }
 
+  SwapSeekAudioLibraries(seek_audio_libraries);
+  if (seek_audio_modules_config_changed) {
+    InitializeSeekAudio();
+  }
+
+  if (seek_audio_async_config_changed && submodules_.seek_audio_aec) {
+    InitializeSeekAudioAsync();
+  }
+
+  if (seek_audio_alignment_config_changed && submodules_.seek_audio_aec) {
+    submodules_.seek_audio_aec->SetFarEndAlignment(
+        config_.seek_audio_aec.align_far_end);
+  }
+
+  if (seek_audio_jitter_config_changed && seek_audio_far_end_queue_) {
+    seek_audio_far_end_queue_->set_jitter_allowance_frames(
+        config_.seek_audio_aec.far_end_jitter_allowance_frames);
+  }
+
+  if (seek_audio_agc_compensation_config_changed) {
+    InitializeSeekAudioAgcCompensation();
+  }
+
+  if (seek_audio_governor_config_changed) {
+    if (submodules_.seek_audio_aec) {
+      submodules_.seek_audio_aec->ConfigurePower(
+          config_.seek_audio_aec.suppress_level,
+          config_.seek_audio_aec.echo_level, config_.seek_audio_power_governor);
+    }
+    if (submodules_.seek_audio_afc) {
+      submodules_.seek_audio_afc->ConfigurePower(
+          config_.seek_audio_afc.suppress_level,
+          config_.seek_audio_power_governor);
+    }
+  }
+
   // Reinitialization must happen after all submodule configuration to avoid
   // additional reinitializations on the next capture / render processing call.
   if (pipeline_config_changed) {
@@ -963,6 +976,16 @@ bool AudioProcessingImpl::PostRuntimeSetting(RuntimeSetting setting) {
     case RuntimeSetting::Type::kCaptureFixedPostGain:
     case RuntimeSetting::Type::kCaptureOutputUsed:
       return capture_runtime_settings_enqueuer_.Enqueue(setting);
+    case RuntimeSetting::Type::kSeekAudioMode: {
+      // The engine libraries are opened and closed on the calling thread, the
+      // capture thread only switches between the modules.
+      int mode;
+      setting.GetInt(&mode);
+      UpdateSeekAudioLibraries(
+          mode & static_cast<int>(RuntimeSetting::SeekAudioMode::kAec),
+          mode & static_cast<int>(RuntimeSetting::SeekAudioMode::kAfc));
+      return capture_runtime_settings_enqueuer_.Enqueue(setting);
+    }
     case RuntimeSetting::Type::kPlayoutVolumeChange: {
       bool enqueueing_successful;
       enqueueing_successful =
@@ -1161,6 +1184,13 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
         setting.GetBool(&value);
         HandleCaptureOutputUsedSetting(value);
         break;
+      case RuntimeSetting::Type::kSeekAudioMode: {
+        int value;
+        setting.GetInt(&value);
+        HandleSeekAudioModeSetting(
+            static_cast<RuntimeSetting::SeekAudioMode>(value));
+        break;
+      }
     }
     ++num_settings_processed;
   }
@@ -1172,6 +1202,157 @@ void AudioProcessingImpl::HandleCaptureRuntimeSettings() {
   }
 }
 
+void AudioProcessingImpl::HandleSeekAudioModeSetting(
+    RuntimeSetting::SeekAudioMode mode) {
+  const int mode_bits = static_cast<int>(mode);
+  const bool aec_enabled =
+      mode_bits & static_cast<int>(RuntimeSetting::SeekAudioMode::kAec);
+  const bool afc_enabled =
+      mode_bits & static_cast<int>(RuntimeSetting::SeekAudioMode::kAfc);
+  if (aec_enabled == config_.seek_audio_aec.enabled &&
+      afc_enabled == config_.seek_audio_afc.enabled) {
+    return;
+  }
+  RTC_LOG(LS_INFO) << "SeekAudio mode: aec=" << aec_enabled
+                   << ", afc=" << afc_enabled;
+  config_.seek_audio_aec.enabled = aec_enabled;
+  config_.seek_audio_afc.enabled = afc_enabled;
+  // Only the SeekAudio modules are (re)created, from the libraries opened by
+  // PostRuntimeSetting(). Turning SeekAudio on or off as a whole changes the
+  // band splitting, which reinitializes APM on the next frame through
+  // UpdateActiveSubmoduleStates().
+  InitializeSeekAudio();
+}
+
+AudioProcessingImpl::SeekAudioLibraries
+AudioProcessingImpl::AcquireSeekAudioLibraries(
+    const AudioProcessing::Config& config) {
+  SeekAudioLibraries libraries;
+  libraries.aec_path = config.seek_audio_aec.library_path;
+  libraries.afc_path = config.seek_audio_afc.library_path;
+  if (config.seek_audio_aec.enabled) {
+    libraries.aec = SeekAudioLibrary::AcquireAec(libraries.aec_path);
+  }
+  if (config.seek_audio_afc.enabled) {
+    libraries.afc = SeekAudioLibrary::AcquireAfc(libraries.afc_path);
+  }
+  return libraries;
+}
+
+void AudioProcessingImpl::SwapSeekAudioLibraries(
+    SeekAudioLibraries& libraries) {
+  MutexLock lock(&mutex_seek_audio_libraries_);
+  std::swap(seek_audio_libraries_, libraries);
+}
+
+void AudioProcessingImpl::UpdateSeekAudioLibraries(bool aec, bool afc) {
+  // Declared first, so that the released libraries are closed after the lock
+  // below is released.
+  std::shared_ptr<const SeekAudioLibrary> released_aec_library;
+  std::shared_ptr<const SeekAudioLibrary> released_afc_library;
+  std::string aec_path;
+  std::string afc_path;
+  {
+    MutexLock lock(&mutex_seek_audio_libraries_);
+    // A module that is switched off keeps its library until the capture
+    // thread has released it.
+    if (!aec && !seek_audio_aec_library_in_use_) {
+      released_aec_library = std::move(seek_audio_libraries_.aec);
+    }
+    if (!afc && !seek_audio_afc_library_in_use_) {
+      released_afc_library = std::move(seek_audio_libraries_.afc);
+    }
+    aec = aec && !seek_audio_libraries_.aec;
+    afc = afc && !seek_audio_libraries_.afc;
+    aec_path = seek_audio_libraries_.aec_path;
+    afc_path = seek_audio_libraries_.afc_path;
+  }
+  // The lock is not held while opening, which would block a capture thread
+  // initializing the SeekAudio modules meanwhile.
+  std::shared_ptr<const SeekAudioLibrary> aec_library =
+      aec ? SeekAudioLibrary::AcquireAec(aec_path) : nullptr;
+  std::shared_ptr<const SeekAudioLibrary> afc_library =
+      afc ? SeekAudioLibrary::AcquireAfc(afc_path) : nullptr;
+  MutexLock lock(&mutex_seek_audio_libraries_);
+  if (aec_library && !seek_audio_libraries_.aec &&
+      seek_audio_libraries_.aec_path == aec_path) {
+    seek_audio_libraries_.aec = std::move(aec_library);
+  }
+  if (afc_library && !seek_audio_libraries_.afc &&
+      seek_audio_libraries_.afc_path == afc_path) {
+    seek_audio_libraries_.afc = std::move(afc_library);
+  }
+}
+
+std::vector<uint8_t> AudioProcessingImpl::GetWarmStartState() {
+  MutexLock lock_capture(&mutex_capture_);
+  return GetWarmStartStateLocked();
+}
+
+bool AudioProcessingImpl::SetWarmStartState(ArrayView<const uint8_t> state) {
+  MutexLock lock_capture(&mutex_capture_);
+  return SetWarmStartStateLocked(state);
+}
+
+std::vector<uint8_t> AudioProcessingImpl::GetWarmStartStateLocked() {
+  using Module = SeekAudioWarmStart::Module;
+  SeekAudioWarmStart warm_start;
+  if (submodules_.echo_canceller3) {
+    warm_start.Add(Module::kAec3, 0,
+                   submodules_.echo_canceller3->GetWarmStartState());
+  }
+  if (submodules_.seek_audio_aec) {
+    for (int ch = 0; ch < submodules_.seek_audio_aec->num_channels(); ++ch) {
+      warm_start.Add(Module::kSeekAudioAec, ch,
+                     submodules_.seek_audio_aec->GetEngineState(ch));
+    }
+  }
+  if (submodules_.seek_audio_afc) {
+    for (int ch = 0; ch < submodules_.seek_audio_afc->num_channels(); ++ch) {
+      warm_start.Add(Module::kSeekAudioAfc, ch,
+                     submodules_.seek_audio_afc->GetEngineState(ch));
+    }
+  }
+  if (warm_start.sections().empty()) {
+    return {};
+  }
+  return warm_start.Serialize();
+}
+
+bool AudioProcessingImpl::SetWarmStartStateLocked(
+    ArrayView<const uint8_t> state) {
+  using Module = SeekAudioWarmStart::Module;
+  SeekAudioWarmStart warm_start;
+  if (!warm_start.Parse(state)) {
+    RTC_LOG(LS_WARNING) << "Malformed warm start state";
+    return false;
+  }
+  bool restored = false;
+  ArrayView<const uint8_t> aec3_state = warm_start.Find(Module::kAec3, 0);
+  if (submodules_.echo_canceller3 && !aec3_state.empty()) {
+    restored |= submodules_.echo_canceller3->SetWarmStartState(aec3_state);
+  }
+  if (submodules_.seek_audio_aec) {
+    for (int ch = 0; ch < submodules_.seek_audio_aec->num_channels(); ++ch) {
+      ArrayView<const uint8_t> engine_state =
+          warm_start.Find(Module::kSeekAudioAec, ch);
+      if (!engine_state.empty()) {
+        restored |= submodules_.seek_audio_aec->SetEngineState(ch, engine_state);
+      }
+    }
+  }
+  if (submodules_.seek_audio_afc) {
+    for (int ch = 0; ch < submodules_.seek_audio_afc->num_channels(); ++ch) {
+      ArrayView<const uint8_t> engine_state =
+          warm_start.Find(Module::kSeekAudioAfc, ch);
+      if (!engine_state.empty()) {
+        restored |= submodules_.seek_audio_afc->SetEngineState(ch, engine_state);
+      }
+    }
+  }
+  return restored;
+}
+
 void AudioProcessingImpl::HandleOverrunInCaptureRuntimeSettingsQueue() {
   // Fall back to a safe state for the case when a setting for capture output
   // usage setting has been missed.
@@ -1197,6 +1378,7 @@ void AudioProcessingImpl::HandleRenderRuntimeSettings() {
       case RuntimeSetting::Type::kCaptureCompressionGain:  // fall-through
       case RuntimeSetting::Type::kCaptureFixedPostGain:    // fall-through
       case RuntimeSetting::Type::kCaptureOutputUsed:       // fall-through
+      case RuntimeSetting::Type::kSeekAudioMode:           // fall-through
       case RuntimeSetting::Type::kNotSpecified:
         RTC_DCHECK_NOTREACHED();
         break;
@@ -1224,6 +1406,25 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     }
   }
 
+  if (seek_audio_render_queue_active_.load(std::memory_order_relaxed)) {
+    RTC_DCHECK(seek_audio_far_end_queue_);
+    // Unlike above, a full queue drops the frame rather than taking the
+    // capture lock to empty it.
+    SeekAudioFarEndQueue::Frame* frame = seek_audio_far_end_queue_->BeginPush();
+    if (frame) {
+      frame->num_samples = audio->num_frames_per_band();
+      frame->render_time_us = TimeMicros();
+      // The AEC takes one far-end reference for all its capture channels.
+      RTC_DCHECK(seek_audio_render_mixer_);
+      RTC_DCHECK_EQ(audio->num_channels(),
+                    seek_audio_render_mixer_->num_channels());
+      seek_audio_render_mixer_->Mix(
+          audio->split_channels_const(kBand0To8kHz),
+          ArrayView<float>(frame->samples.data(), frame->num_samples));
+      seek_audio_far_end_queue_->CommitPush();
+    }
+  }
+
   if (!submodules_.agc_manager && submodules_.gain_control) {
     GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
@@ -1283,6 +1484,21 @@ void AudioProcessingImpl::AllocateRenderQueue() {
     agc_render_signal_queue_->Clear();
   }
 
+  // Allocated regardless of the SeekAudio mode, since the mode may change
+  // without reinitialization.
+  if (!seek_audio_far_end_queue_) {
+    seek_audio_far_end_queue_ = std::make_unique<SeekAudioFarEndQueue>(
+        kMaxNumFramesToBuffer,
+        config_.seek_audio_aec.far_end_jitter_allowance_frames);
+  } else {
+    seek_audio_far_end_queue_->Clear();
+  }
+  if (!seek_audio_render_mixer_ ||
+      seek_audio_render_mixer_->num_channels() != num_reverse_channels()) {
+    seek_audio_render_mixer_ =
+        std::make_unique<SeekAudioRenderMixer>(num_reverse_channels());
+  }
+
   if (submodules_.echo_detector) {
     if (red_render_queue_element_max_size_ <
         new_red_render_queue_element_max_size) {
@@ -1333,6 +1549,20 @@ void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
   }
 }
 
+void AudioProcessingImpl::EmptyQueuedSeekAudioFarEnd() {
+  // Drained also when the AEC is off, to drop frames queued before a mode
+  // change.
+  if (!seek_audio_far_end_queue_) {
+    return;
+  }
+  seek_audio_far_end_queue_->Drain(
+      TimeMicros(), [this](const SeekAudioFarEndQueue::Frame& frame) {
+        if (submodules_.seek_audio_aec) {
+          submodules_.seek_audio_aec->AnalyzeRender(frame.view());
+        }
+      });
+}
+
 int AudioProcessingImpl::ProcessStream(const int16_t* const src,
                                        const StreamConfig& input_config,
                                        const StreamConfig& output_config,
@@ -1371,8 +1601,20 @@ int AudioProcessingImpl::ProcessStream(const int16_t* const src,
 }
 
 int AudioProcessingImpl::ProcessCaptureStreamLocked() {
-  EmptyQueuedRenderAudioLocked();
+  CaptureStageTimer::FrameScope frame_timing(capture_stage_timer_);
+  {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kRenderQueues);
+    EmptyQueuedRenderAudioLocked();
+  }
   HandleCaptureRuntimeSettings();
+  {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kRenderQueues);
+    // After the runtime settings, so that an AEC created by a mode change gets
+    // the far-end frames of this capture frame.
+    EmptyQueuedSeekAudioFarEnd();
+  }
   DenormalDisabler denormal_disabler;
 
   // Ensure that not both the AEC and AECM are active at the same time.
@@ -1391,11 +1633,15 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodules_.high_pass_filter &&
       config_.high_pass_filter.apply_in_full_band &&
       !constants_.enforce_split_band_hpf) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kHighPassFilter);
     submodules_.high_pass_filter->Process(capture_buffer,
                                           /*use_split_band_data=*/false);
   }
 
   if (submodules_.capture_levels_adjuster) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kCaptureLevelsAdjuster);
     if (config_.capture_level_adjustment.analog_mic_gain_emulation.enabled) {
       // When the input volume is emulated, retrieve the volume applied to the
       // input audio and notify that to APM so that the volume is passed to the
@@ -1448,10 +1694,14 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
          capture_.prev_playout_volume >= 0);
     capture_.prev_playout_volume = capture_.playout_volume;
 
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kEchoController);
     submodules_.echo_controller->AnalyzeCapture(capture_buffer);
   }
 
   if (submodules_.agc_manager) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kGainControl);
     submodules_.agc_manager->AnalyzePreProcess(*capture_buffer);
   }
 
@@ -1460,6 +1710,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     // Expect the volume to be available if the input controller is enabled.
     RTC_DCHECK(capture_.applied_input_volume.has_value());
     if (capture_.applied_input_volume.has_value()) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kGainController2);
       submodules_.gain_controller2->Analyze(*capture_.applied_input_volume,
                                             *capture_buffer);
     }
@@ -1484,11 +1736,15 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodules_.high_pass_filter &&
       (!config_.high_pass_filter.apply_in_full_band ||
        constants_.enforce_split_band_hpf)) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kHighPassFilter);
     submodules_.high_pass_filter->Process(capture_buffer,
                                           /*use_split_band_data=*/true);
   }
 
   if (submodules_.gain_control) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kGainControl);
     RETURN_ON_ERR(
         submodules_.gain_control->AnalyzeCaptureAudio(*capture_buffer));
   }
@@ -1496,6 +1752,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if ((!config_.noise_suppression.analyze_linear_aec_output_when_available ||
        !linear_aec_buffer || submodules_.echo_control_mobile) &&
       submodules_.noise_suppressor) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kNoiseSuppressor);
     submodules_.noise_suppressor->Analyze(*capture_buffer);
   }
 
@@ -1507,13 +1765,19 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.noise_suppressor) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kNoiseSuppressor);
       submodules_.noise_suppressor->Process(capture_buffer);
     }
 
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kEchoControlMobile);
     RETURN_ON_ERR(submodules_.echo_control_mobile->ProcessCaptureAudio(
         capture_buffer, stream_delay_ms()));
   } else {
     if (submodules_.echo_controller) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kEchoController);
       data_dumper_->DumpRaw("stream_delay", stream_delay_ms());
 
       if (capture_.was_stream_delay_set) {
@@ -1526,54 +1790,120 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
     if (config_.noise_suppression.analyze_linear_aec_output_when_available &&
         linear_aec_buffer && submodules_.noise_suppressor) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kNoiseSuppressor);
       submodules_.noise_suppressor->Analyze(*linear_aec_buffer);
     }
 
     if (submodules_.noise_suppressor) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kNoiseSuppressor);
       submodules_.noise_suppressor->Process(capture_buffer);
     }
   }
-#if AEC_TEST
   if (submodules_.seek_audio_aec) {
+	  CaptureStageTimer::StageScope timing(
+	      capture_stage_timer_, CaptureStage::kSeekAudioAec);
 
 	  //LOGI("Calling SeekAudio AEC processing,num_frames_per_band:%d,num_frames:%d", capture_buffer->num_frames_per_band(), capture_buffer->num_frames());
 
-	  if (capture_buffer->num_frames_per_band() == 160) {		  
-		  submodules_.seek_audio_aec->ProcessCaptureAudio(
-			  capture_buffer->split_bands(0), capture_buffer->num_frames_per_band());
-
-		  float howling_prob = submodules_.seek_audio_aec->GetHowlingProbability();
-		  if (howling_prob > 0.9f) {
-			  LOGW("High howling probability detected: %.3f", howling_prob);
-		  }
+	  submodules_.seek_audio_aec->ProcessCapture(capture_buffer);
+	  // The echo detector runs later in the chain, so the governor sees the
+	  // likelihood of the previous frame.
+	  std::optional<float> residual_echo_likelihood;
+	  if (submodules_.echo_detector &&
+		  capture_.stats.residual_echo_likelihood) {
+		  residual_echo_likelihood = *capture_.stats.residual_echo_likelihood;
 	  }
-	  else {
-		  LOGW("Audio frame size mismatch: expected 160, got %d", capture_buffer->num_frames_per_band());
+	  submodules_.seek_audio_aec->UpdatePowerGovernor(residual_echo_likelihood);
+
+	  float howling_prob = submodules_.seek_audio_aec->GetHowlingProbability();
+	  if (howling_prob > 0.9f) {
+		  SEEK_AUDIO_EVENT(submodules_.seek_audio_aec->events(),
+		                   SeekAudioEvent::kHowling,
+		                   "High howling probability detected: %.3f",
+		                   howling_prob);
 	  }
   }
-#else
+
+  if (submodules_.seek_audio_aec &&
+      submodules_.seek_audio_aec->async_lookahead_frames() > 0) {
+    capture_.stats.seek_audio_latency_ms =
+        submodules_.seek_audio_aec->async_lookahead_frames() * 10;
+    capture_.stats.seek_audio_late_frames =
+        submodules_.seek_audio_aec->num_late_frames();
+    capture_.stats.seek_audio_deadline_slack_us = static_cast<int32_t>(
+        submodules_.seek_audio_aec->deadline_slack_us());
+  } else {
+    capture_.stats.seek_audio_latency_ms = std::nullopt;
+    capture_.stats.seek_audio_late_frames = std::nullopt;
+    capture_.stats.seek_audio_deadline_slack_us = std::nullopt;
+  }
+  if (submodules_.seek_audio_aec && seek_audio_far_end_queue_) {
+    capture_.stats.seek_audio_far_end_overflows =
+        seek_audio_far_end_queue_->num_overflows();
+    capture_.stats.seek_audio_far_end_underflows =
+        seek_audio_far_end_queue_->num_underflows();
+    capture_.stats.seek_audio_far_end_queue_delay_ms = static_cast<int32_t>(
+        seek_audio_far_end_queue_->queue_delay_us() / 1000);
+    capture_.stats.seek_audio_far_end_delay_ms =
+        submodules_.seek_audio_aec->far_end_delay_ms();
+  } else {
+    capture_.stats.seek_audio_far_end_overflows = std::nullopt;
+    capture_.stats.seek_audio_far_end_underflows = std::nullopt;
+    capture_.stats.seek_audio_far_end_queue_delay_ms = std::nullopt;
+    capture_.stats.seek_audio_far_end_delay_ms = std::nullopt;
+  }
+
+  // In AEC->AFC mode the AFC runs on the echo cancelled signal.
   if (submodules_.seek_audio_afc) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kSeekAudioAfc);
 
       //LOGI("Calling SeekAudio AFC processing,num_frames_per_band:%d,num_frames:%d", capture_buffer->num_frames_per_band(), capture_buffer->num_frames());
       
-      if (capture_buffer->num_frames_per_band() == 160) {
-          submodules_.seek_audio_afc->ProcessCaptureAudio(
-              capture_buffer->split_bands(0), capture_buffer->num_frames_per_band());
-
-          float howling_prob = submodules_.seek_audio_afc->GetHowlingProbability();
-          if (howling_prob > 0.9f) {
-              LOGW("High howling probability detected: %.3f", howling_prob);
-          }
-      }
-      else {
-          LOGW("Audio frame size mismatch: expected 160, got %d", capture_buffer->num_frames_per_band());
+      submodules_.seek_audio_afc->ProcessCapture(capture_buffer);
+      submodules_.seek_audio_afc->UpdatePowerGovernor();
+
+      float howling_prob = submodules_.seek_audio_afc->GetHowlingProbability();
+      if (howling_prob > 0.9f) {
+          SEEK_AUDIO_EVENT(submodules_.seek_audio_afc->events(),
+                           SeekAudioEvent::kHowling,
+                           "High howling probability detected: %.3f",
+                           howling_prob);
       }
   }
-#endif
 
-  capture_buffer->CopyTo(agc_in_audio.get());
+  if (submodules_.seek_audio_aec || submodules_.seek_audio_afc) {
+    const SeekAudioAec* aec = submodules_.seek_audio_aec.get();
+    const SeekAudioAfc* afc = submodules_.seek_audio_afc.get();
+    capture_.stats.seek_audio_not_ready_frames =
+        SeekAudioEventCount(aec, afc, SeekAudioEvent::kNotReady);
+    capture_.stats.seek_audio_invalid_frames =
+        SeekAudioEventCount(aec, afc, SeekAudioEvent::kInvalidFrame);
+    capture_.stats.seek_audio_engine_errors =
+        SeekAudioEventCount(aec, afc, SeekAudioEvent::kEngineError);
+    capture_.stats.seek_audio_power_changes =
+        SeekAudioEventCount(aec, afc, SeekAudioEvent::kPowerChange);
+    capture_.stats.seek_audio_howling_frames =
+        SeekAudioEventCount(aec, afc, SeekAudioEvent::kHowling);
+  } else {
+    capture_.stats.seek_audio_not_ready_frames = std::nullopt;
+    capture_.stats.seek_audio_invalid_frames = std::nullopt;
+    capture_.stats.seek_audio_engine_errors = std::nullopt;
+    capture_.stats.seek_audio_power_changes = std::nullopt;
+    capture_.stats.seek_audio_howling_frames = std::nullopt;
+  }
+
+  if (submodules_.seek_audio_agc_compensation) {
+    CaptureStageTimer::StageScope timing(
+        capture_stage_timer_, CaptureStage::kSeekAudioAgcCompensation);
+    submodules_.seek_audio_agc_compensation->AnalyzeAgcInput(*capture_buffer);
+  }
 
   if (submodules_.agc_manager) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kGainControl);
     submodules_.agc_manager->Process(*capture_buffer);
 
     std::optional<int> new_digital_gain =
@@ -1584,11 +1914,38 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (submodules_.gain_control) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kGainControl);
     // TODO(peah): Add reporting from AEC3 whether there is echo.
     RETURN_ON_ERR(submodules_.gain_control->ProcessCaptureAudio(
         capture_buffer, /*stream_has_echo*/ false));
   }
 
+  // Runs on the split bands while they are at hand, see
+  // SeekAudioAgcCompensation.
+  if (submodules_.seek_audio_agc_compensation) {
+    CaptureStageTimer::StageScope timing(
+        capture_stage_timer_, CaptureStage::kSeekAudioAgcCompensation);
+    SeekAudioAec* aec = config_.seek_audio_aec.agc_compensation
+                            ? submodules_.seek_audio_aec.get()
+                            : nullptr;
+    SeekAudioAfc* afc = config_.seek_audio_afc.agc_compensation
+                            ? submodules_.seek_audio_afc.get()
+                            : nullptr;
+    submodules_.seek_audio_agc_compensation->Process(
+        capture_buffer, [aec, afc](float* const* agc_in, float* const* agc_out,
+                                   float* const* frames) {
+          if (aec) {
+            aec->ProcessAGCCompensate(agc_in, agc_out, frames,
+                                      kSeekAudioFrameSize);
+          }
+          if (afc) {
+            afc->ProcessAGCCompensate(agc_in, agc_out, frames,
+                                      kSeekAudioFrameSize);
+          }
+        });
+  }
+
   if (submodule_states_.CaptureMultiBandProcessingPresent() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
@@ -1608,6 +1965,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.echo_detector) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kEchoDetector);
       submodules_.echo_detector->AnalyzeCaptureAudio(ArrayView<const float>(
           capture_buffer->channels()[0], capture_buffer->num_frames()));
     }
@@ -1618,6 +1977,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.gain_controller2) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kGainController2);
       // TODO(bugs.webrtc.org/7494): Let AGC2 detect applied input volume
       // changes.
       submodules_.gain_controller2->Process(
@@ -1626,10 +1987,14 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.post_filter) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kPostFilter);
       submodules_.post_filter->Process(*capture_buffer);
     }
 
     if (submodules_.capture_post_processor) {
+      CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                           CaptureStage::kCapturePostProcessor);
       submodules_.capture_post_processor->Process(capture_buffer);
     }
 
@@ -1663,24 +2028,6 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     capture_.stats.delay_ms = ec_metrics.delay_ms;
   }
 
-  capture_buffer->CopyTo(agc_out_audio.get());
-
-#if 0
-#if AEC_TEST
-  if (submodules_.seek_audio_aec && capture_nonlocked_.capture_processing_format.sample_rate_hz() == 16000 && capture_buffer->num_frames() == 160)
-  {
-	  submodules_.seek_audio_aec->ProcessAGCCompensate(agc_in_audio->channels(), agc_out_audio->channels(),
-		  capture_buffer->channels(), capture_buffer->num_frames());
-  }
-#else
-  if (submodules_.seek_audio_afc && capture_nonlocked_.capture_processing_format.sample_rate_hz() == 16000 && capture_buffer->num_frames() == 160)
-  {
-	submodules_.seek_audio_afc->ProcessAGCCompensate(agc_in_audio->channels(), agc_out_audio->channels(),
-			  capture_buffer->channels(), capture_buffer->num_frames());
-  }
-#endif
-#endif
-
   // Pass stats for reporting.
   stats_reporter_.UpdateStatistics(capture_.stats);
 
@@ -1691,6 +2038,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (submodules_.capture_levels_adjuster) {
+    CaptureStageTimer::StageScope timing(capture_stage_timer_,
+                                         CaptureStage::kCaptureLevelsAdjuster);
     submodules_.capture_levels_adjuster->ApplyPostLevelAdjustment(
         *capture_buffer);
 
@@ -1839,12 +2188,6 @@ int AudioProcessingImpl::ProcessRenderStreamLocked() {
     QueueBandedRenderAudio(render_buffer);
   }
 
-#if AEC_TEST
-  if (submodules_.seek_audio_aec) {
-	  submodules_.seek_audio_aec->BufferFarend(render_buffer->split_bands(0), render_buffer->num_frames_per_band());
-  }
-#endif
-
   // TODO(peah): Perform the queuing inside QueueRenderAudiuo().
   if (submodules_.echo_controller) {
     submodules_.echo_controller->AnalyzeRender(render_buffer);
@@ -2050,7 +2393,155 @@ bool AudioProcessingImpl::UpdateActiveSubmoduleStates() {
       !!submodules_.noise_suppressor, !!submodules_.gain_control,
       !!submodules_.gain_controller2,
       config_.pre_amplifier.enabled || config_.capture_level_adjustment.enabled,
-      capture_nonlocked_.echo_controller_enabled);
+      capture_nonlocked_.echo_controller_enabled,
+      config_.seek_audio_aec.enabled || config_.seek_audio_afc.enabled);
+}
+
+void AudioProcessingImpl::InitializeSeekAudio() {
+  // Modules that are not selected are released. Their engine library is not
+  // closed here, since this may run on the capture thread, but by the next
+  // configuration call, see `seek_audio_libraries_`.
+  seek_audio_render_queue_active_.store(false, std::memory_order_relaxed);
+
+  // The modules only use libraries opened beforehand, a module without one
+  // stays disabled. A library is marked in use before a module is built from
+  // it, and no longer in use once the module has been released below.
+  std::shared_ptr<const SeekAudioLibrary> aec_library;
+  std::shared_ptr<const SeekAudioLibrary> afc_library;
+  {
+    MutexLock lock(&mutex_seek_audio_libraries_);
+    if (config_.seek_audio_aec.enabled) {
+      aec_library = seek_audio_libraries_.aec;
+      seek_audio_aec_library_in_use_ = true;
+    }
+    if (config_.seek_audio_afc.enabled) {
+      afc_library = seek_audio_libraries_.afc;
+      seek_audio_afc_library_in_use_ = true;
+    }
+  }
+
+  if (config_.seek_audio_aec.enabled) {
+    LOGI("Initializing SeekAudio AEC module");
+    if (!submodules_.seek_audio_aec ||
+        submodules_.seek_audio_aec->library_path() !=
+            config_.seek_audio_aec.library_path) {
+      submodules_.seek_audio_aec = std::make_unique<SeekAudioAec>(
+          config_.seek_audio_aec.library_path, aec_library);
+    }
+#if LOG_TEST
+    if (!config_.seek_audio_aec.log_directory.empty()) {
+      LOGI("Opening AEC log in directory: %s",
+           config_.seek_audio_aec.log_directory.c_str());
+      if (submodules_.seek_audio_aec->ProcessOpenLog(
+              config_.seek_audio_aec.log_directory.c_str()) != 0) {
+        LOGW("Failed to open SeekAudioAEC log");
+      } else {
+        LOGI("AEC log opened successfully");
+      }
+    }
+#endif
+
+    // The engine runs at 16 kHz on the lowest split band, see
+    // ProcessCapture().
+    bool aec_initialized = submodules_.seek_audio_aec->Initialize(
+        capture_nonlocked_.split_rate, static_cast<int>(num_proc_channels()));
+    submodules_.seek_audio_aec->ConfigurePower(
+        config_.seek_audio_aec.suppress_level,
+        config_.seek_audio_aec.echo_level, config_.seek_audio_power_governor);
+    submodules_.seek_audio_aec->SetFarEndAlignment(
+        config_.seek_audio_aec.align_far_end);
+    InitializeSeekAudioAsync();
+
+    if (!aec_initialized) {
+      LOGW("SeekAudio AEC initialization failed, disabling module");
+      submodules_.seek_audio_aec.reset();
+    } else {
+      LOGI("SeekAudio AEC module initialized successfully");
+    }
+  } else {
+    LOGI("SeekAudio AEC disabled by configuration");
+    submodules_.seek_audio_aec.reset();
+  }
+
+  if (config_.seek_audio_afc.enabled) {
+    LOGI("Initializing SeekAudio AFC module");
+    if (!submodules_.seek_audio_afc ||
+        submodules_.seek_audio_afc->library_path() !=
+            config_.seek_audio_afc.library_path) {
+      submodules_.seek_audio_afc = std::make_unique<SeekAudioAfc>(
+          config_.seek_audio_afc.library_path, afc_library);
+    }
+#if LOG_TEST
+    if (!config_.seek_audio_afc.log_directory.empty()) {
+      LOGI("Opening AFC log in directory: %s",
+           config_.seek_audio_afc.log_directory.c_str());
+      if (submodules_.seek_audio_afc->ProcessOpenLog(
+              config_.seek_audio_afc.log_directory.c_str()) != 0) {
+        LOGW("Failed to open SeekAudioAFC log");
+      } else {
+        LOGI("AFC log opened successfully");
+      }
+    }
+#endif
+
+    bool afc_initialized = submodules_.seek_audio_afc->Initialize(
+        capture_nonlocked_.split_rate, static_cast<int>(num_proc_channels()));
+    submodules_.seek_audio_afc->ConfigurePower(
+        config_.seek_audio_afc.suppress_level,
+        config_.seek_audio_power_governor);
+
+    if (!afc_initialized) {
+      LOGW("SeekAudio AFC initialization failed, disabling module");
+      submodules_.seek_audio_afc.reset();
+    } else {
+      LOGI("SeekAudio AFC module initialized successfully");
+    }
+  } else {
+    LOGI("SeekAudio AFC disabled by configuration");
+    submodules_.seek_audio_afc.reset();
+  }
+
+  aec_library.reset();
+  afc_library.reset();
+  {
+    MutexLock lock(&mutex_seek_audio_libraries_);
+    seek_audio_aec_library_in_use_ = !!submodules_.seek_audio_aec;
+    seek_audio_afc_library_in_use_ = !!submodules_.seek_audio_afc;
+  }
+
+  InitializeSeekAudioAgcCompensation();
+
+  // The far-end reference is only passed from the render side while the AEC
+  // runs.
+  seek_audio_render_queue_active_.store(!!submodules_.seek_audio_aec,
+                                        std::memory_order_relaxed);
+}
+
+void AudioProcessingImpl::InitializeSeekAudioAsync() {
+  RTC_DCHECK(submodules_.seek_audio_aec);
+  const int lookahead_frames = config_.seek_audio_aec.async_lookahead_frames;
+  std::shared_ptr<SeekAudioScheduler> scheduler;
+  if (lookahead_frames > 0 && config_.seek_audio_aec.shared_worker_threads > 0) {
+    scheduler = SeekAudioScheduler::AcquireShared(
+        config_.seek_audio_aec.shared_worker_threads);
+  }
+  submodules_.seek_audio_aec->SetAsyncLookahead(lookahead_frames,
+                                                std::move(scheduler));
+}
+
+void AudioProcessingImpl::InitializeSeekAudioAgcCompensation() {
+  const bool compensation_enabled =
+      (submodules_.seek_audio_aec && config_.seek_audio_aec.agc_compensation) ||
+      (submodules_.seek_audio_afc && config_.seek_audio_afc.agc_compensation);
+  if (!compensation_enabled) {
+    submodules_.seek_audio_agc_compensation.reset();
+    return;
+  }
+  if (!submodules_.seek_audio_agc_compensation) {
+    submodules_.seek_audio_agc_compensation =
+        std::make_unique<SeekAudioAgcCompensation>();
+  }
+  submodules_.seek_audio_agc_compensation->Initialize(num_proc_channels());
 }
 
 void AudioProcessingImpl::InitializeHighPassFilter(bool forced_reset) {
@@ -2090,6 +2581,7 @@ void AudioProcessingImpl::InitializeEchoController() {
       submodules_.echo_controller = echo_control_factory_->Create(
           env_, proc_sample_rate_hz(), num_reverse_channels(),
           num_proc_channels());
+      submodules_.echo_canceller3 = nullptr;
       RTC_DCHECK(submodules_.echo_controller);
     } else {
       EchoCanceller3Config config;
@@ -2098,9 +2590,11 @@ void AudioProcessingImpl::InitializeEchoController() {
         multichannel_config =
             EchoCanceller3Config::CreateDefaultMultichannelConfig();
       }
-      submodules_.echo_controller = std::make_unique<EchoCanceller3>(
+      auto echo_canceller3 = std::make_unique<EchoCanceller3>(
           env_, config, multichannel_config, proc_sample_rate_hz(),
           num_reverse_channels(), num_proc_channels());
+      submodules_.echo_canceller3 = echo_canceller3.get();
+      submodules_.echo_controller = std::move(echo_canceller3);
     }
 
     // Setup the storage for returning the linear AEC output.
@@ -2128,6 +2622,7 @@ void AudioProcessingImpl::InitializeEchoController() {
   }
 
   submodules_.echo_controller.reset();
+  submodules_.echo_canceller3 = nullptr;
   capture_nonlocked_.echo_controller_enabled = false;
   capture_.linear_aec_output.reset();
 
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,7 @@
 #include "modules/audio_processing/agc2/input_volume_stats_reporter.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/capture_levels_adjuster/capture_levels_adjuster.h"
+#include "modules/audio_processing/capture_stage_timer.h"
 #include "modules/audio_processing/echo_control_mobile_impl.h"
 #include "modules/audio_processing/gain_control_impl.h"
 #include "modules/audio_processing/gain_controller2.h"
@@ -46,6 +48,10 @@
 #include "modules/audio_processing/rms_level.h"
 #include "modules/audio_processing/seek_audio_afc.h"
 #include "modules/audio_processing/seek_audio_aec.h"
+#include "modules/audio_processing/seek_audio_agc_compensation.h"
+#include "modules/audio_processing/seek_audio_far_end_queue.h"
+#include "modules/audio_processing/seek_audio_library.h"
+#include "modules/audio_processing/seek_audio_render_mixer.h"
 #include "rtc_base/gtest_prod_util.h"
 #include "rtc_base/swap_queue.h"
 #include "rtc_base/synchronization/mutex.h"
@@ -55,6 +61,7 @@ namespace webrtc {
 
 class ApmDataDumper;
 class AudioConverter;
+class EchoCanceller3;
 
 constexpr int RuntimeSettingQueueSize() {
   return 100;
@@ -143,6 +150,11 @@ class AudioProcessingImpl : public AudioProcessing {
   }
 
   AudioProcessing::Config GetConfig() const override;
+  std::vector<uint8_t> GetWarmStartState() override;
+  bool SetWarmStartState(ArrayView<const uint8_t> state) override;
+  AudioProcessingStageTimings GetStageTimings() override {
+    return capture_stage_timer_.GetTimings();
+  }
 
  protected:
   // Overridden in a mock.
@@ -207,7 +219,8 @@ class AudioProcessingImpl : public AudioProcessing {
                 bool adaptive_gain_controller_enabled,
                 bool gain_controller2_enabled,
                 bool gain_adjustment_enabled,
-                bool echo_controller_enabled);
+                bool echo_controller_enabled,
+                bool seek_audio_enabled);
     bool CaptureMultiBandSubModulesActive() const;
     bool CaptureMultiBandProcessingPresent() const;
     bool CaptureMultiBandProcessingActive(bool ec_processing_active) const;
@@ -229,6 +242,7 @@ class AudioProcessingImpl : public AudioProcessing {
     bool gain_controller2_enabled_ = false;
     bool gain_adjustment_enabled_ = false;
     bool echo_controller_enabled_ = false;
+    bool seek_audio_enabled_ = false;
     bool first_update_ = true;
   };
 
@@ -288,9 +302,51 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
+  // Creates, initializes or releases the SeekAudio modules according to
+  // `config_`, without touching the rest of APM.
+  void InitializeSeekAudio() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  // Starts, moves or stops the worker of the SeekAudio AEC.
+  void InitializeSeekAudioAsync() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  // Creates or releases the AGC compensation of the SeekAudio modules.
+  void InitializeSeekAudioAgcCompensation()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
+  void HandleSeekAudioModeSetting(RuntimeSetting::SeekAudioMode mode)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
+  // Engine libraries of the SeekAudio modules, see `seek_audio_libraries_`.
+  struct SeekAudioLibraries {
+    std::string aec_path;
+    std::string afc_path;
+    std::shared_ptr<const SeekAudioLibrary> aec;
+    std::shared_ptr<const SeekAudioLibrary> afc;
+  };
+  // Opens the libraries of the modules enabled in `config`. Opening may
+  // block, so this is called without holding any APM lock.
+  static SeekAudioLibraries AcquireSeekAudioLibraries(
+      const AudioProcessing::Config& config);
+  // Replaces the libraries with `libraries`, which receives the previous
+  // ones. They are to be released after the APM locks.
+  void SwapSeekAudioLibraries(SeekAudioLibraries& libraries)
+      RTC_LOCKS_EXCLUDED(mutex_seek_audio_libraries_);
+  // Opens the libraries of the modules selected by a runtime setting, and
+  // releases those of the modules that are neither selected nor in use on
+  // the capture side. Called without holding any APM lock.
+  void UpdateSeekAudioLibraries(bool aec, bool afc)
+      RTC_LOCKS_EXCLUDED(mutex_seek_audio_libraries_);
+
+  // Collect and apply the warm start state of the echo cancellers.
+  std::vector<uint8_t> GetWarmStartStateLocked()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  bool SetWarmStartStateLocked(ArrayView<const uint8_t> state)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+
   void EmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
   void EmptyQueuedRenderAudioLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  // Passes the queued far-end frames to the SeekAudio AEC. Called once per
+  // capture frame.
+  void EmptyQueuedSeekAudioFarEnd() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_, mutex_capture_);
   void QueueBandedRenderAudio(AudioBuffer* audio)
@@ -385,12 +441,15 @@ class AudioProcessingImpl : public AudioProcessing {
     std::unique_ptr<GainController2> gain_controller2;
     std::unique_ptr<HighPassFilter> high_pass_filter;
     std::unique_ptr<EchoControl> echo_controller;
+    // The `echo_controller` when it is an AEC3 created by APM, null otherwise.
+    EchoCanceller3* echo_canceller3 = nullptr;
     std::unique_ptr<EchoControlMobileImpl> echo_control_mobile;
     std::unique_ptr<NoiseSuppressor> noise_suppressor;
     std::unique_ptr<PostFilter> post_filter;
     std::unique_ptr<CaptureLevelsAdjuster> capture_levels_adjuster;
     std::unique_ptr<SeekAudioAfc> seek_audio_afc;
     std::unique_ptr<SeekAudioAec> seek_audio_aec;
+    std::unique_ptr<SeekAudioAgcCompensation> seek_audio_agc_compensation;
   } submodules_;
 
   // State that is written to while holding both the render and capture locks
@@ -497,9 +556,6 @@ class AudioProcessingImpl : public AudioProcessing {
     SwapQueue<AudioProcessingStats> stats_message_queue_;
   } stats_reporter_;
 
-  std::unique_ptr<AudioBuffer> agc_in_audio;
-  std::unique_ptr<AudioBuffer> agc_out_audio;
-
   std::vector<int16_t> aecm_render_queue_buffer_ RTC_GUARDED_BY(mutex_render_);
   std::vector<int16_t> aecm_capture_queue_buffer_
       RTC_GUARDED_BY(mutex_capture_);
@@ -514,6 +570,28 @@ class AudioProcessingImpl : public AudioProcessing {
   std::vector<float> red_render_queue_buffer_ RTC_GUARDED_BY(mutex_render_);
   std::vector<float> red_capture_queue_buffer_ RTC_GUARDED_BY(mutex_capture_);
 
+  std::unique_ptr<SeekAudioRenderMixer> seek_audio_render_mixer_
+      RTC_GUARDED_BY(mutex_render_);
+  // Set while the SeekAudio AEC needs the far-end reference.
+  std::atomic<bool> seek_audio_render_queue_active_{false};
+
+  // Libraries of the selected SeekAudio modules. They are opened and closed
+  // by the constructor, ApplyConfig() and PostRuntimeSetting(), never on the
+  // capture thread and never while holding the APM locks. A module switched
+  // off at runtime is released by the capture thread, which then clears its
+  // `*_in_use` flag; its library is closed by the next of these calls. Taken
+  // after `mutex_capture_`.
+  Mutex mutex_seek_audio_libraries_;
+  SeekAudioLibraries seek_audio_libraries_
+      RTC_GUARDED_BY(mutex_seek_audio_libraries_);
+  bool seek_audio_aec_library_in_use_
+      RTC_GUARDED_BY(mutex_seek_audio_libraries_) = false;
+  bool seek_audio_afc_library_in_use_
+      RTC_GUARDED_BY(mutex_seek_audio_libraries_) = false;
+
+  // Written under `mutex_capture_`, read lock-free by GetStageTimings().
+  CaptureStageTimer capture_stage_timer_;
+
   RmsLevel capture_input_rms_ RTC_GUARDED_BY(mutex_capture_);
   RmsLevel capture_output_rms_ RTC_GUARDED_BY(mutex_capture_);
   int capture_rms_interval_counter_ RTC_GUARDED_BY(mutex_capture_) = 0;
@@ -532,6 +610,7 @@ class AudioProcessingImpl : public AudioProcessing {
       agc_render_signal_queue_;
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       red_render_signal_queue_;
+  std::unique_ptr<SeekAudioFarEndQueue> seek_audio_far_end_queue_;
 };
 
 }  // namespace webrtc
@@ -579,6 +579,78 @@ TEST(AudioProcessingImplTest, EchoControllerObservesPlayoutVolumeChange) {
   apm->ProcessStream(frame.data(), stream_config, stream_config, frame.data());
 }
 
+TEST(AudioProcessingImplTest, WarmStartStateRestoresAec3) {
+  AudioProcessing::Config apm_config;
+  apm_config.echo_canceller.enabled = true;
+  constexpr int kSampleRateHz = 16000;
+  std::array<int16_t, kSampleRateHz / 100> frame;
+  frame.fill(1000);
+  StreamConfig stream_config(kSampleRateHz, 1);
+
+  scoped_refptr<AudioProcessing> apm =
+      BuiltinAudioProcessingBuilder().Build(CreateEnvironment());
+  apm->ApplyConfig(apm_config);
+  for (int k = 0; k < 10; ++k) {
+    apm->ProcessReverseStream(frame.data(), stream_config, stream_config,
+                              frame.data());
+    apm->ProcessStream(frame.data(), stream_config, stream_config,
+                       frame.data());
+  }
+  const std::vector<uint8_t> state = apm->GetWarmStartState();
+  ASSERT_FALSE(state.empty());
+
+  scoped_refptr<AudioProcessing> restored_apm =
+      BuiltinAudioProcessingBuilder().Build(CreateEnvironment());
+  restored_apm->ApplyConfig(apm_config);
+  restored_apm->ProcessStream(frame.data(), stream_config, stream_config,
+                              frame.data());
+  EXPECT_TRUE(restored_apm->SetWarmStartState(state));
+  const uint8_t malformed_state[] = {1, 2, 3};
+  EXPECT_FALSE(restored_apm->SetWarmStartState(malformed_state));
+}
+
+TEST(AudioProcessingImplTest, NoWarmStartStateForInjectedEchoController) {
+  scoped_refptr<AudioProcessing> apm =
+      BuiltinAudioProcessingBuilder()
+          .SetEchoControlFactory(std::make_unique<MockEchoControlFactory>())
+          .Build(CreateEnvironment());
+  apm->ApplyConfig(AudioProcessing::Config());
+  EXPECT_TRUE(apm->GetWarmStartState().empty());
+}
+
+TEST(AudioProcessingImplTest, MeasuresStageTimingsWhenEnabled) {
+  using Stage = AudioProcessingStageTimings::Stage;
+  AudioProcessing::Config apm_config;
+  apm_config.noise_suppression.enabled = true;
+  apm_config.high_pass_filter.enabled = true;
+  constexpr int kSampleRateHz = 16000;
+  constexpr int kNumFrames = 20;
+  std::array<int16_t, kSampleRateHz / 100> frame;
+  frame.fill(1000);
+  StreamConfig stream_config(kSampleRateHz, 1);
+
+  scoped_refptr<AudioProcessing> apm =
+      BuiltinAudioProcessingBuilder().Build(CreateEnvironment());
+  apm->ApplyConfig(apm_config);
+  apm->ProcessStream(frame.data(), stream_config, stream_config, frame.data());
+  EXPECT_EQ(0, apm->GetStageTimings()[Stage::kTotal].num_frames);
+
+  apm_config.pipeline.measure_stage_timings = true;
+  apm->ApplyConfig(apm_config);
+  for (int k = 0; k < kNumFrames; ++k) {
+    apm->ProcessStream(frame.data(), stream_config, stream_config,
+                       frame.data());
+  }
+  const AudioProcessingStageTimings timings = apm->GetStageTimings();
+  EXPECT_EQ(kNumFrames, timings[Stage::kTotal].num_frames);
+  EXPECT_EQ(kNumFrames, timings[Stage::kHighPassFilter].num_frames);
+  EXPECT_EQ(kNumFrames, timings[Stage::kNoiseSuppressor].num_frames);
+  EXPECT_EQ(0, timings[Stage::kEchoControlMobile].num_frames);
+  EXPECT_GT(timings[Stage::kTotal].max_us, 0.0);
+  EXPECT_LE(timings[Stage::kNoiseSuppressor].max_us,
+            timings[Stage::kTotal].max_us);
+}
+
 TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
   // Make sure that signal changes caused by a render pre-processing sub-module
   // take place before any echo detector analysis.
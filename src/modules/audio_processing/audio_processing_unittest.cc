@@ -2488,6 +2488,50 @@ TEST(RuntimeSettingTest, TestUsageWithSwapQueue) {
   EXPECT_EQ(AudioProcessing::RuntimeSetting::Type::kNotSpecified, s.type());
 }
 
+TEST(RuntimeSettingTest, TestSeekAudioMode) {
+  using SeekAudioMode = AudioProcessing::RuntimeSetting::SeekAudioMode;
+  for (auto mode : {SeekAudioMode::kOff, SeekAudioMode::kAec,
+                    SeekAudioMode::kAfc, SeekAudioMode::kAecThenAfc}) {
+    auto s = AudioProcessing::RuntimeSetting::CreateSeekAudioMode(mode);
+    EXPECT_EQ(AudioProcessing::RuntimeSetting::Type::kSeekAudioMode, s.type());
+    int value;
+    s.GetInt(&value);
+    EXPECT_EQ(static_cast<int>(mode), value);
+  }
+}
+
+// The SeekAudio mode is applied on the next capture frame and is reflected in
+// the config. Processing must continue in every mode, also when the engine
+// libraries are not available.
+TEST(ApmConfiguration, SeekAudioModeRuntimeSetting) {
+  using SeekAudioMode = AudioProcessing::RuntimeSetting::SeekAudioMode;
+  scoped_refptr<AudioProcessing> apm =
+      BuiltinAudioProcessingBuilder().Build(CreateEnvironment());
+
+  Int16FrameData audio;
+  audio.SetProperties(AudioProcessing::GetFrameSize(
+                          AudioProcessing::NativeRate::kSampleRate48kHz),
+                      /* num_channels=*/1);
+  const StreamConfig config(audio.sample_rate_hz, audio.num_channels());
+
+  for (auto mode : {SeekAudioMode::kAecThenAfc, SeekAudioMode::kAfc,
+                    SeekAudioMode::kAec, SeekAudioMode::kOff}) {
+    apm->SetRuntimeSetting(
+        AudioProcessing::RuntimeSetting::CreateSeekAudioMode(mode));
+    EXPECT_EQ(apm->ProcessReverseStream(audio.data.data(), config, config,
+                                        audio.data.data()),
+              AudioProcessing::kNoError);
+    EXPECT_EQ(apm->ProcessStream(audio.data.data(), config, config,
+                                 audio.data.data()),
+              AudioProcessing::kNoError);
+    const int mode_bits = static_cast<int>(mode);
+    EXPECT_EQ(apm->GetConfig().seek_audio_aec.enabled,
+              (mode_bits & static_cast<int>(SeekAudioMode::kAec)) != 0);
+    EXPECT_EQ(apm->GetConfig().seek_audio_afc.enabled,
+              (mode_bits & static_cast<int>(SeekAudioMode::kAfc)) != 0);
+  }
+}
+
 TEST(ApmConfiguration, EnablePostProcessing) {
   // Verify that apm uses a capture post processing module if one is provided.
   auto mock_post_processor_ptr =
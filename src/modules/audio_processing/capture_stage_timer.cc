@@ -0,0 +1,235 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/capture_stage_timer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int64_t kFrameBudgetNs = 10 * kNumNanosecsPerMillisec;
+constexpr double kPercentiles[] = {0.5, 0.9, 0.99, 0.999};
+
+int FloorLog2(uint64_t value) {
+  RTC_DCHECK_GT(value, 0);
+  int log2 = 0;
+  while (value >>= 1) {
+    ++log2;
+  }
+  return log2;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() {
+  Reset();
+}
+
+size_t LatencyHistogram::BucketIndex(int64_t duration_ns) {
+  const uint64_t value =
+      static_cast<uint64_t>(std::max<int64_t>(duration_ns, 0));
+  if (value < kNumSubBuckets) {
+    return value;
+  }
+  const int octave = FloorLog2(value);
+  if (octave > kMaxOctave) {
+    return kNumBuckets - 1;
+  }
+  const int shift = octave - kSubBucketBits;
+  return (octave - kSubBucketBits + 1) * kNumSubBuckets +
+         ((value >> shift) & (kNumSubBuckets - 1));
+}
+
+int64_t LatencyHistogram::BucketUpperEdge(size_t bucket) {
+  RTC_DCHECK_LT(bucket, kNumBuckets);
+  if (bucket < kNumSubBuckets) {
+    return bucket + 1;
+  }
+  const int shift = static_cast<int>(bucket / kNumSubBuckets) - 1;
+  const int64_t sub_bucket = bucket % kNumSubBuckets;
+  return (kNumSubBuckets + sub_bucket + 1) << shift;
+}
+
+void LatencyHistogram::Add(int64_t duration_ns) {
+  std::atomic<uint32_t>& bucket = buckets_[BucketIndex(duration_ns)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+  count_.store(count_.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+  sum_ns_.store(sum_ns_.load(std::memory_order_relaxed) + duration_ns,
+                std::memory_order_relaxed);
+  if (duration_ns > max_ns_.load(std::memory_order_relaxed)) {
+    max_ns_.store(duration_ns, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (std::atomic<uint32_t>& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_ns_.store(0, std::memory_order_relaxed);
+  max_ns_.store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Summarize(
+    AudioProcessingStageTimings::Timing& timing) const {
+  // The writer may add to the histogram while it is read, so the percentiles
+  // are based on the bucket counts alone.
+  std::array<uint32_t, kNumBuckets> buckets;
+  int64_t num_values = 0;
+  for (size_t k = 0; k < kNumBuckets; ++k) {
+    buckets[k] = buckets_[k].load(std::memory_order_relaxed);
+    num_values += buckets[k];
+  }
+  const int64_t count = count_.load(std::memory_order_relaxed);
+  const int64_t max_ns = max_ns_.load(std::memory_order_relaxed);
+  timing.num_frames = count;
+  timing.mean_us =
+      count > 0 ? sum_ns_.load(std::memory_order_relaxed) / (count * 1000.0)
+                : 0.0;
+  timing.max_us = max_ns / 1000.0;
+
+  double* const percentiles_us[] = {&timing.p50_us, &timing.p90_us,
+                                    &timing.p99_us, &timing.p999_us};
+  size_t bucket = 0;
+  int64_t num_below = 0;
+  for (size_t k = 0; k < std::size(kPercentiles); ++k) {
+    if (num_values == 0) {
+      *percentiles_us[k] = 0.0;
+      continue;
+    }
+    const int64_t rank = std::max<int64_t>(
+        1, static_cast<int64_t>(std::ceil(kPercentiles[k] * num_values)));
+    while (num_below + buckets[bucket] < rank) {
+      num_below += buckets[bucket];
+      ++bucket;
+    }
+    *percentiles_us[k] = std::min(BucketUpperEdge(bucket), max_ns) / 1000.0;
+  }
+}
+
+CaptureStageTimer::FrameScope::FrameScope(CaptureStageTimer& timer)
+    : timer_(timer), start_ns_(timer.enabled_ ? TimeNanos() : 0) {
+  if (timer_.enabled_) {
+    timer_.BeginFrame();
+  }
+}
+
+CaptureStageTimer::FrameScope::~FrameScope() {
+  if (timer_.enabled_) {
+    timer_.EndFrame(TimeNanos() - start_ns_);
+  }
+}
+
+CaptureStageTimer::StageScope::StageScope(CaptureStageTimer& timer,
+                                          Stage stage)
+    : timer_(timer),
+      stage_(stage),
+      start_ns_(timer.enabled_ ? TimeNanos() : 0) {}
+
+CaptureStageTimer::StageScope::~StageScope() {
+  if (timer_.enabled_) {
+    int64_t& frame_ns = timer_.frame_ns_[static_cast<size_t>(stage_)];
+    frame_ns = std::max<int64_t>(frame_ns, 0) + TimeNanos() - start_ns_;
+  }
+}
+
+CaptureStageTimer::CaptureStageTimer() {
+  frame_ns_.fill(-1);
+  for (std::atomic<int64_t>& num_frames : num_frames_over_budget_) {
+    num_frames.store(0, std::memory_order_relaxed);
+  }
+}
+
+void CaptureStageTimer::SetEnabled(bool enabled) {
+  if (enabled && !enabled_) {
+    for (size_t k = 0; k < AudioProcessingStageTimings::kNumStages; ++k) {
+      histograms_[k].Reset();
+      num_frames_over_budget_[k].store(0, std::memory_order_relaxed);
+    }
+  }
+  enabled_ = enabled;
+}
+
+AudioProcessingStageTimings CaptureStageTimer::GetTimings() const {
+  AudioProcessingStageTimings timings;
+  for (size_t k = 0; k < AudioProcessingStageTimings::kNumStages; ++k) {
+    histograms_[k].Summarize(timings.stages[k]);
+    timings.stages[k].num_frames_over_budget =
+        num_frames_over_budget_[k].load(std::memory_order_relaxed);
+  }
+  return timings;
+}
+
+const char* CaptureStageTimer::StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kRenderQueues:
+      return "render queues";
+    case Stage::kHighPassFilter:
+      return "high-pass filter";
+    case Stage::kCaptureLevelsAdjuster:
+      return "capture levels adjuster";
+    case Stage::kEchoController:
+      return "echo controller";
+    case Stage::kEchoControlMobile:
+      return "AECM";
+    case Stage::kNoiseSuppressor:
+      return "noise suppressor";
+    case Stage::kSeekAudioAec:
+      return "SeekAudio AEC";
+    case Stage::kSeekAudioAfc:
+      return "SeekAudio AFC";
+    case Stage::kSeekAudioAgcCompensation:
+      return "SeekAudio AGC compensation";
+    case Stage::kGainControl:
+      return "AGC1";
+    case Stage::kGainController2:
+      return "AGC2";
+    case Stage::kEchoDetector:
+      return "echo detector";
+    case Stage::kPostFilter:
+      return "post filter";
+    case Stage::kCapturePostProcessor:
+      return "capture post processor";
+    case Stage::kTotal:
+      return "total";
+  }
+  RTC_DCHECK_NOTREACHED();
+  return "";
+}
+
+void CaptureStageTimer::BeginFrame() {
+  frame_ns_.fill(-1);
+}
+
+void CaptureStageTimer::EndFrame(int64_t frame_duration_ns) {
+  frame_ns_[static_cast<size_t>(Stage::kTotal)] = frame_duration_ns;
+  for (size_t k = 0; k < AudioProcessingStageTimings::kNumStages; ++k) {
+    if (frame_ns_[k] < 0) {
+      continue;
+    }
+    histograms_[k].Add(frame_ns_[k]);
+    if (frame_ns_[k] > kFrameBudgetNs) {
+      std::atomic<int64_t>& num_frames = num_frames_over_budget_[k];
+      num_frames.store(num_frames.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace webrtc
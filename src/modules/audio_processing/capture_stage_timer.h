@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_CAPTURE_STAGE_TIMER_H_
+#define MODULES_AUDIO_PROCESSING_CAPTURE_STAGE_TIMER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "api/audio/audio_processing_statistics.h"
+
+namespace webrtc {
+
+// Histogram of execution times with logarithmically spaced buckets, each
+// octave being split into 16 linear sub-buckets. Covers 1 ns to 134 ms with a
+// relative bucket width of at most 6.25%; longer times land in the last
+// bucket. Written by a single thread and read lock-free by any thread.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kNumSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxOctave = 26;
+  static constexpr size_t kNumBuckets =
+      (kMaxOctave - kSubBucketBits + 2) * kNumSubBuckets;
+
+  LatencyHistogram();
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  // Only to be called by the writing thread.
+  void Add(int64_t duration_ns);
+  void Reset();
+
+  // Fills in all fields of `timing` but the number of frames over budget.
+  void Summarize(AudioProcessingStageTimings::Timing& timing) const;
+
+  static size_t BucketIndex(int64_t duration_ns);
+  // Smallest duration that does not fit into `bucket`.
+  static int64_t BucketUpperEdge(size_t bucket);
+
+ private:
+  std::array<std::atomic<uint32_t>, kNumBuckets> buckets_;
+  std::atomic<int64_t> count_{0};
+  std::atomic<int64_t> sum_ns_{0};
+  std::atomic<int64_t> max_ns_{0};
+};
+
+// Measures the execution time of the capture processing stages of APM per
+// frame. The time of a stage that runs in several places of a frame, like the
+// analysis and the processing of the noise suppressor, is summed up before it
+// is added to the histogram of the stage. Uses the monotonic clock of
+// TimeNanos(). While disabled, a scope costs a single branch.
+class CaptureStageTimer {
+ public:
+  using Stage = AudioProcessingStageTimings::Stage;
+
+  // Times the capture processing of one frame.
+  class FrameScope {
+   public:
+    explicit FrameScope(CaptureStageTimer& timer);
+    ~FrameScope();
+    FrameScope(const FrameScope&) = delete;
+    FrameScope& operator=(const FrameScope&) = delete;
+
+   private:
+    CaptureStageTimer& timer_;
+    const int64_t start_ns_;
+  };
+
+  // Times one stage within a FrameScope.
+  class StageScope {
+   public:
+    StageScope(CaptureStageTimer& timer, Stage stage);
+    ~StageScope();
+    StageScope(const StageScope&) = delete;
+    StageScope& operator=(const StageScope&) = delete;
+
+   private:
+    CaptureStageTimer& timer_;
+    const Stage stage_;
+    const int64_t start_ns_;
+  };
+
+  CaptureStageTimer();
+  CaptureStageTimer(const CaptureStageTimer&) = delete;
+  CaptureStageTimer& operator=(const CaptureStageTimer&) = delete;
+
+  // Starts a new measurement when enabled. Must not be called concurrently
+  // with the capture processing.
+  void SetEnabled(bool enabled);
+  bool enabled() const { return enabled_; }
+
+  // May be called on any thread.
+  AudioProcessingStageTimings GetTimings() const;
+
+  static const char* StageName(Stage stage);
+
+ private:
+  void BeginFrame();
+  void EndFrame(int64_t frame_duration_ns);
+
+  bool enabled_ = false;
+  // Per-stage time of the current frame, negative for stages that did not run.
+  std::array<int64_t, AudioProcessingStageTimings::kNumStages> frame_ns_;
+  std::array<LatencyHistogram, AudioProcessingStageTimings::kNumStages>
+      histograms_;
+  std::array<std::atomic<int64_t>, AudioProcessingStageTimings::kNumStages>
+      num_frames_over_budget_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_CAPTURE_STAGE_TIMER_H_
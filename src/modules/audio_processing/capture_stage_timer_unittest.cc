@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2026 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/capture_stage_timer.h"
+
+#include <algorithm>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Stage = AudioProcessingStageTimings::Stage;
+
+}  // namespace
+
+TEST(LatencyHistogram, BucketsAreContiguous) {
+  EXPECT_EQ(0u, LatencyHistogram::BucketIndex(-5));
+  EXPECT_EQ(0u, LatencyHistogram::BucketIndex(0));
+  int64_t lower_edge = 0;
+  for (size_t bucket = 0; bucket < LatencyHistogram::kNumBuckets; ++bucket) {
+    const int64_t upper_edge = LatencyHistogram::BucketUpperEdge(bucket);
+    ASSERT_LT(lower_edge, upper_edge);
+    EXPECT_EQ(bucket, LatencyHistogram::BucketIndex(lower_edge));
+    EXPECT_EQ(bucket, LatencyHistogram::BucketIndex(upper_edge - 1));
+    // At most 1/16th of the values in the bucket.
+    EXPECT_LE((upper_edge - lower_edge) * 16,
+              std::max<int64_t>(upper_edge, 16));
+    lower_edge = upper_edge;
+  }
+  EXPECT_EQ(int64_t{1} << 27, lower_edge);
+  EXPECT_EQ(LatencyHistogram::kNumBuckets - 1,
+            LatencyHistogram::BucketIndex(int64_t{1} << 40));
+}
+
+TEST(LatencyHistogram, Summarize) {
+  LatencyHistogram histogram;
+  AudioProcessingStageTimings::Timing timing;
+  histogram.Summarize(timing);
+  EXPECT_EQ(0, timing.num_frames);
+  EXPECT_EQ(0.0, timing.p50_us);
+
+  // 1000 values of 1..1000 us.
+  for (int64_t k = 1; k <= 1000; ++k) {
+    histogram.Add(k * 1000);
+  }
+  histogram.Summarize(timing);
+  EXPECT_EQ(1000, timing.num_frames);
+  EXPECT_DOUBLE_EQ(500.5, timing.mean_us);
+  EXPECT_DOUBLE_EQ(1000.0, timing.max_us);
+  EXPECT_GE(timing.p50_us, 500.0);
+  EXPECT_LE(timing.p50_us, 500.0 * 1.0625);
+  EXPECT_GE(timing.p90_us, 900.0);
+  EXPECT_LE(timing.p90_us, 900.0 * 1.0625);
+  EXPECT_GE(timing.p99_us, 990.0);
+  EXPECT_LE(timing.p99_us, 1000.0);
+  EXPECT_DOUBLE_EQ(1000.0, timing.p999_us);
+
+  histogram.Reset();
+  histogram.Summarize(timing);
+  EXPECT_EQ(0, timing.num_frames);
+  EXPECT_EQ(0.0, timing.max_us);
+}
+
+TEST(CaptureStageTimer, MeasuresNothingWhenDisabled) {
+  CaptureStageTimer timer;
+  {
+    CaptureStageTimer::FrameScope frame(timer);
+    CaptureStageTimer::StageScope stage(timer, Stage::kNoiseSuppressor);
+  }
+  const AudioProcessingStageTimings timings = timer.GetTimings();
+  for (const auto& timing : timings.stages) {
+    EXPECT_EQ(0, timing.num_frames);
+  }
+}
+
+TEST(CaptureStageTimer, CountsStagesThatRan) {
+  CaptureStageTimer timer;
+  timer.SetEnabled(true);
+  for (int frame = 0; frame < 10; ++frame) {
+    CaptureStageTimer::FrameScope frame_scope(timer);
+    {
+      CaptureStageTimer::StageScope stage(timer, Stage::kNoiseSuppressor);
+    }
+    // A stage running twice in a frame counts once.
+    {
+      CaptureStageTimer::StageScope stage(timer, Stage::kNoiseSuppressor);
+    }
+    if (frame % 2 == 0) {
+      CaptureStageTimer::StageScope stage(timer, Stage::kSeekAudioAec);
+    }
+  }
+  AudioProcessingStageTimings timings = timer.GetTimings();
+  EXPECT_EQ(10, timings[Stage::kTotal].num_frames);
+  EXPECT_EQ(10, timings[Stage::kNoiseSuppressor].num_frames);
+  EXPECT_EQ(5, timings[Stage::kSeekAudioAec].num_frames);
+  EXPECT_EQ(0, timings[Stage::kEchoController].num_frames);
+  EXPECT_EQ(0, timings[Stage::kTotal].num_frames_over_budget);
+  EXPECT_LE(timings[Stage::kNoiseSuppressor].max_us,
+            timings[Stage::kTotal].max_us);
+
+  // Disabling keeps the measurement, re-enabling starts a new one.
+  timer.SetEnabled(false);
+  {
+    CaptureStageTimer::FrameScope frame_scope(timer);
+  }
+  EXPECT_EQ(10, timer.GetTimings()[Stage::kTotal].num_frames);
+  timer.SetEnabled(true);
+  EXPECT_EQ(0, timer.GetTimings()[Stage::kTotal].num_frames);
+}
+
+TEST(CaptureStageTimer, NamesAllStages) {
+  for (size_t k = 0; k < AudioProcessingStageTimings::kNumStages; ++k) {
+    EXPECT_STRNE("", CaptureStageTimer::StageName(static_cast<Stage>(k)));
+  }
+}
+
+}  // namespace webrtc
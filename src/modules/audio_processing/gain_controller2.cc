@@ -57,6 +57,9 @@ AvailableCpuFeatures GetAllowedCpuFeatures(
   if (field_trials.IsEnabled("WebRTC-Agc2SimdAvx2KillSwitch")) {
     features.avx2 = false;
   }
+  if (field_trials.IsEnabled("WebRTC-Agc2SimdAvx512KillSwitch")) {
+    features.avx512 = false;
+  }
   if (field_trials.IsEnabled("WebRTC-Agc2SimdNeonKillSwitch")) {
     features.neon = false;
   }
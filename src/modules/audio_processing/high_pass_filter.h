@@ -30,6 +30,8 @@ class HighPassFilter {
 
   void Process(AudioBuffer* audio, bool use_split_band_data);
   void Process(std::vector<std::vector<float>>* audio);
+  // Filters the samples of one channel in place.
+  void Process(size_t channel, ArrayView<float> audio);
   void Reset();
   void Reset(size_t num_channels);
 
@@ -174,6 +174,12 @@ class MockAudioProcessing : public AudioProcessing {
   MOCK_METHOD(AudioProcessingStats, GetStatistics, (bool), (override));
 
   MOCK_METHOD(AudioProcessing::Config, GetConfig, (), (const, override));
+  MOCK_METHOD(std::vector<uint8_t>, GetWarmStartState, (), (override));
+  MOCK_METHOD(bool,
+              SetWarmStartState,
+              (ArrayView<const uint8_t> state),
+              (override));
+  MOCK_METHOD(AudioProcessingStageTimings, GetStageTimings, (), (override));
 };
 
 class MockAudioProcessingBuilder : public AudioProcessingBuilderInterface {
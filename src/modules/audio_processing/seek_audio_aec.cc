@@ -1,17 +1,36 @@
 // seek_audio_aec.cc
 #include "modules/audio_processing/seek_audio_aec.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "common_audio/include/audio_util.h"
 
-#include <dlfcn.h>  // dlopen, dlsym, dlclose
+namespace webrtc {
 
-#define SEEKAUDIO_SAT(a, b, c)         (b > a ? a : b < c ? c : b)
+namespace {
 
-namespace webrtc {
+const SeekAudioAecApi kNoAecApi;
+
+}  // namespace
+
+SeekAudioAec::Channel::Channel(SeekAudioAec* parent, void* handle)
+    : parent(parent), handle(handle) {}
+
+SeekAudioAec::SeekAudioAec() : SeekAudioAec(std::string()) {}
 
-SeekAudioAec::SeekAudioAec() {
+SeekAudioAec::SeekAudioAec(const std::string& library_path)
+    : SeekAudioAec(library_path, SeekAudioLibrary::AcquireAec(library_path)) {}
+
+SeekAudioAec::SeekAudioAec(const std::string& library_path,
+                           std::shared_ptr<const SeekAudioLibrary> library)
+    : library_(std::move(library)),
+      api_(&kNoAecApi),
+      converter_(GetAvailableCpuFeatures()),
+      library_path_(library_path) {
   LOGI("SeekAudioAec constructor called");
   
   if (!LoadLibrary()) {
@@ -19,16 +38,17 @@ SeekAudioAec::SeekAudioAec() {
     return;
   }
 
-  if (!aec_create_) {
+  if (!api_->create) {
     LOGE("AEC create function not available");
     return;
   }
 
-  aec_handle_ = aec_create_();
-  if (!aec_handle_) {
+  void* aec_handle = api_->create();
+  if (!aec_handle) {
     LOGE("Failed to create AEC handle");
     return;
   }
+  channels_.push_back(std::make_unique<Channel>(this, aec_handle));
 
   is_initialized_ = false;
   is_log_opened = false;
@@ -38,263 +58,453 @@ SeekAudioAec::SeekAudioAec() {
 
 SeekAudioAec::~SeekAudioAec() {
   LOGI("SeekAudioAec destructor called");
+
+  // Joins the workers before the engines go away.
+  for (auto& channel : channels_) {
+    channel->async.reset();
+  }
   
-  if (aec_handle_ && aec_free_) {
-    aec_free_(aec_handle_);
-    aec_handle_ = nullptr;
+  if (api_->free) {
+    for (auto& channel : channels_) {
+      api_->free(channel->handle);
+    }
   }
+  channels_.clear();
   
   UnloadLibrary();
   LOGI("SeekAudioAec destroyed");
 }
 
 bool SeekAudioAec::LoadLibrary() {
-#ifdef __ANDROID__
-  const char* library_path = "libseekaudio_aec.so";  // Android库路径
-#else
-  const char* library_path = "libseekaudio_aec.so";  // Linux库路径
-#endif
-
-  library_handle_ = dlopen(library_path, RTLD_LAZY);
-  if (!library_handle_) {
-    LOGE("Failed to load library: %s, error: %s", library_path, dlerror());
-    return false;
-  }
-
-  LOGI("Successfully loaded library: %s", library_path);
-
-  // 加载所有需要的函数
-  aec_create_ = reinterpret_cast<AEC_CreateFunc>(GetFunctionPointer("SeekAudioAEC_Create"));
-  aec_free_ = reinterpret_cast<AEC_FreeFunc>(GetFunctionPointer("SeekAudioAEC_Free"));
-  aec_open_log_ = reinterpret_cast<AEC_OpenLogFunc>(GetFunctionPointer("SeekAudioAEC_OpenLog"));
-  aec_init_ = reinterpret_cast<AEC_InitFunc>(GetFunctionPointer("SeekAudioAEC_Init"));
-  aec_process_ = reinterpret_cast<AEC_ProcessFunc>(GetFunctionPointer("SeekAudioAEC_Process"));
-  aec_buffer_farend_ = reinterpret_cast<AEC_BufferFarendFunc>(GetFunctionPointer("SeekAudioAEC_buffer_farend"));
-  aec_agc_compensate_ = reinterpret_cast<AEC_AGC_CompensateFunc>(GetFunctionPointer("SeekAudioAEC_AGC_Compensate"));
-  aec_get_howling_status_ = reinterpret_cast<AEC_GetHowlingStatusFunc>(GetFunctionPointer("SeekAudioAEC_GetHowlingStatus"));
-  aec_set_power_howl_ = reinterpret_cast<AEC_SetPowerFunc>(GetFunctionPointer("SeekAudioAEC_Set_AI_Engine_Power_For_Howl"));
-  aec_set_power_echo_ = reinterpret_cast<AEC_SetPowerFunc>(GetFunctionPointer("SeekAudioAEC_Set_AI_Engine_Power_For_Echo"));
-  // 检查必需函数是否加载成功
-  if (!aec_create_ || !aec_free_ || !aec_init_ || !aec_process_ || !aec_buffer_farend_) {
-    LOGE("Failed to load essential AEC functions");
-    UnloadLibrary();
+  if (!library_) {
     return false;
   }
-
-  LOGI("All AEC functions loaded successfully");
+  api_ = &library_->aec();
+  LOGI("Using AEC library: %s", library_->path().c_str());
   return true;
 }
 
 void SeekAudioAec::UnloadLibrary() {
-  if (library_handle_) {
-    dlclose(library_handle_);
-    library_handle_ = nullptr;
-    
-    // 清空函数指针
-    aec_create_ = nullptr;
-    aec_free_ = nullptr;
-    aec_open_log_ = nullptr;
-    aec_init_ = nullptr;
-	aec_set_power_howl_ = nullptr;
-    aec_process_ = nullptr;
-    aec_buffer_farend_ = nullptr;
-    aec_agc_compensate_ = nullptr;
-    aec_get_howling_status_ = nullptr;
-	aec_set_power_echo_ = nullptr;
-    
-    LOGI("AEC library unloaded");
-  }
-}
-
-void* SeekAudioAec::GetFunctionPointer(const char* function_name) {
-  if (!library_handle_) {
-    LOGE("Library not loaded, cannot get function: %s", function_name);
-    return nullptr;
-  }
-
-  void* func_ptr = dlsym(library_handle_, function_name);
-  if (!func_ptr) {
-    LOGW("Failed to load function: %s, error: %s", function_name, dlerror());
-    return nullptr;
-  }
-
-  LOGI("Successfully loaded function: %s", function_name);
-  return func_ptr;
+  // The library itself is closed once no instance uses it anymore.
+  api_ = &kNoAecApi;
+  library_.reset();
 }
 
 void SeekAudioAec::SetSuppressPowerHowl(int level)
 {
-	LOGI("SeekAudioAec::SetSuppressPowerHowl called: level=%d", level);
-	if (!library_handle_) {
+	SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kPowerChange,
+	                 "SeekAudioAec::SetSuppressPowerHowl called: level=%d", level);
+	if (!library_) {
 		LOGE("Library not loaded, cannot initialize");
 		return ;
 	}
 
-	if (!aec_set_power_howl_) {
-		LOGE("aec_set_power_howl_ function not available");
+	if (!api_->set_power_howl) {
+		LOGE("set_power_howl function not available");
 		return ;
 	}
 
-	aec_set_power_howl_(aec_handle_, level);
+	power_howl_ = level;
+	for (auto& channel : channels_) {
+		if (channel->async) {
+			channel->async->PostControl(kControlPowerHowl, level);
+		} else {
+			api_->set_power_howl(channel->handle, level);
+		}
+	}
 
 }
 
 void SeekAudioAec::SetSuppressPowerEcho(int level)
 {
-	LOGI("SeekAudioAec::SetSuppressPowerEcho called: level=%d", level);
-	if (!library_handle_) {
+	SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kPowerChange,
+	                 "SeekAudioAec::SetSuppressPowerEcho called: level=%d", level);
+	if (!library_) {
 		LOGE("Library not loaded, cannot initialize");
 		return;
 	}
 
-	if (!aec_set_power_echo_) {
-		LOGE("aec_set_power_echo_ function not available");
+	if (!api_->set_power_echo) {
+		LOGE("set_power_echo function not available");
 		return;
 	}
 
-	aec_set_power_echo_(aec_handle_, level);
+	power_echo_ = level;
+	for (auto& channel : channels_) {
+		if (channel->async) {
+			channel->async->PostControl(kControlPowerEcho, level);
+		} else {
+			api_->set_power_echo(channel->handle, level);
+		}
+	}
 
 }
 
-bool SeekAudioAec::Initialize(int sample_rate_hz) {
-  if (is_initialized_)
-        return true;
-  LOGI("SeekAudioAec::Initialize called: sample_rate=%d", sample_rate_hz);
-  
+bool SeekAudioAec::Initialize(int sample_rate_hz, int num_channels) {
   RTC_DCHECK_GT(sample_rate_hz, 0);
-  
-  if (!library_handle_) {
-    LOGE("Library not loaded, cannot initialize");
+  RTC_DCHECK_GT(num_channels, 0);
+
+  if (sample_rate_hz != kSeekAudioSampleRateHz &&
+      sample_rate_hz != kSeekAudioSampleRateHz / 2) {
+    LOGE("SeekAudioAEC only supports 8kHz and 16kHz bands, got %d", sample_rate_hz);
     return false;
   }
+
+  if (!is_initialized_) {
+    LOGI("SeekAudioAec::Initialize called: sample_rate=%d, channels=%d",
+         sample_rate_hz, num_channels);
   
+    if (!library_) {
+      LOGE("Library not loaded, cannot initialize");
+      return false;
+    }
+    if (channels_.empty()) {
+      LOGE("AEC handle not available, cannot initialize");
+      return false;
+    }
+  
+    sample_rate_hz_ = kSeekAudioSampleRateHz;
 
-  if (sample_rate_hz != 16000) {
-    LOGE("SeekAudioAEC only supports 16kHz sample rates, got %d", sample_rate_hz);
-    return false;
+ 
+    if (!api_->init) {
+      LOGE("AEC init function not available");
+      return false;
+    }
+  
+    if (api_->init(channels_[0]->handle, sample_rate_hz_) != 0) {
+      LOGE("Failed to initialize SeekAudioAEC");
+      if (api_->free) {
+        api_->free(channels_[0]->handle);
+      }
+      channels_.clear();
+      return false;
+    }
+  
+    is_initialized_ = true;
+    LOGI("SeekAudioAEC initialized successfully: sample_rate=%d",sample_rate_hz_);
+  }
+
+  // The channel count may change on every reinitialization of APM. The
+  // workers of the old layout are stopped first.
+  const size_t new_num_channels = static_cast<size_t>(num_channels);
+  if (new_num_channels != channels_.size()) {
+    SetAsyncLookahead(0);
+    while (channels_.size() > new_num_channels) {
+      if (api_->free) {
+        api_->free(channels_.back()->handle);
+      }
+      channels_.pop_back();
+    }
+    while (channels_.size() < new_num_channels) {
+      if (!AddChannel()) {
+        return false;
+      }
+    }
+    LOGI("SeekAudioAEC running %d channels", num_channels);
+  }
+
+  // The band layout may change on every reinitialization of APM, while the
+  // engine keeps running at 16 kHz.
+  for (auto& channel : channels_) {
+    channel->band_bridge.Reset();
+    channel->resampler.Reset();
+    std::fill(channel->upper_band_delay.begin(),
+              channel->upper_band_delay.end(),
+              SeekAudioAsyncProcessor::Frame{});
+  }
+  render_resampler_.Reset();
+  if (delay_aligner_) {
+    delay_aligner_->Reset();
   }
   
-  sample_rate_hz_ = sample_rate_hz;
+  return true;
+}
 
- 
-  if (!aec_init_) {
-    LOGE("AEC init function not available");
+bool SeekAudioAec::AddChannel() {
+  if (!api_->create || !api_->init) {
+    LOGE("AEC create or init function not available");
     return false;
   }
-  
-  if (aec_init_(aec_handle_, sample_rate_hz_) != 0) {
-    LOGE("Failed to initialize SeekAudioAEC");
-    if (aec_free_) {
-      aec_free_(aec_handle_);
-      aec_handle_ = nullptr;
+  void* aec_handle = api_->create();
+  if (!aec_handle) {
+    LOGE("Failed to create AEC handle for channel %zu", channels_.size());
+    return false;
+  }
+  if (api_->init(aec_handle, sample_rate_hz_) != 0) {
+    LOGE("Failed to initialize SeekAudioAEC channel %zu", channels_.size());
+    if (api_->free) {
+      api_->free(aec_handle);
     }
     return false;
   }
-  
-  is_initialized_ = true;
-  LOGI("SeekAudioAEC initialized successfully: sample_rate=%d",sample_rate_hz_);
-  
+  if (power_howl_ && api_->set_power_howl) {
+    api_->set_power_howl(aec_handle, *power_howl_);
+  }
+  if (power_echo_ && api_->set_power_echo) {
+    api_->set_power_echo(aec_handle, *power_echo_);
+  }
+  channels_.push_back(std::make_unique<Channel>(this, aec_handle));
   return true;
 }
 
 void SeekAudioAec::ProcessCaptureAudio(float* const* data, int samples_per_channel) {
-  if (!is_initialized_ || !aec_handle_ || !aec_process_) {
-    LOGW("AEC not ready for processing: initialized=%d, handle=%p, process_func=%p",
-         is_initialized_, aec_handle_, aec_process_);
+  if (!is_initialized_ || channels_.empty() || !api_->process) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AEC not ready for processing: initialized=%d, channels=%zu, process=%d",
+                     is_initialized_, channels_.size(), !!api_->process);
     return;
   }
   
-  if (samples_per_channel <= 0) {
-    LOGW("Invalid samples per channel: %d", samples_per_channel);
+  if (samples_per_channel != static_cast<int>(kSeekAudioFrameSize)) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "Invalid samples per channel: %d", samples_per_channel);
     return;
   }
 
-  int i = 0;
-  float* audioframe = data[0];
-  short near_frame[160];
-  short out_frame[160];
+  if (delay_aligner_) {
+    delay_aligner_->AnalyzeCapture(
+        ArrayView<const float, kSeekAudioFrameSize>(data[0], kSeekAudioFrameSize));
+  }
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    SubmitCaptureFrame(*channels_[ch], data[ch]);
+  }
+}
+
+void SeekAudioAec::ProcessCapture(AudioBuffer* audio) {
+  if (!is_initialized_ || channels_.empty() || !api_->process) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AEC not ready for processing: initialized=%d, channels=%zu, process=%d",
+                     is_initialized_, channels_.size(), !!api_->process);
+    return;
+  }
 
-  for (i = 0; i < 160; i++)
-  {
-	  near_frame[i] = SEEKAUDIO_SAT(32767, audioframe[i], -32768);
-	  out_frame[i] = 0;
+  const size_t num_frames = audio->num_frames_per_band();
+  if (num_frames != kSeekAudioFrameSize &&
+      num_frames != kSeekAudioNarrowbandFrameSize) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "Audio frame size mismatch: expected 160, got %zu", num_frames);
+    return;
   }
-  //LOGI("Processing capture audio: %d samples", samples_per_channel);
-  
-  int ret = aec_process_(aec_handle_, near_frame, out_frame, samples_per_channel);
+
+  RTC_DCHECK_EQ(audio->num_channels(), channels_.size());
+  const size_t num_channels = std::min(audio->num_channels(), channels_.size());
+  const size_t num_bands = audio->num_bands();
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    Channel& channel = *channels_[ch];
+    float* const* bands = audio->split_bands(ch);
+    if (num_frames == kSeekAudioNarrowbandFrameSize) {
+      ArrayView<float> narrowband(bands[0], num_frames);
+      channel.resampler.Upsample(narrowband, channel.frame);
+      if (delay_aligner_ && ch == 0) {
+        delay_aligner_->AnalyzeCapture(channel.frame);
+      }
+      SubmitCaptureFrame(channel, channel.frame.data());
+      channel.resampler.Downsample(channel.frame, narrowband);
+      continue;
+    }
+    if (delay_aligner_ && ch == 0) {
+      delay_aligner_->AnalyzeCapture(
+          ArrayView<const float, kSeekAudioFrameSize>(bands[0], num_frames));
+    }
+    if (channel.async) {
+      ProcessBandsAsync(channel, bands, num_bands);
+      continue;
+    }
+    if (num_bands > 1) {
+      std::copy(bands[0], bands[0] + num_frames, channel.lowband_in.begin());
+    }
+    ProcessFrame(channel.handle, bands[0]);
+    if (num_bands > 1) {
+      channel.band_bridge.Update(channel.lowband_in,
+                                 ArrayView<const float>(bands[0], num_frames));
+      channel.band_bridge.ApplyToUpperBands(bands, num_bands, num_frames);
+    }
+  }
+}
+
+void SeekAudioAec::ProcessFrame(void* handle, float* frame) {
+  const int64_t start_us = TimeMicros();
+  int ret = 0;
+  if (api_->process_float) {
+    ret = api_->process_float(handle, frame, frame, kSeekAudioFrameSize);
+  } else {
+    int16_t near_frame[kSeekAudioFrameSize];
+    int16_t out_frame[kSeekAudioFrameSize];
+    ArrayView<float> frame_view(frame, kSeekAudioFrameSize);
+    converter_.FloatS16ToS16(frame_view, near_frame);
+    ret = api_->process(handle, near_frame, out_frame, kSeekAudioFrameSize);
+    converter_.S16ToFloatS16(out_frame, frame_view);
+  }
+  engine_time_us_.fetch_add(TimeMicros() - start_us, std::memory_order_relaxed);
   if (ret != 0) {
-    LOGW("AEC process returned error: %d", ret);
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kEngineError,
+                     "AEC process returned error: %d", ret);
   }
-  
-  for (i = 0; i < 160; i++)
-  {
-	  audioframe[i] = (float)out_frame[i];
+}
+
+void SeekAudioAec::ConfigurePower(
+    int howl_level,
+    int echo_level,
+    const SeekAudioPowerGovernor::Config& governor) {
+  if (!governor.enabled) {
+    power_governor_.reset();
+    SetSuppressPowerHowl(howl_level);
+    SetSuppressPowerEcho(echo_level);
+    return;
   }
+  power_governor_ = std::make_unique<SeekAudioPowerGovernor>(
+      governor, SeekAudioPowerGovernor::Levels{howl_level, echo_level});
+  engine_time_us_.store(0, std::memory_order_relaxed);
+  SetSuppressPowerHowl(power_governor_->levels().howl);
+  SetSuppressPowerEcho(power_governor_->levels().echo);
+}
 
-  //LOGI("Capture audio processing completed");
+void SeekAudioAec::UpdatePowerGovernor(
+    std::optional<float> residual_echo_likelihood) {
+  if (!power_governor_) {
+    return;
+  }
+  const SeekAudioPowerGovernor::Levels previous = power_governor_->levels();
+  if (!power_governor_->Update(
+          GetHowlingProbability(), residual_echo_likelihood,
+          engine_time_us_.exchange(0, std::memory_order_relaxed),
+          TimeMicros())) {
+    return;
+  }
+  const SeekAudioPowerGovernor::Levels& levels = power_governor_->levels();
+  if (levels.howl != previous.howl) {
+    SetSuppressPowerHowl(levels.howl);
+  }
+  if (levels.echo != previous.echo) {
+    SetSuppressPowerEcho(levels.echo);
+  }
 }
 
 void SeekAudioAec::BufferFarend(float* const* farend, int samples_per_channel) {
-  if (!is_initialized_ || !aec_handle_ || !aec_buffer_farend_) {
-    LOGW("AEC not ready for buffering farend: initialized=%d, handle=%p, buffer_func=%p",
-         is_initialized_, aec_handle_, aec_buffer_farend_);
+  if (!is_initialized_ || channels_.empty() || !api_->buffer_farend) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AEC not ready for buffering farend: initialized=%d, channels=%zu, buffer=%d",
+                     is_initialized_, channels_.size(), !!api_->buffer_farend);
     return;
   }
   
-  if (samples_per_channel <= 0) {
-    LOGW("Invalid samples per channel: %d", samples_per_channel);
+  if (samples_per_channel != static_cast<int>(kSeekAudioFrameSize)) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "Invalid samples per channel: %d", samples_per_channel);
     return;
   }
-  
-  //LOGI("Buffering farend audio: %d samples", samples_per_channel);
-  int i = 0;
-  float* dataTemp = farend[0];
-  short far_frame[160];
-  for (i = 0; i < 160; i++)
-  {
-	  far_frame[i] = SEEKAUDIO_SAT(32767, dataTemp[i], -32768);
+
+  const float* frame = farend[0];
+  if (delay_aligner_) {
+    std::copy(frame, frame + kSeekAudioFrameSize, render_frame_.begin());
+    delay_aligner_->ProcessRender(render_frame_);
+    frame = render_frame_.data();
   }
+  SubmitFarendFrame(frame);
+}
 
-  int ret = aec_buffer_farend_(aec_handle_, far_frame, samples_per_channel);
+void SeekAudioAec::AnalyzeRender(ArrayView<const float> lowband) {
+  if (!is_initialized_ || channels_.empty() || !api_->buffer_farend) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AEC not ready for buffering farend: initialized=%d, channels=%zu, buffer=%d",
+                     is_initialized_, channels_.size(), !!api_->buffer_farend);
+    return;
+  }
+
+  const float* frame = lowband.data();
+  if (lowband.size() == kSeekAudioNarrowbandFrameSize) {
+    // Same filter as on the capture side, so that both signals see the same
+    // resampling delay.
+    render_resampler_.Upsample(lowband, render_frame_);
+    frame = render_frame_.data();
+  } else if (lowband.size() != kSeekAudioFrameSize) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "Render frame size mismatch: expected 160, got %zu", lowband.size());
+    return;
+  }
+
+  if (delay_aligner_) {
+    if (frame != render_frame_.data()) {
+      std::copy(lowband.begin(), lowband.end(), render_frame_.begin());
+      frame = render_frame_.data();
+    }
+    delay_aligner_->ProcessRender(render_frame_);
+  }
+  SubmitFarendFrame(frame);
+}
+
+void SeekAudioAec::SetFarEndAlignment(bool enabled) {
+  if (!enabled) {
+    delay_aligner_.reset();
+  } else if (!delay_aligner_) {
+    delay_aligner_ = std::make_unique<SeekAudioDelayAligner>();
+  }
+}
+
+std::optional<int> SeekAudioAec::far_end_delay_ms() const {
+  if (!delay_aligner_) {
+    return std::nullopt;
+  }
+  return delay_aligner_->delay_samples() / (kSeekAudioSampleRateHz / 1000);
+}
+
+void SeekAudioAec::BufferFarendFrame(void* handle, const float* frame) {
+  int ret = 0;
+  if (api_->buffer_farend_float) {
+    ret = api_->buffer_farend_float(handle, frame, kSeekAudioFrameSize);
+  } else {
+    int16_t far_frame[kSeekAudioFrameSize];
+    converter_.FloatS16ToS16(ArrayView<const float>(frame, kSeekAudioFrameSize),
+                             far_frame);
+    ret = api_->buffer_farend(handle, far_frame, kSeekAudioFrameSize);
+  }
   if (ret != 0) {
-    LOGW("AEC buffer farend returned error: %d", ret);
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kEngineError,
+                     "AEC buffer farend returned error: %d", ret);
   }
 }
 
 void SeekAudioAec::ProcessAGCCompensate(float* const* agcIn, float* const* agcOut, float* const* data, int samples_per_channel){
-  if (!is_initialized_ || !aec_handle_ || !aec_agc_compensate_) {
-    LOGW("AEC not ready for AGC compensation: initialized=%d, handle=%p, agc_func=%p",
-         is_initialized_, aec_handle_, aec_agc_compensate_);
+  // The compensation needs the engine state of the current frame, which the
+  // workers only reach `async_lookahead_frames()` frames later.
+  if (async()) {
     return;
   }
-  
-  if (samples_per_channel <= 0) {
-    LOGW("Invalid samples per channel: %d", samples_per_channel);
+
+  if (!is_initialized_ || channels_.empty() ||
+      (!api_->agc_compensate && !api_->agc_compensate_float)) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AEC not ready for AGC compensation: initialized=%d, channels=%zu, agc=%d",
+                     is_initialized_, channels_.size(), !!api_->agc_compensate);
     return;
   }
   
-  int i = 0;
-  float* dataTemp = data[0];
-  float* agcInTemp = agcIn[0];
-  float* agcOutTemp = agcOut[0];
-  short agc_in[160];
-  short agc_out[160];
-  short in_frame[160];
-  short out_frame[160];
-  for (i = 0; i < 160; i++)
-  {
-	  agc_in[i] = SEEKAUDIO_SAT(32767, agcInTemp[i], -32768);
-	  agc_out[i] = SEEKAUDIO_SAT(32767, agcOutTemp[i], -32768);
-	  in_frame[i] = SEEKAUDIO_SAT(32767, dataTemp[i], -32768);
+  if (samples_per_channel < static_cast<int>(kSeekAudioFrameSize)) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "Invalid samples per channel: %d", samples_per_channel);
+    return;
   }
+
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    void* aec_handle = channels_[ch]->handle;
+    if (api_->agc_compensate_float) {
+      api_->agc_compensate_float(aec_handle, agcIn[ch], agcOut[ch], data[ch], data[ch]);
+      continue;
+    }
+
+    int16_t agc_in[kSeekAudioFrameSize];
+    int16_t agc_out[kSeekAudioFrameSize];
+    int16_t in_frame[kSeekAudioFrameSize];
+    int16_t out_frame[kSeekAudioFrameSize];
+    ArrayView<float> frame(data[ch], kSeekAudioFrameSize);
+    converter_.FloatS16ToS16(ArrayView<const float>(agcIn[ch], kSeekAudioFrameSize), agc_in);
+    converter_.FloatS16ToS16(ArrayView<const float>(agcOut[ch], kSeekAudioFrameSize), agc_out);
+    converter_.FloatS16ToS16(frame, in_frame);
   
-  aec_agc_compensate_(aec_handle_, agc_in, agc_out, in_frame, out_frame);
+    api_->agc_compensate(aec_handle, agc_in, agc_out, in_frame, out_frame);
 
-  for (i = 0; i < 160; i++)
-  {
-	  dataTemp[i] = (float)out_frame[i];
+    converter_.S16ToFloatS16(out_frame, frame);
   }
-
 }
 
 int SeekAudioAec::ProcessOpenLog(const char* folder_path) {
@@ -303,12 +513,18 @@ int SeekAudioAec::ProcessOpenLog(const char* folder_path) {
   if (is_log_opened)
       return ret;
 
-  if (!aec_handle_ || !aec_open_log_) {
+  // The engine belongs to the worker thread.
+  if (async()) {
+    LOGW("AEC ProcessOpenLog not supported in worker thread mode");
+    return -1;
+  }
+
+  if (channels_.empty() || !api_->open_log) {
     LOGE("AEC ProcessOpenLog function failed");
     return -1;
   }
 
-  ret = aec_open_log_(aec_handle_, folder_path);
+  ret = api_->open_log(channels_[0]->handle, folder_path);
 
   if (ret != 0) {
     LOGE("AEC ProcessOpenLog function failed, ret: %d", ret);
@@ -319,15 +535,204 @@ int SeekAudioAec::ProcessOpenLog(const char* folder_path) {
 }
 
 float SeekAudioAec::GetHowlingProbability() const {
-  if (!is_initialized_ || !aec_handle_ || !aec_get_howling_status_) {
-    LOGW("Cannot get howling probability: initialized=%d, handle=%p, func=%p",
-         is_initialized_, aec_handle_, aec_get_howling_status_);
+  float probability = 0.0f;
+  if (async()) {
+    for (const auto& channel : channels_) {
+      probability = std::max(probability,
+                             channel->async_howling_probability.load(
+                                 std::memory_order_relaxed));
+    }
+    return probability;
+  }
+
+  if (!is_initialized_ || channels_.empty() || !api_->get_howling_status) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "Cannot get howling probability: initialized=%d, channels=%zu, func=%d",
+                     is_initialized_, channels_.size(), !!api_->get_howling_status);
     return 0.0f;
   }
   
-  float probability = aec_get_howling_status_(aec_handle_);
+  for (const auto& channel : channels_) {
+    probability =
+        std::max(probability, api_->get_howling_status(channel->handle));
+  }
   //LOGI("Howling probability: %.3f", probability);
   return probability;
 }
 
+void SeekAudioAec::SetAsyncLookahead(
+    int lookahead_frames,
+    std::shared_ptr<SeekAudioScheduler> scheduler) {
+  lookahead_frames = std::clamp(lookahead_frames, 0,
+                                SeekAudioAsyncProcessor::kMaxLookaheadFrames);
+  if (lookahead_frames == 0) {
+    scheduler.reset();
+  }
+  if (lookahead_frames == async_lookahead_frames() &&
+      (!async() || channels_[0]->async->scheduler() == scheduler.get())) {
+    return;
+  }
+  if (lookahead_frames > 0 && (!is_initialized_ || channels_.empty())) {
+    LOGW("AEC not ready for worker thread mode");
+    return;
+  }
+
+  // Stopping a worker flushes its pending requests, after which the engine
+  // is used from the calling thread again.
+  for (auto& channel : channels_) {
+    channel->async.reset();
+    channel->upper_band_delay.clear();
+    channel->upper_band_delay_index = 0;
+  }
+  if (lookahead_frames == 0) {
+    LOGI("SeekAudioAec worker thread stopped");
+    return;
+  }
+
+  for (auto& channel : channels_) {
+    channel->upper_band_delay.resize(
+        (SeekAudioBandBridge::kMaxNumBands - 1) * (lookahead_frames + 1),
+        SeekAudioAsyncProcessor::Frame{});
+    channel->async_howling_probability.store(
+        api_->get_howling_status ? api_->get_howling_status(channel->handle)
+                                 : 0.0f,
+        std::memory_order_relaxed);
+    channel->async = std::make_unique<SeekAudioAsyncProcessor>(
+        channel.get(), lookahead_frames, scheduler);
+  }
+  LOGI("SeekAudioAec worker thread started: lookahead=%d, channels=%zu, shared=%d",
+       lookahead_frames, channels_.size(), scheduler != nullptr);
+}
+
+int SeekAudioAec::async_lookahead_frames() const {
+  return async() ? channels_[0]->async->lookahead_frames() : 0;
+}
+
+int SeekAudioAec::num_late_frames() const {
+  int num_late_frames = 0;
+  for (const auto& channel : channels_) {
+    if (channel->async) {
+      num_late_frames += channel->async->num_late_frames();
+    }
+  }
+  return num_late_frames;
+}
+
+int64_t SeekAudioAec::deadline_slack_us() const {
+  if (!async()) {
+    return 0;
+  }
+  int64_t slack_us = channels_[0]->async->deadline_slack_us();
+  for (const auto& channel : channels_) {
+    slack_us = std::min(slack_us, channel->async->deadline_slack_us());
+  }
+  return slack_us;
+}
+
+void SeekAudioAec::SubmitCaptureFrame(Channel& channel, float* frame) {
+  if (channel.async) {
+    channel.async->ProcessCapture(
+        ArrayView<float, kSeekAudioFrameSize>(frame, kSeekAudioFrameSize));
+  } else {
+    ProcessFrame(channel.handle, frame);
+  }
+}
+
+void SeekAudioAec::SubmitFarendFrame(const float* frame) {
+  for (auto& channel : channels_) {
+    if (channel->async) {
+      channel->async->AnalyzeRender(ArrayView<const float, kSeekAudioFrameSize>(
+          frame, kSeekAudioFrameSize));
+    } else {
+      BufferFarendFrame(channel->handle, frame);
+    }
+  }
+}
+
+void SeekAudioAec::ProcessBandsAsync(Channel& channel,
+                                     float* const* bands,
+                                     size_t num_bands) {
+  RTC_DCHECK(channel.async);
+  RTC_DCHECK_LE(num_bands, SeekAudioBandBridge::kMaxNumBands);
+  ArrayView<float, kSeekAudioFrameSize> lowband(bands[0], kSeekAudioFrameSize);
+  channel.async->ProcessCapture(lowband);
+  if (num_bands == 1) {
+    return;
+  }
+
+  // The upper bands are delayed to line up with the returned lowband, whose
+  // gain is then measured against the matching delayed input.
+  const size_t num_slots = channel.async->lookahead_frames() + 1;
+  const size_t read_index = (channel.upper_band_delay_index + 1) % num_slots;
+  for (size_t band = 1; band < num_bands; ++band) {
+    SeekAudioAsyncProcessor::Frame* slots =
+        &channel.upper_band_delay[(band - 1) * num_slots];
+    std::copy(bands[band], bands[band] + kSeekAudioFrameSize,
+              slots[channel.upper_band_delay_index].begin());
+    std::copy(slots[read_index].begin(), slots[read_index].end(), bands[band]);
+  }
+  channel.upper_band_delay_index = read_index;
+
+  channel.band_bridge.Update(channel.async->delayed_input(), lowband);
+  channel.band_bridge.ApplyToUpperBands(bands, num_bands, kSeekAudioFrameSize);
+}
+
+void SeekAudioAec::Channel::ProcessCaptureFrame(
+    ArrayView<float, kSeekAudioFrameSize> frame) {
+  parent->ProcessFrame(handle, frame.data());
+  if (parent->api_->get_howling_status) {
+    async_howling_probability.store(parent->api_->get_howling_status(handle),
+                                    std::memory_order_relaxed);
+  }
+}
+
+void SeekAudioAec::Channel::AnalyzeRenderFrame(
+    ArrayView<const float, kSeekAudioFrameSize> frame) {
+  parent->BufferFarendFrame(handle, frame.data());
+}
+
+void SeekAudioAec::Channel::ApplyControl(int id, int value) {
+  switch (id) {
+    case kControlPowerHowl:
+      parent->api_->set_power_howl(handle, value);
+      break;
+    case kControlPowerEcho:
+      parent->api_->set_power_echo(handle, value);
+      break;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+}
+
+std::vector<uint8_t> SeekAudioAec::GetEngineState(int channel) const {
+  if (!is_initialized_ || channel < 0 || channel >= num_channels() ||
+      !api_->get_state || async()) {
+    return {};
+  }
+  void* handle = channels_[channel]->handle;
+  const int size = api_->get_state(handle, nullptr, 0);
+  if (size <= 0) {
+    return {};
+  }
+  std::vector<uint8_t> state(size);
+  if (api_->get_state(handle, state.data(), size) != size) {
+    LOGW("Failed to get the engine state of channel %d", channel);
+    return {};
+  }
+  return state;
+}
+
+bool SeekAudioAec::SetEngineState(int channel, ArrayView<const uint8_t> state) {
+  if (!is_initialized_ || channel < 0 || channel >= num_channels() ||
+      !api_->set_state || async()) {
+    return false;
+  }
+  if (api_->set_state(channels_[channel]->handle, state.data(),
+                      static_cast<int>(state.size())) != 0) {
+    LOGW("Engine state of channel %d rejected", channel);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace webrtc
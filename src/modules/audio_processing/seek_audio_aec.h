@@ -2,11 +2,24 @@
 #ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AEC_H_
 #define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AEC_H_
 
+#include <array>
+#include <atomic>
+#include <optional>
 #include <memory>
 #include <vector>
 #include <string>
 
 #include "api/audio/audio_processing.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/seek_audio_async_processor.h"
+#include "modules/audio_processing/seek_audio_band_bridge.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/seek_audio_delay_aligner.h"
+#include "modules/audio_processing/seek_audio_event_log.h"
+#include "modules/audio_processing/seek_audio_library.h"
+#include "modules/audio_processing/seek_audio_power_governor.h"
+#include "modules/audio_processing/seek_audio_resampler.h"
+#include "modules/audio_processing/seek_audio_sample_converter.h"
 
 // Android日志支持
 #ifdef __ANDROID__
@@ -26,69 +39,184 @@ namespace webrtc {
 
 class SeekAudioAec {
  public:
-  explicit SeekAudioAec();
+  SeekAudioAec();
+  // Uses the engine library at `library_path`, or the default library if
+  // empty.
+  explicit SeekAudioAec(const std::string& library_path);
+  // Uses `library`, acquired for `library_path` beforehand, and never opens
+  // a library itself. A null `library` gives an inert instance.
+  SeekAudioAec(const std::string& library_path,
+               std::shared_ptr<const SeekAudioLibrary> library);
   ~SeekAudioAec();
 
-  // 初始化AEC
-  bool Initialize(int sample_rate_hz);
+  // Path of the requested engine library, empty for the default one.
+  const std::string& library_path() const { return library_path_; }
+
+  // 初始化AEC. `sample_rate_hz` is the rate of the lowest split band, 8000 or
+  // 16000. The engine itself always runs at 16 kHz. Every capture channel gets
+  // an engine handle of its own, all fed with the same far-end reference.
+  // Handles are only created or released here. A change of the number of
+  // channels stops the worker thread mode, see SetAsyncLookahead().
+  bool Initialize(int sample_rate_hz, int num_channels = 1);
+  int num_channels() const { return static_cast<int>(channels_.size()); }
 
   void SetSuppressPowerHowl(int level);
   void SetSuppressPowerEcho(int level);
+
+  // Sets the engine powers to `howl_level` and `echo_level`, or lets a
+  // governor vary them between the idle level and those levels when
+  // `governor.enabled`.
+  void ConfigurePower(int howl_level,
+                      int echo_level,
+                      const SeekAudioPowerGovernor::Config& governor);
+  // Feeds the governor, if any, with the outcome of the last processed frame
+  // and the current residual echo likelihood, when an echo detector runs.
+  void UpdatePowerGovernor(std::optional<float> residual_echo_likelihood);
+
+  // Moves the engine calls to worker streams, one per capture channel, when
+  // `lookahead_frames` > 0. The capture signal is then delayed by that many
+  // 10 ms frames, clamped to SeekAudioAsyncProcessor::kMaxLookaheadFrames. 0
+  // runs the engines inline. With a `scheduler` the workers are taken from its
+  // pool instead of threads of their own. Must be called after Initialize().
+  void SetAsyncLookahead(
+      int lookahead_frames,
+      std::shared_ptr<SeekAudioScheduler> scheduler = nullptr);
+  int async_lookahead_frames() const;
+  // Number of frames passed through unprocessed because a worker was late,
+  // summed over the channels.
+  int num_late_frames() const;
+  // See SeekAudioAsyncProcessor::deadline_slack_us(). The smallest slack of
+  // the channels.
+  int64_t deadline_slack_us() const;
+
+  // Pre-delays the far-end reference by the echo path delay estimated from
+  // the far-end and the first capture channel when `enabled`, see
+  // SeekAudioDelayAligner. Off by default.
+  void SetFarEndAlignment(bool enabled);
+  // Delay applied to the far-end reference, unset without alignment.
+  std::optional<int> far_end_delay_ms() const;
   
-  // 处理近端音频（包含回音消除）
+  // 处理近端音频（包含回音消除）, `num_channels()` channels.
   void ProcessCaptureAudio(float* const* data, int samples_per_channel);
   
-  // 缓冲远端音频（用于回音消除参考）
+  // 缓冲远端音频（用于回音消除参考）, mono in `farend[0]`.
   void BufferFarend(float* const* farend, int samples_per_channel);
+
+  // Processes the lowest split band of every channel of `audio` and
+  // propagates the resulting suppression to the upper bands. 8 kHz audio is
+  // upsampled for the engine and downsampled back.
+  void ProcessCapture(AudioBuffer* audio);
+
+  // Buffers `lowband`, the lowest split band of the render signal mixed to
+  // mono (see SeekAudioRenderMixer), as far-end reference of all channels.
+  // 8 kHz audio is upsampled the same way as on the capture side.
+  void AnalyzeRender(ArrayView<const float> lowband);
   
   // AGC补偿处理
   void ProcessAGCCompensate(float* const* agcIn, float* const* agcOut,float* const* data, int samples_per_channel);
   
-  // 打开日志
+  // 打开日志, for the first channel only.
   int ProcessOpenLog(const char* folder_path);
   
-  // 获取啸叫状态概率
+  // 获取啸叫状态概率, the highest one of the channels.
   float GetHowlingProbability() const;
 
+  // Adaptive state of the engine of `channel` for a warm start, see
+  // SetEngineState(). Empty if the engine does not export the state entry
+  // points or runs on a worker, see SetAsyncLookahead().
+  std::vector<uint8_t> GetEngineState(int channel) const;
+  // Restores a state returned by GetEngineState() of an engine of the same
+  // library. Returns false if unsupported or rejected by the engine.
+  bool SetEngineState(int channel, ArrayView<const uint8_t> state);
+
+  // Per-frame events of this module, which are counted instead of logged on
+  // every occurrence. Also updated by const methods and by APM.
+  SeekAudioEventCounters& events() const { return events_; }
+
  private:
-  // 动态加载的函数指针类型定义
-  typedef void* (*AEC_CreateFunc)();
-  typedef void (*AEC_FreeFunc)(void*);
-  typedef int (*AEC_OpenLogFunc)(void*, const char*);
-  typedef int (*AEC_InitFunc)(void*, int);
-  typedef void(*AEC_SetPowerFunc)(void*, int); 
-  typedef int (*AEC_ProcessFunc)(void*, const short*, short*, int);
-  typedef int (*AEC_BufferFarendFunc)(void*, const short*, int);
-  typedef void (*AEC_AGC_CompensateFunc)(void*, const short*, const short*, const short*, short*);
-  typedef float (*AEC_GetHowlingStatusFunc)(void*);
-
-  // 函数指针声明
-  AEC_CreateFunc aec_create_ = nullptr;
-  AEC_FreeFunc aec_free_ = nullptr;
-  AEC_OpenLogFunc aec_open_log_ = nullptr;
-  AEC_InitFunc aec_init_ = nullptr;
-  AEC_SetPowerFunc aec_set_power_howl_= nullptr;
-  AEC_SetPowerFunc aec_set_power_echo_ = nullptr;
-  AEC_ProcessFunc aec_process_ = nullptr;
-  AEC_BufferFarendFunc aec_buffer_farend_ = nullptr;
-  AEC_AGC_CompensateFunc aec_agc_compensate_ = nullptr;
-  AEC_GetHowlingStatusFunc aec_get_howling_status_ = nullptr;
-
-
-  void* library_handle_ = nullptr;
-  
+  enum ControlId { kControlPowerHowl, kControlPowerEcho };
+
+  // Engine handle and band processing of one capture channel. Also runs the
+  // engine calls of the channel on the worker in worker thread mode.
+  class Channel : public SeekAudioAsyncProcessor::Handler {
+   public:
+    Channel(SeekAudioAec* parent, void* handle);
+
+    // SeekAudioAsyncProcessor::Handler implementation, run on the worker.
+    void ProcessCaptureFrame(
+        ArrayView<float, kSeekAudioFrameSize> frame) override;
+    void AnalyzeRenderFrame(
+        ArrayView<const float, kSeekAudioFrameSize> frame) override;
+    void ApplyControl(int id, int value) override;
+
+    SeekAudioAec* const parent;
+    void* const handle;
+
+    // 16 kHz lowband processing and band propagation.
+    SeekAudioBandBridge band_bridge;
+    SeekAudioResampler resampler;
+    std::array<float, kSeekAudioFrameSize> lowband_in;
+    std::array<float, kSeekAudioFrameSize> frame;
+
+    // Worker thread mode. The upper bands are delayed as much as the lowband,
+    // one ring of lookahead + 1 frames per upper band.
+    std::unique_ptr<SeekAudioAsyncProcessor> async;
+    std::vector<SeekAudioAsyncProcessor::Frame> upper_band_delay;
+    size_t upper_band_delay_index = 0;
+    // Written by the worker after every processed frame.
+    std::atomic<float> async_howling_probability{0.0f};
+  };
+
+  // Shared engine library and its entry points. `api_` points to an empty
+  // table while no library is loaded.
+  std::shared_ptr<const SeekAudioLibrary> library_;
+  const SeekAudioAecApi* api_;
+
+  // int16 fallback used when the float entry points are not exported.
+  const SeekAudioSampleConverter converter_;
+
   bool is_initialized_ = false;
   bool is_log_opened = false;
   int sample_rate_hz_ = 0;
-  
-  void* aec_handle_ = nullptr; 
-  
+
+  // One per capture channel. The first handle is created with the instance,
+  // so that the log can be opened before initialization.
+  std::vector<std::unique_ptr<Channel>> channels_;
+  // Last levels set, applied to handles created later on.
+  std::optional<int> power_howl_;
+  std::optional<int> power_echo_;
+
+  // The far-end reference is shared by all channels.
+  SeekAudioResampler render_resampler_;
+  std::array<float, kSeekAudioFrameSize> render_frame_;
+  // Fed from the capture thread like the engines, see AnalyzeRender().
+  std::unique_ptr<SeekAudioDelayAligner> delay_aligner_;
+
+  const std::string library_path_;
+
+  mutable SeekAudioEventCounters events_;
+
+  std::unique_ptr<SeekAudioPowerGovernor> power_governor_;
+  // Engine time since the last governor update, also written by the workers.
+  std::atomic<int64_t> engine_time_us_{0};
 
   bool LoadLibrary();
   void UnloadLibrary();
-  void* GetFunctionPointer(const char* function_name);
+  // Creates and initializes the handle of a new channel.
+  bool AddChannel();
+  bool async() const { return !channels_.empty() && channels_[0]->async; }
+
+  // Runs the engine `handle` in-place on one 160 sample frame.
+  void ProcessFrame(void* handle, float* frame);
+  void BufferFarendFrame(void* handle, const float* frame);
+  // Run the frame inline or queue it to the worker.
+  void SubmitCaptureFrame(Channel& channel, float* frame);
+  void SubmitFarendFrame(const float* frame);
+  void ProcessBandsAsync(Channel& channel,
+                         float* const* bands,
+                         size_t num_bands);
 };
 
 }  // namespace webrtc
 
-#endif  
\ No newline at end of file
+#endif
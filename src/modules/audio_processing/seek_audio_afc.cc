@@ -1,17 +1,33 @@
 // seek_audio_afc.cc
 #include "modules/audio_processing/seek_audio_afc.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "common_audio/include/audio_util.h"
 
-#include <dlfcn.h>  // dlopen, dlsym, dlclose
-#define SEEKAUDIO_SAT(a, b, c)         (b > a ? a : b < c ? c : b)
-
 namespace webrtc {
 
-SeekAudioAfc::SeekAudioAfc()
-{
+namespace {
+
+const SeekAudioAfcApi kNoAfcApi;
+
+}  // namespace
+
+SeekAudioAfc::SeekAudioAfc() : SeekAudioAfc(std::string()) {}
+
+SeekAudioAfc::SeekAudioAfc(const std::string& library_path)
+    : SeekAudioAfc(library_path, SeekAudioLibrary::AcquireAfc(library_path)) {}
+
+SeekAudioAfc::SeekAudioAfc(const std::string& library_path,
+                           std::shared_ptr<const SeekAudioLibrary> library)
+    : library_(std::move(library)),
+      api_(&kNoAfcApi),
+      converter_(GetAvailableCpuFeatures()),
+      library_path_(library_path) {
   LOGI("SeekAudioAfc constructor called");
   
   // 尝试加载库
@@ -21,16 +37,17 @@ SeekAudioAfc::SeekAudioAfc()
   }
 
   // 创建AFC句柄
-  if (!afc_create_) {
+  if (!api_->create) {
       LOGE("AFC create function not available");
       return;
   }
 
-  afc_handle_ = afc_create_();
-  if (!afc_handle_) {
+  void* afc_handle = api_->create();
+  if (!afc_handle) {
       LOGE("Failed to create AFC handle");
       return;
   }
+  channels_.push_back(std::make_unique<Channel>(afc_handle));
   is_initialized_ = false;
   is_log_opened = false;
   LOGI("SeekAudioAfc created successfully");
@@ -39,149 +56,147 @@ SeekAudioAfc::SeekAudioAfc()
 SeekAudioAfc::~SeekAudioAfc() {
   LOGI("SeekAudioAfc destructor called");
   
-  if (afc_handle_ && afc_free_) {
-    afc_free_(afc_handle_);
-    afc_handle_ = nullptr;
+  if (api_->free) {
+    for (auto& channel : channels_) {
+      api_->free(channel->handle);
+    }
   }
+  channels_.clear();
   
   UnloadLibrary();
   LOGI("SeekAudioAfc destroyed");
 }
 
 bool SeekAudioAfc::LoadLibrary() {
-#ifdef __ANDROID__
-  const char* library_path = "libseekaudio_afc.so";  // Android库路径
-#else
-  const char* library_path = "libseekaudio_afc.so";  // Linux库路径
-#endif
-
-  library_handle_ = dlopen(library_path, RTLD_LAZY);
-  if (!library_handle_) {
-    LOGE("Failed to load library: %s, error: %s", library_path, dlerror());
-    return false;
-  }
-
-  LOGI("Successfully loaded library: %s", library_path);
-
-  // 加载所有需要的函数
-  afc_create_ = reinterpret_cast<AFC_CreateFunc>(GetFunctionPointer("SeekAudioAFC_Create"));
-  afc_free_ = reinterpret_cast<AFC_FreeFunc>(GetFunctionPointer("SeekAudioAFC_Free"));
-  afc_open_log_ = reinterpret_cast<AFC_OpenLogFunc>(GetFunctionPointer("SeekAudioAFC_OpenLog"));
-  afc_init_ = reinterpret_cast<AFC_InitFunc>(GetFunctionPointer("SeekAudioAFC_Init"));
-  afc_process_ = reinterpret_cast<AFC_ProcessFunc>(GetFunctionPointer("SeekAudioAFC_Process"));
-  afc_agc_compensate_ = reinterpret_cast<AFC_AGC_CompensateFunc>(GetFunctionPointer("SeekAudioAFC_AGC_Compensate"));
-  afc_get_howling_status_ = reinterpret_cast<AFC_GetHowlingStatusFunc>(GetFunctionPointer("SeekAudioAFC_GetHowlingStatus"));
-  afc_set_power_ = reinterpret_cast<AFC_SetPowerFunc>(GetFunctionPointer("SeekAudioAFC_Set_AI_Engine_Power"));
-
-  // 检查必需函数是否加载成功
-  if (!afc_create_ || !afc_free_ || !afc_init_ || !afc_process_) {
-    LOGE("Failed to load essential AFC functions");
-    UnloadLibrary();
+  if (!library_) {
     return false;
   }
-
-  LOGI("All AFC functions loaded successfully");
+  api_ = &library_->afc();
+  LOGI("Using AFC library: %s", library_->path().c_str());
   return true;
 }
 
 void SeekAudioAfc::UnloadLibrary() {
-  if (library_handle_) {
-    dlclose(library_handle_);
-    library_handle_ = nullptr;
-    
-    // 清空函数指针
-    afc_create_ = nullptr;
-    afc_free_ = nullptr;
-    afc_open_log_ = nullptr;
-    afc_init_ = nullptr;
-	afc_set_power_ = nullptr;
-    afc_process_ = nullptr;
-    afc_agc_compensate_ = nullptr;
-    afc_get_howling_status_ = nullptr;
-    
-    LOGI("AFC library unloaded");
-  }
-}
-
-void* SeekAudioAfc::GetFunctionPointer(const char* function_name) {
-  if (!library_handle_) {
-    LOGE("Library not loaded, cannot get function: %s", function_name);
-    return nullptr;
-  }
-
-  void* func_ptr = dlsym(library_handle_, function_name);
-  if (!func_ptr) {
-    LOGW("Failed to load function: %s, error: %s", function_name, dlerror());
-    return nullptr;
-  }
-
-  LOGI("Successfully loaded function: %s", function_name);
-  return func_ptr;
+  // The library itself is closed once no instance uses it anymore.
+  api_ = &kNoAfcApi;
+  library_.reset();
 }
 
 void SeekAudioAfc::SetSuppressPower(int level)
 {
-	LOGI("SeekAudioAfc::SetSuppressPower called: level=%d", level);
-	if (!library_handle_) {
+	SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kPowerChange,
+	                 "SeekAudioAfc::SetSuppressPower called: level=%d", level);
+	if (!library_) {
 		LOGE("Library not loaded, cannot initialize");
 		return;
 	}
 
-	if (!afc_set_power_) {
-		LOGE("afc_set_power_ function not available");
+	if (!api_->set_power) {
+		LOGE("set_power function not available");
 		return;
 	}
 
-	afc_set_power_(afc_handle_, level);
+	power_ = level;
+	for (auto& channel : channels_) {
+		api_->set_power(channel->handle, level);
+	}
 
 }
 
 bool SeekAudioAfc::Initialize(int sample_rate_hz, int num_channels) {
-  if (is_initialized_)
-		return true;
-  LOGI("SeekAudioAfc::Initialize called: sample_rate=%d, channels=%d", 
-       sample_rate_hz, num_channels);
-  
   RTC_DCHECK_GT(sample_rate_hz, 0);
   RTC_DCHECK_GT(num_channels, 0);
-  
-  if (!library_handle_) {
-    LOGE("Library not loaded, cannot initialize");
+
+  if (sample_rate_hz != kSeekAudioSampleRateHz &&
+      sample_rate_hz != kSeekAudioSampleRateHz / 2) {
+    LOGE("SeekAudioAFC only supports 8kHz and 16kHz bands, got %d", sample_rate_hz);
     return false;
   }
+
+  if (!is_initialized_) {
+    LOGI("SeekAudioAfc::Initialize called: sample_rate=%d, channels=%d", 
+         sample_rate_hz, num_channels);
   
-  if (sample_rate_hz != 16000) {
-    LOGE("SeekAudioAFC only supports 16kHz sample rate, got %d", sample_rate_hz);
-    return false;
-  }
+    if (!library_) {
+      LOGE("Library not loaded, cannot initialize");
+      return false;
+    }
+    if (channels_.empty()) {
+      LOGE("AFC handle not available, cannot initialize");
+      return false;
+    }
+
+    sample_rate_hz_ = kSeekAudioSampleRateHz;
+
+
+    // 初始化AFC
+    if (!api_->init) {
+      LOGE("AFC init function not available");
+      return false;
+    }
+  
+    if (api_->init(channels_[0]->handle, sample_rate_hz_) != 0) {
+      LOGE("Failed to initialize SeekAudioAFC");
+      if (api_->free) {
+        api_->free(channels_[0]->handle);
+      }
+      channels_.clear();
+      return false;
+    }
   
-  if (num_channels != 1) {
-	  LOGE("SeekAudioAFC only supports mono channel, num_channels %d", num_channels);
-	  return false;
+    is_initialized_ = true;
+    LOGI("SeekAudioAFC initialized successfully: sample_rate=%d",
+         sample_rate_hz_);
   }
 
-  sample_rate_hz_ = sample_rate_hz;
+  // The channel count may change on every reinitialization of APM.
+  const size_t new_num_channels = static_cast<size_t>(num_channels);
+  if (new_num_channels != channels_.size()) {
+    while (channels_.size() > new_num_channels) {
+      if (api_->free) {
+        api_->free(channels_.back()->handle);
+      }
+      channels_.pop_back();
+    }
+    while (channels_.size() < new_num_channels) {
+      if (!AddChannel()) {
+        return false;
+      }
+    }
+    LOGI("SeekAudioAFC running %d channels", num_channels);
+  }
 
+  // The band layout may change on every reinitialization of APM, while the
+  // engine keeps running at 16 kHz.
+  for (auto& channel : channels_) {
+    channel->band_bridge.Reset();
+    channel->resampler.Reset();
+  }
+  
+  return true;
+}
 
-  // 初始化AFC
-  if (!afc_init_) {
-    LOGE("AFC init function not available");
+bool SeekAudioAfc::AddChannel() {
+  if (!api_->create || !api_->init) {
+    LOGE("AFC create or init function not available");
     return false;
   }
-  
-  if (afc_init_(afc_handle_, sample_rate_hz_) != 0) {
-    LOGE("Failed to initialize SeekAudioAFC");
-    if (afc_free_) {
-      afc_free_(afc_handle_);
-      afc_handle_ = nullptr;
+  void* afc_handle = api_->create();
+  if (!afc_handle) {
+    LOGE("Failed to create AFC handle for channel %zu", channels_.size());
+    return false;
+  }
+  if (api_->init(afc_handle, sample_rate_hz_) != 0) {
+    LOGE("Failed to initialize SeekAudioAFC channel %zu", channels_.size());
+    if (api_->free) {
+      api_->free(afc_handle);
     }
     return false;
   }
-  
-  is_initialized_ = true;
-  LOGI("SeekAudioAFC initialized successfully: sample_rate=%d",
-       sample_rate_hz_);
-  
+  if (power_ && api_->set_power) {
+    api_->set_power(afc_handle, *power_);
+  }
+  channels_.push_back(std::make_unique<Channel>(afc_handle));
   return true;
 }
 
@@ -189,12 +204,12 @@ int  SeekAudioAfc::ProcessOpenLog(const char *folderPath){
 	int ret = 0;
 	if (is_log_opened)
 		return ret;
-	if (!afc_handle_ || !afc_open_log_) {
+	if (channels_.empty() || !api_->open_log) {
 		LOGE("AFC ProcessOpenLog function failed");
 		return -1;
 	}
 
-	ret = afc_open_log_(afc_handle_, folderPath);
+	ret = api_->open_log(channels_[0]->handle, folderPath);
 
 	if (ret != 0)
 	{
@@ -208,87 +223,191 @@ int  SeekAudioAfc::ProcessOpenLog(const char *folderPath){
 
 void SeekAudioAfc::ProcessAGCCompensate(float* const* agc_in, float* const* agc_out, float* const* data, int samples_per_channel)
 {
-	if (!is_initialized_ || !afc_handle_ || !afc_agc_compensate_) {
-		LOGW("AFC not ready for processing: initialized=%d, handle=%p, process_func=%p",
-			is_initialized_, afc_handle_, afc_agc_compensate_);
+	if (!is_initialized_ || channels_.empty() ||
+	    (!api_->agc_compensate && !api_->agc_compensate_float)) {
+		SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+		                 "AFC not ready for processing: initialized=%d, channels=%zu, process=%d",
+		                 is_initialized_, channels_.size(), !!api_->agc_compensate);
 		return;
 	}
 
 	if (samples_per_channel != 160) {
-		LOGW("AFC requires 10ms frames (160 samples), got %d samples", samples_per_channel);
+		SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+		                 "AFC requires 10ms frames (160 samples), got %d samples", samples_per_channel);
 		return;
 	}
 
-	int i = 0;
-	float* tempframe = data[0];
-	float* agcframeIn = agc_in[0];
-	float* agcframeOut = agc_out[0];
-
-	short input_frame[160];
-	short output_frame[160];
-	short agc_in_frame[160];
-	short agc_out_frame[160];
-
-	for (i = 0; i < 160; i++)
-	{
-		input_frame[i] = SEEKAUDIO_SAT(32767, tempframe[i], -32768);
-		agc_in_frame[i] = SEEKAUDIO_SAT(32767, agcframeIn[i], -32768);
-		agc_out_frame[i] = SEEKAUDIO_SAT(32767, agcframeOut[i], -32768);
-		output_frame[i] = 0;
-	}
-
-	afc_agc_compensate_(afc_handle_, agc_in_frame, agc_out_frame, input_frame, output_frame);
-
-
-	for (i = 0; i < 160; i++)
-	{
-		tempframe[i] = (float)output_frame[i];
+	for (size_t ch = 0; ch < channels_.size(); ++ch) {
+		void* afc_handle = channels_[ch]->handle;
+		if (api_->agc_compensate_float) {
+			api_->agc_compensate_float(afc_handle, agc_in[ch], agc_out[ch], data[ch], data[ch]);
+			continue;
+		}
+
+		int16_t input_frame[kSeekAudioFrameSize];
+		int16_t output_frame[kSeekAudioFrameSize];
+		int16_t agc_in_frame[kSeekAudioFrameSize];
+		int16_t agc_out_frame[kSeekAudioFrameSize];
+		ArrayView<float> frame(data[ch], kSeekAudioFrameSize);
+		converter_.FloatS16ToS16(frame, input_frame);
+		converter_.FloatS16ToS16(ArrayView<const float>(agc_in[ch], kSeekAudioFrameSize), agc_in_frame);
+		converter_.FloatS16ToS16(ArrayView<const float>(agc_out[ch], kSeekAudioFrameSize), agc_out_frame);
+
+		api_->agc_compensate(afc_handle, agc_in_frame, agc_out_frame, input_frame, output_frame);
+
+		converter_.S16ToFloatS16(output_frame, frame);
 	}
-
 }
 
 void SeekAudioAfc::ProcessCaptureAudio(float* const* data, int samples_per_channel) {
-  if (!is_initialized_ || !afc_handle_ || !afc_process_) {
-    LOGW("AFC not ready for processing: initialized=%d, handle=%p, process_func=%p",
-         is_initialized_, afc_handle_, afc_process_);
+  if (!is_initialized_ || channels_.empty() || !api_->process) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AFC not ready for processing: initialized=%d, channels=%zu, process=%d",
+                     is_initialized_, channels_.size(), !!api_->process);
     return;
   }
   
-  if (samples_per_channel != 160 ) {
-    LOGW("AFC requires 10ms frames (160 samples), got %d samples", samples_per_channel);
+  if (samples_per_channel != static_cast<int>(kSeekAudioFrameSize)) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "AFC requires 10ms frames (160 samples), got %d samples", samples_per_channel);
     return;
   }
   
-  //LOGI("Processing capture audio: %d samples",samples_per_channel);
-  int i = 0;
-  float* temp_frame = data[0];
-  short input_frame[160];
-  short output_frame[160];
-  for (i = 0; i < 160; i++)
-  {
-	  input_frame[i] = SEEKAUDIO_SAT(32767, temp_frame[i], -32768);
-	  output_frame[i] = 0;
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    ProcessFrame(channels_[ch]->handle, data[ch]);
   }
+}
 
-  afc_process_(afc_handle_, input_frame, output_frame);
+void SeekAudioAfc::ProcessCapture(AudioBuffer* audio) {
+  if (!is_initialized_ || channels_.empty() || !api_->process) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "AFC not ready for processing: initialized=%d, channels=%zu, process=%d",
+                     is_initialized_, channels_.size(), !!api_->process);
+    return;
+  }
 
-  for (i = 0; i < 160; i++)
-  {
-	  temp_frame[i] =(float)output_frame[i];
+  const size_t num_frames = audio->num_frames_per_band();
+  if (num_frames != kSeekAudioFrameSize &&
+      num_frames != kSeekAudioNarrowbandFrameSize) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kInvalidFrame,
+                     "AFC requires 10ms frames (160 samples), got %zu samples", num_frames);
+    return;
   }
 
+  RTC_DCHECK_EQ(audio->num_channels(), channels_.size());
+  const size_t num_channels = std::min(audio->num_channels(), channels_.size());
+  const size_t num_bands = audio->num_bands();
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    Channel& channel = *channels_[ch];
+    float* const* bands = audio->split_bands(ch);
+    if (num_frames == kSeekAudioNarrowbandFrameSize) {
+      ArrayView<float> narrowband(bands[0], num_frames);
+      channel.resampler.Upsample(narrowband, channel.frame);
+      ProcessFrame(channel.handle, channel.frame.data());
+      channel.resampler.Downsample(channel.frame, narrowband);
+      continue;
+    }
+    if (num_bands > 1) {
+      std::copy(bands[0], bands[0] + num_frames, channel.lowband_in.begin());
+    }
+    ProcessFrame(channel.handle, bands[0]);
+    if (num_bands > 1) {
+      channel.band_bridge.Update(channel.lowband_in,
+                                 ArrayView<const float>(bands[0], num_frames));
+      channel.band_bridge.ApplyToUpperBands(bands, num_bands, num_frames);
+    }
+  }
+}
+
+void SeekAudioAfc::ProcessFrame(void* handle, float* frame) {
+  const int64_t start_us = TimeMicros();
+  if (api_->process_float) {
+    api_->process_float(handle, frame, frame);
+  } else {
+    int16_t input_frame[kSeekAudioFrameSize];
+    int16_t output_frame[kSeekAudioFrameSize];
+    ArrayView<float> frame_view(frame, kSeekAudioFrameSize);
+    converter_.FloatS16ToS16(frame_view, input_frame);
+    api_->process(handle, input_frame, output_frame);
+    converter_.S16ToFloatS16(output_frame, frame_view);
+  }
+  engine_time_us_ += TimeMicros() - start_us;
+}
+
+void SeekAudioAfc::ConfigurePower(
+    int level,
+    const SeekAudioPowerGovernor::Config& governor) {
+  if (!governor.enabled) {
+    power_governor_.reset();
+    SetSuppressPower(level);
+    return;
+  }
+  // The AFC has no echo power, the echo level of the governor is unused.
+  power_governor_ = std::make_unique<SeekAudioPowerGovernor>(
+      governor, SeekAudioPowerGovernor::Levels{level, governor.idle_level});
+  engine_time_us_ = 0;
+  SetSuppressPower(power_governor_->levels().howl);
+}
+
+void SeekAudioAfc::UpdatePowerGovernor() {
+  if (!power_governor_) {
+    return;
+  }
+  const int howl_level = power_governor_->levels().howl;
+  power_governor_->Update(GetHowlingProbability(), std::nullopt,
+                          engine_time_us_, TimeMicros());
+  engine_time_us_ = 0;
+  if (power_governor_->levels().howl != howl_level) {
+    SetSuppressPower(power_governor_->levels().howl);
+  }
 }
 
 float SeekAudioAfc::GetHowlingProbability() const {
-  if (!is_initialized_ || !afc_handle_ || !afc_get_howling_status_) {
-    LOGW("Cannot get howling probability: initialized=%d, handle=%p, func=%p",
-         is_initialized_, afc_handle_, afc_get_howling_status_);
+  if (!is_initialized_ || channels_.empty() || !api_->get_howling_status) {
+    SEEK_AUDIO_EVENT(events_, SeekAudioEvent::kNotReady,
+                     "Cannot get howling probability: initialized=%d, channels=%zu, func=%d",
+                     is_initialized_, channels_.size(), !!api_->get_howling_status);
     return 0.0f;
   }
   
-  float probability = afc_get_howling_status_(afc_handle_);
+  float probability = 0.0f;
+  for (const auto& channel : channels_) {
+    probability =
+        std::max(probability, api_->get_howling_status(channel->handle));
+  }
   //LOGI("Howling probability: %.3f", probability);
   return probability;
 }
 
+std::vector<uint8_t> SeekAudioAfc::GetEngineState(int channel) const {
+  if (!is_initialized_ || channel < 0 || channel >= num_channels() ||
+      !api_->get_state) {
+    return {};
+  }
+  void* handle = channels_[channel]->handle;
+  const int size = api_->get_state(handle, nullptr, 0);
+  if (size <= 0) {
+    return {};
+  }
+  std::vector<uint8_t> state(size);
+  if (api_->get_state(handle, state.data(), size) != size) {
+    LOGW("Failed to get the engine state of channel %d", channel);
+    return {};
+  }
+  return state;
+}
+
+bool SeekAudioAfc::SetEngineState(int channel, ArrayView<const uint8_t> state) {
+  if (!is_initialized_ || channel < 0 || channel >= num_channels() ||
+      !api_->set_state) {
+    return false;
+  }
+  if (api_->set_state(channels_[channel]->handle, state.data(),
+                      static_cast<int>(state.size())) != 0) {
+    LOGW("Engine state of channel %d rejected", channel);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace webrtc
@@ -2,11 +2,21 @@
 #ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AFC_H_
 #define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AFC_H_
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 
 #include "api/audio/audio_processing.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/seek_audio_band_bridge.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/seek_audio_event_log.h"
+#include "modules/audio_processing/seek_audio_library.h"
+#include "modules/audio_processing/seek_audio_power_governor.h"
+#include "modules/audio_processing/seek_audio_resampler.h"
+#include "modules/audio_processing/seek_audio_sample_converter.h"
 
 // Android日志支持
 #ifdef __ANDROID__
@@ -25,61 +35,109 @@ namespace webrtc {
 
 class SeekAudioAfc {
  public:
-  explicit SeekAudioAfc();
+  SeekAudioAfc();
+  // Uses the engine library at `library_path`, or the default library if
+  // empty.
+  explicit SeekAudioAfc(const std::string& library_path);
+  // Uses `library`, acquired for `library_path` beforehand, and never opens
+  // a library itself. A null `library` gives an inert instance.
+  SeekAudioAfc(const std::string& library_path,
+               std::shared_ptr<const SeekAudioLibrary> library);
   ~SeekAudioAfc();
 
+  // Path of the requested engine library, empty for the default one.
+  const std::string& library_path() const { return library_path_; }
 
+
+  // Every capture channel gets an engine handle of its own. Handles are only
+  // created or released here.
   bool Initialize(int sample_rate_hz, int num_channels);
+  int num_channels() const { return static_cast<int>(channels_.size()); }
   void SetSuppressPower(int level);
 
+  // Sets the engine power to `level`, or lets a governor vary it between the
+  // idle level and `level` when `governor.enabled`.
+  void ConfigurePower(int level, const SeekAudioPowerGovernor::Config& governor);
+  // Feeds the governor, if any, with the outcome of the last processed frame.
+  void UpdatePowerGovernor();
+
   void ProcessCaptureAudio(float* const* data, int samples_per_channel);
 
+  // Processes the lowest split band of every channel of `audio` and
+  // propagates the resulting suppression to the upper bands. 8 kHz audio is
+  // upsampled for the engine and downsampled back.
+  void ProcessCapture(AudioBuffer* audio);
+
   void ProcessAGCCompensate(float* const* agc_in, float* const* agc_out, float* const* data, int samples_per_channel);
   
 
+  // For the first channel only.
   int  ProcessOpenLog(const char *folderPath);
   
 
+  // The highest howling probability of the channels.
   float GetHowlingProbability() const;
 
+  // Adaptive state of the engine of `channel` for a warm start, see
+  // SetEngineState(). Empty if the engine does not export the state entry
+  // points.
+  std::vector<uint8_t> GetEngineState(int channel) const;
+  // Restores a state returned by GetEngineState() of an engine of the same
+  // library. Returns false if unsupported or rejected by the engine.
+  bool SetEngineState(int channel, ArrayView<const uint8_t> state);
+
+  // Per-frame events of this module, which are counted instead of logged on
+  // every occurrence. Also updated by const methods and by APM.
+  SeekAudioEventCounters& events() const { return events_; }
+
  private:
-  // 动态加载的函数指针类型定义
-  typedef void* (*AFC_CreateFunc)();
-  typedef void (*AFC_FreeFunc)(void*);
-  typedef int (*AFC_OpenLogFunc)(void*, const char*);
-  typedef int (*AFC_InitFunc)(void*, int);
-  typedef void(*AFC_SetPowerFunc)(void*, int);
-  typedef void (*AFC_ProcessFunc)(void*, const short*, short*);
-  typedef void (*AFC_AGC_CompensateFunc)(void*, const short*, const short*, const short*, short*);
-  typedef float (*AFC_GetHowlingStatusFunc)(void*);
-
-  // 函数指针声明
-  AFC_CreateFunc afc_create_ = nullptr;
-  AFC_FreeFunc afc_free_ = nullptr;
-  AFC_OpenLogFunc afc_open_log_ = nullptr;
-  AFC_InitFunc afc_init_ = nullptr;
-  AFC_SetPowerFunc afc_set_power_ = nullptr;
-  AFC_ProcessFunc afc_process_ = nullptr;
-  AFC_AGC_CompensateFunc afc_agc_compensate_ = nullptr;
-  AFC_GetHowlingStatusFunc afc_get_howling_status_ = nullptr;
-
-  // 动态库句柄
-  void* library_handle_ = nullptr;
-  
+  // Shared engine library and its entry points. `api_` points to an empty
+  // table while no library is loaded.
+  std::shared_ptr<const SeekAudioLibrary> library_;
+  const SeekAudioAfcApi* api_;
+
+  // int16 fallback used when the float entry points are not exported.
+  const SeekAudioSampleConverter converter_;
+
   bool is_initialized_ = false;
   bool is_log_opened = false;
   int sample_rate_hz_ = 0;
   
-  void* afc_handle_ = nullptr;  // 使用void*代替具体的AFCHandle*
-  
-  // 音频缓冲区
-  std::vector<float> processing_buffer_;
-  std::vector<const float*> channel_ptrs_;
-  
+  // Engine handle and band processing of one capture channel.
+  struct Channel {
+    explicit Channel(void* handle) : handle(handle) {}
+
+    void* const handle;  // 使用void*代替具体的AFCHandle*
+
+    // 16 kHz lowband processing and band propagation.
+    SeekAudioBandBridge band_bridge;
+    SeekAudioResampler resampler;
+    std::array<float, kSeekAudioFrameSize> lowband_in;
+    std::array<float, kSeekAudioFrameSize> frame;
+  };
+
+  // One per capture channel. The first handle is created with the instance,
+  // so that the log can be opened before initialization.
+  std::vector<std::unique_ptr<Channel>> channels_;
+  // Last level set, applied to handles created later on.
+  std::optional<int> power_;
+
   // 动态加载库
+  const std::string library_path_;
+
+  mutable SeekAudioEventCounters events_;
+
+  std::unique_ptr<SeekAudioPowerGovernor> power_governor_;
+  int64_t engine_time_us_ = 0;
+
   bool LoadLibrary();
   void UnloadLibrary();
-  void* GetFunctionPointer(const char* function_name);
+
+  // Creates and initializes the handle of a new channel.
+  bool AddChannel();
+
+  // Runs the engine `handle` in-place on one 160 sample frame.
+  void ProcessFrame(void* handle, float* frame);
   
 };
 
@@ -0,0 +1,98 @@
+// seek_audio_agc_compensation.cc
+#include "modules/audio_processing/seek_audio_agc_compensation.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+SeekAudioAgcCompensation::SeekAudioAgcCompensation() = default;
+
+SeekAudioAgcCompensation::~SeekAudioAgcCompensation() = default;
+
+void SeekAudioAgcCompensation::Initialize(size_t num_channels) {
+  channels_.clear();
+  agc_in_.clear();
+  agc_out_.clear();
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    channels_.push_back(std::make_unique<Channel>());
+    Channel& channel = *channels_.back();
+    channel.agc_in.fill(0.f);
+    channel.agc_out.fill(0.f);
+    channel.frame.fill(0.f);
+    agc_in_.push_back(channel.agc_in.data());
+    agc_out_.push_back(channel.agc_out.data());
+  }
+  frames_.assign(num_channels, nullptr);
+  has_agc_input_ = false;
+}
+
+bool SeekAudioAgcCompensation::IsSupported(const AudioBuffer& audio,
+                                           size_t num_channels) {
+  const size_t num_frames = audio.num_frames_per_band();
+  return num_channels > 0 && audio.num_channels() == num_channels &&
+         audio.num_bands() <= SeekAudioBandBridge::kMaxNumBands &&
+         (num_frames == kSeekAudioFrameSize ||
+          num_frames == kSeekAudioNarrowbandFrameSize);
+}
+
+void SeekAudioAgcCompensation::AnalyzeAgcInput(const AudioBuffer& audio) {
+  has_agc_input_ = IsSupported(audio, channels_.size());
+  if (!has_agc_input_) {
+    return;
+  }
+  const size_t num_frames = audio.num_frames_per_band();
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    Channel& channel = *channels_[ch];
+    ArrayView<const float> lowband(audio.split_bands_const(ch)[0], num_frames);
+    if (num_frames == kSeekAudioNarrowbandFrameSize) {
+      channel.agc_in_resampler.Upsample(lowband, channel.agc_in);
+    } else {
+      std::copy(lowband.begin(), lowband.end(), channel.agc_in.begin());
+    }
+  }
+}
+
+void SeekAudioAgcCompensation::Process(AudioBuffer* audio,
+                                       Compensator compensate) {
+  RTC_DCHECK(audio);
+  if (!has_agc_input_ || !IsSupported(*audio, channels_.size())) {
+    has_agc_input_ = false;
+    return;
+  }
+  has_agc_input_ = false;
+
+  const size_t num_frames = audio->num_frames_per_band();
+  const size_t num_bands = audio->num_bands();
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    Channel& channel = *channels_[ch];
+    float* lowband = audio->split_bands(ch)[0];
+    if (num_frames == kSeekAudioNarrowbandFrameSize) {
+      channel.resampler.Upsample(ArrayView<const float>(lowband, num_frames),
+                                 channel.frame);
+      channel.agc_out = channel.frame;
+      frames_[ch] = channel.frame.data();
+    } else {
+      std::copy(lowband, lowband + num_frames, channel.agc_out.begin());
+      frames_[ch] = lowband;
+    }
+  }
+
+  compensate(agc_in_.data(), agc_out_.data(), frames_.data());
+
+  for (size_t ch = 0; ch < channels_.size(); ++ch) {
+    Channel& channel = *channels_[ch];
+    float* const* bands = audio->split_bands(ch);
+    if (num_frames == kSeekAudioNarrowbandFrameSize) {
+      channel.resampler.Downsample(channel.frame,
+                                   ArrayView<float>(bands[0], num_frames));
+    } else if (num_bands > 1) {
+      channel.band_bridge.Update(channel.agc_out,
+                                 ArrayView<const float>(bands[0], num_frames));
+      channel.band_bridge.ApplyToUpperBands(bands, num_bands, num_frames);
+    }
+  }
+}
+
+}  // namespace webrtc
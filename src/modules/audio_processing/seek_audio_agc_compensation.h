@@ -0,0 +1,76 @@
+// seek_audio_agc_compensation.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AGC_COMPENSATION_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AGC_COMPENSATION_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/seek_audio_band_bridge.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/seek_audio_resampler.h"
+
+namespace webrtc {
+
+// Feeds the AGC compensation of the SeekAudio engines, which undoes the part
+// of the AGC gain that the engines consider residual echo or howling.
+//
+// Only the 16 kHz lowband before and after the AGC is recorded, in the split
+// band domain where the SeekAudio engines and AGC1 run, instead of full-band
+// snapshots of the whole capture buffer. The compensation then runs in-place
+// on the lowband and the resulting change is propagated to the upper bands by
+// a SeekAudioBandBridge. 8 kHz audio is upsampled for the engines and
+// downsampled back. No memory is allocated after Initialize().
+class SeekAudioAgcCompensation {
+ public:
+  // Engine compensation of all channels, with the frames before the AGC, after
+  // the AGC, and the frames to compensate in-place, see
+  // SeekAudioAec::ProcessAGCCompensate().
+  using Compensator = FunctionView<void(float* const* agc_in,
+                                        float* const* agc_out,
+                                        float* const* frames)>;
+
+  SeekAudioAgcCompensation();
+  ~SeekAudioAgcCompensation();
+  SeekAudioAgcCompensation(const SeekAudioAgcCompensation&) = delete;
+  SeekAudioAgcCompensation& operator=(const SeekAudioAgcCompensation&) = delete;
+
+  // Sets up `num_channels` channels and clears all state.
+  void Initialize(size_t num_channels);
+  size_t num_channels() const { return channels_.size(); }
+
+  // Records the lowband of `audio` before the AGC.
+  void AnalyzeAgcInput(const AudioBuffer& audio);
+
+  // Runs `compensate` on the lowband of `audio` after the AGC and applies the
+  // result to all bands. Frames without a preceding AnalyzeAgcInput() or with
+  // an unsupported band layout are left untouched.
+  void Process(AudioBuffer* audio, Compensator compensate);
+
+ private:
+  struct Channel {
+    std::array<float, kSeekAudioFrameSize> agc_in;
+    std::array<float, kSeekAudioFrameSize> agc_out;
+    std::array<float, kSeekAudioFrameSize> frame;
+    SeekAudioResampler agc_in_resampler;
+    SeekAudioResampler resampler;
+    SeekAudioBandBridge band_bridge;
+  };
+
+  static bool IsSupported(const AudioBuffer& audio, size_t num_channels);
+
+  std::vector<std::unique_ptr<Channel>> channels_;
+  // Per-channel pointers passed to the Compensator.
+  std::vector<float*> agc_in_;
+  std::vector<float*> agc_out_;
+  std::vector<float*> frames_;
+  bool has_agc_input_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_AGC_COMPENSATION_H_
@@ -0,0 +1,210 @@
+// seek_audio_agc_compensation_unittest.cc
+#include "modules/audio_processing/seek_audio_agc_compensation.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+void FillNoiseLike(size_t seed, AudioBuffer& audio) {
+  uint32_t state = 12345u + seed;
+  for (size_t ch = 0; ch < audio.num_channels(); ++ch) {
+    for (size_t band = 0; band < audio.num_bands(); ++band) {
+      float* samples = audio.split_bands(ch)[band];
+      for (size_t k = 0; k < audio.num_frames_per_band(); ++k) {
+        state = state * 1664525u + 1013904223u;
+        samples[k] =
+            static_cast<float>(static_cast<int32_t>(state >> 16) - 32768) /
+            8.f;
+      }
+    }
+  }
+}
+
+void ApplyGain(float gain, AudioBuffer& audio) {
+  for (size_t ch = 0; ch < audio.num_channels(); ++ch) {
+    for (size_t band = 0; band < audio.num_bands(); ++band) {
+      float* samples = audio.split_bands(ch)[band];
+      for (size_t k = 0; k < audio.num_frames_per_band(); ++k) {
+        samples[k] *= gain;
+      }
+    }
+  }
+}
+
+std::unique_ptr<AudioBuffer> CreateSplitBuffer(int sample_rate_hz,
+                                               size_t num_channels) {
+  auto audio = std::make_unique<AudioBuffer>(sample_rate_hz, num_channels,
+                                             sample_rate_hz, num_channels,
+                                             sample_rate_hz, num_channels);
+  audio->SplitIntoFrequencyBands();
+  return audio;
+}
+
+}  // namespace
+
+TEST(SeekAudioAgcCompensation, PassesLowbandBeforeAndAfterAgc) {
+  constexpr size_t kNumChannels = 2;
+  auto audio = CreateSplitBuffer(16000, kNumChannels);
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(kNumChannels);
+
+  FillNoiseLike(0, *audio);
+  std::array<std::array<float, kSeekAudioFrameSize>, kNumChannels> agc_in;
+  for (size_t ch = 0; ch < kNumChannels; ++ch) {
+    std::copy(audio->split_bands(ch)[0],
+              audio->split_bands(ch)[0] + kSeekAudioFrameSize,
+              agc_in[ch].begin());
+  }
+  compensation.AnalyzeAgcInput(*audio);
+  ApplyGain(2.f, *audio);
+
+  int num_calls = 0;
+  compensation.Process(audio.get(), [&](float* const* in, float* const* out,
+                                        float* const* frames) {
+    ++num_calls;
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      EXPECT_EQ(audio->split_bands(ch)[0], frames[ch]);
+      for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+        EXPECT_EQ(agc_in[ch][k], in[ch][k]);
+        EXPECT_EQ(2.f * agc_in[ch][k], out[ch][k]);
+      }
+      // Undoes the AGC gain.
+      std::copy(in[ch], in[ch] + kSeekAudioFrameSize, frames[ch]);
+    }
+  });
+  EXPECT_EQ(1, num_calls);
+  for (size_t ch = 0; ch < kNumChannels; ++ch) {
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      EXPECT_EQ(agc_in[ch][k], audio->split_bands(ch)[0][k]);
+    }
+  }
+}
+
+TEST(SeekAudioAgcCompensation, SkipsFramesWithoutAgcInput) {
+  auto audio = CreateSplitBuffer(16000, 1);
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(1);
+  int num_calls = 0;
+  auto count_calls = [&](float* const*, float* const*, float* const*) {
+    ++num_calls;
+  };
+
+  compensation.Process(audio.get(), count_calls);
+  EXPECT_EQ(0, num_calls);
+
+  compensation.AnalyzeAgcInput(*audio);
+  compensation.Process(audio.get(), count_calls);
+  compensation.Process(audio.get(), count_calls);
+  EXPECT_EQ(1, num_calls);
+}
+
+TEST(SeekAudioAgcCompensation, SkipsMismatchingChannelCount) {
+  auto audio = CreateSplitBuffer(16000, 2);
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(1);
+  int num_calls = 0;
+  compensation.AnalyzeAgcInput(*audio);
+  compensation.Process(audio.get(),
+                       [&](float* const*, float* const*, float* const*) {
+                         ++num_calls;
+                       });
+  EXPECT_EQ(0, num_calls);
+}
+
+TEST(SeekAudioAgcCompensation, PropagatesCompensationToUpperBands) {
+  auto audio = CreateSplitBuffer(48000, 1);
+  ASSERT_EQ(3u, audio->num_bands());
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(1);
+  auto halve = [](float* const*, float* const*, float* const* frames) {
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      frames[0][k] *= 0.5f;
+    }
+  };
+
+  std::array<float, kSeekAudioFrameSize> upper_band;
+  for (int frame = 0; frame < 20; ++frame) {
+    FillNoiseLike(frame, *audio);
+    std::copy(audio->split_bands(0)[2],
+              audio->split_bands(0)[2] + kSeekAudioFrameSize,
+              upper_band.begin());
+    compensation.AnalyzeAgcInput(*audio);
+    compensation.Process(audio.get(), halve);
+  }
+  for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+    EXPECT_NEAR(0.5f * upper_band[k], audio->split_bands(0)[2][k],
+                0.01f * std::abs(upper_band[k]) + 1.f);
+  }
+}
+
+TEST(SeekAudioAgcCompensation, NarrowbandIsResampledForTheEngine) {
+  auto audio = CreateSplitBuffer(8000, 1);
+  ASSERT_EQ(kSeekAudioNarrowbandFrameSize, audio->num_frames_per_band());
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(1);
+  auto mute = [](float* const*, float* const*, float* const* frames) {
+    std::fill(frames[0], frames[0] + kSeekAudioFrameSize, 0.f);
+  };
+
+  for (int frame = 0; frame < 2; ++frame) {
+    FillNoiseLike(frame, *audio);
+    compensation.AnalyzeAgcInput(*audio);
+    compensation.Process(audio.get(), mute);
+  }
+  for (size_t k = 0; k < kSeekAudioNarrowbandFrameSize; ++k) {
+    EXPECT_EQ(0.f, audio->split_bands(0)[0][k]);
+  }
+}
+
+// Compares the lowband stage with the full-band snapshots that the
+// compensation used to take of every frame, at 48 kHz stereo.
+TEST(SeekAudioAgcCompensation, DISABLED_Benchmark) {
+  constexpr size_t kNumChannels = 2;
+  constexpr int kNumFrames = 100000;
+  auto audio = CreateSplitBuffer(48000, kNumChannels);
+  auto agc_in_audio = CreateSplitBuffer(48000, kNumChannels);
+  auto agc_out_audio = CreateSplitBuffer(48000, kNumChannels);
+  SeekAudioAgcCompensation compensation;
+  compensation.Initialize(kNumChannels);
+  auto compensate = [](float* const* agc_in, float* const* agc_out,
+                       float* const* frames) {
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      frames[ch][0] = 0.5f * (agc_in[ch][0] + agc_out[ch][0]);
+    }
+  };
+
+  test::PerformanceTimer snapshot_timer(kNumFrames);
+  test::PerformanceTimer lowband_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    FillNoiseLike(k, *audio);
+    snapshot_timer.StartTimer();
+    audio->CopyTo(agc_in_audio.get());
+    audio->CopyTo(agc_out_audio.get());
+    snapshot_timer.StopTimer();
+
+    lowband_timer.StartTimer();
+    compensation.AnalyzeAgcInput(*audio);
+    compensation.Process(audio.get(), compensate);
+    lowband_timer.StopTimer();
+  }
+  RTC_LOG(LS_INFO) << "Full-band snapshots: "
+                   << snapshot_timer.GetDurationAverage() << " +/- "
+                   << snapshot_timer.GetDurationStandardDeviation()
+                   << " us per 10 ms frame";
+  RTC_LOG(LS_INFO) << "Lowband compensation: "
+                   << lowband_timer.GetDurationAverage() << " +/- "
+                   << lowband_timer.GetDurationStandardDeviation()
+                   << " us per 10 ms frame";
+}
+
+}  // namespace webrtc
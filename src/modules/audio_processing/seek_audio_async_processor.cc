@@ -0,0 +1,183 @@
+// seek_audio_async_processor.cc
+#include "modules/audio_processing/seek_audio_async_processor.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+namespace {
+
+// Requests of about four lookahead windows (capture, render and control) can
+// be pending before frames are dropped. Results never outnumber requests.
+constexpr size_t kRingCapacity =
+    4 * SeekAudioAsyncProcessor::kMaxLookaheadFrames;
+
+constexpr int64_t kFrameDurationUs = 10000;
+
+}  // namespace
+
+constexpr int SeekAudioAsyncProcessor::kMaxLookaheadFrames;
+
+SeekAudioAsyncProcessor::SeekAudioAsyncProcessor(
+    Handler* handler,
+    int lookahead_frames,
+    std::shared_ptr<SeekAudioScheduler> scheduler)
+    : handler_(handler),
+      lookahead_frames_(lookahead_frames),
+      input_delay_(lookahead_frames + 1),
+      requests_(kRingCapacity),
+      results_(kRingCapacity),
+      scheduler_(std::move(scheduler)) {
+  RTC_DCHECK(handler_);
+  RTC_DCHECK_GE(lookahead_frames_, 1);
+  RTC_DCHECK_LE(lookahead_frames_, kMaxLookaheadFrames);
+  for (Frame& frame : input_delay_) {
+    frame.fill(0.f);
+  }
+  if (scheduler_) {
+    return;
+  }
+  worker_ = PlatformThread::SpawnJoinable(
+      [this] { Run(); }, "SeekAudioWorker",
+      ThreadAttributes().SetPriority(ThreadPriority::kRealtime));
+}
+
+SeekAudioAsyncProcessor::~SeekAudioAsyncProcessor() {
+  if (scheduler_) {
+    scheduler_->Remove(this);
+  } else {
+    quit_.store(true, std::memory_order_release);
+    wakeup_.Set();
+    worker_.Finalize();
+  }
+  // Requests still pending, such as control changes, are run here so that the
+  // engine state is complete when the caller takes over again. Their results
+  // are dropped.
+  HandleRequests();
+}
+
+bool SeekAudioAsyncProcessor::ProcessCapture(
+    ArrayView<float, kSeekAudioFrameSize> frame) {
+  const int64_t sequence = capture_sequence_++;
+  const size_t write_index = sequence % input_delay_.size();
+  std::copy(frame.begin(), frame.end(), input_delay_[write_index].begin());
+
+  Request* request = requests_.BeginPush();
+  if (request) {
+    request->type = RequestType::kCapture;
+    request->sequence = sequence;
+    request->deadline_us = TimeMicros() + lookahead_frames_ * kFrameDurationUs;
+    std::copy(frame.begin(), frame.end(), request->samples.begin());
+    requests_.CommitPush();
+    Wake();
+  } else {
+    ++num_dropped_requests_;
+  }
+
+  // Results are produced in order. Results older than the wanted one have
+  // been late and are dropped.
+  const int64_t wanted_sequence = sequence - lookahead_frames_;
+  read_index_ = (write_index + 1) % input_delay_.size();
+  while (Result* result = results_.Front()) {
+    if (result->sequence > wanted_sequence) {
+      break;
+    }
+    const bool wanted = result->sequence == wanted_sequence;
+    deadline_slack_us_ = result->slack_us;
+    if (wanted) {
+      std::copy(result->samples.begin(), result->samples.end(), frame.begin());
+    }
+    results_.Pop();
+    if (wanted) {
+      return true;
+    }
+  }
+
+  const Frame& delayed = input_delay_[read_index_];
+  std::copy(delayed.begin(), delayed.end(), frame.begin());
+  if (wanted_sequence >= 0) {
+    ++num_late_frames_;
+  }
+  return false;
+}
+
+void SeekAudioAsyncProcessor::AnalyzeRender(
+    ArrayView<const float, kSeekAudioFrameSize> frame) {
+  Request* request = requests_.BeginPush();
+  if (!request) {
+    ++num_dropped_requests_;
+    return;
+  }
+  request->type = RequestType::kRender;
+  std::copy(frame.begin(), frame.end(), request->samples.begin());
+  requests_.CommitPush();
+  Wake();
+}
+
+void SeekAudioAsyncProcessor::PostControl(int id, int value) {
+  Request* request = requests_.BeginPush();
+  if (!request) {
+    ++num_dropped_requests_;
+    return;
+  }
+  request->type = RequestType::kControl;
+  request->control_id = id;
+  request->control_value = value;
+  requests_.CommitPush();
+  Wake();
+}
+
+void SeekAudioAsyncProcessor::RunPendingRequests() {
+  HandleRequests();
+}
+
+void SeekAudioAsyncProcessor::Wake() {
+  if (scheduler_) {
+    scheduler_->Schedule(this);
+  } else {
+    wakeup_.Set();
+  }
+}
+
+void SeekAudioAsyncProcessor::Run() {
+  while (!quit_.load(std::memory_order_acquire)) {
+    // Auto-reset event: a request queued while the previous ones are handled
+    // leaves the event set, so no wakeup is lost.
+    wakeup_.Wait(Event::kForever);
+    HandleRequests();
+  }
+}
+
+void SeekAudioAsyncProcessor::HandleRequests() {
+  while (Request* request = requests_.Front()) {
+    switch (request->type) {
+      case RequestType::kCapture: {
+        // The engine state depends on every frame, so even frames that will
+        // be late are processed.
+        Result* result = results_.BeginPush();
+        if (result) {
+          result->sequence = request->sequence;
+          result->samples = request->samples;
+          handler_->ProcessCaptureFrame(result->samples);
+          result->slack_us = request->deadline_us - TimeMicros();
+          results_.CommitPush();
+        } else {
+          handler_->ProcessCaptureFrame(request->samples);
+        }
+        break;
+      }
+      case RequestType::kRender:
+        handler_->AnalyzeRenderFrame(request->samples);
+        break;
+      case RequestType::kControl:
+        handler_->ApplyControl(request->control_id, request->control_value);
+        break;
+    }
+    requests_.Pop();
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,132 @@
+// seek_audio_async_processor.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_ASYNC_PROCESSOR_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_ASYNC_PROCESSOR_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/seek_audio_scheduler.h"
+#include "modules/audio_processing/seek_audio_spsc_ring.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Runs the engine calls of a SeekAudio wrapper on a dedicated thread, so that
+// AI inference load does not cause deadline misses on the capture thread.
+//
+// Requests go to the worker and results come back through lock-free SPSC
+// rings. The worker is either a dedicated thread or, when a scheduler is
+// given, any worker of a pool shared with other streams. The result for a
+// capture frame is returned `lookahead_frames` calls later; the capture thread
+// never waits for the worker. If a result is late, the unprocessed input of
+// that frame is returned instead, so that the latency stays constant.
+//
+// All methods except the Handler callbacks are called on the capture thread.
+class SeekAudioAsyncProcessor : public SeekAudioScheduler::Stream {
+ public:
+  static constexpr int kMaxLookaheadFrames = 16;
+
+  using Frame = std::array<float, kSeekAudioFrameSize>;
+
+  // Engine calls, run on the worker thread in request order.
+  class Handler {
+   public:
+    virtual ~Handler() = default;
+    virtual void ProcessCaptureFrame(
+        ArrayView<float, kSeekAudioFrameSize> frame) = 0;
+    virtual void AnalyzeRenderFrame(
+        ArrayView<const float, kSeekAudioFrameSize> frame) = 0;
+    virtual void ApplyControl(int id, int value) = 0;
+  };
+
+  SeekAudioAsyncProcessor(
+      Handler* handler,
+      int lookahead_frames,
+      std::shared_ptr<SeekAudioScheduler> scheduler = nullptr);
+  ~SeekAudioAsyncProcessor() override;
+  SeekAudioAsyncProcessor(const SeekAudioAsyncProcessor&) = delete;
+  SeekAudioAsyncProcessor& operator=(const SeekAudioAsyncProcessor&) = delete;
+
+  int lookahead_frames() const { return lookahead_frames_; }
+  const SeekAudioScheduler* scheduler() const { return scheduler_.get(); }
+
+  // Queues `frame` for processing and replaces it with the processed frame
+  // queued `lookahead_frames()` calls earlier. Returns false if that result
+  // was not ready, in which case `frame` holds the delayed unprocessed input.
+  bool ProcessCapture(ArrayView<float, kSeekAudioFrameSize> frame);
+
+  // Unprocessed input of the frame last returned by ProcessCapture().
+  ArrayView<const float, kSeekAudioFrameSize> delayed_input() const {
+    return input_delay_[read_index_];
+  }
+
+  // Queues a far-end frame. Far-end and capture frames reach the engine in the
+  // order they were queued.
+  void AnalyzeRender(ArrayView<const float, kSeekAudioFrameSize> frame);
+
+  // Queues a call to Handler::ApplyControl().
+  void PostControl(int id, int value);
+
+  // Number of capture frames whose result was late since construction.
+  int num_late_frames() const { return num_late_frames_; }
+  // Number of requests dropped because the worker fell behind by more than
+  // the request ring capacity.
+  int num_dropped_requests() const { return num_dropped_requests_; }
+  // Time left between the completion of the last returned frame and its
+  // deadline, `lookahead_frames()` x 10 ms after it was queued. Negative
+  // when the frame was late.
+  int64_t deadline_slack_us() const { return deadline_slack_us_; }
+
+ private:
+  enum class RequestType { kCapture, kRender, kControl };
+  struct Request {
+    RequestType type;
+    int64_t sequence;
+    int64_t deadline_us;
+    int control_id;
+    int control_value;
+    Frame samples;
+  };
+  struct Result {
+    int64_t sequence;
+    int64_t slack_us;
+    Frame samples;
+  };
+
+  // SeekAudioScheduler::Stream implementation.
+  void RunPendingRequests() override;
+
+  void Run();
+  void Wake();
+  void HandleRequests();
+
+  Handler* const handler_;
+  const int lookahead_frames_;
+
+  // Capture thread state.
+  int64_t capture_sequence_ = 0;
+  std::vector<Frame> input_delay_;
+  size_t read_index_ = 0;
+  int num_late_frames_ = 0;
+  int num_dropped_requests_ = 0;
+  int64_t deadline_slack_us_ = 0;
+
+  SeekAudioSpscRing<Request> requests_;
+  SeekAudioSpscRing<Result> results_;
+  // Either `scheduler_` or the dedicated `worker_` runs the requests.
+  const std::shared_ptr<SeekAudioScheduler> scheduler_;
+  Event wakeup_;
+  std::atomic<bool> quit_{false};
+  PlatformThread worker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_ASYNC_PROCESSOR_H_
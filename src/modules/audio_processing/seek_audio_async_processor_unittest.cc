@@ -0,0 +1,153 @@
+// seek_audio_async_processor_unittest.cc
+#include "modules/audio_processing/seek_audio_async_processor.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Frame = SeekAudioAsyncProcessor::Frame;
+
+// Doubles the capture frames and records the order of the engine calls. The
+// recorded values are only read after the processor is destroyed.
+class FakeHandler : public SeekAudioAsyncProcessor::Handler {
+ public:
+  void ProcessCaptureFrame(
+      ArrayView<float, kSeekAudioFrameSize> frame) override {
+    calls.push_back(frame[0]);
+    for (float& sample : frame) {
+      sample *= 2.f;
+    }
+  }
+  void AnalyzeRenderFrame(
+      ArrayView<const float, kSeekAudioFrameSize> frame) override {
+    calls.push_back(-frame[0]);
+  }
+  void ApplyControl(int id, int value) override {
+    controls.push_back(id * 100 + value);
+  }
+
+  std::vector<float> calls;
+  std::vector<int> controls;
+};
+
+Frame ConstantFrame(float value) {
+  Frame frame;
+  frame.fill(value);
+  return frame;
+}
+
+}  // namespace
+
+TEST(SeekAudioAsyncProcessor, ReturnsDelayedFrames) {
+  constexpr int kLookahead = 3;
+  constexpr int kNumFrames = 200;
+  FakeHandler handler;
+  int num_processed = 0;
+  int num_dropped = 0;
+  {
+    SeekAudioAsyncProcessor processor(&handler, kLookahead);
+    EXPECT_EQ(processor.lookahead_frames(), kLookahead);
+    for (int k = 0; k < kNumFrames; ++k) {
+      Frame frame = ConstantFrame(k + 1);
+      const bool processed = processor.ProcessCapture(frame);
+      const float input = std::max(k + 1 - kLookahead, 0);
+      EXPECT_EQ(processor.delayed_input()[0], input);
+      // Either the processed or, if the worker was late, the raw input of
+      // the frame `kLookahead` calls earlier. Silence while priming.
+      EXPECT_EQ(frame[0], processed ? 2.f * input : input);
+      EXPECT_EQ(frame[kSeekAudioFrameSize - 1], frame[0]);
+      num_processed += processed;
+    }
+    EXPECT_EQ(processor.num_late_frames(),
+              kNumFrames - kLookahead - num_processed);
+    num_dropped = processor.num_dropped_requests();
+  }
+  // Late frames are processed too, so that the engine state stays complete.
+  // Only frames that did not fit in the request ring are skipped.
+  ASSERT_EQ(handler.calls.size(),
+            static_cast<size_t>(kNumFrames - num_dropped));
+  for (size_t k = 1; k < handler.calls.size(); ++k) {
+    EXPECT_GT(handler.calls[k], handler.calls[k - 1]);
+  }
+}
+
+TEST(SeekAudioAsyncProcessor, KeepsRequestOrder) {
+  FakeHandler handler;
+  {
+    SeekAudioAsyncProcessor processor(&handler, 1);
+    for (int k = 1; k <= 20; ++k) {
+      Frame render = ConstantFrame(k);
+      Frame capture = ConstantFrame(k);
+      processor.AnalyzeRender(render);
+      processor.PostControl(1, k);
+      processor.ProcessCapture(capture);
+    }
+  }
+  ASSERT_EQ(handler.calls.size(), 40u);
+  ASSERT_EQ(handler.controls.size(), 20u);
+  for (int k = 1; k <= 20; ++k) {
+    EXPECT_EQ(handler.calls[2 * k - 2], -k);
+    EXPECT_EQ(handler.calls[2 * k - 1], k);
+    EXPECT_EQ(handler.controls[k - 1], 100 + k);
+  }
+}
+
+TEST(SeekAudioAsyncProcessor, RunsPendingRequestsOnDestruction) {
+  FakeHandler handler;
+  {
+    SeekAudioAsyncProcessor processor(&handler, 2);
+    processor.PostControl(0, 35);
+  }
+  ASSERT_EQ(handler.controls.size(), 1u);
+  EXPECT_EQ(handler.controls[0], 35);
+}
+
+// Measures the capture thread cost of a frame with and without the worker,
+// for a handler that is about as expensive as a small neural network.
+TEST(SeekAudioAsyncProcessor, DISABLED_CaptureThreadBenchmark) {
+  constexpr int kNumFrames = 2000;
+  class BusyHandler : public SeekAudioAsyncProcessor::Handler {
+   public:
+    void ProcessCaptureFrame(
+        ArrayView<float, kSeekAudioFrameSize> frame) override {
+      for (int k = 0; k < 2000; ++k) {
+        for (float& sample : frame) {
+          sample = sample * 0.999f + 0.001f;
+        }
+      }
+    }
+    void AnalyzeRenderFrame(
+        ArrayView<const float, kSeekAudioFrameSize> frame) override {}
+    void ApplyControl(int id, int value) override {}
+  } handler;
+
+  Frame frame = ConstantFrame(1.f);
+  test::PerformanceTimer inline_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    inline_timer.StartTimer();
+    handler.ProcessCaptureFrame(frame);
+    inline_timer.StopTimer();
+  }
+
+  SeekAudioAsyncProcessor processor(&handler, 2);
+  test::PerformanceTimer async_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    async_timer.StartTimer();
+    processor.ProcessCapture(frame);
+    async_timer.StopTimer();
+  }
+
+  RTC_LOG(LS_INFO) << "SeekAudio capture thread cost: "
+                   << inline_timer.GetDurationAverage() << " us inline, "
+                   << async_timer.GetDurationAverage()
+                   << " us with worker, late frames: "
+                   << processor.num_late_frames();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,117 @@
+// seek_audio_band_bridge.cc
+#include "modules/audio_processing/seek_audio_band_bridge.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Lowest gain applied to the upper bands (about -30 dB).
+constexpr float kMinGain = 0.03f;
+// Frames whose lowband energy is below this level (about -80 dBFS at 160
+// samples) carry no information about the suppression and keep the gains.
+constexpr float kMinInputEnergy = 160.f * 3.3f * 3.3f;
+// Release rate towards higher gains per 10 ms frame. Attacks are immediate.
+constexpr float kReleaseRate = 0.2f;
+
+float GainFromEnergies(float input_energy, float output_energy) {
+  const float gain = std::sqrt(output_energy / input_energy);
+  return std::min(std::max(gain, kMinGain), 1.f);
+}
+
+}  // namespace
+
+SeekAudioBandBridge::SeekAudioBandBridge() {
+  Reset();
+}
+
+void SeekAudioBandBridge::Reset() {
+  gains_.fill(1.f);
+  applied_gains_.fill(1.f);
+  last_input_sample_ = 0.f;
+  last_output_sample_ = 0.f;
+}
+
+void SeekAudioBandBridge::Update(ArrayView<const float> lowband_in,
+                                 ArrayView<const float> lowband_out) {
+  RTC_DCHECK_EQ(lowband_in.size(), lowband_out.size());
+  if (lowband_in.empty()) {
+    return;
+  }
+
+  // The first difference emphasizes the 4-8 kHz content of the lowband, which
+  // is the best predictor of what the engine would have done above 8 kHz.
+  float input_energy = 0.f;
+  float output_energy = 0.f;
+  float input_hp_energy = 0.f;
+  float output_hp_energy = 0.f;
+  float last_in = last_input_sample_;
+  float last_out = last_output_sample_;
+  for (size_t k = 0; k < lowband_in.size(); ++k) {
+    const float in = lowband_in[k];
+    const float out = lowband_out[k];
+    const float in_hp = in - last_in;
+    const float out_hp = out - last_out;
+    input_energy += in * in;
+    output_energy += out * out;
+    input_hp_energy += in_hp * in_hp;
+    output_hp_energy += out_hp * out_hp;
+    last_in = in;
+    last_out = out;
+  }
+  last_input_sample_ = last_in;
+  last_output_sample_ = last_out;
+
+  if (input_energy < kMinInputEnergy) {
+    return;
+  }
+
+  std::array<float, kMaxNumBands> targets;
+  targets[0] = GainFromEnergies(input_energy, output_energy);
+  targets[1] = input_hp_energy > 0.f
+                   ? GainFromEnergies(input_hp_energy, output_hp_energy)
+                   : targets[0];
+  // The 16-24 kHz band is furthest from the measurement, use the more
+  // conservative of the two estimates.
+  targets[2] = std::min(targets[0], targets[1]);
+
+  for (size_t band = 0; band < kMaxNumBands; ++band) {
+    if (targets[band] < gains_[band]) {
+      gains_[band] = targets[band];
+    } else {
+      gains_[band] += kReleaseRate * (targets[band] - gains_[band]);
+    }
+  }
+}
+
+void SeekAudioBandBridge::ApplyToUpperBands(float* const* bands,
+                                            size_t num_bands,
+                                            size_t num_frames_per_band) {
+  RTC_DCHECK_LE(num_bands, kMaxNumBands);
+  for (size_t band = 1; band < num_bands; ++band) {
+    const float start_gain = applied_gains_[band];
+    const float end_gain = gains_[band];
+    float* data = bands[band];
+    if (start_gain == end_gain) {
+      if (end_gain != 1.f) {
+        for (size_t k = 0; k < num_frames_per_band; ++k) {
+          data[k] *= end_gain;
+        }
+      }
+    } else {
+      const float step = (end_gain - start_gain) / num_frames_per_band;
+      float gain = start_gain;
+      for (size_t k = 0; k < num_frames_per_band; ++k) {
+        gain += step;
+        data[k] *= gain;
+      }
+    }
+    applied_gains_[band] = end_gain;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,50 @@
+// seek_audio_band_bridge.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_BAND_BRIDGE_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_BAND_BRIDGE_H_
+
+#include <array>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Extends the 0-8 kHz processing of the SeekAudio engines to the upper split
+// bands at 32 and 48 kHz. The suppression that the engine applied to the
+// lowband is measured from its input and output and propagated as a smoothed
+// per-band gain, so the upper bands cost a single multiply per sample.
+class SeekAudioBandBridge {
+ public:
+  static constexpr size_t kMaxNumBands = 3;
+
+  SeekAudioBandBridge();
+  SeekAudioBandBridge(const SeekAudioBandBridge&) = delete;
+  SeekAudioBandBridge& operator=(const SeekAudioBandBridge&) = delete;
+
+  // Resets the gains to unity.
+  void Reset();
+
+  // Updates the band gains from one lowband frame before (`lowband_in`) and
+  // after (`lowband_out`) engine processing.
+  void Update(ArrayView<const float> lowband_in,
+              ArrayView<const float> lowband_out);
+
+  // Applies the gains to `bands[1]` ... `bands[num_bands - 1]`, ramping from
+  // the gains of the previous frame to avoid discontinuities.
+  void ApplyToUpperBands(float* const* bands,
+                         size_t num_bands,
+                         size_t num_frames_per_band);
+
+  // Returns the current gain of `band`. The gain of band 0 is the broadband
+  // lowband estimate and is never applied.
+  float gain(size_t band) const { return gains_[band]; }
+
+ private:
+  std::array<float, kMaxNumBands> gains_;
+  std::array<float, kMaxNumBands> applied_gains_;
+  float last_input_sample_ = 0.f;
+  float last_output_sample_ = 0.f;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_BAND_BRIDGE_H_
@@ -0,0 +1,126 @@
+// seek_audio_band_bridge_unittest.cc
+#include "modules/audio_processing/seek_audio_band_bridge.h"
+
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumBands = 3;
+using Frame = std::array<float, kSeekAudioFrameSize>;
+
+void FillNoiseLike(size_t seed, Frame& frame) {
+  uint32_t state = 12345u + seed;
+  for (float& sample : frame) {
+    state = state * 1664525u + 1013904223u;
+    sample = static_cast<float>(static_cast<int32_t>(state >> 16) - 32768) /
+             8.f;
+  }
+}
+
+// Runs `num_frames` frames where the engine output is `engine_gain` times its
+// input and returns the upper bands of the last frame.
+std::array<Frame, kNumBands> RunBridge(SeekAudioBandBridge& bridge,
+                                       float engine_gain,
+                                       int num_frames) {
+  std::array<Frame, kNumBands> bands;
+  for (int frame = 0; frame < num_frames; ++frame) {
+    Frame lowband_in;
+    FillNoiseLike(frame, lowband_in);
+    Frame lowband_out = lowband_in;
+    for (float& sample : lowband_out) {
+      sample *= engine_gain;
+    }
+    for (Frame& band : bands) {
+      band.fill(1000.f);
+    }
+    bridge.Update(lowband_in, lowband_out);
+    std::array<float*, kNumBands> band_ptrs = {bands[0].data(),
+                                                bands[1].data(),
+                                                bands[2].data()};
+    bridge.ApplyToUpperBands(band_ptrs.data(), kNumBands,
+                             kSeekAudioFrameSize);
+  }
+  return bands;
+}
+
+}  // namespace
+
+TEST(SeekAudioBandBridge, TransparentEngineLeavesUpperBandsUntouched) {
+  SeekAudioBandBridge bridge;
+  auto bands = RunBridge(bridge, 1.f, 10);
+  for (size_t band = 0; band < kNumBands; ++band) {
+    for (float sample : bands[band]) {
+      EXPECT_EQ(1000.f, sample);
+    }
+  }
+}
+
+TEST(SeekAudioBandBridge, SuppressionIsPropagatedToUpperBands) {
+  SeekAudioBandBridge bridge;
+  auto bands = RunBridge(bridge, 0.1f, 10);
+  for (float sample : bands[0]) {
+    EXPECT_EQ(1000.f, sample);
+  }
+  for (size_t band = 1; band < kNumBands; ++band) {
+    EXPECT_NEAR(0.1f, bridge.gain(band), 0.01f);
+    for (float sample : bands[band]) {
+      EXPECT_NEAR(100.f, sample, 10.f);
+    }
+  }
+}
+
+TEST(SeekAudioBandBridge, GainsRecoverAfterSuppression) {
+  SeekAudioBandBridge bridge;
+  RunBridge(bridge, 0.1f, 10);
+  RunBridge(bridge, 1.f, 50);
+  for (size_t band = 1; band < kNumBands; ++band) {
+    EXPECT_NEAR(1.f, bridge.gain(band), 0.01f);
+  }
+}
+
+TEST(SeekAudioBandBridge, SilenceKeepsGains) {
+  SeekAudioBandBridge bridge;
+  RunBridge(bridge, 0.1f, 10);
+  const float gain = bridge.gain(1);
+  Frame silence;
+  silence.fill(0.f);
+  for (int frame = 0; frame < 10; ++frame) {
+    bridge.Update(silence, silence);
+  }
+  EXPECT_EQ(gain, bridge.gain(1));
+}
+
+TEST(SeekAudioBandBridge, DISABLED_Benchmark) {
+  SeekAudioBandBridge bridge;
+  std::array<Frame, kNumBands> bands;
+  Frame lowband_in;
+  Frame lowband_out;
+  std::array<float*, kNumBands> band_ptrs = {bands[0].data(), bands[1].data(),
+                                              bands[2].data()};
+  constexpr int kNumFrames = 100000;
+  test::PerformanceTimer perf_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    FillNoiseLike(k, lowband_in);
+    lowband_out = lowband_in;
+    lowband_out[k % kSeekAudioFrameSize] *= 0.5f;
+    for (Frame& band : bands) {
+      band = lowband_in;
+    }
+    perf_timer.StartTimer();
+    bridge.Update(lowband_in, lowband_out);
+    bridge.ApplyToUpperBands(band_ptrs.data(), kNumBands, kSeekAudioFrameSize);
+    perf_timer.StopTimer();
+  }
+  RTC_LOG(LS_INFO) << "48 kHz band bridge: " << perf_timer.GetDurationAverage()
+                   << " +/- " << perf_timer.GetDurationStandardDeviation()
+                   << " us per 10 ms frame";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,19 @@
+// seek_audio_common.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_COMMON_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_COMMON_H_
+
+#include <stddef.h>
+
+namespace webrtc {
+
+// The SeekAudio engines only run at 16 kHz on 10 ms frames.
+constexpr int kSeekAudioSampleRateHz = 16000;
+constexpr size_t kSeekAudioFrameSize = 160;
+
+// Number of samples in a 10 ms frame at 8 kHz, which is upsampled before being
+// fed to the engines.
+constexpr size_t kSeekAudioNarrowbandFrameSize = kSeekAudioFrameSize / 2;
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_COMMON_H_
@@ -0,0 +1,163 @@
+// seek_audio_delay_aligner.cc
+#include "modules/audio_processing/seek_audio_delay_aligner.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "modules/audio_processing/logging/apm_data_dumper.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// Unread far-end above which the far-end is assumed to have jumped ahead of
+// the capture, like AEC3 detects excess render blocks.
+constexpr int kMaxUnreadRenderBlocks = 8;
+
+std::atomic<int> instance_count(0);
+
+}  // namespace
+
+constexpr int SeekAudioDelayAligner::kHeadroomSamples;
+constexpr int SeekAudioDelayAligner::kHysteresisSamples;
+
+SeekAudioDelayAligner::SeekAudioDelayAligner()
+    : SeekAudioDelayAligner(EchoCanceller3Config()) {}
+
+SeekAudioDelayAligner::SeekAudioDelayAligner(
+    const EchoCanceller3Config& config)
+    : sub_block_size_(
+          static_cast<int>(kBlockSize / config.delay.down_sampling_factor)),
+      max_delay_samples_(static_cast<int>(
+          GetDownSampledBufferSize(config.delay.down_sampling_factor,
+                                   config.delay.num_filters) *
+          config.delay.down_sampling_factor)),
+      data_dumper_(new ApmDataDumper(instance_count.fetch_add(1) + 1)),
+      delay_estimator_(data_dumper_.get(), config, /*num_capture_channels=*/1),
+      render_decimator_(config.delay.down_sampling_factor),
+      render_buffer_(GetDownSampledBufferSize(config.delay.down_sampling_factor,
+                                              config.delay.num_filters)),
+      render_ds_(sub_block_size_, 0.f),
+      capture_block_(/*num_bands=*/1, /*num_channels=*/1),
+      delay_line_(max_delay_samples_ + kSeekAudioFrameSize, 0.f) {
+  RTC_DCHECK_EQ(kBlockSize % config.delay.down_sampling_factor, 0);
+  Reset();
+}
+
+SeekAudioDelayAligner::~SeekAudioDelayAligner() = default;
+
+void SeekAudioDelayAligner::Reset() {
+  delay_estimator_.Reset(/*reset_delay_confidence=*/true);
+  std::fill(render_buffer_.buffer.begin(), render_buffer_.buffer.end(), 0.f);
+  render_buffer_.read = render_buffer_.write;
+  render_blocker_.size = 0;
+  capture_blocker_.size = 0;
+  estimated_delay_samples_ = std::nullopt;
+  std::fill(delay_line_.begin(), delay_line_.end(), 0.f);
+  delay_line_write_ = 0;
+  delay_samples_ = 0;
+  pending_delay_samples_ = 0;
+}
+
+template <typename Callback>
+void SeekAudioDelayAligner::ForEachBlock(ArrayView<const float> frame,
+                                         Blocker& blocker,
+                                         Callback callback) {
+  size_t offset = 0;
+  while (offset < frame.size()) {
+    const size_t num_samples =
+        std::min(kBlockSize - blocker.size, frame.size() - offset);
+    std::copy(frame.begin() + offset, frame.begin() + offset + num_samples,
+              blocker.block.begin() + blocker.size);
+    blocker.size += num_samples;
+    offset += num_samples;
+    if (blocker.size == kBlockSize) {
+      callback(ArrayView<const float, kBlockSize>(blocker.block));
+      blocker.size = 0;
+    }
+  }
+}
+
+void SeekAudioDelayAligner::ProcessRender(
+    ArrayView<float, kSeekAudioFrameSize> frame) {
+  ForEachBlock(frame, render_blocker_,
+               [this](ArrayView<const float, kBlockSize> block) {
+                 InsertRenderBlock(block);
+               });
+
+  const size_t size = delay_line_.size();
+  for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+    delay_line_[(delay_line_write_ + k) % size] = frame[k];
+  }
+  auto delayed = [&](int delay, size_t k) {
+    return delay_line_[(delay_line_write_ + size + k - delay) % size];
+  };
+  if (pending_delay_samples_ != delay_samples_) {
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      const float weight = (k + 1) / static_cast<float>(kSeekAudioFrameSize);
+      frame[k] = (1.f - weight) * delayed(delay_samples_, k) +
+                 weight * delayed(pending_delay_samples_, k);
+    }
+    delay_samples_ = pending_delay_samples_;
+  } else if (delay_samples_ > 0) {
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      frame[k] = delayed(delay_samples_, k);
+    }
+  }
+  delay_line_write_ = (delay_line_write_ + kSeekAudioFrameSize) % size;
+}
+
+void SeekAudioDelayAligner::AnalyzeCapture(
+    ArrayView<const float, kSeekAudioFrameSize> frame) {
+  ForEachBlock(frame, capture_blocker_,
+               [this](ArrayView<const float, kBlockSize> block) {
+                 AnalyzeCaptureBlock(block);
+               });
+
+  DownsampledRenderBuffer& b = render_buffer_;
+  const int unread_samples = (b.size + b.read - b.write) % b.size;
+  if (unread_samples > kMaxUnreadRenderBlocks * sub_block_size_) {
+    b.read = b.write;
+    delay_estimator_.Reset(/*reset_delay_confidence=*/false);
+  }
+}
+
+void SeekAudioDelayAligner::InsertRenderBlock(
+    ArrayView<const float, kBlockSize> block) {
+  // Newest samples first, at decreasing indices, see RenderDelayBuffer.
+  DownsampledRenderBuffer& b = render_buffer_;
+  b.UpdateWriteIndex(-sub_block_size_);
+  render_decimator_.Decimate(block, render_ds_);
+  std::copy(render_ds_.rbegin(), render_ds_.rend(), b.buffer.begin() + b.write);
+}
+
+void SeekAudioDelayAligner::AnalyzeCaptureBlock(
+    ArrayView<const float, kBlockSize> block) {
+  // Points the read index at the far-end block of the same time, unless the
+  // far-end has run dry.
+  DownsampledRenderBuffer& b = render_buffer_;
+  if (b.read != b.write) {
+    b.UpdateReadIndex(-sub_block_size_);
+  }
+
+  std::copy(block.begin(), block.end(), capture_block_.begin(0, 0));
+  std::optional<DelayEstimate> estimate =
+      delay_estimator_.EstimateDelay(render_buffer_, capture_block_);
+  if (!estimate) {
+    return;
+  }
+  estimated_delay_samples_ = static_cast<int>(estimate->delay);
+  if (estimate->quality != DelayEstimate::Quality::kRefined) {
+    return;
+  }
+  const int target = std::clamp(*estimated_delay_samples_ - kHeadroomSamples,
+                                0, max_delay_samples_);
+  if (std::abs(target - pending_delay_samples_) >= kHysteresisSamples) {
+    pending_delay_samples_ = target;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,102 @@
+// seek_audio_delay_aligner.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_DELAY_ALIGNER_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_DELAY_ALIGNER_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/decimator.h"
+#include "modules/audio_processing/aec3/downsampled_render_buffer.h"
+#include "modules/audio_processing/aec3/echo_path_delay_estimator.h"
+#include "modules/audio_processing/seek_audio_common.h"
+
+namespace webrtc {
+
+class ApmDataDumper;
+
+// Pre-delays the 16 kHz far-end reference of the SeekAudio AEC by the echo
+// path delay, so that the engine only has to cover a short, fixed search
+// window instead of the render/capture skew of the audio device.
+//
+// The delay is estimated by the AEC3 EchoPathDelayEstimator, fed in 64 sample
+// blocks the same way as by the AEC3 RenderDelayBuffer, from the far-end as
+// passed to the engine and the first capture channel. Only refined estimates
+// are applied, less kHeadroomSamples so that the engine still sees a causal
+// reference, and changes of the delay are crossfaded over one frame.
+//
+// The far-end frames of a capture frame must be processed before it, which is
+// how APM feeds the AEC.
+class SeekAudioDelayAligner {
+ public:
+  // Delay left to the engine.
+  static constexpr int kHeadroomSamples = 2 * kBlockSize;
+  // Smaller changes of the estimate are not applied.
+  static constexpr int kHysteresisSamples = kBlockSize / 2;
+
+  SeekAudioDelayAligner();
+  explicit SeekAudioDelayAligner(const EchoCanceller3Config& config);
+  ~SeekAudioDelayAligner();
+  SeekAudioDelayAligner(const SeekAudioDelayAligner&) = delete;
+  SeekAudioDelayAligner& operator=(const SeekAudioDelayAligner&) = delete;
+
+  // Analyzes the far-end `frame` and replaces it with the far-end delayed by
+  // delay_samples().
+  void ProcessRender(ArrayView<float, kSeekAudioFrameSize> frame);
+  // Analyzes a frame of the first capture channel.
+  void AnalyzeCapture(ArrayView<const float, kSeekAudioFrameSize> frame);
+
+  // Delay applied to the far-end.
+  int delay_samples() const { return delay_samples_; }
+  // Last echo path delay estimate, if any.
+  std::optional<int> estimated_delay_samples() const {
+    return estimated_delay_samples_;
+  }
+  int max_delay_samples() const { return max_delay_samples_; }
+
+  // Forgets the estimate and the buffered signals.
+  void Reset();
+
+ private:
+  // Collects 10 ms frames into 64 sample blocks.
+  struct Blocker {
+    std::array<float, kBlockSize> block;
+    size_t size = 0;
+  };
+  template <typename Callback>
+  static void ForEachBlock(ArrayView<const float> frame,
+                           Blocker& blocker,
+                           Callback callback);
+
+  void InsertRenderBlock(ArrayView<const float, kBlockSize> block);
+  void AnalyzeCaptureBlock(ArrayView<const float, kBlockSize> block);
+
+  const int sub_block_size_;
+  const int max_delay_samples_;
+  std::unique_ptr<ApmDataDumper> data_dumper_;
+  EchoPathDelayEstimator delay_estimator_;
+  Decimator render_decimator_;
+  DownsampledRenderBuffer render_buffer_;
+  std::vector<float> render_ds_;
+  Block capture_block_;
+  Blocker render_blocker_;
+  Blocker capture_blocker_;
+  std::optional<int> estimated_delay_samples_;
+
+  // Far-end history of max_delay_samples() + one frame.
+  std::vector<float> delay_line_;
+  size_t delay_line_write_ = 0;
+  int delay_samples_ = 0;
+  int pending_delay_samples_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_DELAY_ALIGNER_H_
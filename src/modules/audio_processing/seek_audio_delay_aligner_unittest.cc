@@ -0,0 +1,100 @@
+// seek_audio_delay_aligner_unittest.cc
+#include "modules/audio_processing/seek_audio_delay_aligner.h"
+
+#include <array>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumFrames = 400;
+
+// Far-end noise and its echo, delayed by `echo_delay` samples.
+class EchoPath {
+ public:
+  explicit EchoPath(int echo_delay)
+      : echo_delay_(echo_delay), far_end_(echo_delay + kSeekAudioFrameSize) {}
+
+  void Next(std::array<float, kSeekAudioFrameSize>& far_end,
+            std::array<float, kSeekAudioFrameSize>& capture) {
+    std::copy(far_end_.begin() + kSeekAudioFrameSize, far_end_.end(),
+              far_end_.begin());
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      far_end[k] = random_.Gaussian(0.f, 2000.f);
+      far_end_[echo_delay_ + k] = far_end[k];
+      capture[k] = 0.5f * far_end_[k];
+    }
+  }
+
+ private:
+  Random random_{42};
+  const size_t echo_delay_;
+  std::vector<float> far_end_;
+};
+
+}  // namespace
+
+TEST(SeekAudioDelayAligner, PassesFarEndThroughUntilEstimated) {
+  SeekAudioDelayAligner aligner;
+  std::array<float, kSeekAudioFrameSize> frame;
+  frame.fill(1000.f);
+  const auto original = frame;
+  aligner.ProcessRender(frame);
+  EXPECT_EQ(frame, original);
+  EXPECT_EQ(aligner.delay_samples(), 0);
+  EXPECT_FALSE(aligner.estimated_delay_samples());
+}
+
+TEST(SeekAudioDelayAligner, DelaysFarEndByEchoPathDelayLessHeadroom) {
+  for (int echo_delay : {300, 1000, 2500}) {
+    SCOPED_TRACE(echo_delay);
+    SeekAudioDelayAligner aligner;
+    EchoPath echo_path(echo_delay);
+    std::vector<float> far_end_history;
+    std::array<float, kSeekAudioFrameSize> far_end;
+    std::array<float, kSeekAudioFrameSize> capture;
+    for (int k = 0; k < kNumFrames; ++k) {
+      echo_path.Next(far_end, capture);
+      far_end_history.insert(far_end_history.end(), far_end.begin(),
+                             far_end.end());
+      aligner.ProcessRender(far_end);
+      aligner.AnalyzeCapture(capture);
+    }
+
+    // Like in AEC3 the estimate errs on the early side.
+    ASSERT_TRUE(aligner.estimated_delay_samples());
+    const int estimate = *aligner.estimated_delay_samples();
+    EXPECT_LE(estimate, echo_delay);
+    EXPECT_GT(estimate, echo_delay - 2 * static_cast<int>(kBlockSize));
+    const int delay = aligner.delay_samples();
+    EXPECT_NEAR(delay, estimate - SeekAudioDelayAligner::kHeadroomSamples,
+                SeekAudioDelayAligner::kHysteresisSamples);
+
+    // The last far-end frame passed on is the delayed far-end.
+    const size_t end = far_end_history.size() - delay;
+    for (size_t k = 0; k < kSeekAudioFrameSize; ++k) {
+      ASSERT_EQ(far_end[k], far_end_history[end - kSeekAudioFrameSize + k]);
+    }
+  }
+}
+
+TEST(SeekAudioDelayAligner, ResetForgetsDelay) {
+  SeekAudioDelayAligner aligner;
+  EchoPath echo_path(1000);
+  std::array<float, kSeekAudioFrameSize> far_end;
+  std::array<float, kSeekAudioFrameSize> capture;
+  for (int k = 0; k < kNumFrames; ++k) {
+    echo_path.Next(far_end, capture);
+    aligner.ProcessRender(far_end);
+    aligner.AnalyzeCapture(capture);
+  }
+  EXPECT_GT(aligner.delay_samples(), 0);
+  aligner.Reset();
+  EXPECT_EQ(aligner.delay_samples(), 0);
+  EXPECT_FALSE(aligner.estimated_delay_samples());
+}
+
+}  // namespace webrtc
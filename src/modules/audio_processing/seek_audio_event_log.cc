@@ -0,0 +1,154 @@
+// seek_audio_event_log.cc
+#include "modules/audio_processing/seek_audio_event_log.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+constexpr int64_t kNeverLoggedUs = -1;
+
+const char* LevelPrefix(SeekAudioEvent event) {
+  switch (event) {
+    case SeekAudioEvent::kPowerChange:
+      return "[INFO]";
+    default:
+      return "[WARN]";
+  }
+}
+
+void WriteToPlatformLog(const char* text) {
+#ifdef __ANDROID__
+  __android_log_write(ANDROID_LOG_INFO, "SEEKAUDIO", text);
+#else
+  printf("%s\n", text);
+#endif
+}
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+constexpr int64_t SeekAudioEventCounters::kLogIntervalUs;
+
+SeekAudioEventCounters::SeekAudioEventCounters() {
+  for (size_t k = 0; k < kNumEvents; ++k) {
+    counts_[k].store(0, std::memory_order_relaxed);
+    last_log_us_[k].store(kNeverLoggedUs, std::memory_order_relaxed);
+  }
+}
+
+int SeekAudioEventCounters::Add(SeekAudioEvent event) {
+  return counts_[Index(event)].fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+bool SeekAudioEventCounters::ShouldLog(SeekAudioEvent event, int64_t now_us) {
+  std::atomic<int64_t>& last_log_us = last_log_us_[Index(event)];
+  int64_t last_us = last_log_us.load(std::memory_order_relaxed);
+  if (last_us != kNeverLoggedUs && now_us - last_us < kLogIntervalUs) {
+    return false;
+  }
+  // Only one of concurrent callers logs.
+  return last_log_us.compare_exchange_strong(last_us, now_us,
+                                             std::memory_order_relaxed);
+}
+
+SeekAudioEventLog::SeekAudioEventLog(size_t capacity)
+    : mask_(RoundUpToPowerOfTwo(capacity) - 1),
+      slots_(new Slot[mask_ + 1]) {
+  for (size_t k = 0; k <= mask_; ++k) {
+    slots_[k].sequence.store(k, std::memory_order_relaxed);
+  }
+}
+
+SeekAudioEventLog::~SeekAudioEventLog() = default;
+
+SeekAudioEventLog& SeekAudioEventLog::Global() {
+  // Leaked along with its thread, which runs until the process exits.
+  struct GlobalLog {
+    SeekAudioEventLog log{256};
+    PlatformThread thread;
+  };
+  static GlobalLog* const global = [] {
+    auto* global = new GlobalLog();
+    SeekAudioEventLog* log = &global->log;
+    global->thread = PlatformThread::SpawnJoinable(
+        [log] {
+          Event wakeup;
+          while (true) {
+            wakeup.Wait(TimeDelta::Millis(100));
+            log->Drain(WriteToPlatformLog);
+          }
+        },
+        "SeekAudioLog", ThreadAttributes().SetPriority(ThreadPriority::kLow));
+    return global;
+  }();
+  return global->log;
+}
+
+void SeekAudioEventLog::Post(SeekAudioEvent event,
+                             int count,
+                             const char* format,
+                             ...) {
+  size_t position = write_position_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    slot = &slots_[position & mask_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (difference == 0) {
+      if (write_position_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (difference < 0) {
+      num_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      position = write_position_.load(std::memory_order_relaxed);
+    }
+  }
+
+  int length = snprintf(slot->text, kMessageSize, "%s ", LevelPrefix(event));
+  va_list args;
+  va_start(args, format);
+  length += vsnprintf(slot->text + length, kMessageSize - length, format, args);
+  va_end(args);
+  if (length < static_cast<int>(kMessageSize)) {
+    snprintf(slot->text + length, kMessageSize - length, " (#%d)", count);
+  }
+  slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+size_t SeekAudioEventLog::Drain(FunctionView<void(const char*)> sink) {
+  size_t num_messages = 0;
+  while (true) {
+    Slot& slot = slots_[read_position_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != read_position_ + 1) {
+      return num_messages;
+    }
+    sink(slot.text);
+    slot.sequence.store(read_position_ + mask_ + 1, std::memory_order_release);
+    ++read_position_;
+    ++num_messages;
+  }
+}
+
+}  // namespace webrtc
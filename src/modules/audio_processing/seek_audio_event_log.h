@@ -0,0 +1,129 @@
+// seek_audio_event_log.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_EVENT_LOG_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_EVENT_LOG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "api/function_view.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+// Log messages of per-frame events are only formatted in builds with DCHECKs,
+// the counters are always kept.
+#ifndef SEEK_AUDIO_EVENT_LOG_IS_ON
+#define SEEK_AUDIO_EVENT_LOG_IS_ON RTC_DCHECK_IS_ON
+#endif
+
+namespace webrtc {
+
+// Events of the SeekAudio modules that may occur on every frame.
+enum class SeekAudioEvent {
+  kNotReady,      // Processing requested before a successful initialization.
+  kInvalidFrame,  // Frame of an unsupported size.
+  kEngineError,   // Engine call that returned an error.
+  kPowerChange,   // Engine power level set.
+  kHowling,       // Frame with a howling probability above 0.9.
+  kNumEvents
+};
+
+// Event counts of one module. Lock-free, since events are reported from the
+// capture, render and worker threads.
+class SeekAudioEventCounters {
+ public:
+  // Minimum time between two log messages of the same event.
+  static constexpr int64_t kLogIntervalUs = 1000000;
+
+  SeekAudioEventCounters();
+
+  // Counts `event` and returns its count so far.
+  int Add(SeekAudioEvent event);
+  int count(SeekAudioEvent event) const {
+    return counts_[Index(event)].load(std::memory_order_relaxed);
+  }
+
+  // Returns true if `event` may be logged at `now_us`, at most once per
+  // kLogIntervalUs.
+  bool ShouldLog(SeekAudioEvent event, int64_t now_us);
+
+ private:
+  static size_t Index(SeekAudioEvent event) {
+    RTC_DCHECK(event < SeekAudioEvent::kNumEvents);
+    return static_cast<size_t>(event);
+  }
+
+  static constexpr size_t kNumEvents =
+      static_cast<size_t>(SeekAudioEvent::kNumEvents);
+  std::array<std::atomic<int>, kNumEvents> counts_;
+  std::array<std::atomic<int64_t>, kNumEvents> last_log_us_;
+};
+
+// Process-wide log of the SeekAudio modules. Messages are formatted into a
+// fixed-size, lock-free ring and written to the platform log by a background
+// thread, so that the audio threads neither allocate nor wait for stdout.
+// Messages that do not fit are dropped.
+class SeekAudioEventLog {
+ public:
+  static constexpr size_t kMessageSize = 192;
+
+  // `capacity` is rounded up to a power of two.
+  explicit SeekAudioEventLog(size_t capacity);
+  ~SeekAudioEventLog();
+  SeekAudioEventLog(const SeekAudioEventLog&) = delete;
+  SeekAudioEventLog& operator=(const SeekAudioEventLog&) = delete;
+
+  // The log drained to the platform log every 100 ms.
+  static SeekAudioEventLog& Global();
+
+  // Any thread. Formats one message about the `count`th `event`.
+  void Post(SeekAudioEvent event, int count, const char* format, ...)
+#if defined(__GNUC__)
+      __attribute__((format(printf, 4, 5)))
+#endif
+      ;
+
+  // Passes the queued messages, oldest first, to `sink`. One thread at a time.
+  size_t Drain(FunctionView<void(const char*)> sink);
+
+  int num_dropped() const {
+    return num_dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    // Bounded multi-producer ring: a slot is free for position p when its
+    // sequence is p, and holds the message of position p when it is p + 1.
+    std::atomic<size_t> sequence;
+    char text[kMessageSize];
+  };
+
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<size_t> write_position_{0};
+  alignas(64) size_t read_position_ = 0;
+  std::atomic<int> num_dropped_{0};
+};
+
+// Counts `event` in `counters`. In builds with the event log on, the message
+// given by the printf-style arguments is also logged, at most once per second
+// and event, along with the event count.
+#if SEEK_AUDIO_EVENT_LOG_IS_ON
+#define SEEK_AUDIO_EVENT(counters, event, ...)                             \
+  do {                                                                     \
+    const int seek_audio_event_count = (counters).Add(event);              \
+    if ((counters).ShouldLog(event, ::webrtc::TimeMicros())) {             \
+      ::webrtc::SeekAudioEventLog::Global().Post(                          \
+          event, seek_audio_event_count, __VA_ARGS__);                     \
+    }                                                                      \
+  } while (0)
+#else
+#define SEEK_AUDIO_EVENT(counters, event, ...) (void)(counters).Add(event)
+#endif
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_EVENT_LOG_H_
@@ -0,0 +1,125 @@
+// seek_audio_event_log_unittest.cc
+#include "modules/audio_processing/seek_audio_event_log.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::vector<std::string> DrainMessages(SeekAudioEventLog& log) {
+  std::vector<std::string> messages;
+  log.Drain([&](const char* text) { messages.push_back(text); });
+  return messages;
+}
+
+}  // namespace
+
+TEST(SeekAudioEventCounters, CountsEvents) {
+  SeekAudioEventCounters counters;
+  EXPECT_EQ(counters.Add(SeekAudioEvent::kEngineError), 1);
+  EXPECT_EQ(counters.Add(SeekAudioEvent::kEngineError), 2);
+  EXPECT_EQ(counters.Add(SeekAudioEvent::kHowling), 1);
+  EXPECT_EQ(counters.count(SeekAudioEvent::kEngineError), 2);
+  EXPECT_EQ(counters.count(SeekAudioEvent::kHowling), 1);
+  EXPECT_EQ(counters.count(SeekAudioEvent::kNotReady), 0);
+}
+
+TEST(SeekAudioEventCounters, LogsEachEventAtMostOncePerInterval) {
+  constexpr int64_t kIntervalUs = SeekAudioEventCounters::kLogIntervalUs;
+  SeekAudioEventCounters counters;
+  EXPECT_TRUE(counters.ShouldLog(SeekAudioEvent::kHowling, 0));
+  EXPECT_FALSE(counters.ShouldLog(SeekAudioEvent::kHowling, 1));
+  EXPECT_FALSE(counters.ShouldLog(SeekAudioEvent::kHowling, kIntervalUs - 1));
+  // Other events are limited independently.
+  EXPECT_TRUE(counters.ShouldLog(SeekAudioEvent::kNotReady, 1));
+  EXPECT_TRUE(counters.ShouldLog(SeekAudioEvent::kHowling, kIntervalUs));
+  EXPECT_FALSE(counters.ShouldLog(SeekAudioEvent::kHowling, kIntervalUs + 1));
+}
+
+TEST(SeekAudioEventLog, DrainsMessagesInOrder) {
+  SeekAudioEventLog log(4);
+  log.Post(SeekAudioEvent::kEngineError, 3, "error %d", -1);
+  log.Post(SeekAudioEvent::kPowerChange, 1, "level %d", 2);
+  EXPECT_EQ(DrainMessages(log),
+            (std::vector<std::string>{"[WARN] error -1 (#3)",
+                                      "[INFO] level 2 (#1)"}));
+  EXPECT_TRUE(DrainMessages(log).empty());
+}
+
+TEST(SeekAudioEventLog, TruncatesLongMessages) {
+  SeekAudioEventLog log(1);
+  const std::string long_text(2 * SeekAudioEventLog::kMessageSize, 'x');
+  log.Post(SeekAudioEvent::kHowling, 1, "%s", long_text.c_str());
+  std::vector<std::string> messages = DrainMessages(log);
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].size(), SeekAudioEventLog::kMessageSize - 1);
+}
+
+TEST(SeekAudioEventLog, DropsAndCountsMessagesWhenFull) {
+  SeekAudioEventLog log(3);  // Rounded up to 4.
+  for (int k = 0; k < 6; ++k) {
+    log.Post(SeekAudioEvent::kHowling, k, "message");
+  }
+  EXPECT_EQ(log.num_dropped(), 2);
+  EXPECT_EQ(DrainMessages(log).size(), 4u);
+  // The slots are reused once drained.
+  log.Post(SeekAudioEvent::kHowling, 6, "message");
+  EXPECT_EQ(DrainMessages(log),
+            std::vector<std::string>{"[WARN] message (#6)"});
+}
+
+TEST(SeekAudioEventLog, KeepsOrderOfEachProducer) {
+  constexpr int kNumThreads = 3;
+  constexpr int kNumMessages = 1000;
+  SeekAudioEventLog log(16);
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kNumThreads; ++t) {
+    producers.emplace_back([&log, t] {
+      for (int k = 0; k < kNumMessages; ++k) {
+        while (true) {
+          const int num_dropped = log.num_dropped();
+          log.Post(SeekAudioEvent::kHowling, k, "%d", t);
+          if (log.num_dropped() == num_dropped) {
+            break;
+          }
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(kNumThreads, 0);
+  int num_received = 0;
+  // Retried posts may be counted as dropped by another producer, so the
+  // drain stops once every message arrived.
+  while (num_received < kNumThreads * kNumMessages) {
+    log.Drain([&](const char* text) {
+      int t = -1;
+      int k = -1;
+      ASSERT_EQ(sscanf(text, "[WARN] %d (#%d)", &t, &k), 2);
+      ASSERT_GE(t, 0);
+      ASSERT_LT(t, kNumThreads);
+      // A message dropped by a concurrent producer may be repeated, but
+      // never reordered.
+      EXPECT_GE(k, next[t] - 1);
+      EXPECT_LE(k, next[t]);
+      if (k == next[t]) {
+        ++next[t];
+        ++num_received;
+      }
+    });
+    std::this_thread::yield();
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(next, std::vector<int>(kNumThreads, kNumMessages));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+// seek_audio_far_end_queue.cc
+#include "modules/audio_processing/seek_audio_far_end_queue.h"
+
+namespace webrtc {
+
+SeekAudioFarEndQueue::SeekAudioFarEndQueue(size_t capacity,
+                                           int jitter_allowance_frames)
+    : ring_(capacity), jitter_allowance_frames_(jitter_allowance_frames) {}
+
+SeekAudioFarEndQueue::Frame* SeekAudioFarEndQueue::BeginPush() {
+  Frame* frame = ring_.BeginPush();
+  if (!frame) {
+    num_overflows_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return frame;
+}
+
+void SeekAudioFarEndQueue::CommitPush() {
+  ring_.CommitPush();
+}
+
+size_t SeekAudioFarEndQueue::Drain(int64_t now_us,
+                                   FunctionView<void(const Frame&)> sink) {
+  size_t num_frames = 0;
+  while (const Frame* frame = ring_.Front()) {
+    if (num_frames == 0) {
+      queue_delay_us_ = now_us - frame->render_time_us;
+    }
+    sink(*frame);
+    ring_.Pop();
+    ++num_frames;
+  }
+  if (num_frames > 0) {
+    started_ = true;
+    num_frames_ahead_ = static_cast<int>(num_frames) - 1;
+    num_empty_drains_ = 0;
+  } else if (started_) {
+    ++num_empty_drains_;
+    if (num_empty_drains_ > num_frames_ahead_ + jitter_allowance_frames_) {
+      ++num_underflows_;
+    }
+  }
+  return num_frames;
+}
+
+void SeekAudioFarEndQueue::Clear() {
+  while (ring_.Front()) {
+    ring_.Pop();
+  }
+  num_overflows_.store(0, std::memory_order_relaxed);
+  started_ = false;
+  num_frames_ahead_ = 0;
+  num_empty_drains_ = 0;
+  num_underflows_ = 0;
+  queue_delay_us_ = 0;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,91 @@
+// seek_audio_far_end_queue.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_FAR_END_QUEUE_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_FAR_END_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "api/array_view.h"
+#include "api/function_view.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/seek_audio_spsc_ring.h"
+
+namespace webrtc {
+
+// Carries the far-end reference of the SeekAudio AEC from the render thread to
+// the capture thread, which alone calls the engine. Lock-free, like the render
+// transfer queue of AEC3: when the capture side falls behind, new frames are
+// dropped and counted instead of making the render thread wait for the
+// capture lock.
+class SeekAudioFarEndQueue {
+ public:
+  struct Frame {
+    ArrayView<const float> view() const {
+      return ArrayView<const float>(samples.data(), num_samples);
+    }
+
+    // Lowest split band, 80 or 160 samples.
+    std::array<float, kSeekAudioFrameSize> samples;
+    size_t num_samples = 0;
+    // TimeMicros() when the frame was queued, for delay and drift tracking.
+    int64_t render_time_us = 0;
+  };
+
+  // Up to `jitter_allowance_frames` consecutive capture frames may find no
+  // new far-end frame before they count as underflow.
+  SeekAudioFarEndQueue(size_t capacity, int jitter_allowance_frames);
+  SeekAudioFarEndQueue(const SeekAudioFarEndQueue&) = delete;
+  SeekAudioFarEndQueue& operator=(const SeekAudioFarEndQueue&) = delete;
+
+  // Render thread. Returns the frame to fill, or null if the queue is full, in
+  // which case the frame is dropped and counted as overflow. The frame is
+  // published by CommitPush().
+  Frame* BeginPush();
+  void CommitPush();
+
+  // Capture thread, once per capture frame. Passes the queued frames, oldest
+  // first, to `sink` and returns their number. Once the far-end has started,
+  // a capture frame that finds no new frame is counted as underflow, unless
+  // it is covered by the frames that the last non-empty drain received ahead
+  // or by the jitter allowance. A render burst followed by a gap thus does
+  // not count.
+  size_t Drain(int64_t now_us, FunctionView<void(const Frame&)> sink);
+
+  // Capture thread, or neither side running.
+  void set_jitter_allowance_frames(int frames) {
+    jitter_allowance_frames_ = frames;
+  }
+
+  // Drops all frames and resets the counters. Neither side may run
+  // meanwhile.
+  void Clear();
+
+  int num_overflows() const {
+    return num_overflows_.load(std::memory_order_relaxed);
+  }
+  int num_underflows() const { return num_underflows_; }
+  // Time that the oldest frame of the last non-empty drain spent queued. A
+  // steady increase means that the render and capture clocks drift apart.
+  int64_t queue_delay_us() const { return queue_delay_us_; }
+
+ private:
+  SeekAudioSpscRing<Frame> ring_;
+  // Written by the render thread.
+  std::atomic<int> num_overflows_{0};
+  // Written by the capture thread.
+  int jitter_allowance_frames_;
+  bool started_ = false;
+  // Frames beyond the first of the last non-empty drain, and capture frames
+  // without a new frame since.
+  int num_frames_ahead_ = 0;
+  int num_empty_drains_ = 0;
+  int num_underflows_ = 0;
+  int64_t queue_delay_us_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_FAR_END_QUEUE_H_
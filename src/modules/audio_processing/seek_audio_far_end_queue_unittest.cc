@@ -0,0 +1,130 @@
+// seek_audio_far_end_queue_unittest.cc
+#include "modules/audio_processing/seek_audio_far_end_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Frame = SeekAudioFarEndQueue::Frame;
+
+bool PushFrame(SeekAudioFarEndQueue& queue, float value, int64_t time_us) {
+  Frame* frame = queue.BeginPush();
+  if (!frame) {
+    return false;
+  }
+  frame->samples.fill(value);
+  frame->num_samples = kSeekAudioFrameSize;
+  frame->render_time_us = time_us;
+  queue.CommitPush();
+  return true;
+}
+
+std::vector<float> DrainValues(SeekAudioFarEndQueue& queue, int64_t now_us) {
+  std::vector<float> values;
+  queue.Drain(now_us, [&](const Frame& frame) {
+    EXPECT_EQ(frame.view().size(), kSeekAudioFrameSize);
+    values.push_back(frame.samples[0]);
+  });
+  return values;
+}
+
+}  // namespace
+
+TEST(SeekAudioFarEndQueue, DropsAndCountsFramesWhenFull) {
+  SeekAudioFarEndQueue queue(2, /*jitter_allowance_frames=*/0);
+  EXPECT_TRUE(PushFrame(queue, 1.f, 0));
+  EXPECT_TRUE(PushFrame(queue, 2.f, 0));
+  EXPECT_FALSE(PushFrame(queue, 3.f, 0));
+  EXPECT_EQ(queue.num_overflows(), 1);
+  EXPECT_EQ(DrainValues(queue, 0), (std::vector<float>{1.f, 2.f}));
+  EXPECT_TRUE(PushFrame(queue, 4.f, 0));
+  EXPECT_EQ(DrainValues(queue, 0), std::vector<float>{4.f});
+}
+
+TEST(SeekAudioFarEndQueue, CountsUnderflowsOnceStarted) {
+  SeekAudioFarEndQueue queue(4, /*jitter_allowance_frames=*/0);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 0);
+  PushFrame(queue, 1.f, 0);
+  EXPECT_EQ(DrainValues(queue, 0).size(), 1u);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 2);
+
+  queue.Clear();
+  EXPECT_EQ(queue.num_underflows(), 0);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 0);
+}
+
+// The frames of a render burst cover the capture frames that follow it.
+TEST(SeekAudioFarEndQueue, DoesNotCountGapsAfterBurstsAsUnderflows) {
+  SeekAudioFarEndQueue queue(4, /*jitter_allowance_frames=*/0);
+  PushFrame(queue, 1.f, 0);
+  PushFrame(queue, 2.f, 0);
+  PushFrame(queue, 3.f, 0);
+  EXPECT_EQ(DrainValues(queue, 0).size(), 3u);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 0);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 1);
+}
+
+TEST(SeekAudioFarEndQueue, CountsUnderflowsBeyondJitterAllowance) {
+  SeekAudioFarEndQueue queue(4, /*jitter_allowance_frames=*/2);
+  for (int i = 0; i < 2; ++i) {
+    PushFrame(queue, 1.f, 0);
+    EXPECT_EQ(DrainValues(queue, 0).size(), 1u);
+    EXPECT_TRUE(DrainValues(queue, 0).empty());
+    EXPECT_TRUE(DrainValues(queue, 0).empty());
+    EXPECT_EQ(queue.num_underflows(), 0);
+  }
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 2);
+
+  queue.set_jitter_allowance_frames(0);
+  PushFrame(queue, 1.f, 0);
+  EXPECT_EQ(DrainValues(queue, 0).size(), 1u);
+  EXPECT_TRUE(DrainValues(queue, 0).empty());
+  EXPECT_EQ(queue.num_underflows(), 3);
+}
+
+TEST(SeekAudioFarEndQueue, ReportsDelayOfOldestFrame) {
+  SeekAudioFarEndQueue queue(4, /*jitter_allowance_frames=*/0);
+  PushFrame(queue, 1.f, 1000);
+  PushFrame(queue, 2.f, 11000);
+  DrainValues(queue, 15000);
+  EXPECT_EQ(queue.queue_delay_us(), 14000);
+  // An empty drain keeps the last delay.
+  DrainValues(queue, 25000);
+  EXPECT_EQ(queue.queue_delay_us(), 14000);
+}
+
+TEST(SeekAudioFarEndQueue, KeepsOrderAcrossThreads) {
+  constexpr int kNumFrames = 2000;
+  SeekAudioFarEndQueue queue(8, /*jitter_allowance_frames=*/0);
+  std::thread render([&] {
+    for (int k = 0; k < kNumFrames; ++k) {
+      PushFrame(queue, k, k);
+      std::this_thread::yield();
+    }
+  });
+  std::vector<float> values;
+  while (values.size() + queue.num_overflows() < kNumFrames) {
+    std::vector<float> drained = DrainValues(queue, 0);
+    values.insert(values.end(), drained.begin(), drained.end());
+    std::this_thread::yield();
+  }
+  render.join();
+  for (size_t k = 1; k < values.size(); ++k) {
+    EXPECT_LT(values[k - 1], values[k]);
+  }
+}
+
+}  // namespace webrtc
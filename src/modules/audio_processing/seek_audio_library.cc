@@ -0,0 +1,188 @@
+// seek_audio_library.cc
+#include "modules/audio_processing/seek_audio_library.h"
+
+#include <dlfcn.h>  // dlopen, dlsym, dlclose
+
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+namespace {
+
+template <typename T>
+void ResolveSymbol(void* symbol, T* function) {
+  *function = reinterpret_cast<T>(symbol);
+}
+
+// The registry only holds weak references, the libraries themselves are owned
+// by the AEC/AFC wrappers. Both the mutex and the map are intentionally leaked
+// so that wrappers destroyed during static destruction stay safe.
+Mutex& RegistryMutex() {
+  static Mutex* const mutex = new Mutex();
+  return *mutex;
+}
+
+std::map<std::string, std::weak_ptr<const SeekAudioLibrary>>& Registry() {
+  static auto* const registry =
+      new std::map<std::string, std::weak_ptr<const SeekAudioLibrary>>();
+  return *registry;
+}
+
+}  // namespace
+
+constexpr char SeekAudioLibrary::kDefaultAecPath[];
+constexpr char SeekAudioLibrary::kDefaultAfcPath[];
+
+std::shared_ptr<const SeekAudioLibrary> SeekAudioLibrary::AcquireAec(
+    absl::string_view path) {
+  return Acquire(Kind::kAec, path.empty() ? kDefaultAecPath : path);
+}
+
+std::shared_ptr<const SeekAudioLibrary> SeekAudioLibrary::AcquireAfc(
+    absl::string_view path) {
+  return Acquire(Kind::kAfc, path.empty() ? kDefaultAfcPath : path);
+}
+
+std::shared_ptr<const SeekAudioLibrary> SeekAudioLibrary::Acquire(
+    Kind kind,
+    absl::string_view path) {
+  // The same file may in theory provide both engines, so the kind is part of
+  // the key.
+  std::string key(kind == Kind::kAec ? "aec:" : "afc:");
+  key.append(path.data(), path.size());
+  MutexLock lock(&RegistryMutex());
+  auto& registry = Registry();
+  auto it = registry.find(key);
+  if (it != registry.end()) {
+    std::shared_ptr<const SeekAudioLibrary> library = it->second.lock();
+    if (library) {
+      return library;
+    }
+    registry.erase(it);
+  }
+
+  std::shared_ptr<const SeekAudioLibrary> library = Load(kind, path);
+  if (!library) {
+    return nullptr;
+  }
+  // Drops the entries of released libraries, so that the registry does not
+  // grow with every path ever used.
+  for (it = registry.begin(); it != registry.end();) {
+    it = it->second.expired() ? registry.erase(it) : std::next(it);
+  }
+  registry.emplace(std::move(key), library);
+  return library;
+}
+
+int SeekAudioLibrary::NumRegistryEntriesForTesting() {
+  MutexLock lock(&RegistryMutex());
+  return static_cast<int>(Registry().size());
+}
+
+int SeekAudioLibrary::NumOpenLibrariesForTesting() {
+  MutexLock lock(&RegistryMutex());
+  int num_open = 0;
+  for (const auto& entry : Registry()) {
+    if (!entry.second.expired()) {
+      ++num_open;
+    }
+  }
+  return num_open;
+}
+
+std::unique_ptr<SeekAudioLibrary> SeekAudioLibrary::Load(
+    Kind kind,
+    absl::string_view path) {
+  const std::string path_str(path);
+  void* handle = dlopen(path_str.c_str(), RTLD_LAZY);
+  if (!handle) {
+    RTC_LOG(LS_ERROR) << "Failed to load library: " << path_str
+                      << ", error: " << dlerror();
+    return nullptr;
+  }
+
+  std::unique_ptr<SeekAudioLibrary> library(
+      new SeekAudioLibrary(handle, path_str));
+  const bool resolved =
+      kind == Kind::kAec ? library->ResolveAec() : library->ResolveAfc();
+  if (!resolved) {
+    RTC_LOG(LS_ERROR) << "Library " << path_str
+                      << " lacks essential SeekAudio entry points";
+    return nullptr;
+  }
+
+  RTC_LOG(LS_INFO) << "Loaded SeekAudio library " << path_str;
+  return library;
+}
+
+SeekAudioLibrary::SeekAudioLibrary(void* handle, absl::string_view path)
+    : handle_(handle), path_(path) {
+  RTC_DCHECK(handle_);
+}
+
+SeekAudioLibrary::~SeekAudioLibrary() {
+  dlclose(handle_);
+}
+
+void* SeekAudioLibrary::Symbol(const char* name) const {
+  void* symbol = dlsym(handle_, name);
+  if (!symbol) {
+    RTC_LOG(LS_WARNING) << "Failed to load function " << name << " from "
+                        << path_;
+  }
+  return symbol;
+}
+
+bool SeekAudioLibrary::ResolveAec() {
+  ResolveSymbol(Symbol("SeekAudioAEC_Create"), &aec_.create);
+  ResolveSymbol(Symbol("SeekAudioAEC_Free"), &aec_.free);
+  ResolveSymbol(Symbol("SeekAudioAEC_OpenLog"), &aec_.open_log);
+  ResolveSymbol(Symbol("SeekAudioAEC_Init"), &aec_.init);
+  ResolveSymbol(Symbol("SeekAudioAEC_Process"), &aec_.process);
+  ResolveSymbol(Symbol("SeekAudioAEC_buffer_farend"), &aec_.buffer_farend);
+  ResolveSymbol(Symbol("SeekAudioAEC_AGC_Compensate"), &aec_.agc_compensate);
+  ResolveSymbol(Symbol("SeekAudioAEC_GetHowlingStatus"),
+                &aec_.get_howling_status);
+  ResolveSymbol(Symbol("SeekAudioAEC_Set_AI_Engine_Power_For_Howl"),
+                &aec_.set_power_howl);
+  ResolveSymbol(Symbol("SeekAudioAEC_Set_AI_Engine_Power_For_Echo"),
+                &aec_.set_power_echo);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAEC_Process_Float"),
+                &aec_.process_float);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAEC_buffer_farend_Float"),
+                &aec_.buffer_farend_float);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAEC_AGC_Compensate_Float"),
+                &aec_.agc_compensate_float);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAEC_GetState"), &aec_.get_state);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAEC_SetState"), &aec_.set_state);
+  return aec_.create && aec_.free && aec_.init && aec_.process &&
+         aec_.buffer_farend;
+}
+
+bool SeekAudioLibrary::ResolveAfc() {
+  ResolveSymbol(Symbol("SeekAudioAFC_Create"), &afc_.create);
+  ResolveSymbol(Symbol("SeekAudioAFC_Free"), &afc_.free);
+  ResolveSymbol(Symbol("SeekAudioAFC_OpenLog"), &afc_.open_log);
+  ResolveSymbol(Symbol("SeekAudioAFC_Init"), &afc_.init);
+  ResolveSymbol(Symbol("SeekAudioAFC_Process"), &afc_.process);
+  ResolveSymbol(Symbol("SeekAudioAFC_AGC_Compensate"), &afc_.agc_compensate);
+  ResolveSymbol(Symbol("SeekAudioAFC_GetHowlingStatus"),
+                &afc_.get_howling_status);
+  ResolveSymbol(Symbol("SeekAudioAFC_Set_AI_Engine_Power"), &afc_.set_power);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAFC_Process_Float"),
+                &afc_.process_float);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAFC_AGC_Compensate_Float"),
+                &afc_.agc_compensate_float);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAFC_GetState"), &afc_.get_state);
+  ResolveSymbol(dlsym(handle_, "SeekAudioAFC_SetState"), &afc_.set_state);
+  return afc_.create && afc_.free && afc_.init && afc_.process;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,145 @@
+// seek_audio_library.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_LIBRARY_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_LIBRARY_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace webrtc {
+
+// Entry points of libseekaudio_aec.so. Optional entry points are null when the
+// library does not export them.
+struct SeekAudioAecApi {
+  typedef void* (*CreateFunc)();
+  typedef void (*FreeFunc)(void*);
+  typedef int (*OpenLogFunc)(void*, const char*);
+  typedef int (*InitFunc)(void*, int);
+  typedef void (*SetPowerFunc)(void*, int);
+  typedef int (*ProcessFunc)(void*, const short*, short*, int);
+  typedef int (*BufferFarendFunc)(void*, const short*, int);
+  typedef void (*AGC_CompensateFunc)(void*, const short*, const short*, const short*, short*);
+  typedef float (*GetHowlingStatusFunc)(void*);
+  // Optional float entry points taking FloatS16 samples. Processing must be
+  // allowed in-place (`outframe` == `nearend`).
+  typedef int (*ProcessFloatFunc)(void*, const float*, float*, int);
+  typedef int (*BufferFarendFloatFunc)(void*, const float*, int);
+  typedef void (*AGC_CompensateFloatFunc)(void*, const float*, const float*, const float*, float*);
+  // Optional warm start entry points. GetState writes the adaptive state into
+  // `data` and returns its size, or the required size if `capacity` is too
+  // small, or a negative value on failure. SetState returns 0 on success.
+  typedef int (*GetStateFunc)(void*, unsigned char*, int);
+  typedef int (*SetStateFunc)(void*, const unsigned char*, int);
+
+  CreateFunc create = nullptr;
+  FreeFunc free = nullptr;
+  OpenLogFunc open_log = nullptr;
+  InitFunc init = nullptr;
+  SetPowerFunc set_power_howl = nullptr;
+  SetPowerFunc set_power_echo = nullptr;
+  ProcessFunc process = nullptr;
+  BufferFarendFunc buffer_farend = nullptr;
+  AGC_CompensateFunc agc_compensate = nullptr;
+  GetHowlingStatusFunc get_howling_status = nullptr;
+  ProcessFloatFunc process_float = nullptr;
+  BufferFarendFloatFunc buffer_farend_float = nullptr;
+  AGC_CompensateFloatFunc agc_compensate_float = nullptr;
+  GetStateFunc get_state = nullptr;
+  SetStateFunc set_state = nullptr;
+};
+
+// Entry points of libseekaudio_afc.so. Optional entry points are null when the
+// library does not export them.
+struct SeekAudioAfcApi {
+  typedef void* (*CreateFunc)();
+  typedef void (*FreeFunc)(void*);
+  typedef int (*OpenLogFunc)(void*, const char*);
+  typedef int (*InitFunc)(void*, int);
+  typedef void (*SetPowerFunc)(void*, int);
+  typedef void (*ProcessFunc)(void*, const short*, short*);
+  typedef void (*AGC_CompensateFunc)(void*, const short*, const short*, const short*, short*);
+  typedef float (*GetHowlingStatusFunc)(void*);
+  // Optional float entry points taking FloatS16 samples. Processing must be
+  // allowed in-place (`output` == `input`).
+  typedef void (*ProcessFloatFunc)(void*, const float*, float*);
+  typedef void (*AGC_CompensateFloatFunc)(void*, const float*, const float*, const float*, float*);
+  // Optional warm start entry points, as in SeekAudioAecApi.
+  typedef int (*GetStateFunc)(void*, unsigned char*, int);
+  typedef int (*SetStateFunc)(void*, const unsigned char*, int);
+
+  CreateFunc create = nullptr;
+  FreeFunc free = nullptr;
+  OpenLogFunc open_log = nullptr;
+  InitFunc init = nullptr;
+  SetPowerFunc set_power = nullptr;
+  ProcessFunc process = nullptr;
+  AGC_CompensateFunc agc_compensate = nullptr;
+  GetHowlingStatusFunc get_howling_status = nullptr;
+  ProcessFloatFunc process_float = nullptr;
+  AGC_CompensateFloatFunc agc_compensate_float = nullptr;
+  GetStateFunc get_state = nullptr;
+  SetStateFunc set_state = nullptr;
+};
+
+// A dlopen'ed SeekAudio engine library with its resolved entry points.
+//
+// Libraries are shared process-wide: all callers acquiring the same library
+// path get the same instance, so the library is opened and its symbols are
+// resolved once, no matter how many AEC/AFC instances use it. The library is
+// closed when the last reference is released. Acquiring is thread-safe.
+class SeekAudioLibrary {
+ public:
+  static constexpr char kDefaultAecPath[] = "libseekaudio_aec.so";
+  static constexpr char kDefaultAfcPath[] = "libseekaudio_afc.so";
+
+  // Returns the AEC library at `path`, or at `kDefaultAecPath` if `path` is
+  // empty. Returns null if the library cannot be opened or does not export
+  // all essential entry points.
+  static std::shared_ptr<const SeekAudioLibrary> AcquireAec(
+      absl::string_view path);
+
+  // Same as AcquireAec() for the AFC library.
+  static std::shared_ptr<const SeekAudioLibrary> AcquireAfc(
+      absl::string_view path);
+
+  // Number of libraries currently held open through the shared registry.
+  static int NumOpenLibrariesForTesting();
+  // Number of entries of the shared registry, including those of libraries
+  // released since the last successful acquisition.
+  static int NumRegistryEntriesForTesting();
+
+  ~SeekAudioLibrary();
+  SeekAudioLibrary(const SeekAudioLibrary&) = delete;
+  SeekAudioLibrary& operator=(const SeekAudioLibrary&) = delete;
+
+  const std::string& path() const { return path_; }
+
+  // Only valid for libraries returned by AcquireAec().
+  const SeekAudioAecApi& aec() const { return aec_; }
+  // Only valid for libraries returned by AcquireAfc().
+  const SeekAudioAfcApi& afc() const { return afc_; }
+
+ private:
+  enum class Kind { kAec, kAfc };
+
+  SeekAudioLibrary(void* handle, absl::string_view path);
+
+  static std::shared_ptr<const SeekAudioLibrary> Acquire(Kind kind,
+                                                         absl::string_view path);
+  static std::unique_ptr<SeekAudioLibrary> Load(Kind kind,
+                                                absl::string_view path);
+
+  void* Symbol(const char* name) const;
+  bool ResolveAec();
+  bool ResolveAfc();
+
+  void* const handle_;
+  const std::string path_;
+  SeekAudioAecApi aec_;
+  SeekAudioAfcApi afc_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_LIBRARY_H_
@@ -0,0 +1,87 @@
+// seek_audio_library_unittest.cc
+#include "modules/audio_processing/seek_audio_library.h"
+
+#include <memory>
+
+#include "modules/audio_processing/seek_audio_aec.h"
+#include "modules/audio_processing/seek_audio_afc.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr char kMissingLibrary[] = "libseekaudio_does_not_exist.so";
+
+// Creates and destroys the SeekAudio part of an APM instance `num_instances`
+// times and returns the average time per instance in microseconds.
+double MeasureCreateDestroy(int num_instances) {
+  test::PerformanceTimer perf_timer(num_instances);
+  for (int k = 0; k < num_instances; ++k) {
+    perf_timer.StartTimer();
+    {
+      SeekAudioAec aec;
+      SeekAudioAfc afc;
+      aec.Initialize(kSeekAudioSampleRateHz);
+      afc.Initialize(kSeekAudioSampleRateHz, 1);
+    }
+    perf_timer.StopTimer();
+  }
+  return perf_timer.GetDurationAverage();
+}
+
+}  // namespace
+
+TEST(SeekAudioLibrary, MissingLibraryIsNotRegistered) {
+  const int num_open = SeekAudioLibrary::NumOpenLibrariesForTesting();
+  const int num_entries = SeekAudioLibrary::NumRegistryEntriesForTesting();
+  EXPECT_EQ(SeekAudioLibrary::AcquireAec(kMissingLibrary), nullptr);
+  EXPECT_EQ(SeekAudioLibrary::AcquireAfc(kMissingLibrary), nullptr);
+  EXPECT_EQ(SeekAudioLibrary::NumOpenLibrariesForTesting(), num_open);
+  EXPECT_EQ(SeekAudioLibrary::NumRegistryEntriesForTesting(), num_entries);
+}
+
+TEST(SeekAudioLibrary, WrappersWithoutLibraryAreInert) {
+  SeekAudioAec aec(kMissingLibrary);
+  SeekAudioAfc afc(kMissingLibrary);
+  EXPECT_EQ(aec.library_path(), kMissingLibrary);
+  EXPECT_EQ(afc.library_path(), kMissingLibrary);
+  EXPECT_FALSE(aec.Initialize(kSeekAudioSampleRateHz));
+  EXPECT_FALSE(afc.Initialize(kSeekAudioSampleRateHz, 1));
+  EXPECT_EQ(aec.GetHowlingProbability(), 0.0f);
+  EXPECT_EQ(afc.GetHowlingProbability(), 0.0f);
+  const uint8_t state[] = {1, 2, 3};
+  EXPECT_TRUE(aec.GetEngineState(0).empty());
+  EXPECT_TRUE(afc.GetEngineState(0).empty());
+  EXPECT_FALSE(aec.SetEngineState(0, state));
+  EXPECT_FALSE(afc.SetEngineState(0, state));
+}
+
+// Wrappers given their library never open one themselves.
+TEST(SeekAudioLibrary, WrappersWithGivenLibraryDoNotOpenLibraries) {
+  const int num_open = SeekAudioLibrary::NumOpenLibrariesForTesting();
+  SeekAudioAec aec(SeekAudioLibrary::kDefaultAecPath, nullptr);
+  SeekAudioAfc afc(SeekAudioLibrary::kDefaultAfcPath, nullptr);
+  EXPECT_EQ(SeekAudioLibrary::NumOpenLibrariesForTesting(), num_open);
+  EXPECT_FALSE(aec.Initialize(kSeekAudioSampleRateHz));
+  EXPECT_FALSE(afc.Initialize(kSeekAudioSampleRateHz, 1));
+}
+
+// Measures the cost of creating and destroying the SeekAudio modules of an
+// APM, both when every instance opens the library on its own and when another
+// participant keeps it open, which is the common case in a room.
+TEST(SeekAudioLibrary, DISABLED_CreateDestroyBenchmark) {
+  constexpr int kNumInstances = 2000;
+  const double cold_us = MeasureCreateDestroy(kNumInstances);
+
+  SeekAudioAec held_aec;
+  SeekAudioAfc held_afc;
+  const double shared_us = MeasureCreateDestroy(kNumInstances);
+
+  RTC_LOG(LS_INFO) << "SeekAudio create/destroy: " << cold_us
+                   << " us per instance cold, " << shared_us
+                   << " us per instance with the library held open";
+}
+
+}  // namespace webrtc
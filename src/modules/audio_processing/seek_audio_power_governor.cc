@@ -0,0 +1,116 @@
+// seek_audio_power_governor.cc
+#include "modules/audio_processing/seek_audio_power_governor.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace webrtc {
+
+namespace {
+
+std::atomic<int64_t> window_start_us{-1};
+std::atomic<int64_t> window_usage_us{0};
+std::atomic<float> last_load{0.f};
+
+}  // namespace
+
+constexpr int64_t SeekAudioCpuBudget::kWindowUs;
+
+void SeekAudioCpuBudget::AddUsage(int64_t engine_time_us, int64_t now_us) {
+  window_usage_us.fetch_add(engine_time_us, std::memory_order_relaxed);
+  int64_t start_us = window_start_us.load(std::memory_order_relaxed);
+  if (start_us < 0) {
+    window_start_us.compare_exchange_strong(start_us, now_us);
+    return;
+  }
+  if (now_us - start_us < kWindowUs) {
+    return;
+  }
+  // Only the caller that moves the window on publishes the load.
+  if (window_start_us.compare_exchange_strong(start_us, now_us)) {
+    const int64_t usage_us = window_usage_us.exchange(0);
+    last_load.store(static_cast<float>(usage_us) / (now_us - start_us),
+                    std::memory_order_relaxed);
+  }
+}
+
+float SeekAudioCpuBudget::Load() {
+  return last_load.load(std::memory_order_relaxed);
+}
+
+void SeekAudioCpuBudget::ResetForTesting() {
+  window_start_us.store(-1);
+  window_usage_us.store(0);
+  last_load.store(0.f);
+}
+
+SeekAudioPowerGovernor::SeekAudioPowerGovernor(const Config& config,
+                                               const Levels& active_levels)
+    : config_(config),
+      active_levels_(active_levels),
+      levels_{config.idle_level, config.idle_level} {}
+
+bool SeekAudioPowerGovernor::Update(
+    float howling_probability,
+    std::optional<float> residual_echo_likelihood,
+    int64_t engine_time_us,
+    int64_t now_us) {
+  SeekAudioCpuBudget::AddUsage(engine_time_us, now_us);
+  const bool over_budget = config_.cpu_budget_cores > 0.f &&
+                           SeekAudioCpuBudget::Load() > config_.cpu_budget_cores;
+
+  Levels levels;
+  levels.howl =
+      UpdateChannel(howling_probability > config_.howling_threshold,
+                    over_budget, levels_.howl, active_levels_.howl, howl_);
+  if (residual_echo_likelihood) {
+    levels.echo = UpdateChannel(
+        *residual_echo_likelihood > config_.residual_echo_threshold,
+        over_budget, levels_.echo, active_levels_.echo, echo_);
+  } else {
+    levels.echo = active_levels_.echo;
+    echo_ = Channel();
+  }
+
+  const bool changed = levels != levels_;
+  levels_ = levels;
+  return changed;
+}
+
+int SeekAudioPowerGovernor::UpdateChannel(bool detected,
+                                          bool over_budget,
+                                          int level,
+                                          int active_level,
+                                          Channel& channel) const {
+  const int idle_level = config_.idle_level;
+  if (detected) {
+    channel.hold_frames_left = config_.hold_frames;
+    channel.decay_frames_left = 0;
+    // Over budget a raised level is kept, but an idle engine stays idle.
+    return over_budget ? level : active_level;
+  }
+
+  if (level == idle_level) {
+    channel = Channel();
+    return idle_level;
+  }
+  if (over_budget) {
+    channel.hold_frames_left = 0;
+  }
+  if (channel.hold_frames_left > 0) {
+    --channel.hold_frames_left;
+    return level;
+  }
+
+  // Linear decay from the level at which the decay started.
+  if (channel.decay_frames_left == 0) {
+    channel.decay_frames_left = std::max(config_.decay_frames, 1);
+  }
+  const int next_level = idle_level + (level - idle_level) *
+                                          (channel.decay_frames_left - 1) /
+                                          channel.decay_frames_left;
+  --channel.decay_frames_left;
+  return next_level;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+// seek_audio_power_governor.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_POWER_GOVERNOR_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_POWER_GOVERNOR_H_
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "api/audio/audio_processing.h"
+
+namespace webrtc {
+
+// Engine CPU time of all SeekAudio modules of the process, accumulated over
+// one second windows. Lock-free and approximate: usage reported while a
+// window is being closed may be counted in the next one.
+class SeekAudioCpuBudget {
+ public:
+  static constexpr int64_t kWindowUs = 1000000;
+
+  static void AddUsage(int64_t engine_time_us, int64_t now_us);
+  // Cores used in the last completed window.
+  static float Load();
+
+  static void ResetForTesting();
+};
+
+// Decides the AI engine power levels of one SeekAudio module from the
+// detector outputs of each 10 ms frame, see
+// AudioProcessing::Config::SeekAudioPowerGovernor.
+class SeekAudioPowerGovernor {
+ public:
+  using Config = AudioProcessing::Config::SeekAudioPowerGovernor;
+
+  struct Levels {
+    bool operator==(const Levels& rhs) const {
+      return howl == rhs.howl && echo == rhs.echo;
+    }
+    bool operator!=(const Levels& rhs) const { return !(*this == rhs); }
+
+    int howl;
+    int echo;
+  };
+
+  // `active_levels` are used while howling or echo is detected.
+  SeekAudioPowerGovernor(const Config& config, const Levels& active_levels);
+
+  // Levels to apply, starting at the idle level.
+  const Levels& levels() const { return levels_; }
+
+  // Updates the levels with the detector outputs for one frame and the
+  // engine time spent on it. Without `residual_echo_likelihood` the echo
+  // level stays at its active level. Returns true if the levels changed.
+  bool Update(float howling_probability,
+              std::optional<float> residual_echo_likelihood,
+              int64_t engine_time_us,
+              int64_t now_us);
+
+ private:
+  struct Channel {
+    int hold_frames_left = 0;
+    int decay_frames_left = 0;
+  };
+
+  int UpdateChannel(bool detected,
+                    bool over_budget,
+                    int level,
+                    int active_level,
+                    Channel& channel) const;
+
+  const Config config_;
+  const Levels active_levels_;
+  Levels levels_;
+  Channel howl_;
+  Channel echo_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_POWER_GOVERNOR_H_
@@ -0,0 +1,122 @@
+// seek_audio_power_governor_unittest.cc
+#include "modules/audio_processing/seek_audio_power_governor.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kIdleLevel = 5;
+constexpr SeekAudioPowerGovernor::Levels kActiveLevels = {35, 30};
+constexpr int64_t kFrameUs = 10000;
+
+SeekAudioPowerGovernor::Config CreateConfig() {
+  SeekAudioPowerGovernor::Config config;
+  config.enabled = true;
+  config.idle_level = kIdleLevel;
+  config.hold_frames = 10;
+  config.decay_frames = 20;
+  return config;
+}
+
+class SeekAudioPowerGovernorTest : public ::testing::Test {
+ protected:
+  void SetUp() override { SeekAudioCpuBudget::ResetForTesting(); }
+
+  // Runs `num_frames` frames with the given detector outputs.
+  void Run(SeekAudioPowerGovernor& governor,
+           int num_frames,
+           float howling_probability,
+           std::optional<float> residual_echo_likelihood,
+           int64_t engine_time_us = 100) {
+    for (int k = 0; k < num_frames; ++k) {
+      governor.Update(howling_probability, residual_echo_likelihood,
+                      engine_time_us, now_us_);
+      now_us_ += kFrameUs;
+    }
+  }
+
+  int64_t now_us_ = 0;
+};
+
+}  // namespace
+
+TEST_F(SeekAudioPowerGovernorTest, StaysIdleWithoutDetection) {
+  SeekAudioPowerGovernor governor(CreateConfig(), kActiveLevels);
+  EXPECT_EQ(governor.levels().howl, kIdleLevel);
+  Run(governor, 100, 0.1f, 0.1f);
+  EXPECT_EQ(governor.levels().howl, kIdleLevel);
+  EXPECT_EQ(governor.levels().echo, kIdleLevel);
+}
+
+TEST_F(SeekAudioPowerGovernorTest, RaisesHoldsAndDecays) {
+  const SeekAudioPowerGovernor::Config config = CreateConfig();
+  SeekAudioPowerGovernor governor(config, kActiveLevels);
+  EXPECT_TRUE(governor.Update(0.9f, 0.f, 0, now_us_));
+  EXPECT_EQ(governor.levels().howl, kActiveLevels.howl);
+  EXPECT_EQ(governor.levels().echo, kIdleLevel);
+
+  // Held after the detection has ended.
+  Run(governor, config.hold_frames, 0.f, 0.f);
+  EXPECT_EQ(governor.levels().howl, kActiveLevels.howl);
+
+  // Then decays monotonically to the idle level.
+  int level = governor.levels().howl;
+  for (int k = 0; k < config.decay_frames; ++k) {
+    Run(governor, 1, 0.f, 0.f);
+    EXPECT_LE(governor.levels().howl, level);
+    EXPECT_GE(governor.levels().howl, kIdleLevel);
+    level = governor.levels().howl;
+  }
+  EXPECT_EQ(governor.levels().howl, kIdleLevel);
+}
+
+TEST_F(SeekAudioPowerGovernorTest, EchoFollowsResidualEchoLikelihood) {
+  SeekAudioPowerGovernor governor(CreateConfig(), kActiveLevels);
+  Run(governor, 1, 0.f, 0.8f);
+  EXPECT_EQ(governor.levels().howl, kIdleLevel);
+  EXPECT_EQ(governor.levels().echo, kActiveLevels.echo);
+}
+
+TEST_F(SeekAudioPowerGovernorTest, EchoIsNotGovernedWithoutDetector) {
+  SeekAudioPowerGovernor governor(CreateConfig(), kActiveLevels);
+  Run(governor, 100, 0.f, std::nullopt);
+  EXPECT_EQ(governor.levels().echo, kActiveLevels.echo);
+}
+
+TEST_F(SeekAudioPowerGovernorTest, DoesNotRaiseOverCpuBudget) {
+  SeekAudioPowerGovernor::Config config = CreateConfig();
+  config.cpu_budget_cores = 0.5f;
+  SeekAudioPowerGovernor governor(config, kActiveLevels);
+  // One core's worth of engine time for over a second.
+  Run(governor, 120, 0.f, 0.f, kFrameUs);
+  EXPECT_GT(SeekAudioCpuBudget::Load(), config.cpu_budget_cores);
+  Run(governor, 1, 0.9f, 0.f, kFrameUs);
+  EXPECT_EQ(governor.levels().howl, kIdleLevel);
+}
+
+TEST_F(SeekAudioPowerGovernorTest, DecaysWithoutHoldOverCpuBudget) {
+  SeekAudioPowerGovernor::Config config = CreateConfig();
+  config.cpu_budget_cores = 0.5f;
+  SeekAudioPowerGovernor governor(config, kActiveLevels);
+  Run(governor, 1, 0.9f, 0.f);
+  EXPECT_EQ(governor.levels().howl, kActiveLevels.howl);
+  // A raised level is kept while the detection lasts, even over budget.
+  Run(governor, 120, 0.9f, 0.f, kFrameUs);
+  EXPECT_EQ(governor.levels().howl, kActiveLevels.howl);
+  Run(governor, 1, 0.f, 0.f, kFrameUs);
+  EXPECT_LT(governor.levels().howl, kActiveLevels.howl);
+}
+
+TEST(SeekAudioCpuBudget, MeasuresLoadPerWindow) {
+  SeekAudioCpuBudget::ResetForTesting();
+  // Two users with a quarter of a core each.
+  for (int64_t now_us = 0; now_us <= SeekAudioCpuBudget::kWindowUs;
+       now_us += kFrameUs) {
+    SeekAudioCpuBudget::AddUsage(kFrameUs / 4, now_us);
+    SeekAudioCpuBudget::AddUsage(kFrameUs / 4, now_us);
+  }
+  EXPECT_NEAR(SeekAudioCpuBudget::Load(), 0.5f, 0.02f);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+// seek_audio_render_mixer.cc
+#include "modules/audio_processing/seek_audio_render_mixer.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+#include "modules/audio_processing/seek_audio_common.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+SeekAudioRenderMixer::SeekAudioRenderMixer(size_t num_channels)
+    : SeekAudioRenderMixer(num_channels, EchoCanceller3Config()) {}
+
+SeekAudioRenderMixer::SeekAudioRenderMixer(size_t num_channels,
+                                           const EchoCanceller3Config& config)
+    : num_channels_(num_channels),
+      content_detector_(
+          config.multi_channel.detect_stereo_content,
+          static_cast<int>(num_channels),
+          config.multi_channel.stereo_detection_threshold,
+          config.multi_channel.stereo_detection_timeout_threshold_seconds,
+          config.multi_channel.stereo_detection_hysteresis_seconds),
+      mixer_(num_channels, config.delay.render_alignment_mixing),
+      frame_(1, std::vector<std::vector<float>>(num_channels)),
+      block_(/*num_bands=*/1, static_cast<int>(num_channels)),
+      unmixed_(num_channels) {
+  RTC_DCHECK_GT(num_channels, 0);
+  for (auto& channel : frame_[0]) {
+    channel.reserve(kSeekAudioFrameSize);
+  }
+  for (auto& channel : unmixed_) {
+    channel.reserve(kBlockSize + kSeekAudioFrameSize);
+  }
+  mixed_.reserve(2 * kBlockSize + kSeekAudioFrameSize);
+}
+
+void SeekAudioRenderMixer::Mix(const float* const* lowbands,
+                               ArrayView<float> mono) {
+  const size_t num_frames = mono.size();
+  RTC_DCHECK_LE(num_frames, kSeekAudioFrameSize);
+  if (num_channels_ == 1) {
+    std::copy(lowbands[0], lowbands[0] + num_frames, mono.begin());
+    return;
+  }
+
+  if (num_frames != frame_size_) {
+    // After n frames, n * `num_frames` modulo `kBlockSize` samples are left
+    // unmixed, at most `kBlockSize` - gcd(`num_frames`, `kBlockSize`).
+    frame_size_ = num_frames;
+    delay_ = kBlockSize - std::gcd(num_frames, kBlockSize);
+    for (auto& channel : unmixed_) {
+      channel.clear();
+    }
+    mixed_.assign(delay_, 0.f);
+  }
+
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    frame_[0][ch].assign(lowbands[ch], lowbands[ch] + num_frames);
+    unmixed_[ch].insert(unmixed_[ch].end(), lowbands[ch],
+                        lowbands[ch] + num_frames);
+  }
+  content_detector_.UpdateDetection(frame_);
+
+  std::array<float, kBlockSize> mixed;
+  while (unmixed_[0].size() >= kBlockSize) {
+    if (proper_multichannel_content()) {
+      for (size_t ch = 0; ch < num_channels_; ++ch) {
+        std::copy(unmixed_[ch].begin(), unmixed_[ch].begin() + kBlockSize,
+                  block_.begin(/*band=*/0, ch));
+      }
+      mixer_.ProduceOutput(block_, mixed);
+    } else {
+      // Upmixed mono is passed through from the first channel.
+      std::copy(unmixed_[0].begin(), unmixed_[0].begin() + kBlockSize,
+                mixed.begin());
+    }
+    mixed_.insert(mixed_.end(), mixed.begin(), mixed.end());
+    for (auto& channel : unmixed_) {
+      channel.erase(channel.begin(), channel.begin() + kBlockSize);
+    }
+  }
+
+  RTC_DCHECK_GE(mixed_.size(), num_frames);
+  std::copy(mixed_.begin(), mixed_.begin() + num_frames, mono.begin());
+  mixed_.erase(mixed_.begin(), mixed_.begin() + num_frames);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+// seek_audio_render_mixer.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RENDER_MIXER_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RENDER_MIXER_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/echo_canceller3_config.h"
+#include "modules/audio_processing/aec3/alignment_mixer.h"
+#include "modules/audio_processing/aec3/block.h"
+#include "modules/audio_processing/aec3/multi_channel_content_detector.h"
+
+namespace webrtc {
+
+// Turns the lowest split band of multichannel render audio into the mono
+// far-end reference of the SeekAudio AEC, which takes a single reference for
+// all its capture channels. Upmixed mono is passed through from its first
+// channel, while proper multichannel content, as detected by the AEC3
+// MultiChannelContentDetector, is mixed by an AEC3 AlignmentMixer configured
+// like the render mixing of AEC3. The mixer works on 64 sample blocks, so
+// with more than one channel the reference is delayed by up to one block, see
+// delay().
+class SeekAudioRenderMixer {
+ public:
+  explicit SeekAudioRenderMixer(size_t num_channels);
+  // Uses the multichannel detection and render mixing settings of `config`.
+  SeekAudioRenderMixer(size_t num_channels, const EchoCanceller3Config& config);
+  SeekAudioRenderMixer(const SeekAudioRenderMixer&) = delete;
+  SeekAudioRenderMixer& operator=(const SeekAudioRenderMixer&) = delete;
+
+  size_t num_channels() const { return num_channels_; }
+
+  // Mixes `num_channels()` lowbands of `mono.size()` samples into `mono`. A
+  // change of the frame size restarts the mixing.
+  void Mix(const float* const* lowbands, ArrayView<float> mono);
+
+  // Delay of `mono` relative to the lowbands in samples, 0 for a single
+  // channel.
+  size_t delay() const { return delay_; }
+
+  bool proper_multichannel_content() const {
+    return content_detector_.IsProperMultiChannelContentDetected();
+  }
+
+ private:
+  const size_t num_channels_;
+  MultiChannelContentDetector content_detector_;
+  AlignmentMixer mixer_;
+  // One band of the current frame for the detector, and one block of it for
+  // the mixer.
+  std::vector<std::vector<std::vector<float>>> frame_;
+  Block block_;
+  // Like the AEC3 FrameBlocker, the samples of each channel that do not fill
+  // a block yet, and the mixed samples not output yet, which start with
+  // `delay_` zeros. Every sample goes through the mixer once.
+  std::vector<std::vector<float>> unmixed_;
+  std::vector<float> mixed_;
+  size_t frame_size_ = 0;
+  size_t delay_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RENDER_MIXER_H_
@@ -0,0 +1,106 @@
+// seek_audio_render_mixer_unittest.cc
+#include "modules/audio_processing/seek_audio_render_mixer.h"
+
+#include <array>
+#include <vector>
+
+#include "modules/audio_processing/seek_audio_common.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// More frames than the stereo detection hysteresis of the default config.
+constexpr int kNumFrames = 400;
+
+void FillNoiseLike(size_t seed, ArrayView<float> frame) {
+  uint32_t state = 12345u + seed;
+  for (float& sample : frame) {
+    state = state * 1664525u + 1013904223u;
+    sample = static_cast<float>(static_cast<int32_t>(state >> 16) - 32768) /
+             8.f;
+  }
+}
+
+// Mixes `kNumFrames` frames of `num_frames` samples of two channels, where
+// the second channel is `gain` times the first one, and returns the channels
+// and the mix of all frames.
+std::array<std::vector<float>, 3> RunStereo(SeekAudioRenderMixer& mixer,
+                                            size_t num_frames,
+                                            float gain) {
+  std::array<std::vector<float>, 3> frames;
+  std::array<std::vector<float>, 3> signals;
+  for (auto& frame : frames) {
+    frame.resize(num_frames);
+  }
+  for (int k = 0; k < kNumFrames; ++k) {
+    FillNoiseLike(k, frames[0]);
+    for (size_t i = 0; i < num_frames; ++i) {
+      frames[1][i] = gain * frames[0][i];
+    }
+    const float* lowbands[] = {frames[0].data(), frames[1].data()};
+    mixer.Mix(lowbands, frames[2]);
+    for (size_t i = 0; i < frames.size(); ++i) {
+      signals[i].insert(signals[i].end(), frames[i].begin(), frames[i].end());
+    }
+  }
+  return signals;
+}
+
+// Expects the last `num_samples` of `mix` to be `channel` delayed by `delay`.
+void ExpectDelayedTail(const std::vector<float>& channel,
+                       const std::vector<float>& mix,
+                       size_t delay,
+                       size_t num_samples) {
+  ASSERT_EQ(channel.size(), mix.size());
+  for (size_t i = mix.size() - num_samples; i < mix.size(); ++i) {
+    ASSERT_EQ(mix[i], channel[i - delay]) << "sample " << i;
+  }
+}
+
+}  // namespace
+
+TEST(SeekAudioRenderMixer, PassesMonoThrough) {
+  SeekAudioRenderMixer mixer(1);
+  std::array<float, kSeekAudioFrameSize> lowband;
+  std::array<float, kSeekAudioFrameSize> mono;
+  FillNoiseLike(0, lowband);
+  const float* lowbands[] = {lowband.data()};
+  mixer.Mix(lowbands, mono);
+  EXPECT_EQ(mono, lowband);
+  EXPECT_FALSE(mixer.proper_multichannel_content());
+}
+
+TEST(SeekAudioRenderMixer, UsesFirstChannelOfUpmixedMono) {
+  for (size_t num_frames :
+       {kSeekAudioFrameSize, kSeekAudioNarrowbandFrameSize}) {
+    SeekAudioRenderMixer mixer(2);
+    auto frames = RunStereo(mixer, num_frames, 1.f);
+    EXPECT_FALSE(mixer.proper_multichannel_content());
+    ExpectDelayedTail(frames[0], frames[2], mixer.delay(), 2 * num_frames);
+  }
+}
+
+TEST(SeekAudioRenderMixer, MixesProperStereo) {
+  for (size_t num_frames :
+       {kSeekAudioFrameSize, kSeekAudioNarrowbandFrameSize}) {
+    // Only the much louder second channel carries the far-end.
+    SeekAudioRenderMixer mixer(2);
+    auto frames = RunStereo(mixer, num_frames, 100.f);
+    EXPECT_TRUE(mixer.proper_multichannel_content());
+    // Every sample is mixed once, so blocks across frame boundaries come out
+    // whole.
+    ExpectDelayedTail(frames[1], frames[2], mixer.delay(), 2 * num_frames);
+  }
+}
+
+TEST(SeekAudioRenderMixer, DelaysByTheUnmixedRemainder) {
+  SeekAudioRenderMixer mixer(2);
+  RunStereo(mixer, kSeekAudioFrameSize, 1.f);
+  EXPECT_EQ(mixer.delay(), 32u);
+  RunStereo(mixer, kSeekAudioNarrowbandFrameSize, 1.f);
+  EXPECT_EQ(mixer.delay(), 48u);
+  EXPECT_EQ(SeekAudioRenderMixer(1).delay(), 0u);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,84 @@
+// seek_audio_resampler.cc
+#include "modules/audio_processing/seek_audio_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kFilterLength = 2 * SeekAudioResampler::kNumTapsPerPhase - 1;
+constexpr size_t kCenterTap = kFilterLength / 2;
+constexpr float kPi = 3.14159265358979323846f;
+
+}  // namespace
+
+SeekAudioResampler::SeekAudioResampler() {
+  // Blackman-windowed sinc with a cutoff at a quarter of the 16 kHz rate. Every
+  // second tap of a half-band filter is zero, apart from the center tap.
+  float sum = 0.f;
+  for (size_t i = 0; i < kNumTapsPerPhase; ++i) {
+    const float n = static_cast<float>(2 * i);
+    const float x = 0.5f * kPi * (n - kCenterTap);
+    const float window =
+        0.42f - 0.5f * std::cos(2.f * kPi * n / (kFilterLength - 1)) +
+        0.08f * std::cos(4.f * kPi * n / (kFilterLength - 1));
+    taps_[i] = 0.5f * std::sin(x) / x * window;
+    sum += taps_[i];
+  }
+  // Normalize to unity DC gain, with the center tap contributing 0.5.
+  for (float& tap : taps_) {
+    tap *= 0.5f / sum;
+  }
+  Reset();
+}
+
+void SeekAudioResampler::Reset() {
+  up_buffer_.fill(0.f);
+  down_buffer_.fill(0.f);
+}
+
+void SeekAudioResampler::Upsample(ArrayView<const float> in,
+                                  ArrayView<float> out) {
+  RTC_DCHECK_LE(in.size(), kSeekAudioNarrowbandFrameSize);
+  RTC_DCHECK_EQ(out.size(), 2 * in.size());
+
+  std::copy(in.begin(), in.end(), up_buffer_.begin() + kUpHistorySize);
+  for (size_t m = 0; m < in.size(); ++m) {
+    const float* x = &up_buffer_[kUpHistorySize + m];
+    float even = 0.f;
+    for (size_t i = 0; i < kNumTapsPerPhase; ++i) {
+      even += taps_[i] * x[-static_cast<ptrdiff_t>(i)];
+    }
+    // The zero-stuffing halves the power, which the factor 2 compensates for.
+    out[2 * m] = 2.f * even;
+    out[2 * m + 1] = x[-static_cast<ptrdiff_t>(kCenterTap / 2)];
+  }
+  std::copy(up_buffer_.begin() + in.size(),
+            up_buffer_.begin() + in.size() + kUpHistorySize,
+            up_buffer_.begin());
+}
+
+void SeekAudioResampler::Downsample(ArrayView<const float> in,
+                                    ArrayView<float> out) {
+  RTC_DCHECK_LE(in.size(), kSeekAudioFrameSize);
+  RTC_DCHECK_EQ(in.size(), 2 * out.size());
+
+  std::copy(in.begin(), in.end(), down_buffer_.begin() + kDownHistorySize);
+  for (size_t m = 0; m < out.size(); ++m) {
+    const float* v = &down_buffer_[kDownHistorySize + 2 * m];
+    float sum = 0.5f * v[-static_cast<ptrdiff_t>(kCenterTap)];
+    for (size_t i = 0; i < kNumTapsPerPhase; ++i) {
+      sum += taps_[i] * v[-static_cast<ptrdiff_t>(2 * i)];
+    }
+    out[m] = sum;
+  }
+  std::copy(down_buffer_.begin() + in.size(),
+            down_buffer_.begin() + in.size() + kDownHistorySize,
+            down_buffer_.begin());
+}
+
+}  // namespace webrtc
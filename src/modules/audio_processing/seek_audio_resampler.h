@@ -0,0 +1,48 @@
+// seek_audio_resampler.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RESAMPLER_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RESAMPLER_H_
+
+#include <array>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/seek_audio_common.h"
+
+namespace webrtc {
+
+// Low-latency 2x polyphase resampler between 8 kHz and the 16 kHz rate of the
+// SeekAudio engines. A 31-tap half-band FIR is split into its two phases so
+// that only the 16 non-trivial taps are evaluated per output sample. Each
+// direction delays the signal by `kDelaySamples16kHz` samples at 16 kHz, so a
+// full up/down round trip costs less than 2 ms.
+class SeekAudioResampler {
+ public:
+  static constexpr size_t kNumTapsPerPhase = 16;
+  static constexpr size_t kDelaySamples16kHz = kNumTapsPerPhase - 1;
+
+  SeekAudioResampler();
+  SeekAudioResampler(const SeekAudioResampler&) = delete;
+  SeekAudioResampler& operator=(const SeekAudioResampler&) = delete;
+
+  // Clears the filter states.
+  void Reset();
+
+  // Upsamples one 8 kHz frame `in` into `out`, which must be twice as long.
+  void Upsample(ArrayView<const float> in, ArrayView<float> out);
+
+  // Downsamples one 16 kHz frame `in` into `out`, which must be half as long.
+  void Downsample(ArrayView<const float> in, ArrayView<float> out);
+
+ private:
+  static constexpr size_t kUpHistorySize = kNumTapsPerPhase - 1;
+  static constexpr size_t kDownHistorySize = 2 * kNumTapsPerPhase - 2;
+
+  // Taps of the non-trivial phase. The other phase only holds the 0.5 center
+  // tap of the half-band filter.
+  std::array<float, kNumTapsPerPhase> taps_;
+  std::array<float, kUpHistorySize + kSeekAudioNarrowbandFrameSize> up_buffer_;
+  std::array<float, kDownHistorySize + kSeekAudioFrameSize> down_buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_RESAMPLER_H_
@@ -0,0 +1,115 @@
+// seek_audio_resampler_unittest.cc
+#include "modules/audio_processing/seek_audio_resampler.h"
+
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+
+void FillSine(float frequency_hz,
+              int sample_rate_hz,
+              size_t offset,
+              ArrayView<float> frame) {
+  for (size_t k = 0; k < frame.size(); ++k) {
+    frame[k] = 1000.f * std::sin(2.f * kPi * frequency_hz * (offset + k) /
+                                 sample_rate_hz);
+  }
+}
+
+}  // namespace
+
+// Verifies that a constant signal passes with unity gain in both directions.
+TEST(SeekAudioResampler, UnityDcGain) {
+  SeekAudioResampler resampler;
+  std::array<float, kSeekAudioNarrowbandFrameSize> narrowband;
+  std::array<float, kSeekAudioFrameSize> wideband;
+  narrowband.fill(100.f);
+  for (int frame = 0; frame < 3; ++frame) {
+    resampler.Upsample(narrowband, wideband);
+  }
+  for (float sample : wideband) {
+    EXPECT_NEAR(100.f, sample, 0.5f);
+  }
+
+  wideband.fill(100.f);
+  for (int frame = 0; frame < 3; ++frame) {
+    resampler.Downsample(wideband, narrowband);
+  }
+  for (float sample : narrowband) {
+    EXPECT_NEAR(100.f, sample, 0.5f);
+  }
+}
+
+// Verifies that an up/down round trip reproduces a delayed in-band tone.
+TEST(SeekAudioResampler, RoundTripDelaysInBandTone) {
+  SeekAudioResampler resampler;
+  // Each direction delays by 15 samples at 16 kHz, 15 samples at 8 kHz in total.
+  constexpr size_t kRoundTripDelay8kHz =
+      SeekAudioResampler::kDelaySamples16kHz;
+  std::array<float, kSeekAudioNarrowbandFrameSize> input;
+  std::array<float, kSeekAudioNarrowbandFrameSize> output;
+  std::array<float, kSeekAudioFrameSize> wideband;
+  std::array<float, kSeekAudioNarrowbandFrameSize> expected;
+  for (size_t frame = 0; frame < 10; ++frame) {
+    const size_t offset = frame * kSeekAudioNarrowbandFrameSize;
+    FillSine(500.f, 8000, offset, input);
+    resampler.Upsample(input, wideband);
+    resampler.Downsample(wideband, output);
+    if (frame < 2) {
+      continue;
+    }
+    FillSine(500.f, 8000, offset - kRoundTripDelay8kHz, expected);
+    for (size_t k = 0; k < output.size(); ++k) {
+      EXPECT_NEAR(expected[k], output[k], 10.f);
+    }
+  }
+}
+
+// Verifies that content above 4 kHz is removed by the decimation.
+TEST(SeekAudioResampler, DownsamplingAttenuatesAliases) {
+  SeekAudioResampler resampler;
+  std::array<float, kSeekAudioFrameSize> wideband;
+  std::array<float, kSeekAudioNarrowbandFrameSize> narrowband;
+  float energy = 0.f;
+  for (size_t frame = 0; frame < 10; ++frame) {
+    FillSine(6000.f, 16000, frame * kSeekAudioFrameSize, wideband);
+    resampler.Downsample(wideband, narrowband);
+    if (frame < 2) {
+      continue;
+    }
+    for (float sample : narrowband) {
+      energy += sample * sample;
+    }
+  }
+  const float rms = std::sqrt(energy / (8 * kSeekAudioNarrowbandFrameSize));
+  EXPECT_LT(rms, 1000.f * 0.01f);
+}
+
+TEST(SeekAudioResampler, DISABLED_Benchmark) {
+  SeekAudioResampler resampler;
+  std::array<float, kSeekAudioNarrowbandFrameSize> narrowband;
+  std::array<float, kSeekAudioFrameSize> wideband;
+  FillSine(440.f, 8000, 0, narrowband);
+  constexpr int kNumFrames = 100000;
+  test::PerformanceTimer perf_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    perf_timer.StartTimer();
+    resampler.Upsample(narrowband, wideband);
+    resampler.Downsample(wideband, narrowband);
+    perf_timer.StopTimer();
+  }
+  RTC_LOG(LS_INFO) << "Round trip: " << perf_timer.GetDurationAverage()
+                   << " +/- " << perf_timer.GetDurationStandardDeviation()
+                   << " us per 10 ms frame, latency "
+                   << 2 * SeekAudioResampler::kDelaySamples16kHz / 16.f
+                   << " ms";
+}
+
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+// seek_audio_sample_converter.cc
+#include "modules/audio_processing/seek_audio_sample_converter.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+void SeekAudioSampleConverter::FloatS16ToS16(ArrayView<const float> in,
+                                             ArrayView<int16_t> out) const {
+  RTC_DCHECK_EQ(in.size(), out.size());
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    FloatS16ToS16Avx2(in, out);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    // Clamping in float avoids the 0x80000000 result of the conversion for
+    // large positive values.
+    const __m128 max = _mm_set1_ps(32767.f);
+    const __m128 min = _mm_set1_ps(-32768.f);
+    for (; i + 8 <= in.size(); i += 8) {
+      const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&in[i]), min), max);
+      const __m128 b =
+          _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&in[i + 4]), min), max);
+      const __m128i packed =
+          _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), packed);
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    const float32x4_t max = vdupq_n_f32(32767.f);
+    const float32x4_t min = vdupq_n_f32(-32768.f);
+    for (; i + 8 <= in.size(); i += 8) {
+      const float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(&in[i]), min), max);
+      const float32x4_t b =
+          vminq_f32(vmaxq_f32(vld1q_f32(&in[i + 4]), min), max);
+      // vcvtq_s32_f32 truncates towards zero.
+      const int16x8_t packed = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)),
+                                            vqmovn_s32(vcvtq_s32_f32(b)));
+      vst1q_s16(&out[i], packed);
+    }
+  }
+#endif
+  for (; i < in.size(); ++i) {
+    out[i] = static_cast<int16_t>(std::min(std::max(in[i], -32768.f), 32767.f));
+  }
+}
+
+void SeekAudioSampleConverter::S16ToFloatS16(ArrayView<const int16_t> in,
+                                             ArrayView<float> out) const {
+  RTC_DCHECK_EQ(in.size(), out.size());
+  size_t i = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    S16ToFloatS16Avx2(in, out);
+    return;
+  }
+  if (cpu_features_.sse2) {
+    for (; i + 8 <= in.size(); i += 8) {
+      const __m128i x =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+      // Sign-extend by interleaving with the sign mask.
+      const __m128i sign = _mm_srai_epi16(x, 15);
+      _mm_storeu_ps(&out[i], _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, sign)));
+      _mm_storeu_ps(&out[i + 4], _mm_cvtepi32_ps(_mm_unpackhi_epi16(x, sign)));
+    }
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    for (; i + 8 <= in.size(); i += 8) {
+      const int16x8_t x = vld1q_s16(&in[i]);
+      vst1q_f32(&out[i], vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))));
+      vst1q_f32(&out[i + 4], vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))));
+    }
+  }
+#endif
+  for (; i < in.size(); ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+}  // namespace webrtc
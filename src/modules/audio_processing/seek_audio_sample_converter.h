@@ -0,0 +1,35 @@
+// seek_audio_sample_converter.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SAMPLE_CONVERTER_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SAMPLE_CONVERTER_H_
+
+#include <stdint.h>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+
+namespace webrtc {
+
+// Converts between the FloatS16 samples of APM and the int16 samples of the
+// SeekAudio ABI. Used when the engine library lacks the float entry points.
+// All implementations are bit-exact with the scalar one: samples are clamped
+// to [-32768, 32767] and truncated towards zero.
+class SeekAudioSampleConverter {
+ public:
+  explicit SeekAudioSampleConverter(AvailableCpuFeatures cpu_features)
+      : cpu_features_(cpu_features) {}
+
+  void FloatS16ToS16(ArrayView<const float> in, ArrayView<int16_t> out) const;
+  void S16ToFloatS16(ArrayView<const int16_t> in, ArrayView<float> out) const;
+
+ private:
+  void FloatS16ToS16Avx2(ArrayView<const float> in,
+                         ArrayView<int16_t> out) const;
+  void S16ToFloatS16Avx2(ArrayView<const int16_t> in,
+                         ArrayView<float> out) const;
+
+  const AvailableCpuFeatures cpu_features_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SAMPLE_CONVERTER_H_
@@ -0,0 +1,48 @@
+// seek_audio_sample_converter_avx2.cc
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "modules/audio_processing/seek_audio_sample_converter.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void SeekAudioSampleConverter::FloatS16ToS16Avx2(ArrayView<const float> in,
+                                                 ArrayView<int16_t> out) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(in.size(), out.size());
+  const __m256 max = _mm256_set1_ps(32767.f);
+  const __m256 min = _mm256_set1_ps(-32768.f);
+  size_t i = 0;
+  for (; i + 16 <= in.size(); i += 16) {
+    const __m256 a =
+        _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&in[i]), min), max);
+    const __m256 b =
+        _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(&in[i + 8]), min), max);
+    // The pack works per 128-bit lane, the permute restores sample order.
+    const __m256i packed =
+        _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[i]),
+                        _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+  for (; i < in.size(); ++i) {
+    out[i] = static_cast<int16_t>(std::min(std::max(in[i], -32768.f), 32767.f));
+  }
+}
+
+void SeekAudioSampleConverter::S16ToFloatS16Avx2(ArrayView<const int16_t> in,
+                                                 ArrayView<float> out) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(in.size(), out.size());
+  size_t i = 0;
+  for (; i + 8 <= in.size(); i += 8) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+    _mm256_storeu_ps(&out[i], _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(x)));
+  }
+  for (; i < in.size(); ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,109 @@
+// seek_audio_sample_converter_unittest.cc
+#include "modules/audio_processing/seek_audio_sample_converter.h"
+
+#include <array>
+#include <vector>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/seek_audio_common.h"
+#include "modules/audio_processing/test/performance_timer.h"
+#include "rtc_base/logging.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Odd length so that every implementation also runs its scalar tail.
+constexpr size_t kNumSamples = kSeekAudioFrameSize + 7;
+
+std::vector<float> CreateFloatInput() {
+  std::vector<float> x(kNumSamples);
+  const std::array<float, 12> kEdgeValues = {
+      0.f,      0.9f,      -0.9f,     32766.6f,  32767.f,   32767.9f,
+      32768.f,  -32768.f,  -32768.9f, 40000.f,   -40000.f,  3.0e9f};
+  std::copy(kEdgeValues.begin(), kEdgeValues.end(), x.begin());
+  for (size_t i = kEdgeValues.size(); i < x.size(); ++i) {
+    x[i] = (static_cast<float>(i * 7919 % 1000) - 500.f) * 80.3f;
+  }
+  return x;
+}
+
+class SeekAudioSampleConverterParametrization
+    : public ::testing::TestWithParam<AvailableCpuFeatures> {};
+
+TEST_P(SeekAudioSampleConverterParametrization, FloatS16ToS16IsBitExact) {
+  const SeekAudioSampleConverter converter(GetParam());
+  const SeekAudioSampleConverter reference(NoAvailableCpuFeatures());
+  const std::vector<float> x = CreateFloatInput();
+  std::vector<int16_t> y(x.size());
+  std::vector<int16_t> y_ref(x.size());
+  converter.FloatS16ToS16(x, y);
+  reference.FloatS16ToS16(x, y_ref);
+  EXPECT_EQ(y_ref, y);
+  EXPECT_EQ(32767, y[5]);
+  EXPECT_EQ(32767, y[11]);
+  EXPECT_EQ(-32768, y[8]);
+  EXPECT_EQ(0, y[2]);
+}
+
+TEST_P(SeekAudioSampleConverterParametrization, S16ToFloatS16IsExact) {
+  const SeekAudioSampleConverter converter(GetParam());
+  std::vector<int16_t> x(kNumSamples);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = static_cast<int16_t>(i * 409 - 32768);
+  }
+  std::vector<float> y(x.size());
+  converter.S16ToFloatS16(x, y);
+  for (size_t i = 0; i < x.size(); ++i) {
+    EXPECT_EQ(static_cast<float>(x[i]), y[i]);
+  }
+}
+
+// Compares the per-frame cost of the int16 fallback path of the SeekAudio
+// wrappers with the float entry point, which needs no conversion at all.
+TEST_P(SeekAudioSampleConverterParametrization, DISABLED_Benchmark) {
+  const SeekAudioSampleConverter converter(GetParam());
+  std::vector<float> frame = CreateFloatInput();
+  frame.resize(kSeekAudioFrameSize);
+  std::array<int16_t, kSeekAudioFrameSize> s16_frame;
+  constexpr int kNumFrames = 100000;
+  test::PerformanceTimer perf_timer(kNumFrames);
+  for (int k = 0; k < kNumFrames; ++k) {
+    perf_timer.StartTimer();
+    converter.FloatS16ToS16(frame, s16_frame);
+    converter.S16ToFloatS16(s16_frame, frame);
+    perf_timer.StopTimer();
+  }
+  RTC_LOG(LS_INFO) << GetParam().ToString()
+                   << " int16 round trip: " << perf_timer.GetDurationAverage()
+                   << " +/- " << perf_timer.GetDurationStandardDeviation()
+                   << " us per frame, float path: 0 us";
+}
+
+// Finds the relevant CPU features combinations to test.
+std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
+  std::vector<AvailableCpuFeatures> v;
+  v.push_back(NoAvailableCpuFeatures());
+  AvailableCpuFeatures available = GetAvailableCpuFeatures();
+  if (available.sse2) {
+    v.push_back({/*sse2=*/true, /*avx2=*/false, /*neon=*/false});
+  }
+  if (available.avx2) {
+    v.push_back({/*sse2=*/false, /*avx2=*/true, /*neon=*/false});
+  }
+  if (available.neon) {
+    v.push_back({/*sse2=*/false, /*avx2=*/false, /*neon=*/true});
+  }
+  return v;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SeekAudio,
+    SeekAudioSampleConverterParametrization,
+    ::testing::ValuesIn(GetCpuFeaturesToTest()),
+    [](const ::testing::TestParamInfo<AvailableCpuFeatures>& info) {
+      return info.param.ToString();
+    });
+
+}  // namespace
+}  // namespace webrtc
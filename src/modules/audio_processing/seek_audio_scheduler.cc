@@ -0,0 +1,283 @@
+// seek_audio_scheduler.cc
+#include "modules/audio_processing/seek_audio_scheduler.h"
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+#include <sched.h>  // sched_setaffinity
+#endif
+
+#include <algorithm>
+#include <map>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+namespace {
+
+void PinCurrentThread(int worker_index) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  const int num_cores = std::max<int>(CpuInfo::DetectNumberOfCores(), 1);
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(worker_index % num_cores, &cpu_set);
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to pin SeekAudio worker " << worker_index;
+  }
+#endif
+}
+
+// Same ownership scheme as the library registry: weak references only, the
+// users own the schedulers.
+Mutex& SharedMutex() {
+  static Mutex* const mutex = new Mutex();
+  return *mutex;
+}
+
+std::map<int, std::weak_ptr<SeekAudioScheduler>>& SharedSchedulers() {
+  static auto* const schedulers =
+      new std::map<int, std::weak_ptr<SeekAudioScheduler>>();
+  return *schedulers;
+}
+
+}  // namespace
+
+constexpr size_t SeekAudioScheduler::kMaxBatchSize;
+
+SeekAudioScheduler::SeekAudioScheduler(int num_workers, bool pin_workers)
+    : num_workers_(num_workers) {
+  RTC_DCHECK_GT(num_workers_, 0);
+  workers_.reserve(num_workers);
+  for (int k = 0; k < num_workers; ++k) {
+    workers_.push_back(PlatformThread::SpawnJoinable(
+        [this, k, pin_workers] { Run(k, pin_workers); },
+        "SeekAudioScheduler",
+        ThreadAttributes().SetPriority(ThreadPriority::kRealtime)));
+  }
+}
+
+SeekAudioScheduler::~SeekAudioScheduler() {
+  quit_.store(true, std::memory_order_release);
+  // Each exiting worker wakes the next one.
+  wakeup_.Set();
+  for (PlatformThread& worker : workers_) {
+    worker.Finalize();
+  }
+  RTC_DCHECK_EQ(num_ready_.load(), 0)
+      << "Streams must be removed before destruction";
+}
+
+std::shared_ptr<SeekAudioScheduler> SeekAudioScheduler::AcquireShared(
+    int num_workers) {
+  MutexLock lock(&SharedMutex());
+  std::weak_ptr<SeekAudioScheduler>& entry = SharedSchedulers()[num_workers];
+  std::shared_ptr<SeekAudioScheduler> scheduler = entry.lock();
+  if (!scheduler) {
+    scheduler = std::make_shared<SeekAudioScheduler>(num_workers,
+                                                     /*pin_workers=*/true);
+    entry = scheduler;
+    RTC_LOG(LS_INFO) << "Started shared SeekAudio scheduler with "
+                     << num_workers << " workers";
+  }
+  return scheduler;
+}
+
+void SeekAudioScheduler::Schedule(Stream* stream) {
+  using State = Stream::State;
+  State state = stream->state_.load(std::memory_order_acquire);
+  while (true) {
+    switch (state) {
+      case State::kIdle:
+        if (stream->state_.compare_exchange_weak(state, State::kQueued,
+                                                 std::memory_order_acq_rel)) {
+          PushBack(stream);
+          WakeIdleWorker();
+          return;
+        }
+        break;
+      case State::kRunning:
+        if (stream->state_.compare_exchange_weak(state, State::kRerun,
+                                                 std::memory_order_acq_rel)) {
+          return;
+        }
+        break;
+      case State::kQueued:
+      case State::kRerun:
+        return;
+      case State::kCancelled:
+        // Scheduled after Remove().
+        RTC_DCHECK_NOTREACHED();
+        return;
+    }
+  }
+}
+
+void SeekAudioScheduler::Remove(Stream* stream) {
+  using State = Stream::State;
+  while (true) {
+    State state = stream->state_.load(std::memory_order_acquire);
+    if (state == State::kIdle) {
+      return;
+    }
+    if (state == State::kQueued) {
+      // The stream cannot be unlinked from the lock-free queue, so the worker
+      // that dequeues it drops it.
+      if (stream->state_.compare_exchange_strong(
+              state, State::kCancelled, std::memory_order_acq_rel)) {
+        wakeup_.Set();
+      }
+      continue;
+    }
+    if (state == State::kRerun) {
+      stream->state_.compare_exchange_strong(state, State::kRunning,
+                                             std::memory_order_acq_rel);
+      continue;
+    }
+    // The current batch is short, so polling is fine for this rare case.
+    batch_done_.Wait(TimeDelta::Millis(1));
+  }
+}
+
+void SeekAudioScheduler::Run(int worker_index, bool pin) {
+  if (pin) {
+    PinCurrentThread(worker_index);
+  }
+
+  std::array<Stream*, kMaxBatchSize> batch;
+  while (!quit_.load(std::memory_order_acquire)) {
+    const size_t batch_size = TakeBatch(batch);
+    if (batch_size == 0) {
+      // Either the producer of a stream queued after TakeBatch() sees this
+      // worker as idle and wakes it, or the worker sees the stream here. The
+      // event is auto-reset, so a wakeup before the wait is not lost.
+      num_idle_workers_.fetch_add(1, std::memory_order_seq_cst);
+      if (num_ready_.load(std::memory_order_seq_cst) <= 0) {
+        wakeup_.Wait(Event::kForever);
+      }
+      num_idle_workers_.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
+    for (size_t k = 0; k < batch_size; ++k) {
+      batch[k]->RunPendingRequests();
+    }
+    FinishBatch(batch, batch_size);
+  }
+  wakeup_.Set();
+}
+
+size_t SeekAudioScheduler::TakeBatch(
+    std::array<Stream*, kMaxBatchSize>& batch) {
+  using State = Stream::State;
+  bool dropped_cancelled = false;
+  size_t batch_size = 0;
+  {
+    MutexLock lock(&pop_mutex_);
+    // Spread the queued streams over the workers, but take enough of them
+    // for the batch to amortize the wakeup.
+    // The count lags behind the queue and may be briefly negative.
+    const int num_ready =
+        std::max(num_ready_.load(std::memory_order_relaxed), 0);
+    const size_t share = (num_ready + num_workers_ - 1) / num_workers_;
+    const size_t max_batch_size = std::clamp<size_t>(share, 1, kMaxBatchSize);
+    while (batch_size < max_batch_size) {
+      Stream* stream = PopFront();
+      if (!stream) {
+        break;
+      }
+      State state = State::kQueued;
+      if (!stream->state_.compare_exchange_strong(state, State::kRunning,
+                                                  std::memory_order_acq_rel)) {
+        // Removed while queued. Remove() returns once the stream is idle, so
+        // the stream must not be touched afterwards.
+        RTC_DCHECK(state == State::kCancelled);
+        stream->state_.store(State::kIdle, std::memory_order_release);
+        dropped_cancelled = true;
+        continue;
+      }
+      batch[batch_size++] = stream;
+    }
+  }
+  if (dropped_cancelled) {
+    batch_done_.Set();
+  }
+  if (num_ready_.load(std::memory_order_relaxed) > 0) {
+    // Let another worker take the rest.
+    WakeIdleWorker();
+  }
+  return batch_size;
+}
+
+void SeekAudioScheduler::FinishBatch(std::array<Stream*, kMaxBatchSize>& batch,
+                                     size_t batch_size) {
+  using State = Stream::State;
+  for (size_t k = 0; k < batch_size; ++k) {
+    Stream* stream = batch[k];
+    // Remove() may turn a rerun back into a plain run concurrently.
+    State state = stream->state_.load(std::memory_order_acquire);
+    while (true) {
+      RTC_DCHECK(state == State::kRunning || state == State::kRerun);
+      const State next =
+          state == State::kRunning ? State::kIdle : State::kQueued;
+      if (stream->state_.compare_exchange_weak(state, next,
+                                               std::memory_order_acq_rel)) {
+        if (next == State::kQueued) {
+          // Taken by this worker on its next round at the latest.
+          PushBack(stream);
+        }
+        break;
+      }
+    }
+  }
+  batch_done_.Set();
+}
+
+void SeekAudioScheduler::WakeIdleWorker() {
+  if (num_idle_workers_.load(std::memory_order_seq_cst) > 0) {
+    wakeup_.Set();
+  }
+}
+
+void SeekAudioScheduler::PushBack(Stream* stream) {
+  PushNode(&stream->node_);
+  num_ready_.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void SeekAudioScheduler::PushNode(Node* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  Node* previous = ready_head_.exchange(node, std::memory_order_acq_rel);
+  // Until this store, the consumer sees the queue end at `previous`.
+  previous->next.store(node, std::memory_order_release);
+}
+
+SeekAudioScheduler::Stream* SeekAudioScheduler::PopFront() {
+  Node* tail = ready_tail_;
+  Node* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next) {
+      return nullptr;
+    }
+    ready_tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+  if (!next) {
+    if (tail != ready_head_.load(std::memory_order_acquire)) {
+      // A producer is between its exchange and its link store.
+      return nullptr;
+    }
+    // `tail` is the last node. The stub takes its place so that it can be
+    // dequeued without racing the producers.
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (!next) {
+      return nullptr;
+    }
+  }
+  ready_tail_ = next;
+  num_ready_.fetch_sub(1, std::memory_order_relaxed);
+  return tail->stream;
+}
+
+}  // namespace webrtc
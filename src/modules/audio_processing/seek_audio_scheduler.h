@@ -0,0 +1,127 @@
+// seek_audio_scheduler.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SCHEDULER_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SCHEDULER_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the engine calls of many SeekAudio streams on a fixed pool of worker
+// threads instead of one thread per stream, for hosts running hundreds of APM
+// instances. Streams with pending work are queued and taken in batches, so
+// that a worker runs many streams back to back on the same core and the model
+// weights stay in its caches.
+//
+// Scheduling is lock-free: the producer thread of a stream, typically a
+// realtime capture thread, never waits for the workers or for other streams.
+class SeekAudioScheduler {
+ public:
+  static constexpr size_t kMaxBatchSize = 16;
+
+  class Stream;
+
+ private:
+  // Link of the intrusive ready queue. The stub node has no stream.
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    Stream* stream = nullptr;
+  };
+
+ public:
+  // A stream is run by at most one worker at a time, so that its requests can
+  // be handed over through single-consumer queues.
+  class Stream {
+   public:
+    Stream() { node_.stream = this; }
+    virtual ~Stream() = default;
+    // Runs all requests pending for this stream.
+    virtual void RunPendingRequests() = 0;
+
+   private:
+    friend class SeekAudioScheduler;
+    enum class State {
+      kIdle,
+      kQueued,
+      kRunning,
+      // Scheduled while running; queued again when the run ends.
+      kRerun,
+      // Removed while queued; dropped by the worker that dequeues it.
+      kCancelled
+    };
+    std::atomic<State> state_{State::kIdle};
+    Node node_;
+  };
+
+  // With `pin_workers`, worker k is bound to core k modulo the number of
+  // cores where the platform supports it.
+  SeekAudioScheduler(int num_workers, bool pin_workers);
+  ~SeekAudioScheduler();
+  SeekAudioScheduler(const SeekAudioScheduler&) = delete;
+  SeekAudioScheduler& operator=(const SeekAudioScheduler&) = delete;
+
+  // Returns the process-wide scheduler with `num_workers` pinned workers,
+  // creating it if needed. It is shared by all users in the process and
+  // stopped with its last user.
+  static std::shared_ptr<SeekAudioScheduler> AcquireShared(int num_workers);
+
+  int num_workers() const { return num_workers_; }
+
+  // Queues `stream` for a run. If the stream is running, it is run once more
+  // afterwards. Called by the producer thread of the stream.
+  void Schedule(Stream* stream);
+
+  // Cancels a pending run of `stream` and waits until no worker runs it
+  // anymore. Must be called by the producer thread of the stream before it is
+  // destroyed. Unlike Schedule(), this may block.
+  void Remove(Stream* stream);
+
+ private:
+  void Run(int worker_index, bool pin);
+  // Appends `stream` to the ready queue. Lock-free, any thread.
+  void PushBack(Stream* stream);
+  // Dequeues the oldest ready stream, or returns null if the queue is empty
+  // or a concurrent PushBack() is not complete yet.
+  Stream* PopFront() RTC_EXCLUSIVE_LOCKS_REQUIRED(pop_mutex_);
+  void PushNode(Node* node);
+  void WakeIdleWorker();
+  // Takes a share of the queued streams for one worker.
+  size_t TakeBatch(std::array<Stream*, kMaxBatchSize>& batch);
+  void FinishBatch(std::array<Stream*, kMaxBatchSize>& batch,
+                   size_t batch_size);
+
+  // Set before the workers start, unlike `workers_`.
+  const int num_workers_;
+
+  // Multi-producer single-consumer queue of the ready streams. Producers
+  // append at `ready_head_` without locking; the workers take turns as the
+  // consumer under `pop_mutex_`, which the producers never take.
+  Node stub_;
+  std::atomic<Node*> ready_head_{&stub_};
+  Mutex pop_mutex_;
+  Node* ready_tail_ RTC_GUARDED_BY(pop_mutex_) = &stub_;
+  // Streams in the ready queue. Counted after they are linked, so that an idle
+  // worker that sees the count can dequeue them.
+  std::atomic<int> num_ready_{0};
+  // Workers about to wait for `wakeup_`. Producers only signal the event when
+  // there are any, as signalling takes the lock of the event.
+  std::atomic<int> num_idle_workers_{0};
+
+  Event wakeup_;
+  Event batch_done_;
+  std::atomic<bool> quit_{false};
+  std::vector<PlatformThread> workers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SCHEDULER_H_
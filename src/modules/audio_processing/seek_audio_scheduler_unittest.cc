@@ -0,0 +1,253 @@
+// seek_audio_scheduler_unittest.cc
+#include "modules/audio_processing/seek_audio_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "modules/audio_processing/seek_audio_async_processor.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Frame = SeekAudioAsyncProcessor::Frame;
+
+// Stand-in for the engine: scales the frame and, optionally, burns about as
+// much CPU as a small model per frame.
+class FakeEngine : public SeekAudioAsyncProcessor::Handler {
+ public:
+  explicit FakeEngine(int work_per_frame = 0)
+      : work_per_frame_(work_per_frame) {}
+
+  void ProcessCaptureFrame(
+      ArrayView<float, kSeekAudioFrameSize> frame) override {
+    for (int k = 0; k < work_per_frame_; ++k) {
+      for (float& sample : frame) {
+        sample = sample * 0.999f + 0.001f;
+      }
+    }
+    inputs.push_back(frame[0]);
+    for (float& sample : frame) {
+      sample *= 2.f;
+    }
+    num_processed.fetch_add(1, std::memory_order_release);
+  }
+  void AnalyzeRenderFrame(
+      ArrayView<const float, kSeekAudioFrameSize> frame) override {}
+  void ApplyControl(int id, int value) override {}
+
+  std::vector<float> inputs;
+  std::atomic<int> num_processed{0};
+
+ private:
+  const int work_per_frame_;
+};
+
+Frame ConstantFrame(float value) {
+  Frame frame;
+  frame.fill(value);
+  return frame;
+}
+
+// Feeds `num_frames` frames to every processor from one thread, the way a
+// mixing host does, keeping the pipeline at most `lookahead` frames deep.
+// Returns the processing rate in frames per second over all streams.
+double RunStreams(
+    std::vector<std::unique_ptr<FakeEngine>>& engines,
+    std::vector<std::unique_ptr<SeekAudioAsyncProcessor>>& processors,
+    int num_frames,
+    int lookahead) {
+  const int64_t start_us = TimeMicros();
+  for (int k = 0; k < num_frames; ++k) {
+    for (auto& processor : processors) {
+      Frame frame = ConstantFrame(k + 1);
+      processor->ProcessCapture(frame);
+    }
+    for (auto& engine : engines) {
+      while (engine->num_processed.load(std::memory_order_acquire) <
+             k + 1 - lookahead) {
+        std::this_thread::yield();
+      }
+    }
+  }
+  for (auto& engine : engines) {
+    while (engine->num_processed.load(std::memory_order_acquire) <
+           num_frames) {
+      std::this_thread::yield();
+    }
+  }
+  const int64_t duration_us = std::max<int64_t>(TimeMicros() - start_us, 1);
+  return 1e6 * num_frames * engines.size() / duration_us;
+}
+
+}  // namespace
+
+TEST(SeekAudioScheduler, StreamsShareWorkers) {
+  constexpr int kNumStreams = 8;
+  constexpr int kNumFrames = 100;
+  constexpr int kLookahead = 2;
+  auto scheduler =
+      std::make_shared<SeekAudioScheduler>(2, /*pin_workers=*/false);
+  std::vector<std::unique_ptr<FakeEngine>> engines;
+  std::vector<std::unique_ptr<SeekAudioAsyncProcessor>> processors;
+  for (int k = 0; k < kNumStreams; ++k) {
+    engines.push_back(std::make_unique<FakeEngine>());
+    processors.push_back(std::make_unique<SeekAudioAsyncProcessor>(
+        engines.back().get(), kLookahead, scheduler));
+  }
+
+  RunStreams(engines, processors, kNumFrames, kLookahead);
+  for (auto& processor : processors) {
+    EXPECT_EQ(processor->num_dropped_requests(), 0);
+  }
+  processors.clear();
+
+  // Every stream sees its own frames in order, even though they were run by
+  // different workers.
+  for (const auto& engine : engines) {
+    ASSERT_EQ(engine->inputs.size(), static_cast<size_t>(kNumFrames));
+    for (int k = 0; k < kNumFrames; ++k) {
+      EXPECT_EQ(engine->inputs[k], k + 1);
+    }
+  }
+}
+
+// Streams are scheduled concurrently from their own capture threads, each
+// of which must see all its frames processed in order.
+TEST(SeekAudioScheduler, SchedulesFromManyProducerThreads) {
+  constexpr int kNumStreams = 8;
+  constexpr int kNumFrames = 200;
+  constexpr int kLookahead = 2;
+  auto scheduler =
+      std::make_shared<SeekAudioScheduler>(3, /*pin_workers=*/false);
+  std::vector<std::unique_ptr<FakeEngine>> engines;
+  std::vector<std::unique_ptr<SeekAudioAsyncProcessor>> processors;
+  for (int k = 0; k < kNumStreams; ++k) {
+    engines.push_back(std::make_unique<FakeEngine>());
+    processors.push_back(std::make_unique<SeekAudioAsyncProcessor>(
+        engines.back().get(), kLookahead, scheduler));
+  }
+
+  std::vector<std::thread> producers;
+  for (int k = 0; k < kNumStreams; ++k) {
+    producers.emplace_back([&engine = *engines[k],
+                            &processor = *processors[k]] {
+      for (int n = 0; n < kNumFrames; ++n) {
+        Frame frame = ConstantFrame(n + 1);
+        processor.ProcessCapture(frame);
+        while (engine.num_processed.load(std::memory_order_acquire) <
+               n + 1 - kLookahead) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  processors.clear();
+
+  for (const auto& engine : engines) {
+    ASSERT_EQ(engine->inputs.size(), static_cast<size_t>(kNumFrames));
+    for (int k = 0; k < kNumFrames; ++k) {
+      EXPECT_EQ(engine->inputs[k], k + 1);
+    }
+  }
+}
+
+TEST(SeekAudioScheduler, ReturnsDelayedResultsAndSlack) {
+  constexpr int kLookahead = 3;
+  auto scheduler =
+      std::make_shared<SeekAudioScheduler>(1, /*pin_workers=*/false);
+  FakeEngine engine;
+  SeekAudioAsyncProcessor processor(&engine, kLookahead, scheduler);
+  EXPECT_EQ(processor.scheduler(), scheduler.get());
+  for (int k = 0; k < 20; ++k) {
+    Frame frame = ConstantFrame(k + 1);
+    const bool processed = processor.ProcessCapture(frame);
+    const float input = std::max(k + 1 - kLookahead, 0);
+    EXPECT_EQ(frame[0], processed ? 2.f * input : input);
+    // Let the worker catch up, well within the deadline.
+    while (engine.num_processed.load(std::memory_order_acquire) < k + 1) {
+      std::this_thread::yield();
+    }
+    if (processed) {
+      EXPECT_GT(processor.deadline_slack_us(), 0);
+      EXPECT_LE(processor.deadline_slack_us(), kLookahead * 10000);
+    }
+  }
+  EXPECT_EQ(processor.num_late_frames(), 0);
+}
+
+TEST(SeekAudioScheduler, RemovesStreamsWhileOthersRun) {
+  auto scheduler =
+      std::make_shared<SeekAudioScheduler>(2, /*pin_workers=*/false);
+  FakeEngine busy_engine(/*work_per_frame=*/10);
+  SeekAudioAsyncProcessor busy(&busy_engine, 1, scheduler);
+  for (int k = 0; k < 50; ++k) {
+    FakeEngine engine;
+    {
+      SeekAudioAsyncProcessor processor(&engine, 1, scheduler);
+      Frame frame = ConstantFrame(1.f);
+      Frame busy_frame = ConstantFrame(1.f);
+      processor.ProcessCapture(frame);
+      busy.ProcessCapture(busy_frame);
+    }
+    // Pending requests are run on removal at the latest.
+    EXPECT_EQ(engine.num_processed.load(), 1);
+  }
+}
+
+TEST(SeekAudioScheduler, SharedSchedulerIsReused) {
+  std::shared_ptr<SeekAudioScheduler> first =
+      SeekAudioScheduler::AcquireShared(2);
+  std::shared_ptr<SeekAudioScheduler> second =
+      SeekAudioScheduler::AcquireShared(2);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->num_workers(), 2);
+  EXPECT_NE(SeekAudioScheduler::AcquireShared(1), first);
+}
+
+// Compares the number of streams that can be processed per core in real time
+// by one worker thread per stream, the model of SeekAudioAsyncProcessor
+// without scheduler, and by a pool of one pinned worker per core.
+TEST(SeekAudioScheduler, DISABLED_StreamsPerCoreBenchmark) {
+  constexpr int kNumFrames = 200;
+  constexpr int kLookahead = 2;
+  constexpr int kWorkPerFrame = 200;
+  const int num_cores = std::max<int>(CpuInfo::DetectNumberOfCores(), 1);
+
+  for (int num_streams : {16, 64, 256}) {
+    double frames_per_second[2];
+    for (int pooled = 0; pooled < 2; ++pooled) {
+      std::shared_ptr<SeekAudioScheduler> scheduler;
+      if (pooled) {
+        scheduler = std::make_shared<SeekAudioScheduler>(num_cores,
+                                                         /*pin_workers=*/true);
+      }
+      std::vector<std::unique_ptr<FakeEngine>> engines;
+      std::vector<std::unique_ptr<SeekAudioAsyncProcessor>> processors;
+      for (int k = 0; k < num_streams; ++k) {
+        engines.push_back(std::make_unique<FakeEngine>(kWorkPerFrame));
+        processors.push_back(std::make_unique<SeekAudioAsyncProcessor>(
+            engines.back().get(), kLookahead, scheduler));
+      }
+      frames_per_second[pooled] =
+          RunStreams(engines, processors, kNumFrames, kLookahead);
+    }
+    // A real-time stream needs 100 frames per second.
+    RTC_LOG(LS_INFO) << num_streams << " streams: "
+                     << frames_per_second[0] / 100 / num_cores
+                     << " streams per core with a thread per stream, "
+                     << frames_per_second[1] / 100 / num_cores
+                     << " streams per core with the scheduler";
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,66 @@
+// seek_audio_spsc_ring.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SPSC_RING_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SPSC_RING_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Fixed capacity, lock-free ring for exactly one producer thread and one
+// consumer thread. All slots are allocated at construction and are filled and
+// read in place, so that pushing and popping neither allocates nor copies.
+template <typename T>
+class SeekAudioSpscRing {
+ public:
+  explicit SeekAudioSpscRing(size_t capacity) : slots_(capacity) {
+    RTC_DCHECK_GT(capacity, 0);
+  }
+  SeekAudioSpscRing(const SeekAudioSpscRing&) = delete;
+  SeekAudioSpscRing& operator=(const SeekAudioSpscRing&) = delete;
+
+  size_t capacity() const { return slots_.size(); }
+
+  // Producer side. Returns the slot to fill, or null if the ring is full. The
+  // slot is published by CommitPush().
+  T* BeginPush() {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+      return nullptr;
+    }
+    return &slots_[tail % slots_.size()];
+  }
+  void CommitPush() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // Consumer side. Returns the oldest slot, or null if the ring is empty. The
+  // slot stays valid until Pop().
+  T* Front() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    return &slots_[head % slots_.size()];
+  }
+  void Pop() {
+    head_.store(head_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+ private:
+  std::vector<T> slots_;
+  // Monotonic counters; the producer only writes `tail_` and the consumer only
+  // writes `head_`. Kept on separate cache lines to avoid false sharing.
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_SPSC_RING_H_
@@ -0,0 +1,62 @@
+// seek_audio_spsc_ring_unittest.cc
+#include "modules/audio_processing/seek_audio_spsc_ring.h"
+
+#include <thread>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(SeekAudioSpscRing, FullAndEmpty) {
+  SeekAudioSpscRing<int> ring(3);
+  EXPECT_EQ(ring.Front(), nullptr);
+  for (int k = 0; k < 3; ++k) {
+    int* slot = ring.BeginPush();
+    ASSERT_NE(slot, nullptr);
+    *slot = k;
+    ring.CommitPush();
+  }
+  EXPECT_EQ(ring.BeginPush(), nullptr);
+
+  for (int k = 0; k < 3; ++k) {
+    int* slot = ring.Front();
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(*slot, k);
+    ring.Pop();
+  }
+  EXPECT_EQ(ring.Front(), nullptr);
+  EXPECT_NE(ring.BeginPush(), nullptr);
+}
+
+TEST(SeekAudioSpscRing, PreservesOrderAcrossThreads) {
+  constexpr int kNumItems = 10000;
+  SeekAudioSpscRing<int> ring(7);
+  auto producer = PlatformThread::SpawnJoinable(
+      [&ring] {
+        for (int k = 0; k < kNumItems;) {
+          if (int* slot = ring.BeginPush()) {
+            *slot = k++;
+            ring.CommitPush();
+          } else {
+            std::this_thread::yield();
+          }
+        }
+      },
+      "SpscProducer");
+
+  int expected = 0;
+  while (expected < kNumItems) {
+    if (int* slot = ring.Front()) {
+      ASSERT_EQ(*slot, expected);
+      ring.Pop();
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.Finalize();
+  EXPECT_EQ(ring.Front(), nullptr);
+}
+
+}  // namespace webrtc
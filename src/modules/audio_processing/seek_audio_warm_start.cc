@@ -0,0 +1,118 @@
+// seek_audio_warm_start.cc
+#include "modules/audio_processing/seek_audio_warm_start.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// 格式: "SAWS", version, u16 section count, then per section the module, the
+// channel, the u32 size and the data.
+constexpr uint8_t kMagic[4] = {'S', 'A', 'W', 'S'};
+constexpr uint8_t kVersion = 1;
+constexpr size_t kHeaderSize = sizeof(kMagic) + 3;
+constexpr size_t kSectionHeaderSize = 6;
+constexpr size_t kMaxNumSections = 0xffff;
+
+void WriteLittleEndian(uint32_t value, size_t num_bytes,
+                       std::vector<uint8_t>& data) {
+  for (size_t k = 0; k < num_bytes; ++k) {
+    data.push_back(static_cast<uint8_t>(value >> (8 * k)));
+  }
+}
+
+uint32_t ReadLittleEndian(const uint8_t* data, size_t num_bytes) {
+  uint32_t value = 0;
+  for (size_t k = num_bytes; k > 0; --k) {
+    value = (value << 8) | data[k - 1];
+  }
+  return value;
+}
+
+}  // namespace
+
+SeekAudioWarmStart::SeekAudioWarmStart() = default;
+
+SeekAudioWarmStart::~SeekAudioWarmStart() = default;
+
+void SeekAudioWarmStart::Add(Module module,
+                             int channel,
+                             std::vector<uint8_t> data) {
+  RTC_DCHECK_GE(channel, 0);
+  RTC_DCHECK_LE(channel, 0xff);
+  if (data.empty() || sections_.size() == kMaxNumSections) {
+    return;
+  }
+  sections_.push_back({module, channel, std::move(data)});
+}
+
+ArrayView<const uint8_t> SeekAudioWarmStart::Find(Module module,
+                                                  int channel) const {
+  for (const Section& section : sections_) {
+    if (section.module == module && section.channel == channel) {
+      return section.data;
+    }
+  }
+  return {};
+}
+
+std::vector<uint8_t> SeekAudioWarmStart::Serialize() const {
+  size_t size = kHeaderSize;
+  for (const Section& section : sections_) {
+    size += kSectionHeaderSize + section.data.size();
+  }
+  std::vector<uint8_t> data;
+  data.reserve(size);
+  data.insert(data.end(), std::begin(kMagic), std::end(kMagic));
+  data.push_back(kVersion);
+  WriteLittleEndian(sections_.size(), 2, data);
+  for (const Section& section : sections_) {
+    data.push_back(static_cast<uint8_t>(section.module));
+    data.push_back(static_cast<uint8_t>(section.channel));
+    WriteLittleEndian(section.data.size(), 4, data);
+    data.insert(data.end(), section.data.begin(), section.data.end());
+  }
+  return data;
+}
+
+bool SeekAudioWarmStart::Parse(ArrayView<const uint8_t> data) {
+  sections_.clear();
+  if (data.size() < kHeaderSize ||
+      !std::equal(std::begin(kMagic), std::end(kMagic), data.begin()) ||
+      data[sizeof(kMagic)] != kVersion) {
+    return false;
+  }
+  const size_t num_sections = ReadLittleEndian(&data[sizeof(kMagic) + 1], 2);
+  size_t position = kHeaderSize;
+  for (size_t k = 0; k < num_sections; ++k) {
+    if (data.size() - position < kSectionHeaderSize) {
+      sections_.clear();
+      return false;
+    }
+    const Module module = static_cast<Module>(data[position]);
+    const int channel = data[position + 1];
+    const size_t size = ReadLittleEndian(&data[position + 2], 4);
+    position += kSectionHeaderSize;
+    if (data.size() - position < size) {
+      sections_.clear();
+      return false;
+    }
+    sections_.push_back(
+        {module, channel,
+         std::vector<uint8_t>(data.begin() + position,
+                              data.begin() + position + size)});
+    position += size;
+  }
+  if (position != data.size()) {
+    sections_.clear();
+    return false;
+  }
+  return true;
+}
+
+}  // namespace webrtc
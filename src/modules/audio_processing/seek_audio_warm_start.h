@@ -0,0 +1,54 @@
+// seek_audio_warm_start.h
+#ifndef MODULES_AUDIO_PROCESSING_SEEK_AUDIO_WARM_START_H_
+#define MODULES_AUDIO_PROCESSING_SEEK_AUDIO_WARM_START_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Container of the adaptive state of the echo cancellers of an APM instance,
+// see AudioProcessing::GetWarmStartState(). Every section holds the opaque
+// state of one module, or of one channel of a SeekAudio engine, in the format
+// of that module.
+class SeekAudioWarmStart {
+ public:
+  enum class Module : uint8_t {
+    kAec3 = 1,
+    kSeekAudioAec = 2,
+    kSeekAudioAfc = 3,
+  };
+
+  struct Section {
+    Module module;
+    int channel;
+    std::vector<uint8_t> data;
+  };
+
+  SeekAudioWarmStart();
+  ~SeekAudioWarmStart();
+
+  // Adds a section, unless `data` is empty.
+  void Add(Module module, int channel, std::vector<uint8_t> data);
+  // Returns the state of `channel` of `module`, empty if there is none.
+  ArrayView<const uint8_t> Find(Module module, int channel) const;
+  const std::vector<Section>& sections() const { return sections_; }
+
+  // Compact little-endian binary form of the sections.
+  std::vector<uint8_t> Serialize() const;
+  // Replaces the sections with the parsed `data`. Returns false, leaving no
+  // sections, if `data` is malformed or of another version. Sections of
+  // unknown modules are kept, so that newer states are still partly usable.
+  bool Parse(ArrayView<const uint8_t> data);
+
+ private:
+  std::vector<Section> sections_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_SEEK_AUDIO_WARM_START_H_
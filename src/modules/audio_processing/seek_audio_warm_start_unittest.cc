@@ -0,0 +1,77 @@
+// seek_audio_warm_start_unittest.cc
+#include "modules/audio_processing/seek_audio_warm_start.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Module = SeekAudioWarmStart::Module;
+
+SeekAudioWarmStart CreateWarmStart() {
+  SeekAudioWarmStart warm_start;
+  warm_start.Add(Module::kAec3, 0, {1, 2, 3});
+  warm_start.Add(Module::kSeekAudioAec, 0, {4, 5});
+  warm_start.Add(Module::kSeekAudioAec, 1, {6});
+  warm_start.Add(Module::kSeekAudioAfc, 0, std::vector<uint8_t>(1000, 7));
+  return warm_start;
+}
+
+}  // namespace
+
+TEST(SeekAudioWarmStart, RoundTrip) {
+  const std::vector<uint8_t> data = CreateWarmStart().Serialize();
+  SeekAudioWarmStart parsed;
+  ASSERT_TRUE(parsed.Parse(data));
+  EXPECT_EQ(4u, parsed.sections().size());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3}),
+            std::vector<uint8_t>(parsed.Find(Module::kAec3, 0).begin(),
+                                 parsed.Find(Module::kAec3, 0).end()));
+  EXPECT_EQ(6, parsed.Find(Module::kSeekAudioAec, 1)[0]);
+  EXPECT_EQ(1000u, parsed.Find(Module::kSeekAudioAfc, 0).size());
+  EXPECT_TRUE(parsed.Find(Module::kSeekAudioAfc, 1).empty());
+}
+
+TEST(SeekAudioWarmStart, SkipsEmptySections) {
+  SeekAudioWarmStart warm_start;
+  warm_start.Add(Module::kAec3, 0, {});
+  EXPECT_TRUE(warm_start.sections().empty());
+
+  SeekAudioWarmStart parsed;
+  ASSERT_TRUE(parsed.Parse(warm_start.Serialize()));
+  EXPECT_TRUE(parsed.sections().empty());
+}
+
+TEST(SeekAudioWarmStart, KeepsUnknownModules) {
+  SeekAudioWarmStart warm_start;
+  warm_start.Add(static_cast<Module>(42), 3, {9});
+  SeekAudioWarmStart parsed;
+  ASSERT_TRUE(parsed.Parse(warm_start.Serialize()));
+  EXPECT_EQ(9, parsed.Find(static_cast<Module>(42), 3)[0]);
+}
+
+TEST(SeekAudioWarmStart, RejectsMalformedData) {
+  const std::vector<uint8_t> data = CreateWarmStart().Serialize();
+  SeekAudioWarmStart parsed;
+  EXPECT_FALSE(parsed.Parse({}));
+  for (size_t size : {size_t{4}, size_t{10}, data.size() - 1}) {
+    EXPECT_FALSE(parsed.Parse(ArrayView<const uint8_t>(data.data(), size)));
+    EXPECT_TRUE(parsed.sections().empty());
+  }
+
+  std::vector<uint8_t> trailing = data;
+  trailing.push_back(0);
+  EXPECT_FALSE(parsed.Parse(trailing));
+
+  std::vector<uint8_t> wrong_magic = data;
+  wrong_magic[1] = 'X';
+  EXPECT_FALSE(parsed.Parse(wrong_magic));
+
+  std::vector<uint8_t> wrong_version = data;
+  wrong_version[4] = 0;
+  EXPECT_FALSE(parsed.Parse(wrong_version));
+}
+
+}  // namespace webrtc
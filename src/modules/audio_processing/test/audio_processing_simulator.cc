@@ -27,6 +27,7 @@
 #include "common_audio/include/audio_util.h"
 #include "common_audio/wav_file.h"
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "modules/audio_processing/capture_stage_timer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/api_call_statistics.h"
 #include "modules/audio_processing/test/fake_recording_device.h"
@@ -420,8 +421,27 @@ void AudioProcessingSimulator::DetachAecDump() {
   }
 }
 
+void AudioProcessingSimulator::PrintStageTimingsReport() {
+  const AudioProcessingStageTimings timings = ap_->GetStageTimings();
+  std::cout << std::endl << "Capture stages (us per frame):" << std::endl;
+  for (size_t k = 0; k < AudioProcessingStageTimings::kNumStages; ++k) {
+    const auto stage = static_cast<AudioProcessingStageTimings::Stage>(k);
+    const AudioProcessingStageTimings::Timing& timing = timings[stage];
+    if (timing.num_frames == 0) {
+      continue;
+    }
+    std::cout << " " << CaptureStageTimer::StageName(stage) << ":"
+              << " avg " << timing.mean_us << ", p50 " << timing.p50_us
+              << ", p99 " << timing.p99_us << ", p99.9 " << timing.p999_us
+              << ", max " << timing.max_us << ", frames over budget "
+              << timing.num_frames_over_budget << " of " << timing.num_frames
+              << std::endl;
+  }
+}
+
 void AudioProcessingSimulator::ConfigureAudioProcessor() {
   AudioProcessing::Config apm_config;
+  apm_config.pipeline.measure_stage_timings = settings_.report_performance;
   if (settings_.use_ts) {
     apm_config.transient_suppression.enabled = *settings_.use_ts != 0;
   }
@@ -181,6 +181,10 @@ class AudioProcessingSimulator {
     return api_call_statistics_;
   }
 
+  // Prints the execution times of the capture processing stages, measured
+  // when `report_performance` is set.
+  void PrintStageTimingsReport();
+
   // Analyzes the data in the input and reports the resulting statistics.
   virtual void Analyze() = 0;
 
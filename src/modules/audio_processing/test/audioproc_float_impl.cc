@@ -850,6 +850,7 @@ int RunSimulation(
 
   if (settings.report_performance) {
     processor->GetApiCallStatistics().PrintReport();
+    processor->PrintStageTimingsReport();
   }
   if (settings.performance_report_output_filename) {
     processor->GetApiCallStatistics().WriteReportToFile(
@@ -0,0 +1,402 @@
+// seek_audio_benchmark.cc
+//
+// Offline throughput benchmark of the SeekAudio integration. Drives an APM
+// with the SeekAudio modules enabled over a synthetic call, by default on the
+// deterministic libseekaudio_{aec,afc}_stub.so, and reports frames/s, the
+// p50/p99/p999 time of a 10 ms render + capture frame pair of all streams and
+// the number of heap allocations per frame. With --max_p99_us or
+// --max_allocations_per_frame it exits with 1 when exceeding them, to be used
+// as a regression gate.
+//
+// The stub engine cost is set through its environment variables, see
+// SeekAudioStubEngine::Config, e.g.
+//   SEEKAUDIO_STUB_BASE_TAPS=256 seek_audio_benchmark --channels=2
+//
+// With --streams, one thread drives that many APM instances, the way a mixing
+// host does. Run in real time with worker thread processing, it reports the
+// streams per core of the thread-per-stream model and, with
+// --shared_worker_threads, of the SeekAudioScheduler pool, e.g.
+//   seek_audio_benchmark --mode=aec --streams=64 --async_lookahead_frames=2
+//       --realtime --frames=1000 [--shared_worker_threads=4]
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "api/audio/audio_processing.h"
+#include "api/audio/builtin_audio_processing_builder.h"
+#include "api/environment/environment_factory.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+
+ABSL_FLAG(std::string,
+          mode,
+          "aec_afc",
+          "SeekAudio modules to run: aec, afc or aec_afc");
+ABSL_FLAG(std::string,
+          aec_library,
+          "",
+          "AEC engine library, libseekaudio_aec_stub.so next to the binary "
+          "if empty");
+ABSL_FLAG(std::string,
+          afc_library,
+          "",
+          "AFC engine library, libseekaudio_afc_stub.so next to the binary "
+          "if empty");
+ABSL_FLAG(int, sample_rate_hz, 48000, "Sample rate of the streams");
+ABSL_FLAG(int, channels, 1, "Number of capture and render channels");
+ABSL_FLAG(int, frames, 6000, "Number of measured 10 ms frames");
+ABSL_FLAG(int, warmup_frames, 100, "Number of frames run before measuring");
+ABSL_FLAG(int, howl_level, 30, "AI engine power for howling suppression");
+ABSL_FLAG(int, echo_level, 30, "AI engine power for echo suppression");
+ABSL_FLAG(int,
+          async_lookahead_frames,
+          0,
+          "Runs the AEC on a worker thread with this lookahead if positive");
+ABSL_FLAG(int,
+          shared_worker_threads,
+          0,
+          "With --async_lookahead_frames, runs the AEC engines of all streams "
+          "on a shared pool of this many workers if positive");
+ABSL_FLAG(int, streams, 1, "Number of APM instances driven by one thread");
+ABSL_FLAG(bool,
+          realtime,
+          false,
+          "Paces the frames at 10 ms instead of running them back to back");
+ABSL_FLAG(bool,
+          agc_compensation,
+          false,
+          "Runs AGC1 followed by the AGC compensation of the engines");
+ABSL_FLAG(int, max_p99_us, 0, "Fails above this p99 frame time if positive");
+ABSL_FLAG(double,
+          max_allocations_per_frame,
+          -1.0,
+          "Fails above this many allocations per frame if not negative");
+
+namespace {
+
+// Heap allocations of the whole process, counted by the replaced global
+// operator new below.
+std::atomic<int64_t> g_num_allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+  free(p);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = nullptr;
+  if (posix_memalign(&p,
+                     std::max(static_cast<size_t>(alignment), sizeof(void*)),
+                     size ? size : 1) == 0) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  free(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+  free(p);
+}
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Delay and gain of the simulated echo path.
+constexpr int kEchoDelaySamplesAt16kHz = 480;
+constexpr float kEchoGain = 0.5f;
+
+std::string ExecutableDirectory() {
+  char path[PATH_MAX];
+  const ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+  if (length <= 0) {
+    return ".";
+  }
+  path[length] = '\0';
+  std::string directory(path);
+  return directory.substr(0, directory.rfind('/'));
+}
+
+std::string LibraryPath(const std::string& flag, const char* stub_name) {
+  return flag.empty() ? ExecutableDirectory() + "/" + stub_name : flag;
+}
+
+int64_t ProcessCpuTimeNs() {
+  timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * kNumNanosecsPerSec + ts.tv_nsec;
+}
+
+int64_t Percentile(const std::vector<int64_t>& sorted, double fraction) {
+  const size_t index = std::min(
+      sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+  return sorted[index];
+}
+
+// Synthetic call: noise-like far-end speech, echoed into the capture signal
+// along with a weaker near-end talker. The signals only depend on the seed.
+class CallGenerator {
+ public:
+  CallGenerator(int sample_rate_hz, int num_channels)
+      : random_(42),
+        frame_size_(sample_rate_hz / 100),
+        echo_delay_(kEchoDelaySamplesAt16kHz * sample_rate_hz / 16000),
+        render_history_(echo_delay_ + frame_size_, 0.f),
+        render_(num_channels, std::vector<float>(frame_size_)),
+        capture_(num_channels, std::vector<float>(frame_size_)) {
+    for (auto& channel : render_) {
+      render_channels_.push_back(channel.data());
+    }
+    for (auto& channel : capture_) {
+      capture_channels_.push_back(channel.data());
+    }
+  }
+
+  void Generate() {
+    std::copy(render_history_.begin() + frame_size_, render_history_.end(),
+              render_history_.begin());
+    for (size_t k = 0; k < frame_size_; ++k) {
+      const float far = random_.Gaussian(0.f, 3000.f);
+      render_history_[echo_delay_ + k] = far;
+      const float near = random_.Gaussian(0.f, 300.f);
+      for (size_t ch = 0; ch < render_.size(); ++ch) {
+        render_[ch][k] = far;
+        capture_[ch][k] = kEchoGain * render_history_[k] + near;
+      }
+    }
+  }
+
+  float* const* render() { return render_channels_.data(); }
+  float* const* capture() { return capture_channels_.data(); }
+
+ private:
+  Random random_;
+  const size_t frame_size_;
+  const size_t echo_delay_;
+  std::vector<float> render_history_;
+  std::vector<std::vector<float>> render_;
+  std::vector<std::vector<float>> capture_;
+  std::vector<float*> render_channels_;
+  std::vector<float*> capture_channels_;
+};
+
+int RunBenchmark() {
+  const std::string mode = absl::GetFlag(FLAGS_mode);
+  if (mode != "aec" && mode != "afc" && mode != "aec_afc") {
+    fprintf(stderr, "Unknown --mode %s\n", mode.c_str());
+    return 1;
+  }
+  const int sample_rate_hz = absl::GetFlag(FLAGS_sample_rate_hz);
+  const int num_channels = absl::GetFlag(FLAGS_channels);
+  const int num_frames = absl::GetFlag(FLAGS_frames);
+  const int num_streams = absl::GetFlag(FLAGS_streams);
+  if (sample_rate_hz % 100 != 0 || num_channels <= 0 || num_frames <= 0 ||
+      num_streams <= 0) {
+    fprintf(stderr, "Invalid stream format or number of frames or streams\n");
+    return 1;
+  }
+
+  AudioProcessing::Config config;
+  config.seek_audio_aec.enabled = mode != "afc";
+  config.seek_audio_aec.suppress_level = absl::GetFlag(FLAGS_howl_level);
+  config.seek_audio_aec.echo_level = absl::GetFlag(FLAGS_echo_level);
+  config.seek_audio_aec.library_path =
+      LibraryPath(absl::GetFlag(FLAGS_aec_library),
+                  "libseekaudio_aec_stub.so");
+  config.seek_audio_aec.async_lookahead_frames =
+      absl::GetFlag(FLAGS_async_lookahead_frames);
+  config.seek_audio_aec.shared_worker_threads =
+      absl::GetFlag(FLAGS_shared_worker_threads);
+  config.seek_audio_afc.enabled = mode != "aec";
+  config.seek_audio_afc.suppress_level = absl::GetFlag(FLAGS_howl_level);
+  config.seek_audio_afc.library_path =
+      LibraryPath(absl::GetFlag(FLAGS_afc_library),
+                  "libseekaudio_afc_stub.so");
+  if (absl::GetFlag(FLAGS_agc_compensation)) {
+    config.gain_controller1.enabled = true;
+    config.gain_controller1.mode =
+        AudioProcessing::Config::GainController1::kAdaptiveDigital;
+    config.seek_audio_aec.agc_compensation = true;
+    config.seek_audio_afc.agc_compensation = true;
+  }
+  std::vector<scoped_refptr<AudioProcessing>> apms;
+  std::vector<std::unique_ptr<CallGenerator>> calls;
+  for (int k = 0; k < num_streams; ++k) {
+    apms.push_back(
+        BuiltinAudioProcessingBuilder(config).Build(CreateEnvironment()));
+    calls.push_back(
+        std::make_unique<CallGenerator>(sample_rate_hz, num_channels));
+  }
+
+  // Processes one 10 ms frame of every stream.
+  const StreamConfig stream_config(sample_rate_hz, num_channels);
+  auto process_frame = [&] {
+    for (int k = 0; k < num_streams; ++k) {
+      CallGenerator& call = *calls[k];
+      call.Generate();
+      apms[k]->ProcessReverseStream(call.render(), stream_config,
+                                    stream_config, call.render());
+      if (apms[k]->ProcessStream(call.capture(), stream_config, stream_config,
+                                 call.capture()) != AudioProcessing::kNoError) {
+        return false;
+      }
+    }
+    return true;
+  };
+  // Sums a SeekAudio counter over all streams.
+  auto sum_stats = [&](std::optional<int32_t> AudioProcessingStats::*counter) {
+    int sum = 0;
+    for (const auto& apm : apms) {
+      sum += (apm->GetStatistics().*counter).value_or(0);
+    }
+    return sum;
+  };
+
+  for (int k = 0; k < absl::GetFlag(FLAGS_warmup_frames); ++k) {
+    process_frame();
+  }
+  if (sum_stats(&AudioProcessingStats::seek_audio_engine_errors) > 0 ||
+      sum_stats(&AudioProcessingStats::seek_audio_not_ready_frames) > 0) {
+    fprintf(stderr, "SeekAudio engines not running, check the libraries\n");
+    return 1;
+  }
+  const int late_frames_before =
+      sum_stats(&AudioProcessingStats::seek_audio_late_frames);
+
+  const bool realtime = absl::GetFlag(FLAGS_realtime);
+  std::vector<int64_t> frame_times_ns(num_frames);
+  const int64_t allocations_before =
+      g_num_allocations.load(std::memory_order_relaxed);
+  const int64_t start_ns = TimeNanos();
+  const int64_t start_cpu_ns = ProcessCpuTimeNs();
+  for (int k = 0; k < num_frames; ++k) {
+    if (realtime) {
+      const int64_t wait_ns =
+          start_ns + k * 10 * kNumNanosecsPerMillisec - TimeNanos();
+      if (wait_ns > 0) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns));
+      }
+    }
+    const int64_t frame_start_ns = TimeNanos();
+    if (!process_frame()) {
+      fprintf(stderr, "ProcessStream failed\n");
+      return 1;
+    }
+    frame_times_ns[k] = TimeNanos() - frame_start_ns;
+  }
+  const int64_t total_ns = TimeNanos() - start_ns;
+  const int64_t total_cpu_ns = ProcessCpuTimeNs() - start_cpu_ns;
+  const int64_t num_allocations =
+      g_num_allocations.load(std::memory_order_relaxed) - allocations_before;
+
+  std::sort(frame_times_ns.begin(), frame_times_ns.end());
+  const double frames_per_second = num_frames * 1e9 / total_ns;
+  const int64_t p99_us = Percentile(frame_times_ns, 0.99) / 1000;
+  const double allocations_per_frame =
+      static_cast<double>(num_allocations) / num_frames;
+  // Cores kept busy on average, by the driving thread and the workers.
+  const double cores_used = static_cast<double>(total_cpu_ns) / total_ns;
+
+  printf("mode=%s sample_rate_hz=%d channels=%d frames=%d streams=%d\n",
+         mode.c_str(), sample_rate_hz, num_channels, num_frames, num_streams);
+  printf("frames_per_second=%.1f realtime_factor=%.1f\n", frames_per_second,
+         frames_per_second / 100.0);
+  printf("cores_used=%.2f streams_per_core=%.1f\n", cores_used,
+         cores_used > 0.0 ? num_streams / cores_used : 0.0);
+  printf("frame_time_us p50=%.1f p99=%.1f p999=%.1f max=%.1f\n",
+         Percentile(frame_times_ns, 0.5) / 1000.0,
+         Percentile(frame_times_ns, 0.99) / 1000.0,
+         Percentile(frame_times_ns, 0.999) / 1000.0,
+         frame_times_ns.back() / 1000.0);
+  printf("allocations=%lld allocations_per_frame=%.2f\n",
+         static_cast<long long>(num_allocations), allocations_per_frame);
+
+  printf("late_frames=%d engine_errors=%d far_end_overflows=%d\n",
+         sum_stats(&AudioProcessingStats::seek_audio_late_frames) -
+             late_frames_before,
+         sum_stats(&AudioProcessingStats::seek_audio_engine_errors),
+         sum_stats(&AudioProcessingStats::seek_audio_far_end_overflows));
+
+  bool passed = true;
+  const int max_p99_us = absl::GetFlag(FLAGS_max_p99_us);
+  if (max_p99_us > 0 && p99_us > max_p99_us) {
+    fprintf(stderr, "FAILED: p99 frame time %lld us above %d us\n",
+            static_cast<long long>(p99_us), max_p99_us);
+    passed = false;
+  }
+  const double max_allocations_per_frame =
+      absl::GetFlag(FLAGS_max_allocations_per_frame);
+  if (max_allocations_per_frame >= 0.0 &&
+      allocations_per_frame > max_allocations_per_frame) {
+    fprintf(stderr, "FAILED: %.2f allocations per frame above %.2f\n",
+            allocations_per_frame, max_allocations_per_frame);
+    passed = false;
+  }
+  return passed ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  return webrtc::test::RunBenchmark();
+}
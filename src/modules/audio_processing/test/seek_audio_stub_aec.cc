@@ -0,0 +1,159 @@
+// seek_audio_stub_aec.cc
+//
+// libseekaudio_aec_stub.so: the SeekAudioAEC_* ABI of libseekaudio_aec.so on
+// top of SeekAudioStubEngine, including the optional float and state entry
+// points. The engine runs at the sum of the howl and echo power levels.
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/test/seek_audio_stub_engine.h"
+
+#define SEEKAUDIO_STUB_EXPORT __attribute__((visibility("default")))
+
+namespace {
+
+using webrtc::test::SeekAudioStubEngine;
+
+constexpr size_t kFrameSize = SeekAudioStubEngine::kFrameSize;
+using FloatFrame = std::array<float, kFrameSize>;
+
+struct AecStub {
+  SeekAudioStubEngine engine{SeekAudioStubEngine::Config::FromEnvironment()};
+  int howl_level = 0;
+  int echo_level = 0;
+};
+
+AecStub* Stub(void* handle) {
+  return static_cast<AecStub*>(handle);
+}
+
+void ToFloat(const short* x, FloatFrame& y) {
+  std::copy(x, x + kFrameSize, y.begin());
+}
+
+void ToInt16(const FloatFrame& x, short* y) {
+  for (size_t k = 0; k < kFrameSize; ++k) {
+    y[k] = static_cast<short>(
+        std::clamp(std::lrintf(x[k]), -32768l, 32767l));
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+SEEKAUDIO_STUB_EXPORT void* SeekAudioAEC_Create() {
+  return new AecStub();
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAEC_Free(void* handle) {
+  delete Stub(handle);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_OpenLog(void* handle,
+                                               const char* folder_path) {
+  return 0;
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_Init(void* handle, int sample_rate) {
+  return Stub(handle)->engine.Init(sample_rate);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAEC_Set_AI_Engine_Power_For_Howl(
+    void* handle,
+    int level) {
+  AecStub* stub = Stub(handle);
+  stub->howl_level = level;
+  stub->engine.SetPowerLevel(stub->howl_level + stub->echo_level);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAEC_Set_AI_Engine_Power_For_Echo(
+    void* handle,
+    int level) {
+  AecStub* stub = Stub(handle);
+  stub->echo_level = level;
+  stub->engine.SetPowerLevel(stub->howl_level + stub->echo_level);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_Process_Float(void* handle,
+                                                     const float* nearend,
+                                                     float* outframe,
+                                                     int num_samples) {
+  return Stub(handle)->engine.Process(nearend, outframe, num_samples);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_Process(void* handle,
+                                               const short* nearend,
+                                               short* outframe,
+                                               int num_samples) {
+  if (num_samples != static_cast<int>(kFrameSize)) {
+    return -1;
+  }
+  FloatFrame frame;
+  ToFloat(nearend, frame);
+  const int result =
+      Stub(handle)->engine.Process(frame.data(), frame.data(), num_samples);
+  ToInt16(frame, outframe);
+  return result;
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_buffer_farend_Float(void* handle,
+                                                           const float* farend,
+                                                           int num_samples) {
+  return Stub(handle)->engine.BufferReference(farend, num_samples);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_buffer_farend(void* handle,
+                                                     const short* farend,
+                                                     int num_samples) {
+  if (num_samples != static_cast<int>(kFrameSize)) {
+    return -1;
+  }
+  FloatFrame frame;
+  ToFloat(farend, frame);
+  return Stub(handle)->engine.BufferReference(frame.data(), num_samples);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAEC_AGC_Compensate_Float(
+    void* handle,
+    const float* agc_in,
+    const float* agc_out,
+    const float* inframe,
+    float* outframe) {
+  Stub(handle)->engine.AgcCompensate(agc_in, agc_out, inframe, outframe);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAEC_AGC_Compensate(void* handle,
+                                                       const short* agc_in,
+                                                       const short* agc_out,
+                                                       const short* inframe,
+                                                       short* outframe) {
+  FloatFrame in;
+  FloatFrame out;
+  FloatFrame frame;
+  ToFloat(agc_in, in);
+  ToFloat(agc_out, out);
+  ToFloat(inframe, frame);
+  Stub(handle)->engine.AgcCompensate(in.data(), out.data(), frame.data(),
+                                     frame.data());
+  ToInt16(frame, outframe);
+}
+
+SEEKAUDIO_STUB_EXPORT float SeekAudioAEC_GetHowlingStatus(void* handle) {
+  return Stub(handle)->engine.howling_probability();
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_GetState(void* handle,
+                                                unsigned char* data,
+                                                int capacity) {
+  return Stub(handle)->engine.GetState(data, capacity);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAEC_SetState(void* handle,
+                                                const unsigned char* data,
+                                                int size) {
+  return Stub(handle)->engine.SetState(data, size);
+}
+
+}  // extern "C"
@@ -0,0 +1,121 @@
+// seek_audio_stub_afc.cc
+//
+// libseekaudio_afc_stub.so: the SeekAudioAFC_* ABI of libseekaudio_afc.so on
+// top of SeekAudioStubEngine, including the optional float and state entry
+// points. The engine cancels its own past output, the acoustic feedback path.
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "modules/audio_processing/test/seek_audio_stub_engine.h"
+
+#define SEEKAUDIO_STUB_EXPORT __attribute__((visibility("default")))
+
+namespace {
+
+using webrtc::test::SeekAudioStubEngine;
+
+constexpr size_t kFrameSize = SeekAudioStubEngine::kFrameSize;
+using FloatFrame = std::array<float, kFrameSize>;
+
+SeekAudioStubEngine* Stub(void* handle) {
+  return static_cast<SeekAudioStubEngine*>(handle);
+}
+
+void ToFloat(const short* x, FloatFrame& y) {
+  std::copy(x, x + kFrameSize, y.begin());
+}
+
+void ToInt16(const FloatFrame& x, short* y) {
+  for (size_t k = 0; k < kFrameSize; ++k) {
+    y[k] = static_cast<short>(
+        std::clamp(std::lrintf(x[k]), -32768l, 32767l));
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+SEEKAUDIO_STUB_EXPORT void* SeekAudioAFC_Create() {
+  return new SeekAudioStubEngine(SeekAudioStubEngine::Config::FromEnvironment());
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_Free(void* handle) {
+  delete Stub(handle);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAFC_OpenLog(void* handle,
+                                               const char* folder_path) {
+  return 0;
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAFC_Init(void* handle, int sample_rate) {
+  return Stub(handle)->Init(sample_rate);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_Set_AI_Engine_Power(void* handle,
+                                                            int level) {
+  Stub(handle)->SetPowerLevel(level);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_Process_Float(void* handle,
+                                                      const float* inframe,
+                                                      float* outframe) {
+  SeekAudioStubEngine* engine = Stub(handle);
+  if (engine->Process(inframe, outframe, kFrameSize) == 0) {
+    engine->BufferReference(outframe, kFrameSize);
+  }
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_Process(void* handle,
+                                                const short* inframe,
+                                                short* outframe) {
+  FloatFrame frame;
+  ToFloat(inframe, frame);
+  SeekAudioAFC_Process_Float(handle, frame.data(), frame.data());
+  ToInt16(frame, outframe);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_AGC_Compensate_Float(
+    void* handle,
+    const float* agc_in,
+    const float* agc_out,
+    const float* inframe,
+    float* outframe) {
+  Stub(handle)->AgcCompensate(agc_in, agc_out, inframe, outframe);
+}
+
+SEEKAUDIO_STUB_EXPORT void SeekAudioAFC_AGC_Compensate(void* handle,
+                                                       const short* agc_in,
+                                                       const short* agc_out,
+                                                       const short* inframe,
+                                                       short* outframe) {
+  FloatFrame in;
+  FloatFrame out;
+  FloatFrame frame;
+  ToFloat(agc_in, in);
+  ToFloat(agc_out, out);
+  ToFloat(inframe, frame);
+  Stub(handle)->AgcCompensate(in.data(), out.data(), frame.data(),
+                              frame.data());
+  ToInt16(frame, outframe);
+}
+
+SEEKAUDIO_STUB_EXPORT float SeekAudioAFC_GetHowlingStatus(void* handle) {
+  return Stub(handle)->howling_probability();
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAFC_GetState(void* handle,
+                                                unsigned char* data,
+                                                int capacity) {
+  return Stub(handle)->GetState(data, capacity);
+}
+
+SEEKAUDIO_STUB_EXPORT int SeekAudioAFC_SetState(void* handle,
+                                                const unsigned char* data,
+                                                int size) {
+  return Stub(handle)->SetState(data, size);
+}
+
+}  // extern "C"
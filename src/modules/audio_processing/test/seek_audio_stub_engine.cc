@@ -0,0 +1,182 @@
+// seek_audio_stub_engine.cc
+#include "modules/audio_processing/test/seek_audio_stub_engine.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr float kStepSize = 0.1f;
+constexpr float kRegularization = 1e3f;
+constexpr float kClippingLevel = 32000.f;
+constexpr float kHowlingSmoothing = 0.05f;
+
+void ReadEnvironment(const char* name,
+                     int min_value,
+                     int max_value,
+                     int* value) {
+  const char* text = getenv(name);
+  if (text && *text) {
+    *value = std::clamp(atoi(text), min_value, max_value);
+  }
+}
+
+float Energy(const float* x, size_t num_samples) {
+  float energy = 0.f;
+  for (size_t k = 0; k < num_samples; ++k) {
+    energy += x[k] * x[k];
+  }
+  return energy;
+}
+
+}  // namespace
+
+SeekAudioStubEngine::Config SeekAudioStubEngine::Config::FromEnvironment() {
+  Config config;
+  ReadEnvironment("SEEKAUDIO_STUB_BASE_TAPS", 1, kMaxTaps, &config.base_taps);
+  ReadEnvironment("SEEKAUDIO_STUB_TAPS_PER_LEVEL", 0, kMaxTaps,
+                  &config.taps_per_level);
+  ReadEnvironment("SEEKAUDIO_STUB_DELAY_FRAMES", 0, kMaxDelayFrames,
+                  &config.delay_frames);
+  ReadEnvironment("SEEKAUDIO_STUB_SPIN_US", 0, 10000, &config.spin_us);
+  return config;
+}
+
+SeekAudioStubEngine::SeekAudioStubEngine(const Config& config)
+    : config_(config),
+      num_taps_(std::clamp(config.base_taps, 1, kMaxTaps)),
+      weights_(kMaxTaps, 0.f),
+      reference_(kMaxTaps + kFrameSize, 0.f),
+      delay_line_(std::clamp(config.delay_frames, 0, kMaxDelayFrames) + 1) {
+  for (Frame& frame : delay_line_) {
+    frame.fill(0.f);
+  }
+}
+
+int SeekAudioStubEngine::Init(int sample_rate_hz) {
+  if (sample_rate_hz != kSampleRateHz) {
+    return -1;
+  }
+  initialized_ = true;
+  return 0;
+}
+
+void SeekAudioStubEngine::SetPowerLevel(int level) {
+  num_taps_ = std::clamp(
+      config_.base_taps + config_.taps_per_level * std::clamp(level, 0, 100),
+      1, kMaxTaps);
+}
+
+int SeekAudioStubEngine::BufferReference(const float* frame,
+                                         int num_samples) {
+  if (num_samples != static_cast<int>(kFrameSize)) {
+    return -1;
+  }
+  std::copy(reference_.begin() + kFrameSize, reference_.end(),
+            reference_.begin());
+  std::copy(frame, frame + kFrameSize, reference_.end() - kFrameSize);
+  return 0;
+}
+
+int SeekAudioStubEngine::Process(const float* nearend,
+                                 float* output,
+                                 int num_samples) {
+  if (!initialized_ || num_samples != static_cast<int>(kFrameSize)) {
+    return -1;
+  }
+
+  float peak = 0.f;
+  for (size_t k = 0; k < kFrameSize; ++k) {
+    peak = std::max(peak, std::fabs(nearend[k]));
+  }
+  howling_probability_ +=
+      kHowlingSmoothing *
+      ((peak >= kClippingLevel ? 1.f : 0.f) - howling_probability_);
+
+  // Normalized LMS over the newest `num_taps_` reference samples.
+  Frame& error = delay_line_[delay_index_];
+  const float* x_end = reference_.data() + kMaxTaps + 1;
+  float x_energy = Energy(x_end - num_taps_, num_taps_);
+  for (size_t k = 0; k < kFrameSize; ++k, ++x_end) {
+    const float* x = x_end - num_taps_;
+    float estimate = 0.f;
+    for (int t = 0; t < num_taps_; ++t) {
+      estimate += weights_[t] * x[t];
+    }
+    error[k] = nearend[k] - estimate;
+    const float step = kStepSize * error[k] / (x_energy + kRegularization);
+    for (int t = 0; t < num_taps_; ++t) {
+      weights_[t] += step * x[t];
+    }
+    if (k + 1 < kFrameSize) {
+      x_energy += x[num_taps_] * x[num_taps_] - x[0] * x[0];
+      x_energy = std::max(x_energy, 0.f);
+    }
+  }
+
+  // The error of `delay_frames` frames ago is output.
+  delay_index_ = (delay_index_ + 1) % delay_line_.size();
+  std::copy(delay_line_[delay_index_].begin(), delay_line_[delay_index_].end(),
+            output);
+
+  SpinIfConfigured();
+  return 0;
+}
+
+void SeekAudioStubEngine::AgcCompensate(const float* agc_in,
+                                        const float* agc_out,
+                                        const float* input,
+                                        float* output) const {
+  const float energy_in = Energy(agc_in, kFrameSize);
+  const float energy_out = Energy(agc_out, kFrameSize);
+  const float gain =
+      energy_in > 0.f ? std::min(std::sqrt(energy_out / energy_in), 1.f) : 1.f;
+  for (size_t k = 0; k < kFrameSize; ++k) {
+    output[k] = gain * input[k];
+  }
+}
+
+int SeekAudioStubEngine::GetState(unsigned char* data, int capacity) const {
+  const int32_t num_taps = num_taps_;
+  const int size = sizeof(num_taps) + num_taps * sizeof(float);
+  if (data && capacity >= size) {
+    memcpy(data, &num_taps, sizeof(num_taps));
+    memcpy(data + sizeof(num_taps), weights_.data(), num_taps * sizeof(float));
+  }
+  return size;
+}
+
+int SeekAudioStubEngine::SetState(const unsigned char* data, int size) {
+  int32_t num_taps;
+  if (!data || size < static_cast<int>(sizeof(num_taps))) {
+    return -1;
+  }
+  memcpy(&num_taps, data, sizeof(num_taps));
+  if (num_taps < 1 || num_taps > kMaxTaps ||
+      size != static_cast<int>(sizeof(num_taps) + num_taps * sizeof(float))) {
+    return -1;
+  }
+  std::fill(weights_.begin(), weights_.end(), 0.f);
+  memcpy(weights_.data(), data + sizeof(num_taps), num_taps * sizeof(float));
+  return 0;
+}
+
+void SeekAudioStubEngine::SpinIfConfigured() const {
+  if (config_.spin_us <= 0) {
+    return;
+  }
+  const auto end = std::chrono::steady_clock::now() +
+                   std::chrono::microseconds(config_.spin_us);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+}  // namespace test
+}  // namespace webrtc
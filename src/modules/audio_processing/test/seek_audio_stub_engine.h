@@ -0,0 +1,89 @@
+// seek_audio_stub_engine.h
+#ifndef MODULES_AUDIO_PROCESSING_TEST_SEEK_AUDIO_STUB_ENGINE_H_
+#define MODULES_AUDIO_PROCESSING_TEST_SEEK_AUDIO_STUB_ENGINE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <vector>
+
+namespace webrtc {
+namespace test {
+
+// Deterministic stand-in for the SeekAudio AI engine, behind the
+// SeekAudioAEC_*/SeekAudioAFC_* ABI of libseekaudio_{aec,afc}_stub.so. The
+// output only depends on the input, so that runs are reproducible, while the
+// compute cost and latency are configurable to model engines of different
+// weight:
+//  - An NLMS filter of `base_taps` + `taps_per_level` * power level taps
+//    cancels the reference, the far-end for the AEC and the own past output
+//    for the AFC. The cost thereby grows with the AI engine power like it
+//    does for the real engine.
+//  - The output is delayed by `delay_frames` 10 ms frames.
+//  - Every processed frame busy-waits for `spin_us` in addition.
+class SeekAudioStubEngine {
+ public:
+  struct Config {
+    int base_taps = 32;
+    int taps_per_level = 2;
+    int delay_frames = 0;
+    int spin_us = 0;
+
+    // Defaults overridden by the SEEKAUDIO_STUB_BASE_TAPS,
+    // SEEKAUDIO_STUB_TAPS_PER_LEVEL, SEEKAUDIO_STUB_DELAY_FRAMES and
+    // SEEKAUDIO_STUB_SPIN_US environment variables, read on every Create.
+    static Config FromEnvironment();
+  };
+
+  // The frame format of the engine ABI.
+  static constexpr int kSampleRateHz = 16000;
+  static constexpr size_t kFrameSize = 160;
+
+  static constexpr int kMaxTaps = 1024;
+  static constexpr int kMaxDelayFrames = 16;
+
+  explicit SeekAudioStubEngine(const Config& config);
+
+  // Only 16 kHz is supported, like by the real engine. Returns 0 on success.
+  int Init(int sample_rate_hz);
+  void SetPowerLevel(int level);
+
+  // Sets the next reference frame. Returns 0 on success.
+  int BufferReference(const float* frame, int num_samples);
+  // Processes one frame in-place or not. Returns 0 on success.
+  int Process(const float* nearend, float* output, int num_samples);
+  // Scales `input` by the gain of the AGC, limited to 0 dB, like the real
+  // engine limits the AGC gain during howling.
+  void AgcCompensate(const float* agc_in,
+                     const float* agc_out,
+                     const float* input,
+                     float* output) const;
+  // Warm start state, the filter weights in use as native floats preceded by
+  // their count. GetState() returns the size of the state, also when
+  // `capacity` is too small to write it. SetState() returns 0 on success.
+  int GetState(unsigned char* data, int capacity) const;
+  int SetState(const unsigned char* data, int size);
+  // Smoothed fraction of frames with clipped input, in [0, 1].
+  float howling_probability() const { return howling_probability_; }
+
+ private:
+  using Frame = std::array<float, kFrameSize>;
+
+  void SpinIfConfigured() const;
+
+  const Config config_;
+  bool initialized_ = false;
+  int num_taps_;
+  std::vector<float> weights_;
+  // The last `kMaxTaps` reference samples followed by the current frame.
+  std::vector<float> reference_;
+  std::vector<Frame> delay_line_;
+  size_t delay_index_ = 0;
+  float howling_probability_ = 0.f;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_TEST_SEEK_AUDIO_STUB_ENGINE_H_
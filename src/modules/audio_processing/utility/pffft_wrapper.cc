@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/utility/pffft_wrapper.h"
 
+#include <stdint.h>
+
 #include "rtc_base/checks.h"
 #include "third_party/pffft/src/pffft.h"
 
@@ -24,6 +26,10 @@ float* AllocatePffftBuffer(size_t size) {
   return static_cast<float*>(pffft_aligned_malloc(size * sizeof(float)));
 }
 
+bool IsAligned(const float* data) {
+  return reinterpret_cast<uintptr_t>(data) % Pffft::kAlignment == 0;
+}
+
 }  // namespace
 
 Pffft::FloatBuffer::FloatBuffer(size_t fft_size, FftType fft_type)
@@ -121,6 +127,44 @@ void Pffft::BackwardTransform(const FloatBuffer& in,
   }
 }
 
+void Pffft::ForwardTransform(ArrayView<const float> in,
+                             ArrayView<float> out,
+                             ArrayView<float> work,
+                             bool ordered) const {
+  RTC_DCHECK_EQ(in.size(), GetBufferSize(fft_size_, fft_type_));
+  RTC_DCHECK_EQ(in.size(), out.size());
+  RTC_DCHECK_EQ(in.size(), work.size());
+  RTC_DCHECK(IsAligned(in.data()));
+  RTC_DCHECK(IsAligned(out.data()));
+  RTC_DCHECK(IsAligned(work.data()));
+  if (ordered) {
+    pffft_transform_ordered(pffft_status_, in.data(), out.data(), work.data(),
+                            PFFFT_FORWARD);
+  } else {
+    pffft_transform(pffft_status_, in.data(), out.data(), work.data(),
+                    PFFFT_FORWARD);
+  }
+}
+
+void Pffft::BackwardTransform(ArrayView<const float> in,
+                              ArrayView<float> out,
+                              ArrayView<float> work,
+                              bool ordered) const {
+  RTC_DCHECK_EQ(in.size(), GetBufferSize(fft_size_, fft_type_));
+  RTC_DCHECK_EQ(in.size(), out.size());
+  RTC_DCHECK_EQ(in.size(), work.size());
+  RTC_DCHECK(IsAligned(in.data()));
+  RTC_DCHECK(IsAligned(out.data()));
+  RTC_DCHECK(IsAligned(work.data()));
+  if (ordered) {
+    pffft_transform_ordered(pffft_status_, in.data(), out.data(), work.data(),
+                            PFFFT_BACKWARD);
+  } else {
+    pffft_transform(pffft_status_, in.data(), out.data(), work.data(),
+                    PFFFT_BACKWARD);
+  }
+}
+
 void Pffft::FrequencyDomainConvolve(const FloatBuffer& fft_x,
                                     const FloatBuffer& fft_y,
                                     FloatBuffer* out,
@@ -21,11 +21,14 @@ struct PFFFT_Setup;
 namespace webrtc {
 
 // Pretty-Fast Fast Fourier Transform (PFFFT) wrapper class.
-// Not thread safe.
+// Not thread safe, except for the const transforms.
 class Pffft {
  public:
   enum class FftType { kReal, kComplex };
 
+  // Alignment in bytes of the views passed to the const transforms.
+  static constexpr size_t kAlignment = 16;
+
   // 1D floating point buffer used as input/output data type for the FFT ops.
   // It must be constructed using Pffft::CreateBuffer().
   class FloatBuffer {
@@ -73,6 +76,19 @@ class Pffft {
   // Computes the backward fast Fourier transform.
   void BackwardTransform(const FloatBuffer& in, FloatBuffer* out, bool ordered);
 
+  // Like the transforms above, but with `work` as working memory instead of
+  // that of the wrapper, so concurrent calls with separate buffers are safe.
+  // All views must have the size of a buffer and be aligned to kAlignment
+  // bytes. `in` and `out` may be the same.
+  void ForwardTransform(ArrayView<const float> in,
+                        ArrayView<float> out,
+                        ArrayView<float> work,
+                        bool ordered) const;
+  void BackwardTransform(ArrayView<const float> in,
+                         ArrayView<float> out,
+                         ArrayView<float> work,
+                         bool ordered) const;
+
   // Multiplies the frequency components of `fft_x` and `fft_y` and accumulates
   // them into `out`. The arrays must have been obtained with
   // ForwardTransform(..., /*ordered=*/false) - i.e., `fft_x` and `fft_y` must
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <utility>
 
 #include "test/gtest.h"
 #include "third_party/pffft/src/pffft.h"
@@ -64,6 +65,7 @@ void PffftValidateWrapper(size_t fft_size, bool complex_fft) {
   float* in = static_cast<float*>(pffft_aligned_malloc(num_bytes));
   float* out = static_cast<float*>(pffft_aligned_malloc(num_bytes));
   float* scratch = AllocateScratchBuffer(fft_size, complex_fft);
+  float* const_out = static_cast<float*>(pffft_aligned_malloc(num_bytes));
 
   // Init PFFFT C++ wrapper.
   Pffft::FftType fft_type =
@@ -76,6 +78,8 @@ void PffftValidateWrapper(size_t fft_size, bool complex_fft) {
   // Input and output buffers views.
   ArrayView<float> in_view(in, num_floats);
   ArrayView<float> out_view(out, num_floats);
+  ArrayView<float> scratch_view(scratch, num_floats);
+  ArrayView<float> const_out_view(const_out, num_floats);
   auto in_wrapper_view = in_wrapper->GetView();
   EXPECT_EQ(in_wrapper_view.size(), num_floats);
   auto out_wrapper_view = out_wrapper->GetConstView();
@@ -91,6 +95,10 @@ void PffftValidateWrapper(size_t fft_size, bool complex_fft) {
   pffft_wrapper.ForwardTransform(*in_wrapper, out_wrapper.get(),
                                  /*ordered=*/false);
   ExpectArrayViewsEquality(out_view, out_wrapper_view);
+  std::as_const(pffft_wrapper)
+      .ForwardTransform(in_view, const_out_view, scratch_view,
+                        /*ordered=*/false);
+  ExpectArrayViewsEquality(out_view, const_out_view);
 
   // Copy the FFT results into the input buffers to compute the backward FFT.
   std::copy(out_view.begin(), out_view.end(), in_view.begin());
@@ -102,11 +110,16 @@ void PffftValidateWrapper(size_t fft_size, bool complex_fft) {
   pffft_wrapper.BackwardTransform(*in_wrapper, out_wrapper.get(),
                                   /*ordered=*/false);
   ExpectArrayViewsEquality(out_view, out_wrapper_view);
+  std::as_const(pffft_wrapper)
+      .BackwardTransform(in_view, const_out_view, scratch_view,
+                         /*ordered=*/false);
+  ExpectArrayViewsEquality(out_view, const_out_view);
 
   pffft_destroy_setup(pffft_status);
   pffft_aligned_free(in);
   pffft_aligned_free(out);
   pffft_aligned_free(scratch);
+  pffft_aligned_free(const_out);
 }
 
 }  // namespace